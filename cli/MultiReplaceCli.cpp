@@ -0,0 +1,483 @@
+// This file is part of Notepad++ project
+// Copyright (C)2023 Thomas Knoefel
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+// Command line replacer: runs a list saved by the plugin over files, using the plugin's list matcher.
+// Only Normal and Extended entries are supported; Regex and Variables entries need Scintilla and Lua.
+
+#include "ListMatcher.h"
+#include "ReplaceList.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static const size_t WRITE_BUFFER_SIZE = 1 << 20;
+static const size_t SCAN_CHUNK_LENGTH = 1 << 22;
+// Files whose entries act on each other's results are replaced entry by entry in memory, up to this size
+static const size_t SEQUENTIAL_MAX_LENGTH = size_t(1) << 30;
+
+struct Options {
+    std::string listPath;
+    std::string outputDir;
+    bool inPlace = false;
+    bool countOnly = false;
+    int simultaneous = 0;       // 0 = sequential, 1 = list priority, 2 = leftmost-longest
+    size_t jobs = 1;
+    std::vector<std::string> files;
+};
+
+struct FileResult {
+    std::string path;
+    bool ok = false;
+    std::string error;
+    size_t bytes = 0;
+    bool sequential = false;            // Entries interact, applied one after another
+    std::vector<size_t> entryHits;
+    std::vector<double> entrySeconds;   // Sequential runs only
+    double scanSeconds = 0;
+    double writeSeconds = 0;
+};
+
+// Read-only view of a whole file
+class MappedFile
+{
+public:
+    ~MappedFile() {
+        if (_data != nullptr) {
+            munmap(_data, _size);
+        }
+        if (_fd >= 0) {
+            close(_fd);
+        }
+    }
+
+    bool open(const std::string& path) {
+        _fd = ::open(path.c_str(), O_RDONLY);
+        if (_fd < 0) {
+            return false;
+        }
+        struct stat info;
+        if (fstat(_fd, &info) != 0) {
+            return false;
+        }
+        _size = static_cast<size_t>(info.st_size);
+        _mode = info.st_mode & 07777;
+        _device = info.st_dev;
+        _inode = info.st_ino;
+        if (_size == 0) {
+            return true;
+        }
+        void* data = mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, _fd, 0);
+        if (data == MAP_FAILED) {
+            return false;
+        }
+        _data = data;
+        madvise(_data, _size, MADV_SEQUENTIAL);
+        return true;
+    }
+
+    const char* data() const { return _data ? static_cast<const char*>(_data) : ""; }
+    size_t size() const { return _size; }
+    mode_t mode() const { return _mode; }
+
+    // True if path names this file
+    bool isSameFile(const std::string& path) const {
+        struct stat info;
+        return stat(path.c_str(), &info) == 0 && info.st_dev == _device && info.st_ino == _inode;
+    }
+
+private:
+    int _fd = -1;
+    void* _data = nullptr;
+    size_t _size = 0;
+    mode_t _mode = 0644;
+    dev_t _device = 0;
+    ino_t _inode = 0;
+};
+
+static std::string directoryOf(const std::string& path) {
+    size_t slash = path.find_last_of('/');
+    return (slash == std::string::npos) ? "." : (slash == 0) ? "/" : path.substr(0, slash);
+}
+
+static std::string baseNameOf(const std::string& path) {
+    size_t slash = path.find_last_of('/');
+    return (slash == std::string::npos) ? path : path.substr(slash + 1);
+}
+
+// Collects small pieces (gaps and replacements) into large writes. They go to a temporary file next to the
+// target, which replaces the target only once it is complete, so a target still mapped as input or a
+// failed write never leaves a truncated file.
+class BufferedWriter
+{
+public:
+    ~BufferedWriter() {
+        if (_fd >= 0) {
+            close(_fd);
+        }
+        if (!_tempPath.empty()) {
+            unlink(_tempPath.c_str());
+        }
+    }
+
+    bool open(const std::string& target, mode_t mode) {
+        _target = target;
+        std::string name = directoryOf(target) + "/." + baseNameOf(target) + ".XXXXXX";
+        _fd = mkstemp(&name[0]);
+        if (_fd < 0) {
+            return false;
+        }
+        _tempPath = name;
+        _buffer.reserve(WRITE_BUFFER_SIZE);
+        return fchmod(_fd, mode) == 0;
+    }
+
+    bool write(const char* data, size_t length) {
+        if (_buffer.size() + length > WRITE_BUFFER_SIZE && !flush()) {
+            return false;
+        }
+        if (length >= WRITE_BUFFER_SIZE) {
+            return writeAll(data, length);
+        }
+        _buffer.insert(_buffer.end(), data, data + length);
+        return true;
+    }
+
+    // Replaces the target with the written text; the temporary file is removed if anything failed
+    bool finish() {
+        bool ok = flush();
+        ok = (close(_fd) == 0) && ok;
+        _fd = -1;
+        ok = ok && std::rename(_tempPath.c_str(), _target.c_str()) == 0;
+        if (ok) {
+            _tempPath.clear();
+        }
+        return ok;
+    }
+
+private:
+    int _fd = -1;
+    std::string _target;
+    std::string _tempPath;              // Removed unless it replaced the target
+    std::vector<char> _buffer;
+
+    bool flush() {
+        bool ok = writeAll(_buffer.data(), _buffer.size());
+        _buffer.clear();
+        return ok;
+    }
+
+    bool writeAll(const char* data, size_t length) {
+        while (length > 0) {
+            ssize_t written = ::write(_fd, data, length);
+            if (written < 0) {
+                return false;
+            }
+            data += written;
+            length -= static_cast<size_t>(written);
+        }
+        return true;
+    }
+};
+
+static double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+static void printUsage() {
+    std::fprintf(stderr,
+        "Usage: multireplace-cli -l LIST.csv (-o DIR | -i | -n) [-s priority|longest] [-j JOBS] FILE...\n"
+        "  -l LIST.csv  list saved with 'Save List' in the MultiReplace panel\n"
+        "  -o DIR       write the replaced files into DIR\n"
+        "  -i           replace the files in place\n"
+        "  -n           count only, write nothing\n"
+        "  -s MODE      match all entries against the original text; overlaps go to the\n"
+        "               earlier entry (priority) or the leftmost-longest occurrence (longest)\n"
+        "  -j JOBS      number of files processed in parallel (default 1)\n"
+        "Files are expected in UTF-8. Regex and Use Variables entries are skipped.\n"
+        "Files whose entries act on each other's results are limited to 1 GB unless -s is given.\n");
+}
+
+static bool parseOptions(int argc, char* argv[], Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = (i + 1 < argc);
+        if (arg == "-l" && hasValue) {
+            options.listPath = argv[++i];
+        }
+        else if (arg == "-o" && hasValue) {
+            options.outputDir = argv[++i];
+        }
+        else if (arg == "-i") {
+            options.inPlace = true;
+        }
+        else if (arg == "-n") {
+            options.countOnly = true;
+        }
+        else if (arg == "-s" && hasValue) {
+            std::string mode = argv[++i];
+            if (mode != "priority" && mode != "longest") {
+                return false;
+            }
+            options.simultaneous = (mode == "priority") ? 1 : 2;
+        }
+        else if (arg == "-j" && hasValue) {
+            options.jobs = std::max(1, std::atoi(argv[++i]));
+        }
+        else if (!arg.empty() && arg[0] == '-') {
+            return false;
+        }
+        else {
+            options.files.push_back(arg);
+        }
+    }
+
+    int modes = !options.outputDir.empty() + options.inPlace + options.countOnly;
+    return !options.listPath.empty() && modes == 1 && !options.files.empty();
+}
+
+static std::string outputPath(const Options& options, const std::string& path) {
+    return options.inPlace ? path : options.outputDir + "/" + baseNameOf(path);
+}
+
+static void processFile(const Options& options, const ListMatcher& matcher, const std::vector<std::string>& replacements,
+    size_t scanThreads, FileResult& result) {
+
+    MappedFile input;
+    if (!input.open(result.path)) {
+        result.error = std::strerror(errno);
+        return;
+    }
+    const char* text = input.data();
+    size_t textLength = input.size();
+    result.bytes = textLength;
+    result.entryHits.assign(matcher.patternCount(), 0);
+    result.entrySeconds.assign(matcher.patternCount(), 0.0);
+
+    // Same decision as Replace All in the panel: one pass unless an entry acts on the result of another
+    auto start = std::chrono::steady_clock::now();
+    std::vector<ListMatch> candidates;
+    matcher.findAllParallel(text, textLength, 0, textLength, scanThreads, SCAN_CHUNK_LENGTH, candidates);
+    std::vector<ListMatch> selected = (options.simultaneous == 2) ? ListMatcher::selectLeftmostLongestMatches(std::move(candidates))
+        : matcher.selectSequentialMatches(std::move(candidates));
+
+    std::string sequentialText;
+    result.sequential = !options.simultaneous && matcher.hasCascadingMatches(text, textLength, selected, replacements);
+    if (result.sequential && textLength > SEQUENTIAL_MAX_LENGTH) {
+        result.error = "entries act on each other's results; running them entry by entry holds the file in memory, up to "
+            + std::to_string(SEQUENTIAL_MAX_LENGTH >> 20) + " MB. Use -s to match all entries against the original text";
+        return;
+    }
+    if (result.sequential) {
+        sequentialText.assign(text, textLength);
+        for (size_t entry = 0; entry < matcher.patternCount(); ++entry) {
+            auto entryStart = std::chrono::steady_clock::now();
+            ListMatcher single;
+            single.build({ matcher.pattern(entry) });
+            result.entryHits[entry] = single.replaceSequentially(sequentialText, replacements[entry], false);
+            result.entrySeconds[entry] = secondsSince(entryStart);
+        }
+    }
+    else {
+        for (const ListMatch& match : selected) {
+            ++result.entryHits[match.pattern];
+        }
+    }
+    result.scanSeconds = secondsSince(start);
+
+    if (options.countOnly) {
+        result.ok = true;
+        return;
+    }
+
+    start = std::chrono::steady_clock::now();
+    std::string target = outputPath(options, result.path);
+    if (!options.inPlace && input.isSameFile(target)) {
+        result.error = "the output '" + target + "' is the input file; use -i to replace in place";
+        return;
+    }
+    BufferedWriter writer;
+    bool ok = writer.open(target, input.mode());
+    if (ok && result.sequential) {
+        ok = writer.write(sequentialText.data(), sequentialText.size());
+    }
+    else if (ok) {
+        // Unchanged text is written straight from the mapping, no copy of the file is built
+        size_t copied = 0;
+        for (const ListMatch& match : selected) {
+            const std::string& replacement = replacements[match.pattern];
+            ok = ok && writer.write(text + copied, match.pos - copied) && writer.write(replacement.data(), replacement.size());
+            copied = match.pos + match.length;
+        }
+        ok = ok && writer.write(text + copied, textLength - copied);
+    }
+    ok = ok && writer.finish();
+    if (!ok) {
+        result.error = std::string("cannot write '") + target + "': " + std::strerror(errno);
+        return;
+    }
+    result.writeSeconds = secondsSince(start);
+    result.ok = true;
+}
+
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage();
+        return 2;
+    }
+
+    // Files of the same name would be written to the same output file
+    if (!options.outputDir.empty()) {
+        std::map<std::string, std::string> pathOfName;
+        for (const std::string& path : options.files) {
+            auto [it, added] = pathOfName.emplace(baseNameOf(path), path);
+            if (!added) {
+                std::fprintf(stderr, "'%s' and '%s' would both be written to '%s'.\n", it->second.c_str(), path.c_str(),
+                    outputPath(options, path).c_str());
+                return 2;
+            }
+        }
+    }
+
+    std::vector<ReplaceListEntry> list;
+    try {
+        loadReplaceListCsv(options.listPath, list);
+    }
+    catch (const CsvLoadException& ex) {
+        std::fprintf(stderr, "%s\n", ex.what());
+        return 1;
+    }
+
+    // Build the entries the way the panel prepares them for its matcher
+    std::vector<ListPattern> patterns;
+    std::vector<std::string> replacements;
+    std::vector<size_t> entryRows;
+    for (size_t row = 0; row < list.size(); ++row) {
+        const ReplaceListEntry& item = list[row];
+        if (!item.isSelected || item.findText.empty()) {
+            continue;
+        }
+
+        ListPattern pattern;
+        std::string replaceText = item.replaceText;
+        pattern.findText = item.findText;
+        if (item.extended) {
+            convertExtendedToString(item.findText, pattern.findText);
+            convertExtendedToString(item.replaceText, replaceText);
+        }
+        pattern.wholeWord = item.wholeWord;
+        pattern.matchCase = item.matchCase;
+
+        if (item.regex || item.useVariables || item.fuzzy > 0) {
+            std::fprintf(stderr, "Skipping entry %zu '%s': Regex, Fuzzy and Use Variables are not supported.\n",
+                row + 1, item.findText.c_str());
+            continue;
+        }
+        patterns.push_back(pattern);
+        replacements.push_back(replaceText);
+        entryRows.push_back(row);
+    }
+    if (patterns.empty()) {
+        std::fprintf(stderr, "No usable entries in '%s'.\n", options.listPath.c_str());
+        return 1;
+    }
+
+    ListMatcher matcher;
+    matcher.build(patterns);
+
+    // Files share the cores; a single file is scanned by all of them
+    size_t jobs = std::min(options.jobs, options.files.size());
+    size_t cores = std::max<size_t>(1, std::thread::hardware_concurrency());
+    size_t scanThreads = std::max<size_t>(1, cores / jobs);
+
+    std::vector<FileResult> results(options.files.size());
+    std::atomic<size_t> nextFile(0);
+    std::mutex outputMutex;
+    auto start = std::chrono::steady_clock::now();
+
+    auto worker = [&]() {
+        for (size_t index = nextFile++; index < results.size(); index = nextFile++) {
+            FileResult& result = results[index];
+            result.path = options.files[index];
+            processFile(options, matcher, replacements, scanThreads, result);
+
+            size_t total = 0;
+            for (size_t hits : result.entryHits) {
+                total += hits;
+            }
+            std::lock_guard<std::mutex> lock(outputMutex);
+            if (result.ok) {
+                std::printf("%s: %zu replacements, %.1f MB, scan %.3f s, write %.3f s%s\n", result.path.c_str(), total,
+                    result.bytes / (1024.0 * 1024.0), result.scanSeconds, result.writeSeconds, result.sequential ? " (entry by entry)" : "");
+            }
+            else {
+                std::fprintf(stderr, "%s: %s\n", result.path.c_str(), result.error.c_str());
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < jobs; ++i) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    double seconds = secondsSince(start);
+
+    // Per entry totals over all files
+    std::vector<size_t> entryHits(patterns.size(), 0);
+    std::vector<double> entrySeconds(patterns.size(), 0.0);
+    size_t totalBytes = 0;
+    size_t failed = 0;
+    for (const FileResult& result : results) {
+        if (!result.ok) {
+            ++failed;
+            continue;
+        }
+        totalBytes += result.bytes;
+        for (size_t entry = 0; entry < patterns.size(); ++entry) {
+            entryHits[entry] += result.entryHits[entry];
+            entrySeconds[entry] += result.entrySeconds[entry];
+        }
+    }
+
+    std::printf("\n%8s  %10s  %9s  %s\n", "Entry", "Hits", "Seconds", "Find");
+    size_t totalHits = 0;
+    for (size_t entry = 0; entry < patterns.size(); ++entry) {
+        totalHits += entryHits[entry];
+        std::printf("%8zu  %10zu  %9.3f  %s\n", entryRows[entry] + 1, entryHits[entry], entrySeconds[entry], list[entryRows[entry]].findText.c_str());
+    }
+    std::printf("\n%zu replacements in %zu files, %.1f MB in %.3f s (%.1f MB/s)\n", totalHits, results.size() - failed,
+        totalBytes / (1024.0 * 1024.0), seconds, (seconds > 0) ? totalBytes / (1024.0 * 1024.0) / seconds : 0.0);
+    std::printf("Entry seconds are measured for files run entry by entry; other files are matched by all entries in one scan.\n");
+
+    return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,574 @@
+// This file is part of Notepad++ project
+// Copyright (C)2023 Thomas Knoefel
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "CaseFolding.h"
+
+#include <algorithm>
+#include <cstring>
+
+struct FoldEntry {
+    unsigned int codePoint;
+    const char* folded;     // UTF-8
+};
+
+// Non-ASCII characters whose full case folding (Unicode 14.0 CaseFolding.txt, status C and F) differs from
+// the character, sorted by code point. Scintilla's CaseConvert table is generated from the same data.
+static const FoldEntry foldTable[] = {
+    { 0x00B5, "\xCE\xBC" }, { 0x00C0, "\xC3\xA0" }, { 0x00C1, "\xC3\xA1" }, { 0x00C2, "\xC3\xA2" },
+    { 0x00C3, "\xC3\xA3" }, { 0x00C4, "\xC3\xA4" }, { 0x00C5, "\xC3\xA5" }, { 0x00C6, "\xC3\xA6" },
+    { 0x00C7, "\xC3\xA7" }, { 0x00C8, "\xC3\xA8" }, { 0x00C9, "\xC3\xA9" }, { 0x00CA, "\xC3\xAA" },
+    { 0x00CB, "\xC3\xAB" }, { 0x00CC, "\xC3\xAC" }, { 0x00CD, "\xC3\xAD" }, { 0x00CE, "\xC3\xAE" },
+    { 0x00CF, "\xC3\xAF" }, { 0x00D0, "\xC3\xB0" }, { 0x00D1, "\xC3\xB1" }, { 0x00D2, "\xC3\xB2" },
+    { 0x00D3, "\xC3\xB3" }, { 0x00D4, "\xC3\xB4" }, { 0x00D5, "\xC3\xB5" }, { 0x00D6, "\xC3\xB6" },
+    { 0x00D8, "\xC3\xB8" }, { 0x00D9, "\xC3\xB9" }, { 0x00DA, "\xC3\xBA" }, { 0x00DB, "\xC3\xBB" },
+    { 0x00DC, "\xC3\xBC" }, { 0x00DD, "\xC3\xBD" }, { 0x00DE, "\xC3\xBE" }, { 0x00DF, "\x73\x73" },
+    { 0x0100, "\xC4\x81" }, { 0x0102, "\xC4\x83" }, { 0x0104, "\xC4\x85" }, { 0x0106, "\xC4\x87" },
+    { 0x0108, "\xC4\x89" }, { 0x010A, "\xC4\x8B" }, { 0x010C, "\xC4\x8D" }, { 0x010E, "\xC4\x8F" },
+    { 0x0110, "\xC4\x91" }, { 0x0112, "\xC4\x93" }, { 0x0114, "\xC4\x95" }, { 0x0116, "\xC4\x97" },
+    { 0x0118, "\xC4\x99" }, { 0x011A, "\xC4\x9B" }, { 0x011C, "\xC4\x9D" }, { 0x011E, "\xC4\x9F" },
+    { 0x0120, "\xC4\xA1" }, { 0x0122, "\xC4\xA3" }, { 0x0124, "\xC4\xA5" }, { 0x0126, "\xC4\xA7" },
+    { 0x0128, "\xC4\xA9" }, { 0x012A, "\xC4\xAB" }, { 0x012C, "\xC4\xAD" }, { 0x012E, "\xC4\xAF" },
+    { 0x0130, "\x69\xCC\x87" }, { 0x0132, "\xC4\xB3" }, { 0x0134, "\xC4\xB5" }, { 0x0136, "\xC4\xB7" },
+    { 0x0139, "\xC4\xBA" }, { 0x013B, "\xC4\xBC" }, { 0x013D, "\xC4\xBE" }, { 0x013F, "\xC5\x80" },
+    { 0x0141, "\xC5\x82" }, { 0x0143, "\xC5\x84" }, { 0x0145, "\xC5\x86" }, { 0x0147, "\xC5\x88" },
+    { 0x0149, "\xCA\xBC\x6E" }, { 0x014A, "\xC5\x8B" }, { 0x014C, "\xC5\x8D" }, { 0x014E, "\xC5\x8F" },
+    { 0x0150, "\xC5\x91" }, { 0x0152, "\xC5\x93" }, { 0x0154, "\xC5\x95" }, { 0x0156, "\xC5\x97" },
+    { 0x0158, "\xC5\x99" }, { 0x015A, "\xC5\x9B" }, { 0x015C, "\xC5\x9D" }, { 0x015E, "\xC5\x9F" },
+    { 0x0160, "\xC5\xA1" }, { 0x0162, "\xC5\xA3" }, { 0x0164, "\xC5\xA5" }, { 0x0166, "\xC5\xA7" },
+    { 0x0168, "\xC5\xA9" }, { 0x016A, "\xC5\xAB" }, { 0x016C, "\xC5\xAD" }, { 0x016E, "\xC5\xAF" },
+    { 0x0170, "\xC5\xB1" }, { 0x0172, "\xC5\xB3" }, { 0x0174, "\xC5\xB5" }, { 0x0176, "\xC5\xB7" },
+    { 0x0178, "\xC3\xBF" }, { 0x0179, "\xC5\xBA" }, { 0x017B, "\xC5\xBC" }, { 0x017D, "\xC5\xBE" },
+    { 0x017F, "\x73" }, { 0x0181, "\xC9\x93" }, { 0x0182, "\xC6\x83" }, { 0x0184, "\xC6\x85" },
+    { 0x0186, "\xC9\x94" }, { 0x0187, "\xC6\x88" }, { 0x0189, "\xC9\x96" }, { 0x018A, "\xC9\x97" },
+    { 0x018B, "\xC6\x8C" }, { 0x018E, "\xC7\x9D" }, { 0x018F, "\xC9\x99" }, { 0x0190, "\xC9\x9B" },
+    { 0x0191, "\xC6\x92" }, { 0x0193, "\xC9\xA0" }, { 0x0194, "\xC9\xA3" }, { 0x0196, "\xC9\xA9" },
+    { 0x0197, "\xC9\xA8" }, { 0x0198, "\xC6\x99" }, { 0x019C, "\xC9\xAF" }, { 0x019D, "\xC9\xB2" },
+    { 0x019F, "\xC9\xB5" }, { 0x01A0, "\xC6\xA1" }, { 0x01A2, "\xC6\xA3" }, { 0x01A4, "\xC6\xA5" },
+    { 0x01A6, "\xCA\x80" }, { 0x01A7, "\xC6\xA8" }, { 0x01A9, "\xCA\x83" }, { 0x01AC, "\xC6\xAD" },
+    { 0x01AE, "\xCA\x88" }, { 0x01AF, "\xC6\xB0" }, { 0x01B1, "\xCA\x8A" }, { 0x01B2, "\xCA\x8B" },
+    { 0x01B3, "\xC6\xB4" }, { 0x01B5, "\xC6\xB6" }, { 0x01B7, "\xCA\x92" }, { 0x01B8, "\xC6\xB9" },
+    { 0x01BC, "\xC6\xBD" }, { 0x01C4, "\xC7\x86" }, { 0x01C5, "\xC7\x86" }, { 0x01C7, "\xC7\x89" },
+    { 0x01C8, "\xC7\x89" }, { 0x01CA, "\xC7\x8C" }, { 0x01CB, "\xC7\x8C" }, { 0x01CD, "\xC7\x8E" },
+    { 0x01CF, "\xC7\x90" }, { 0x01D1, "\xC7\x92" }, { 0x01D3, "\xC7\x94" }, { 0x01D5, "\xC7\x96" },
+    { 0x01D7, "\xC7\x98" }, { 0x01D9, "\xC7\x9A" }, { 0x01DB, "\xC7\x9C" }, { 0x01DE, "\xC7\x9F" },
+    { 0x01E0, "\xC7\xA1" }, { 0x01E2, "\xC7\xA3" }, { 0x01E4, "\xC7\xA5" }, { 0x01E6, "\xC7\xA7" },
+    { 0x01E8, "\xC7\xA9" }, { 0x01EA, "\xC7\xAB" }, { 0x01EC, "\xC7\xAD" }, { 0x01EE, "\xC7\xAF" },
+    { 0x01F0, "\x6A\xCC\x8C" }, { 0x01F1, "\xC7\xB3" }, { 0x01F2, "\xC7\xB3" }, { 0x01F4, "\xC7\xB5" },
+    { 0x01F6, "\xC6\x95" }, { 0x01F7, "\xC6\xBF" }, { 0x01F8, "\xC7\xB9" }, { 0x01FA, "\xC7\xBB" },
+    { 0x01FC, "\xC7\xBD" }, { 0x01FE, "\xC7\xBF" }, { 0x0200, "\xC8\x81" }, { 0x0202, "\xC8\x83" },
+    { 0x0204, "\xC8\x85" }, { 0x0206, "\xC8\x87" }, { 0x0208, "\xC8\x89" }, { 0x020A, "\xC8\x8B" },
+    { 0x020C, "\xC8\x8D" }, { 0x020E, "\xC8\x8F" }, { 0x0210, "\xC8\x91" }, { 0x0212, "\xC8\x93" },
+    { 0x0214, "\xC8\x95" }, { 0x0216, "\xC8\x97" }, { 0x0218, "\xC8\x99" }, { 0x021A, "\xC8\x9B" },
+    { 0x021C, "\xC8\x9D" }, { 0x021E, "\xC8\x9F" }, { 0x0220, "\xC6\x9E" }, { 0x0222, "\xC8\xA3" },
+    { 0x0224, "\xC8\xA5" }, { 0x0226, "\xC8\xA7" }, { 0x0228, "\xC8\xA9" }, { 0x022A, "\xC8\xAB" },
+    { 0x022C, "\xC8\xAD" }, { 0x022E, "\xC8\xAF" }, { 0x0230, "\xC8\xB1" }, { 0x0232, "\xC8\xB3" },
+    { 0x023A, "\xE2\xB1\xA5" }, { 0x023B, "\xC8\xBC" }, { 0x023D, "\xC6\x9A" }, { 0x023E, "\xE2\xB1\xA6" },
+    { 0x0241, "\xC9\x82" }, { 0x0243, "\xC6\x80" }, { 0x0244, "\xCA\x89" }, { 0x0245, "\xCA\x8C" },
+    { 0x0246, "\xC9\x87" }, { 0x0248, "\xC9\x89" }, { 0x024A, "\xC9\x8B" }, { 0x024C, "\xC9\x8D" },
+    { 0x024E, "\xC9\x8F" }, { 0x0345, "\xCE\xB9" }, { 0x0370, "\xCD\xB1" }, { 0x0372, "\xCD\xB3" },
+    { 0x0376, "\xCD\xB7" }, { 0x037F, "\xCF\xB3" }, { 0x0386, "\xCE\xAC" }, { 0x0388, "\xCE\xAD" },
+    { 0x0389, "\xCE\xAE" }, { 0x038A, "\xCE\xAF" }, { 0x038C, "\xCF\x8C" }, { 0x038E, "\xCF\x8D" },
+    { 0x038F, "\xCF\x8E" }, { 0x0390, "\xCE\xB9\xCC\x88\xCC\x81" }, { 0x0391, "\xCE\xB1" }, { 0x0392, "\xCE\xB2" },
+    { 0x0393, "\xCE\xB3" }, { 0x0394, "\xCE\xB4" }, { 0x0395, "\xCE\xB5" }, { 0x0396, "\xCE\xB6" },
+    { 0x0397, "\xCE\xB7" }, { 0x0398, "\xCE\xB8" }, { 0x0399, "\xCE\xB9" }, { 0x039A, "\xCE\xBA" },
+    { 0x039B, "\xCE\xBB" }, { 0x039C, "\xCE\xBC" }, { 0x039D, "\xCE\xBD" }, { 0x039E, "\xCE\xBE" },
+    { 0x039F, "\xCE\xBF" }, { 0x03A0, "\xCF\x80" }, { 0x03A1, "\xCF\x81" }, { 0x03A3, "\xCF\x83" },
+    { 0x03A4, "\xCF\x84" }, { 0x03A5, "\xCF\x85" }, { 0x03A6, "\xCF\x86" }, { 0x03A7, "\xCF\x87" },
+    { 0x03A8, "\xCF\x88" }, { 0x03A9, "\xCF\x89" }, { 0x03AA, "\xCF\x8A" }, { 0x03AB, "\xCF\x8B" },
+    { 0x03B0, "\xCF\x85\xCC\x88\xCC\x81" }, { 0x03C2, "\xCF\x83" }, { 0x03CF, "\xCF\x97" }, { 0x03D0, "\xCE\xB2" },
+    { 0x03D1, "\xCE\xB8" }, { 0x03D5, "\xCF\x86" }, { 0x03D6, "\xCF\x80" }, { 0x03D8, "\xCF\x99" },
+    { 0x03DA, "\xCF\x9B" }, { 0x03DC, "\xCF\x9D" }, { 0x03DE, "\xCF\x9F" }, { 0x03E0, "\xCF\xA1" },
+    { 0x03E2, "\xCF\xA3" }, { 0x03E4, "\xCF\xA5" }, { 0x03E6, "\xCF\xA7" }, { 0x03E8, "\xCF\xA9" },
+    { 0x03EA, "\xCF\xAB" }, { 0x03EC, "\xCF\xAD" }, { 0x03EE, "\xCF\xAF" }, { 0x03F0, "\xCE\xBA" },
+    { 0x03F1, "\xCF\x81" }, { 0x03F4, "\xCE\xB8" }, { 0x03F5, "\xCE\xB5" }, { 0x03F7, "\xCF\xB8" },
+    { 0x03F9, "\xCF\xB2" }, { 0x03FA, "\xCF\xBB" }, { 0x03FD, "\xCD\xBB" }, { 0x03FE, "\xCD\xBC" },
+    { 0x03FF, "\xCD\xBD" }, { 0x0400, "\xD1\x90" }, { 0x0401, "\xD1\x91" }, { 0x0402, "\xD1\x92" },
+    { 0x0403, "\xD1\x93" }, { 0x0404, "\xD1\x94" }, { 0x0405, "\xD1\x95" }, { 0x0406, "\xD1\x96" },
+    { 0x0407, "\xD1\x97" }, { 0x0408, "\xD1\x98" }, { 0x0409, "\xD1\x99" }, { 0x040A, "\xD1\x9A" },
+    { 0x040B, "\xD1\x9B" }, { 0x040C, "\xD1\x9C" }, { 0x040D, "\xD1\x9D" }, { 0x040E, "\xD1\x9E" },
+    { 0x040F, "\xD1\x9F" }, { 0x0410, "\xD0\xB0" }, { 0x0411, "\xD0\xB1" }, { 0x0412, "\xD0\xB2" },
+    { 0x0413, "\xD0\xB3" }, { 0x0414, "\xD0\xB4" }, { 0x0415, "\xD0\xB5" }, { 0x0416, "\xD0\xB6" },
+    { 0x0417, "\xD0\xB7" }, { 0x0418, "\xD0\xB8" }, { 0x0419, "\xD0\xB9" }, { 0x041A, "\xD0\xBA" },
+    { 0x041B, "\xD0\xBB" }, { 0x041C, "\xD0\xBC" }, { 0x041D, "\xD0\xBD" }, { 0x041E, "\xD0\xBE" },
+    { 0x041F, "\xD0\xBF" }, { 0x0420, "\xD1\x80" }, { 0x0421, "\xD1\x81" }, { 0x0422, "\xD1\x82" },
+    { 0x0423, "\xD1\x83" }, { 0x0424, "\xD1\x84" }, { 0x0425, "\xD1\x85" }, { 0x0426, "\xD1\x86" },
+    { 0x0427, "\xD1\x87" }, { 0x0428, "\xD1\x88" }, { 0x0429, "\xD1\x89" }, { 0x042A, "\xD1\x8A" },
+    { 0x042B, "\xD1\x8B" }, { 0x042C, "\xD1\x8C" }, { 0x042D, "\xD1\x8D" }, { 0x042E, "\xD1\x8E" },
+    { 0x042F, "\xD1\x8F" }, { 0x0460, "\xD1\xA1" }, { 0x0462, "\xD1\xA3" }, { 0x0464, "\xD1\xA5" },
+    { 0x0466, "\xD1\xA7" }, { 0x0468, "\xD1\xA9" }, { 0x046A, "\xD1\xAB" }, { 0x046C, "\xD1\xAD" },
+    { 0x046E, "\xD1\xAF" }, { 0x0470, "\xD1\xB1" }, { 0x0472, "\xD1\xB3" }, { 0x0474, "\xD1\xB5" },
+    { 0x0476, "\xD1\xB7" }, { 0x0478, "\xD1\xB9" }, { 0x047A, "\xD1\xBB" }, { 0x047C, "\xD1\xBD" },
+    { 0x047E, "\xD1\xBF" }, { 0x0480, "\xD2\x81" }, { 0x048A, "\xD2\x8B" }, { 0x048C, "\xD2\x8D" },
+    { 0x048E, "\xD2\x8F" }, { 0x0490, "\xD2\x91" }, { 0x0492, "\xD2\x93" }, { 0x0494, "\xD2\x95" },
+    { 0x0496, "\xD2\x97" }, { 0x0498, "\xD2\x99" }, { 0x049A, "\xD2\x9B" }, { 0x049C, "\xD2\x9D" },
+    { 0x049E, "\xD2\x9F" }, { 0x04A0, "\xD2\xA1" }, { 0x04A2, "\xD2\xA3" }, { 0x04A4, "\xD2\xA5" },
+    { 0x04A6, "\xD2\xA7" }, { 0x04A8, "\xD2\xA9" }, { 0x04AA, "\xD2\xAB" }, { 0x04AC, "\xD2\xAD" },
+    { 0x04AE, "\xD2\xAF" }, { 0x04B0, "\xD2\xB1" }, { 0x04B2, "\xD2\xB3" }, { 0x04B4, "\xD2\xB5" },
+    { 0x04B6, "\xD2\xB7" }, { 0x04B8, "\xD2\xB9" }, { 0x04BA, "\xD2\xBB" }, { 0x04BC, "\xD2\xBD" },
+    { 0x04BE, "\xD2\xBF" }, { 0x04C0, "\xD3\x8F" }, { 0x04C1, "\xD3\x82" }, { 0x04C3, "\xD3\x84" },
+    { 0x04C5, "\xD3\x86" }, { 0x04C7, "\xD3\x88" }, { 0x04C9, "\xD3\x8A" }, { 0x04CB, "\xD3\x8C" },
+    { 0x04CD, "\xD3\x8E" }, { 0x04D0, "\xD3\x91" }, { 0x04D2, "\xD3\x93" }, { 0x04D4, "\xD3\x95" },
+    { 0x04D6, "\xD3\x97" }, { 0x04D8, "\xD3\x99" }, { 0x04DA, "\xD3\x9B" }, { 0x04DC, "\xD3\x9D" },
+    { 0x04DE, "\xD3\x9F" }, { 0x04E0, "\xD3\xA1" }, { 0x04E2, "\xD3\xA3" }, { 0x04E4, "\xD3\xA5" },
+    { 0x04E6, "\xD3\xA7" }, { 0x04E8, "\xD3\xA9" }, { 0x04EA, "\xD3\xAB" }, { 0x04EC, "\xD3\xAD" },
+    { 0x04EE, "\xD3\xAF" }, { 0x04F0, "\xD3\xB1" }, { 0x04F2, "\xD3\xB3" }, { 0x04F4, "\xD3\xB5" },
+    { 0x04F6, "\xD3\xB7" }, { 0x04F8, "\xD3\xB9" }, { 0x04FA, "\xD3\xBB" }, { 0x04FC, "\xD3\xBD" },
+    { 0x04FE, "\xD3\xBF" }, { 0x0500, "\xD4\x81" }, { 0x0502, "\xD4\x83" }, { 0x0504, "\xD4\x85" },
+    { 0x0506, "\xD4\x87" }, { 0x0508, "\xD4\x89" }, { 0x050A, "\xD4\x8B" }, { 0x050C, "\xD4\x8D" },
+    { 0x050E, "\xD4\x8F" }, { 0x0510, "\xD4\x91" }, { 0x0512, "\xD4\x93" }, { 0x0514, "\xD4\x95" },
+    { 0x0516, "\xD4\x97" }, { 0x0518, "\xD4\x99" }, { 0x051A, "\xD4\x9B" }, { 0x051C, "\xD4\x9D" },
+    { 0x051E, "\xD4\x9F" }, { 0x0520, "\xD4\xA1" }, { 0x0522, "\xD4\xA3" }, { 0x0524, "\xD4\xA5" },
+    { 0x0526, "\xD4\xA7" }, { 0x0528, "\xD4\xA9" }, { 0x052A, "\xD4\xAB" }, { 0x052C, "\xD4\xAD" },
+    { 0x052E, "\xD4\xAF" }, { 0x0531, "\xD5\xA1" }, { 0x0532, "\xD5\xA2" }, { 0x0533, "\xD5\xA3" },
+    { 0x0534, "\xD5\xA4" }, { 0x0535, "\xD5\xA5" }, { 0x0536, "\xD5\xA6" }, { 0x0537, "\xD5\xA7" },
+    { 0x0538, "\xD5\xA8" }, { 0x0539, "\xD5\xA9" }, { 0x053A, "\xD5\xAA" }, { 0x053B, "\xD5\xAB" },
+    { 0x053C, "\xD5\xAC" }, { 0x053D, "\xD5\xAD" }, { 0x053E, "\xD5\xAE" }, { 0x053F, "\xD5\xAF" },
+    { 0x0540, "\xD5\xB0" }, { 0x0541, "\xD5\xB1" }, { 0x0542, "\xD5\xB2" }, { 0x0543, "\xD5\xB3" },
+    { 0x0544, "\xD5\xB4" }, { 0x0545, "\xD5\xB5" }, { 0x0546, "\xD5\xB6" }, { 0x0547, "\xD5\xB7" },
+    { 0x0548, "\xD5\xB8" }, { 0x0549, "\xD5\xB9" }, { 0x054A, "\xD5\xBA" }, { 0x054B, "\xD5\xBB" },
+    { 0x054C, "\xD5\xBC" }, { 0x054D, "\xD5\xBD" }, { 0x054E, "\xD5\xBE" }, { 0x054F, "\xD5\xBF" },
+    { 0x0550, "\xD6\x80" }, { 0x0551, "\xD6\x81" }, { 0x0552, "\xD6\x82" }, { 0x0553, "\xD6\x83" },
+    { 0x0554, "\xD6\x84" }, { 0x0555, "\xD6\x85" }, { 0x0556, "\xD6\x86" }, { 0x0587, "\xD5\xA5\xD6\x82" },
+    { 0x10A0, "\xE2\xB4\x80" }, { 0x10A1, "\xE2\xB4\x81" }, { 0x10A2, "\xE2\xB4\x82" }, { 0x10A3, "\xE2\xB4\x83" },
+    { 0x10A4, "\xE2\xB4\x84" }, { 0x10A5, "\xE2\xB4\x85" }, { 0x10A6, "\xE2\xB4\x86" }, { 0x10A7, "\xE2\xB4\x87" },
+    { 0x10A8, "\xE2\xB4\x88" }, { 0x10A9, "\xE2\xB4\x89" }, { 0x10AA, "\xE2\xB4\x8A" }, { 0x10AB, "\xE2\xB4\x8B" },
+    { 0x10AC, "\xE2\xB4\x8C" }, { 0x10AD, "\xE2\xB4\x8D" }, { 0x10AE, "\xE2\xB4\x8E" }, { 0x10AF, "\xE2\xB4\x8F" },
+    { 0x10B0, "\xE2\xB4\x90" }, { 0x10B1, "\xE2\xB4\x91" }, { 0x10B2, "\xE2\xB4\x92" }, { 0x10B3, "\xE2\xB4\x93" },
+    { 0x10B4, "\xE2\xB4\x94" }, { 0x10B5, "\xE2\xB4\x95" }, { 0x10B6, "\xE2\xB4\x96" }, { 0x10B7, "\xE2\xB4\x97" },
+    { 0x10B8, "\xE2\xB4\x98" }, { 0x10B9, "\xE2\xB4\x99" }, { 0x10BA, "\xE2\xB4\x9A" }, { 0x10BB, "\xE2\xB4\x9B" },
+    { 0x10BC, "\xE2\xB4\x9C" }, { 0x10BD, "\xE2\xB4\x9D" }, { 0x10BE, "\xE2\xB4\x9E" }, { 0x10BF, "\xE2\xB4\x9F" },
+    { 0x10C0, "\xE2\xB4\xA0" }, { 0x10C1, "\xE2\xB4\xA1" }, { 0x10C2, "\xE2\xB4\xA2" }, { 0x10C3, "\xE2\xB4\xA3" },
+    { 0x10C4, "\xE2\xB4\xA4" }, { 0x10C5, "\xE2\xB4\xA5" }, { 0x10C7, "\xE2\xB4\xA7" }, { 0x10CD, "\xE2\xB4\xAD" },
+    { 0x13F8, "\xE1\x8F\xB0" }, { 0x13F9, "\xE1\x8F\xB1" }, { 0x13FA, "\xE1\x8F\xB2" }, { 0x13FB, "\xE1\x8F\xB3" },
+    { 0x13FC, "\xE1\x8F\xB4" }, { 0x13FD, "\xE1\x8F\xB5" }, { 0x1C80, "\xD0\xB2" }, { 0x1C81, "\xD0\xB4" },
+    { 0x1C82, "\xD0\xBE" }, { 0x1C83, "\xD1\x81" }, { 0x1C84, "\xD1\x82" }, { 0x1C85, "\xD1\x82" },
+    { 0x1C86, "\xD1\x8A" }, { 0x1C87, "\xD1\xA3" }, { 0x1C88, "\xEA\x99\x8B" }, { 0x1C90, "\xE1\x83\x90" },
+    { 0x1C91, "\xE1\x83\x91" }, { 0x1C92, "\xE1\x83\x92" }, { 0x1C93, "\xE1\x83\x93" }, { 0x1C94, "\xE1\x83\x94" },
+    { 0x1C95, "\xE1\x83\x95" }, { 0x1C96, "\xE1\x83\x96" }, { 0x1C97, "\xE1\x83\x97" }, { 0x1C98, "\xE1\x83\x98" },
+    { 0x1C99, "\xE1\x83\x99" }, { 0x1C9A, "\xE1\x83\x9A" }, { 0x1C9B, "\xE1\x83\x9B" }, { 0x1C9C, "\xE1\x83\x9C" },
+    { 0x1C9D, "\xE1\x83\x9D" }, { 0x1C9E, "\xE1\x83\x9E" }, { 0x1C9F, "\xE1\x83\x9F" }, { 0x1CA0, "\xE1\x83\xA0" },
+    { 0x1CA1, "\xE1\x83\xA1" }, { 0x1CA2, "\xE1\x83\xA2" }, { 0x1CA3, "\xE1\x83\xA3" }, { 0x1CA4, "\xE1\x83\xA4" },
+    { 0x1CA5, "\xE1\x83\xA5" }, { 0x1CA6, "\xE1\x83\xA6" }, { 0x1CA7, "\xE1\x83\xA7" }, { 0x1CA8, "\xE1\x83\xA8" },
+    { 0x1CA9, "\xE1\x83\xA9" }, { 0x1CAA, "\xE1\x83\xAA" }, { 0x1CAB, "\xE1\x83\xAB" }, { 0x1CAC, "\xE1\x83\xAC" },
+    { 0x1CAD, "\xE1\x83\xAD" }, { 0x1CAE, "\xE1\x83\xAE" }, { 0x1CAF, "\xE1\x83\xAF" }, { 0x1CB0, "\xE1\x83\xB0" },
+    { 0x1CB1, "\xE1\x83\xB1" }, { 0x1CB2, "\xE1\x83\xB2" }, { 0x1CB3, "\xE1\x83\xB3" }, { 0x1CB4, "\xE1\x83\xB4" },
+    { 0x1CB5, "\xE1\x83\xB5" }, { 0x1CB6, "\xE1\x83\xB6" }, { 0x1CB7, "\xE1\x83\xB7" }, { 0x1CB8, "\xE1\x83\xB8" },
+    { 0x1CB9, "\xE1\x83\xB9" }, { 0x1CBA, "\xE1\x83\xBA" }, { 0x1CBD, "\xE1\x83\xBD" }, { 0x1CBE, "\xE1\x83\xBE" },
+    { 0x1CBF, "\xE1\x83\xBF" }, { 0x1E00, "\xE1\xB8\x81" }, { 0x1E02, "\xE1\xB8\x83" }, { 0x1E04, "\xE1\xB8\x85" },
+    { 0x1E06, "\xE1\xB8\x87" }, { 0x1E08, "\xE1\xB8\x89" }, { 0x1E0A, "\xE1\xB8\x8B" }, { 0x1E0C, "\xE1\xB8\x8D" },
+    { 0x1E0E, "\xE1\xB8\x8F" }, { 0x1E10, "\xE1\xB8\x91" }, { 0x1E12, "\xE1\xB8\x93" }, { 0x1E14, "\xE1\xB8\x95" },
+    { 0x1E16, "\xE1\xB8\x97" }, { 0x1E18, "\xE1\xB8\x99" }, { 0x1E1A, "\xE1\xB8\x9B" }, { 0x1E1C, "\xE1\xB8\x9D" },
+    { 0x1E1E, "\xE1\xB8\x9F" }, { 0x1E20, "\xE1\xB8\xA1" }, { 0x1E22, "\xE1\xB8\xA3" }, { 0x1E24, "\xE1\xB8\xA5" },
+    { 0x1E26, "\xE1\xB8\xA7" }, { 0x1E28, "\xE1\xB8\xA9" }, { 0x1E2A, "\xE1\xB8\xAB" }, { 0x1E2C, "\xE1\xB8\xAD" },
+    { 0x1E2E, "\xE1\xB8\xAF" }, { 0x1E30, "\xE1\xB8\xB1" }, { 0x1E32, "\xE1\xB8\xB3" }, { 0x1E34, "\xE1\xB8\xB5" },
+    { 0x1E36, "\xE1\xB8\xB7" }, { 0x1E38, "\xE1\xB8\xB9" }, { 0x1E3A, "\xE1\xB8\xBB" }, { 0x1E3C, "\xE1\xB8\xBD" },
+    { 0x1E3E, "\xE1\xB8\xBF" }, { 0x1E40, "\xE1\xB9\x81" }, { 0x1E42, "\xE1\xB9\x83" }, { 0x1E44, "\xE1\xB9\x85" },
+    { 0x1E46, "\xE1\xB9\x87" }, { 0x1E48, "\xE1\xB9\x89" }, { 0x1E4A, "\xE1\xB9\x8B" }, { 0x1E4C, "\xE1\xB9\x8D" },
+    { 0x1E4E, "\xE1\xB9\x8F" }, { 0x1E50, "\xE1\xB9\x91" }, { 0x1E52, "\xE1\xB9\x93" }, { 0x1E54, "\xE1\xB9\x95" },
+    { 0x1E56, "\xE1\xB9\x97" }, { 0x1E58, "\xE1\xB9\x99" }, { 0x1E5A, "\xE1\xB9\x9B" }, { 0x1E5C, "\xE1\xB9\x9D" },
+    { 0x1E5E, "\xE1\xB9\x9F" }, { 0x1E60, "\xE1\xB9\xA1" }, { 0x1E62, "\xE1\xB9\xA3" }, { 0x1E64, "\xE1\xB9\xA5" },
+    { 0x1E66, "\xE1\xB9\xA7" }, { 0x1E68, "\xE1\xB9\xA9" }, { 0x1E6A, "\xE1\xB9\xAB" }, { 0x1E6C, "\xE1\xB9\xAD" },
+    { 0x1E6E, "\xE1\xB9\xAF" }, { 0x1E70, "\xE1\xB9\xB1" }, { 0x1E72, "\xE1\xB9\xB3" }, { 0x1E74, "\xE1\xB9\xB5" },
+    { 0x1E76, "\xE1\xB9\xB7" }, { 0x1E78, "\xE1\xB9\xB9" }, { 0x1E7A, "\xE1\xB9\xBB" }, { 0x1E7C, "\xE1\xB9\xBD" },
+    { 0x1E7E, "\xE1\xB9\xBF" }, { 0x1E80, "\xE1\xBA\x81" }, { 0x1E82, "\xE1\xBA\x83" }, { 0x1E84, "\xE1\xBA\x85" },
+    { 0x1E86, "\xE1\xBA\x87" }, { 0x1E88, "\xE1\xBA\x89" }, { 0x1E8A, "\xE1\xBA\x8B" }, { 0x1E8C, "\xE1\xBA\x8D" },
+    { 0x1E8E, "\xE1\xBA\x8F" }, { 0x1E90, "\xE1\xBA\x91" }, { 0x1E92, "\xE1\xBA\x93" }, { 0x1E94, "\xE1\xBA\x95" },
+    { 0x1E96, "\x68\xCC\xB1" }, { 0x1E97, "\x74\xCC\x88" }, { 0x1E98, "\x77\xCC\x8A" }, { 0x1E99, "\x79\xCC\x8A" },
+    { 0x1E9A, "\x61\xCA\xBE" }, { 0x1E9B, "\xE1\xB9\xA1" }, { 0x1E9E, "\x73\x73" }, { 0x1EA0, "\xE1\xBA\xA1" },
+    { 0x1EA2, "\xE1\xBA\xA3" }, { 0x1EA4, "\xE1\xBA\xA5" }, { 0x1EA6, "\xE1\xBA\xA7" }, { 0x1EA8, "\xE1\xBA\xA9" },
+    { 0x1EAA, "\xE1\xBA\xAB" }, { 0x1EAC, "\xE1\xBA\xAD" }, { 0x1EAE, "\xE1\xBA\xAF" }, { 0x1EB0, "\xE1\xBA\xB1" },
+    { 0x1EB2, "\xE1\xBA\xB3" }, { 0x1EB4, "\xE1\xBA\xB5" }, { 0x1EB6, "\xE1\xBA\xB7" }, { 0x1EB8, "\xE1\xBA\xB9" },
+    { 0x1EBA, "\xE1\xBA\xBB" }, { 0x1EBC, "\xE1\xBA\xBD" }, { 0x1EBE, "\xE1\xBA\xBF" }, { 0x1EC0, "\xE1\xBB\x81" },
+    { 0x1EC2, "\xE1\xBB\x83" }, { 0x1EC4, "\xE1\xBB\x85" }, { 0x1EC6, "\xE1\xBB\x87" }, { 0x1EC8, "\xE1\xBB\x89" },
+    { 0x1ECA, "\xE1\xBB\x8B" }, { 0x1ECC, "\xE1\xBB\x8D" }, { 0x1ECE, "\xE1\xBB\x8F" }, { 0x1ED0, "\xE1\xBB\x91" },
+    { 0x1ED2, "\xE1\xBB\x93" }, { 0x1ED4, "\xE1\xBB\x95" }, { 0x1ED6, "\xE1\xBB\x97" }, { 0x1ED8, "\xE1\xBB\x99" },
+    { 0x1EDA, "\xE1\xBB\x9B" }, { 0x1EDC, "\xE1\xBB\x9D" }, { 0x1EDE, "\xE1\xBB\x9F" }, { 0x1EE0, "\xE1\xBB\xA1" },
+    { 0x1EE2, "\xE1\xBB\xA3" }, { 0x1EE4, "\xE1\xBB\xA5" }, { 0x1EE6, "\xE1\xBB\xA7" }, { 0x1EE8, "\xE1\xBB\xA9" },
+    { 0x1EEA, "\xE1\xBB\xAB" }, { 0x1EEC, "\xE1\xBB\xAD" }, { 0x1EEE, "\xE1\xBB\xAF" }, { 0x1EF0, "\xE1\xBB\xB1" },
+    { 0x1EF2, "\xE1\xBB\xB3" }, { 0x1EF4, "\xE1\xBB\xB5" }, { 0x1EF6, "\xE1\xBB\xB7" }, { 0x1EF8, "\xE1\xBB\xB9" },
+    { 0x1EFA, "\xE1\xBB\xBB" }, { 0x1EFC, "\xE1\xBB\xBD" }, { 0x1EFE, "\xE1\xBB\xBF" }, { 0x1F08, "\xE1\xBC\x80" },
+    { 0x1F09, "\xE1\xBC\x81" }, { 0x1F0A, "\xE1\xBC\x82" }, { 0x1F0B, "\xE1\xBC\x83" }, { 0x1F0C, "\xE1\xBC\x84" },
+    { 0x1F0D, "\xE1\xBC\x85" }, { 0x1F0E, "\xE1\xBC\x86" }, { 0x1F0F, "\xE1\xBC\x87" }, { 0x1F18, "\xE1\xBC\x90" },
+    { 0x1F19, "\xE1\xBC\x91" }, { 0x1F1A, "\xE1\xBC\x92" }, { 0x1F1B, "\xE1\xBC\x93" }, { 0x1F1C, "\xE1\xBC\x94" },
+    { 0x1F1D, "\xE1\xBC\x95" }, { 0x1F28, "\xE1\xBC\xA0" }, { 0x1F29, "\xE1\xBC\xA1" }, { 0x1F2A, "\xE1\xBC\xA2" },
+    { 0x1F2B, "\xE1\xBC\xA3" }, { 0x1F2C, "\xE1\xBC\xA4" }, { 0x1F2D, "\xE1\xBC\xA5" }, { 0x1F2E, "\xE1\xBC\xA6" },
+    { 0x1F2F, "\xE1\xBC\xA7" }, { 0x1F38, "\xE1\xBC\xB0" }, { 0x1F39, "\xE1\xBC\xB1" }, { 0x1F3A, "\xE1\xBC\xB2" },
+    { 0x1F3B, "\xE1\xBC\xB3" }, { 0x1F3C, "\xE1\xBC\xB4" }, { 0x1F3D, "\xE1\xBC\xB5" }, { 0x1F3E, "\xE1\xBC\xB6" },
+    { 0x1F3F, "\xE1\xBC\xB7" }, { 0x1F48, "\xE1\xBD\x80" }, { 0x1F49, "\xE1\xBD\x81" }, { 0x1F4A, "\xE1\xBD\x82" },
+    { 0x1F4B, "\xE1\xBD\x83" }, { 0x1F4C, "\xE1\xBD\x84" }, { 0x1F4D, "\xE1\xBD\x85" }, { 0x1F50, "\xCF\x85\xCC\x93" },
+    { 0x1F52, "\xCF\x85\xCC\x93\xCC\x80" }, { 0x1F54, "\xCF\x85\xCC\x93\xCC\x81" }, { 0x1F56, "\xCF\x85\xCC\x93\xCD\x82" }, { 0x1F59, "\xE1\xBD\x91" },
+    { 0x1F5B, "\xE1\xBD\x93" }, { 0x1F5D, "\xE1\xBD\x95" }, { 0x1F5F, "\xE1\xBD\x97" }, { 0x1F68, "\xE1\xBD\xA0" },
+    { 0x1F69, "\xE1\xBD\xA1" }, { 0x1F6A, "\xE1\xBD\xA2" }, { 0x1F6B, "\xE1\xBD\xA3" }, { 0x1F6C, "\xE1\xBD\xA4" },
+    { 0x1F6D, "\xE1\xBD\xA5" }, { 0x1F6E, "\xE1\xBD\xA6" }, { 0x1F6F, "\xE1\xBD\xA7" }, { 0x1F80, "\xE1\xBC\x80\xCE\xB9" },
+    { 0x1F81, "\xE1\xBC\x81\xCE\xB9" }, { 0x1F82, "\xE1\xBC\x82\xCE\xB9" }, { 0x1F83, "\xE1\xBC\x83\xCE\xB9" }, { 0x1F84, "\xE1\xBC\x84\xCE\xB9" },
+    { 0x1F85, "\xE1\xBC\x85\xCE\xB9" }, { 0x1F86, "\xE1\xBC\x86\xCE\xB9" }, { 0x1F87, "\xE1\xBC\x87\xCE\xB9" }, { 0x1F88, "\xE1\xBC\x80\xCE\xB9" },
+    { 0x1F89, "\xE1\xBC\x81\xCE\xB9" }, { 0x1F8A, "\xE1\xBC\x82\xCE\xB9" }, { 0x1F8B, "\xE1\xBC\x83\xCE\xB9" }, { 0x1F8C, "\xE1\xBC\x84\xCE\xB9" },
+    { 0x1F8D, "\xE1\xBC\x85\xCE\xB9" }, { 0x1F8E, "\xE1\xBC\x86\xCE\xB9" }, { 0x1F8F, "\xE1\xBC\x87\xCE\xB9" }, { 0x1F90, "\xE1\xBC\xA0\xCE\xB9" },
+    { 0x1F91, "\xE1\xBC\xA1\xCE\xB9" }, { 0x1F92, "\xE1\xBC\xA2\xCE\xB9" }, { 0x1F93, "\xE1\xBC\xA3\xCE\xB9" }, { 0x1F94, "\xE1\xBC\xA4\xCE\xB9" },
+    { 0x1F95, "\xE1\xBC\xA5\xCE\xB9" }, { 0x1F96, "\xE1\xBC\xA6\xCE\xB9" }, { 0x1F97, "\xE1\xBC\xA7\xCE\xB9" }, { 0x1F98, "\xE1\xBC\xA0\xCE\xB9" },
+    { 0x1F99, "\xE1\xBC\xA1\xCE\xB9" }, { 0x1F9A, "\xE1\xBC\xA2\xCE\xB9" }, { 0x1F9B, "\xE1\xBC\xA3\xCE\xB9" }, { 0x1F9C, "\xE1\xBC\xA4\xCE\xB9" },
+    { 0x1F9D, "\xE1\xBC\xA5\xCE\xB9" }, { 0x1F9E, "\xE1\xBC\xA6\xCE\xB9" }, { 0x1F9F, "\xE1\xBC\xA7\xCE\xB9" }, { 0x1FA0, "\xE1\xBD\xA0\xCE\xB9" },
+    { 0x1FA1, "\xE1\xBD\xA1\xCE\xB9" }, { 0x1FA2, "\xE1\xBD\xA2\xCE\xB9" }, { 0x1FA3, "\xE1\xBD\xA3\xCE\xB9" }, { 0x1FA4, "\xE1\xBD\xA4\xCE\xB9" },
+    { 0x1FA5, "\xE1\xBD\xA5\xCE\xB9" }, { 0x1FA6, "\xE1\xBD\xA6\xCE\xB9" }, { 0x1FA7, "\xE1\xBD\xA7\xCE\xB9" }, { 0x1FA8, "\xE1\xBD\xA0\xCE\xB9" },
+    { 0x1FA9, "\xE1\xBD\xA1\xCE\xB9" }, { 0x1FAA, "\xE1\xBD\xA2\xCE\xB9" }, { 0x1FAB, "\xE1\xBD\xA3\xCE\xB9" }, { 0x1FAC, "\xE1\xBD\xA4\xCE\xB9" },
+    { 0x1FAD, "\xE1\xBD\xA5\xCE\xB9" }, { 0x1FAE, "\xE1\xBD\xA6\xCE\xB9" }, { 0x1FAF, "\xE1\xBD\xA7\xCE\xB9" }, { 0x1FB2, "\xE1\xBD\xB0\xCE\xB9" },
+    { 0x1FB3, "\xCE\xB1\xCE\xB9" }, { 0x1FB4, "\xCE\xAC\xCE\xB9" }, { 0x1FB6, "\xCE\xB1\xCD\x82" }, { 0x1FB7, "\xCE\xB1\xCD\x82\xCE\xB9" },
+    { 0x1FB8, "\xE1\xBE\xB0" }, { 0x1FB9, "\xE1\xBE\xB1" }, { 0x1FBA, "\xE1\xBD\xB0" }, { 0x1FBB, "\xE1\xBD\xB1" },
+    { 0x1FBC, "\xCE\xB1\xCE\xB9" }, { 0x1FBE, "\xCE\xB9" }, { 0x1FC2, "\xE1\xBD\xB4\xCE\xB9" }, { 0x1FC3, "\xCE\xB7\xCE\xB9" },
+    { 0x1FC4, "\xCE\xAE\xCE\xB9" }, { 0x1FC6, "\xCE\xB7\xCD\x82" }, { 0x1FC7, "\xCE\xB7\xCD\x82\xCE\xB9" }, { 0x1FC8, "\xE1\xBD\xB2" },
+    { 0x1FC9, "\xE1\xBD\xB3" }, { 0x1FCA, "\xE1\xBD\xB4" }, { 0x1FCB, "\xE1\xBD\xB5" }, { 0x1FCC, "\xCE\xB7\xCE\xB9" },
+    { 0x1FD2, "\xCE\xB9\xCC\x88\xCC\x80" }, { 0x1FD3, "\xCE\xB9\xCC\x88\xCC\x81" }, { 0x1FD6, "\xCE\xB9\xCD\x82" }, { 0x1FD7, "\xCE\xB9\xCC\x88\xCD\x82" },
+    { 0x1FD8, "\xE1\xBF\x90" }, { 0x1FD9, "\xE1\xBF\x91" }, { 0x1FDA, "\xE1\xBD\xB6" }, { 0x1FDB, "\xE1\xBD\xB7" },
+    { 0x1FE2, "\xCF\x85\xCC\x88\xCC\x80" }, { 0x1FE3, "\xCF\x85\xCC\x88\xCC\x81" }, { 0x1FE4, "\xCF\x81\xCC\x93" }, { 0x1FE6, "\xCF\x85\xCD\x82" },
+    { 0x1FE7, "\xCF\x85\xCC\x88\xCD\x82" }, { 0x1FE8, "\xE1\xBF\xA0" }, { 0x1FE9, "\xE1\xBF\xA1" }, { 0x1FEA, "\xE1\xBD\xBA" },
+    { 0x1FEB, "\xE1\xBD\xBB" }, { 0x1FEC, "\xE1\xBF\xA5" }, { 0x1FF2, "\xE1\xBD\xBC\xCE\xB9" }, { 0x1FF3, "\xCF\x89\xCE\xB9" },
+    { 0x1FF4, "\xCF\x8E\xCE\xB9" }, { 0x1FF6, "\xCF\x89\xCD\x82" }, { 0x1FF7, "\xCF\x89\xCD\x82\xCE\xB9" }, { 0x1FF8, "\xE1\xBD\xB8" },
+    { 0x1FF9, "\xE1\xBD\xB9" }, { 0x1FFA, "\xE1\xBD\xBC" }, { 0x1FFB, "\xE1\xBD\xBD" }, { 0x1FFC, "\xCF\x89\xCE\xB9" },
+    { 0x2126, "\xCF\x89" }, { 0x212A, "\x6B" }, { 0x212B, "\xC3\xA5" }, { 0x2132, "\xE2\x85\x8E" },
+    { 0x2160, "\xE2\x85\xB0" }, { 0x2161, "\xE2\x85\xB1" }, { 0x2162, "\xE2\x85\xB2" }, { 0x2163, "\xE2\x85\xB3" },
+    { 0x2164, "\xE2\x85\xB4" }, { 0x2165, "\xE2\x85\xB5" }, { 0x2166, "\xE2\x85\xB6" }, { 0x2167, "\xE2\x85\xB7" },
+    { 0x2168, "\xE2\x85\xB8" }, { 0x2169, "\xE2\x85\xB9" }, { 0x216A, "\xE2\x85\xBA" }, { 0x216B, "\xE2\x85\xBB" },
+    { 0x216C, "\xE2\x85\xBC" }, { 0x216D, "\xE2\x85\xBD" }, { 0x216E, "\xE2\x85\xBE" }, { 0x216F, "\xE2\x85\xBF" },
+    { 0x2183, "\xE2\x86\x84" }, { 0x24B6, "\xE2\x93\x90" }, { 0x24B7, "\xE2\x93\x91" }, { 0x24B8, "\xE2\x93\x92" },
+    { 0x24B9, "\xE2\x93\x93" }, { 0x24BA, "\xE2\x93\x94" }, { 0x24BB, "\xE2\x93\x95" }, { 0x24BC, "\xE2\x93\x96" },
+    { 0x24BD, "\xE2\x93\x97" }, { 0x24BE, "\xE2\x93\x98" }, { 0x24BF, "\xE2\x93\x99" }, { 0x24C0, "\xE2\x93\x9A" },
+    { 0x24C1, "\xE2\x93\x9B" }, { 0x24C2, "\xE2\x93\x9C" }, { 0x24C3, "\xE2\x93\x9D" }, { 0x24C4, "\xE2\x93\x9E" },
+    { 0x24C5, "\xE2\x93\x9F" }, { 0x24C6, "\xE2\x93\xA0" }, { 0x24C7, "\xE2\x93\xA1" }, { 0x24C8, "\xE2\x93\xA2" },
+    { 0x24C9, "\xE2\x93\xA3" }, { 0x24CA, "\xE2\x93\xA4" }, { 0x24CB, "\xE2\x93\xA5" }, { 0x24CC, "\xE2\x93\xA6" },
+    { 0x24CD, "\xE2\x93\xA7" }, { 0x24CE, "\xE2\x93\xA8" }, { 0x24CF, "\xE2\x93\xA9" }, { 0x2C00, "\xE2\xB0\xB0" },
+    { 0x2C01, "\xE2\xB0\xB1" }, { 0x2C02, "\xE2\xB0\xB2" }, { 0x2C03, "\xE2\xB0\xB3" }, { 0x2C04, "\xE2\xB0\xB4" },
+    { 0x2C05, "\xE2\xB0\xB5" }, { 0x2C06, "\xE2\xB0\xB6" }, { 0x2C07, "\xE2\xB0\xB7" }, { 0x2C08, "\xE2\xB0\xB8" },
+    { 0x2C09, "\xE2\xB0\xB9" }, { 0x2C0A, "\xE2\xB0\xBA" }, { 0x2C0B, "\xE2\xB0\xBB" }, { 0x2C0C, "\xE2\xB0\xBC" },
+    { 0x2C0D, "\xE2\xB0\xBD" }, { 0x2C0E, "\xE2\xB0\xBE" }, { 0x2C0F, "\xE2\xB0\xBF" }, { 0x2C10, "\xE2\xB1\x80" },
+    { 0x2C11, "\xE2\xB1\x81" }, { 0x2C12, "\xE2\xB1\x82" }, { 0x2C13, "\xE2\xB1\x83" }, { 0x2C14, "\xE2\xB1\x84" },
+    { 0x2C15, "\xE2\xB1\x85" }, { 0x2C16, "\xE2\xB1\x86" }, { 0x2C17, "\xE2\xB1\x87" }, { 0x2C18, "\xE2\xB1\x88" },
+    { 0x2C19, "\xE2\xB1\x89" }, { 0x2C1A, "\xE2\xB1\x8A" }, { 0x2C1B, "\xE2\xB1\x8B" }, { 0x2C1C, "\xE2\xB1\x8C" },
+    { 0x2C1D, "\xE2\xB1\x8D" }, { 0x2C1E, "\xE2\xB1\x8E" }, { 0x2C1F, "\xE2\xB1\x8F" }, { 0x2C20, "\xE2\xB1\x90" },
+    { 0x2C21, "\xE2\xB1\x91" }, { 0x2C22, "\xE2\xB1\x92" }, { 0x2C23, "\xE2\xB1\x93" }, { 0x2C24, "\xE2\xB1\x94" },
+    { 0x2C25, "\xE2\xB1\x95" }, { 0x2C26, "\xE2\xB1\x96" }, { 0x2C27, "\xE2\xB1\x97" }, { 0x2C28, "\xE2\xB1\x98" },
+    { 0x2C29, "\xE2\xB1\x99" }, { 0x2C2A, "\xE2\xB1\x9A" }, { 0x2C2B, "\xE2\xB1\x9B" }, { 0x2C2C, "\xE2\xB1\x9C" },
+    { 0x2C2D, "\xE2\xB1\x9D" }, { 0x2C2E, "\xE2\xB1\x9E" }, { 0x2C2F, "\xE2\xB1\x9F" }, { 0x2C60, "\xE2\xB1\xA1" },
+    { 0x2C62, "\xC9\xAB" }, { 0x2C63, "\xE1\xB5\xBD" }, { 0x2C64, "\xC9\xBD" }, { 0x2C67, "\xE2\xB1\xA8" },
+    { 0x2C69, "\xE2\xB1\xAA" }, { 0x2C6B, "\xE2\xB1\xAC" }, { 0x2C6D, "\xC9\x91" }, { 0x2C6E, "\xC9\xB1" },
+    { 0x2C6F, "\xC9\x90" }, { 0x2C70, "\xC9\x92" }, { 0x2C72, "\xE2\xB1\xB3" }, { 0x2C75, "\xE2\xB1\xB6" },
+    { 0x2C7E, "\xC8\xBF" }, { 0x2C7F, "\xC9\x80" }, { 0x2C80, "\xE2\xB2\x81" }, { 0x2C82, "\xE2\xB2\x83" },
+    { 0x2C84, "\xE2\xB2\x85" }, { 0x2C86, "\xE2\xB2\x87" }, { 0x2C88, "\xE2\xB2\x89" }, { 0x2C8A, "\xE2\xB2\x8B" },
+    { 0x2C8C, "\xE2\xB2\x8D" }, { 0x2C8E, "\xE2\xB2\x8F" }, { 0x2C90, "\xE2\xB2\x91" }, { 0x2C92, "\xE2\xB2\x93" },
+    { 0x2C94, "\xE2\xB2\x95" }, { 0x2C96, "\xE2\xB2\x97" }, { 0x2C98, "\xE2\xB2\x99" }, { 0x2C9A, "\xE2\xB2\x9B" },
+    { 0x2C9C, "\xE2\xB2\x9D" }, { 0x2C9E, "\xE2\xB2\x9F" }, { 0x2CA0, "\xE2\xB2\xA1" }, { 0x2CA2, "\xE2\xB2\xA3" },
+    { 0x2CA4, "\xE2\xB2\xA5" }, { 0x2CA6, "\xE2\xB2\xA7" }, { 0x2CA8, "\xE2\xB2\xA9" }, { 0x2CAA, "\xE2\xB2\xAB" },
+    { 0x2CAC, "\xE2\xB2\xAD" }, { 0x2CAE, "\xE2\xB2\xAF" }, { 0x2CB0, "\xE2\xB2\xB1" }, { 0x2CB2, "\xE2\xB2\xB3" },
+    { 0x2CB4, "\xE2\xB2\xB5" }, { 0x2CB6, "\xE2\xB2\xB7" }, { 0x2CB8, "\xE2\xB2\xB9" }, { 0x2CBA, "\xE2\xB2\xBB" },
+    { 0x2CBC, "\xE2\xB2\xBD" }, { 0x2CBE, "\xE2\xB2\xBF" }, { 0x2CC0, "\xE2\xB3\x81" }, { 0x2CC2, "\xE2\xB3\x83" },
+    { 0x2CC4, "\xE2\xB3\x85" }, { 0x2CC6, "\xE2\xB3\x87" }, { 0x2CC8, "\xE2\xB3\x89" }, { 0x2CCA, "\xE2\xB3\x8B" },
+    { 0x2CCC, "\xE2\xB3\x8D" }, { 0x2CCE, "\xE2\xB3\x8F" }, { 0x2CD0, "\xE2\xB3\x91" }, { 0x2CD2, "\xE2\xB3\x93" },
+    { 0x2CD4, "\xE2\xB3\x95" }, { 0x2CD6, "\xE2\xB3\x97" }, { 0x2CD8, "\xE2\xB3\x99" }, { 0x2CDA, "\xE2\xB3\x9B" },
+    { 0x2CDC, "\xE2\xB3\x9D" }, { 0x2CDE, "\xE2\xB3\x9F" }, { 0x2CE0, "\xE2\xB3\xA1" }, { 0x2CE2, "\xE2\xB3\xA3" },
+    { 0x2CEB, "\xE2\xB3\xAC" }, { 0x2CED, "\xE2\xB3\xAE" }, { 0x2CF2, "\xE2\xB3\xB3" }, { 0xA640, "\xEA\x99\x81" },
+    { 0xA642, "\xEA\x99\x83" }, { 0xA644, "\xEA\x99\x85" }, { 0xA646, "\xEA\x99\x87" }, { 0xA648, "\xEA\x99\x89" },
+    { 0xA64A, "\xEA\x99\x8B" }, { 0xA64C, "\xEA\x99\x8D" }, { 0xA64E, "\xEA\x99\x8F" }, { 0xA650, "\xEA\x99\x91" },
+    { 0xA652, "\xEA\x99\x93" }, { 0xA654, "\xEA\x99\x95" }, { 0xA656, "\xEA\x99\x97" }, { 0xA658, "\xEA\x99\x99" },
+    { 0xA65A, "\xEA\x99\x9B" }, { 0xA65C, "\xEA\x99\x9D" }, { 0xA65E, "\xEA\x99\x9F" }, { 0xA660, "\xEA\x99\xA1" },
+    { 0xA662, "\xEA\x99\xA3" }, { 0xA664, "\xEA\x99\xA5" }, { 0xA666, "\xEA\x99\xA7" }, { 0xA668, "\xEA\x99\xA9" },
+    { 0xA66A, "\xEA\x99\xAB" }, { 0xA66C, "\xEA\x99\xAD" }, { 0xA680, "\xEA\x9A\x81" }, { 0xA682, "\xEA\x9A\x83" },
+    { 0xA684, "\xEA\x9A\x85" }, { 0xA686, "\xEA\x9A\x87" }, { 0xA688, "\xEA\x9A\x89" }, { 0xA68A, "\xEA\x9A\x8B" },
+    { 0xA68C, "\xEA\x9A\x8D" }, { 0xA68E, "\xEA\x9A\x8F" }, { 0xA690, "\xEA\x9A\x91" }, { 0xA692, "\xEA\x9A\x93" },
+    { 0xA694, "\xEA\x9A\x95" }, { 0xA696, "\xEA\x9A\x97" }, { 0xA698, "\xEA\x9A\x99" }, { 0xA69A, "\xEA\x9A\x9B" },
+    { 0xA722, "\xEA\x9C\xA3" }, { 0xA724, "\xEA\x9C\xA5" }, { 0xA726, "\xEA\x9C\xA7" }, { 0xA728, "\xEA\x9C\xA9" },
+    { 0xA72A, "\xEA\x9C\xAB" }, { 0xA72C, "\xEA\x9C\xAD" }, { 0xA72E, "\xEA\x9C\xAF" }, { 0xA732, "\xEA\x9C\xB3" },
+    { 0xA734, "\xEA\x9C\xB5" }, { 0xA736, "\xEA\x9C\xB7" }, { 0xA738, "\xEA\x9C\xB9" }, { 0xA73A, "\xEA\x9C\xBB" },
+    { 0xA73C, "\xEA\x9C\xBD" }, { 0xA73E, "\xEA\x9C\xBF" }, { 0xA740, "\xEA\x9D\x81" }, { 0xA742, "\xEA\x9D\x83" },
+    { 0xA744, "\xEA\x9D\x85" }, { 0xA746, "\xEA\x9D\x87" }, { 0xA748, "\xEA\x9D\x89" }, { 0xA74A, "\xEA\x9D\x8B" },
+    { 0xA74C, "\xEA\x9D\x8D" }, { 0xA74E, "\xEA\x9D\x8F" }, { 0xA750, "\xEA\x9D\x91" }, { 0xA752, "\xEA\x9D\x93" },
+    { 0xA754, "\xEA\x9D\x95" }, { 0xA756, "\xEA\x9D\x97" }, { 0xA758, "\xEA\x9D\x99" }, { 0xA75A, "\xEA\x9D\x9B" },
+    { 0xA75C, "\xEA\x9D\x9D" }, { 0xA75E, "\xEA\x9D\x9F" }, { 0xA760, "\xEA\x9D\xA1" }, { 0xA762, "\xEA\x9D\xA3" },
+    { 0xA764, "\xEA\x9D\xA5" }, { 0xA766, "\xEA\x9D\xA7" }, { 0xA768, "\xEA\x9D\xA9" }, { 0xA76A, "\xEA\x9D\xAB" },
+    { 0xA76C, "\xEA\x9D\xAD" }, { 0xA76E, "\xEA\x9D\xAF" }, { 0xA779, "\xEA\x9D\xBA" }, { 0xA77B, "\xEA\x9D\xBC" },
+    { 0xA77D, "\xE1\xB5\xB9" }, { 0xA77E, "\xEA\x9D\xBF" }, { 0xA780, "\xEA\x9E\x81" }, { 0xA782, "\xEA\x9E\x83" },
+    { 0xA784, "\xEA\x9E\x85" }, { 0xA786, "\xEA\x9E\x87" }, { 0xA78B, "\xEA\x9E\x8C" }, { 0xA78D, "\xC9\xA5" },
+    { 0xA790, "\xEA\x9E\x91" }, { 0xA792, "\xEA\x9E\x93" }, { 0xA796, "\xEA\x9E\x97" }, { 0xA798, "\xEA\x9E\x99" },
+    { 0xA79A, "\xEA\x9E\x9B" }, { 0xA79C, "\xEA\x9E\x9D" }, { 0xA79E, "\xEA\x9E\x9F" }, { 0xA7A0, "\xEA\x9E\xA1" },
+    { 0xA7A2, "\xEA\x9E\xA3" }, { 0xA7A4, "\xEA\x9E\xA5" }, { 0xA7A6, "\xEA\x9E\xA7" }, { 0xA7A8, "\xEA\x9E\xA9" },
+    { 0xA7AA, "\xC9\xA6" }, { 0xA7AB, "\xC9\x9C" }, { 0xA7AC, "\xC9\xA1" }, { 0xA7AD, "\xC9\xAC" },
+    { 0xA7AE, "\xC9\xAA" }, { 0xA7B0, "\xCA\x9E" }, { 0xA7B1, "\xCA\x87" }, { 0xA7B2, "\xCA\x9D" },
+    { 0xA7B3, "\xEA\xAD\x93" }, { 0xA7B4, "\xEA\x9E\xB5" }, { 0xA7B6, "\xEA\x9E\xB7" }, { 0xA7B8, "\xEA\x9E\xB9" },
+    { 0xA7BA, "\xEA\x9E\xBB" }, { 0xA7BC, "\xEA\x9E\xBD" }, { 0xA7BE, "\xEA\x9E\xBF" }, { 0xA7C0, "\xEA\x9F\x81" },
+    { 0xA7C2, "\xEA\x9F\x83" }, { 0xA7C4, "\xEA\x9E\x94" }, { 0xA7C5, "\xCA\x82" }, { 0xA7C6, "\xE1\xB6\x8E" },
+    { 0xA7C7, "\xEA\x9F\x88" }, { 0xA7C9, "\xEA\x9F\x8A" }, { 0xA7D0, "\xEA\x9F\x91" }, { 0xA7D6, "\xEA\x9F\x97" },
+    { 0xA7D8, "\xEA\x9F\x99" }, { 0xA7F5, "\xEA\x9F\xB6" }, { 0xAB70, "\xE1\x8E\xA0" }, { 0xAB71, "\xE1\x8E\xA1" },
+    { 0xAB72, "\xE1\x8E\xA2" }, { 0xAB73, "\xE1\x8E\xA3" }, { 0xAB74, "\xE1\x8E\xA4" }, { 0xAB75, "\xE1\x8E\xA5" },
+    { 0xAB76, "\xE1\x8E\xA6" }, { 0xAB77, "\xE1\x8E\xA7" }, { 0xAB78, "\xE1\x8E\xA8" }, { 0xAB79, "\xE1\x8E\xA9" },
+    { 0xAB7A, "\xE1\x8E\xAA" }, { 0xAB7B, "\xE1\x8E\xAB" }, { 0xAB7C, "\xE1\x8E\xAC" }, { 0xAB7D, "\xE1\x8E\xAD" },
+    { 0xAB7E, "\xE1\x8E\xAE" }, { 0xAB7F, "\xE1\x8E\xAF" }, { 0xAB80, "\xE1\x8E\xB0" }, { 0xAB81, "\xE1\x8E\xB1" },
+    { 0xAB82, "\xE1\x8E\xB2" }, { 0xAB83, "\xE1\x8E\xB3" }, { 0xAB84, "\xE1\x8E\xB4" }, { 0xAB85, "\xE1\x8E\xB5" },
+    { 0xAB86, "\xE1\x8E\xB6" }, { 0xAB87, "\xE1\x8E\xB7" }, { 0xAB88, "\xE1\x8E\xB8" }, { 0xAB89, "\xE1\x8E\xB9" },
+    { 0xAB8A, "\xE1\x8E\xBA" }, { 0xAB8B, "\xE1\x8E\xBB" }, { 0xAB8C, "\xE1\x8E\xBC" }, { 0xAB8D, "\xE1\x8E\xBD" },
+    { 0xAB8E, "\xE1\x8E\xBE" }, { 0xAB8F, "\xE1\x8E\xBF" }, { 0xAB90, "\xE1\x8F\x80" }, { 0xAB91, "\xE1\x8F\x81" },
+    { 0xAB92, "\xE1\x8F\x82" }, { 0xAB93, "\xE1\x8F\x83" }, { 0xAB94, "\xE1\x8F\x84" }, { 0xAB95, "\xE1\x8F\x85" },
+    { 0xAB96, "\xE1\x8F\x86" }, { 0xAB97, "\xE1\x8F\x87" }, { 0xAB98, "\xE1\x8F\x88" }, { 0xAB99, "\xE1\x8F\x89" },
+    { 0xAB9A, "\xE1\x8F\x8A" }, { 0xAB9B, "\xE1\x8F\x8B" }, { 0xAB9C, "\xE1\x8F\x8C" }, { 0xAB9D, "\xE1\x8F\x8D" },
+    { 0xAB9E, "\xE1\x8F\x8E" }, { 0xAB9F, "\xE1\x8F\x8F" }, { 0xABA0, "\xE1\x8F\x90" }, { 0xABA1, "\xE1\x8F\x91" },
+    { 0xABA2, "\xE1\x8F\x92" }, { 0xABA3, "\xE1\x8F\x93" }, { 0xABA4, "\xE1\x8F\x94" }, { 0xABA5, "\xE1\x8F\x95" },
+    { 0xABA6, "\xE1\x8F\x96" }, { 0xABA7, "\xE1\x8F\x97" }, { 0xABA8, "\xE1\x8F\x98" }, { 0xABA9, "\xE1\x8F\x99" },
+    { 0xABAA, "\xE1\x8F\x9A" }, { 0xABAB, "\xE1\x8F\x9B" }, { 0xABAC, "\xE1\x8F\x9C" }, { 0xABAD, "\xE1\x8F\x9D" },
+    { 0xABAE, "\xE1\x8F\x9E" }, { 0xABAF, "\xE1\x8F\x9F" }, { 0xABB0, "\xE1\x8F\xA0" }, { 0xABB1, "\xE1\x8F\xA1" },
+    { 0xABB2, "\xE1\x8F\xA2" }, { 0xABB3, "\xE1\x8F\xA3" }, { 0xABB4, "\xE1\x8F\xA4" }, { 0xABB5, "\xE1\x8F\xA5" },
+    { 0xABB6, "\xE1\x8F\xA6" }, { 0xABB7, "\xE1\x8F\xA7" }, { 0xABB8, "\xE1\x8F\xA8" }, { 0xABB9, "\xE1\x8F\xA9" },
+    { 0xABBA, "\xE1\x8F\xAA" }, { 0xABBB, "\xE1\x8F\xAB" }, { 0xABBC, "\xE1\x8F\xAC" }, { 0xABBD, "\xE1\x8F\xAD" },
+    { 0xABBE, "\xE1\x8F\xAE" }, { 0xABBF, "\xE1\x8F\xAF" }, { 0xFB00, "\x66\x66" }, { 0xFB01, "\x66\x69" },
+    { 0xFB02, "\x66\x6C" }, { 0xFB03, "\x66\x66\x69" }, { 0xFB04, "\x66\x66\x6C" }, { 0xFB05, "\x73\x74" },
+    { 0xFB06, "\x73\x74" }, { 0xFB13, "\xD5\xB4\xD5\xB6" }, { 0xFB14, "\xD5\xB4\xD5\xA5" }, { 0xFB15, "\xD5\xB4\xD5\xAB" },
+    { 0xFB16, "\xD5\xBE\xD5\xB6" }, { 0xFB17, "\xD5\xB4\xD5\xAD" }, { 0xFF21, "\xEF\xBD\x81" }, { 0xFF22, "\xEF\xBD\x82" },
+    { 0xFF23, "\xEF\xBD\x83" }, { 0xFF24, "\xEF\xBD\x84" }, { 0xFF25, "\xEF\xBD\x85" }, { 0xFF26, "\xEF\xBD\x86" },
+    { 0xFF27, "\xEF\xBD\x87" }, { 0xFF28, "\xEF\xBD\x88" }, { 0xFF29, "\xEF\xBD\x89" }, { 0xFF2A, "\xEF\xBD\x8A" },
+    { 0xFF2B, "\xEF\xBD\x8B" }, { 0xFF2C, "\xEF\xBD\x8C" }, { 0xFF2D, "\xEF\xBD\x8D" }, { 0xFF2E, "\xEF\xBD\x8E" },
+    { 0xFF2F, "\xEF\xBD\x8F" }, { 0xFF30, "\xEF\xBD\x90" }, { 0xFF31, "\xEF\xBD\x91" }, { 0xFF32, "\xEF\xBD\x92" },
+    { 0xFF33, "\xEF\xBD\x93" }, { 0xFF34, "\xEF\xBD\x94" }, { 0xFF35, "\xEF\xBD\x95" }, { 0xFF36, "\xEF\xBD\x96" },
+    { 0xFF37, "\xEF\xBD\x97" }, { 0xFF38, "\xEF\xBD\x98" }, { 0xFF39, "\xEF\xBD\x99" }, { 0xFF3A, "\xEF\xBD\x9A" },
+    { 0x10400, "\xF0\x90\x90\xA8" }, { 0x10401, "\xF0\x90\x90\xA9" }, { 0x10402, "\xF0\x90\x90\xAA" }, { 0x10403, "\xF0\x90\x90\xAB" },
+    { 0x10404, "\xF0\x90\x90\xAC" }, { 0x10405, "\xF0\x90\x90\xAD" }, { 0x10406, "\xF0\x90\x90\xAE" }, { 0x10407, "\xF0\x90\x90\xAF" },
+    { 0x10408, "\xF0\x90\x90\xB0" }, { 0x10409, "\xF0\x90\x90\xB1" }, { 0x1040A, "\xF0\x90\x90\xB2" }, { 0x1040B, "\xF0\x90\x90\xB3" },
+    { 0x1040C, "\xF0\x90\x90\xB4" }, { 0x1040D, "\xF0\x90\x90\xB5" }, { 0x1040E, "\xF0\x90\x90\xB6" }, { 0x1040F, "\xF0\x90\x90\xB7" },
+    { 0x10410, "\xF0\x90\x90\xB8" }, { 0x10411, "\xF0\x90\x90\xB9" }, { 0x10412, "\xF0\x90\x90\xBA" }, { 0x10413, "\xF0\x90\x90\xBB" },
+    { 0x10414, "\xF0\x90\x90\xBC" }, { 0x10415, "\xF0\x90\x90\xBD" }, { 0x10416, "\xF0\x90\x90\xBE" }, { 0x10417, "\xF0\x90\x90\xBF" },
+    { 0x10418, "\xF0\x90\x91\x80" }, { 0x10419, "\xF0\x90\x91\x81" }, { 0x1041A, "\xF0\x90\x91\x82" }, { 0x1041B, "\xF0\x90\x91\x83" },
+    { 0x1041C, "\xF0\x90\x91\x84" }, { 0x1041D, "\xF0\x90\x91\x85" }, { 0x1041E, "\xF0\x90\x91\x86" }, { 0x1041F, "\xF0\x90\x91\x87" },
+    { 0x10420, "\xF0\x90\x91\x88" }, { 0x10421, "\xF0\x90\x91\x89" }, { 0x10422, "\xF0\x90\x91\x8A" }, { 0x10423, "\xF0\x90\x91\x8B" },
+    { 0x10424, "\xF0\x90\x91\x8C" }, { 0x10425, "\xF0\x90\x91\x8D" }, { 0x10426, "\xF0\x90\x91\x8E" }, { 0x10427, "\xF0\x90\x91\x8F" },
+    { 0x104B0, "\xF0\x90\x93\x98" }, { 0x104B1, "\xF0\x90\x93\x99" }, { 0x104B2, "\xF0\x90\x93\x9A" }, { 0x104B3, "\xF0\x90\x93\x9B" },
+    { 0x104B4, "\xF0\x90\x93\x9C" }, { 0x104B5, "\xF0\x90\x93\x9D" }, { 0x104B6, "\xF0\x90\x93\x9E" }, { 0x104B7, "\xF0\x90\x93\x9F" },
+    { 0x104B8, "\xF0\x90\x93\xA0" }, { 0x104B9, "\xF0\x90\x93\xA1" }, { 0x104BA, "\xF0\x90\x93\xA2" }, { 0x104BB, "\xF0\x90\x93\xA3" },
+    { 0x104BC, "\xF0\x90\x93\xA4" }, { 0x104BD, "\xF0\x90\x93\xA5" }, { 0x104BE, "\xF0\x90\x93\xA6" }, { 0x104BF, "\xF0\x90\x93\xA7" },
+    { 0x104C0, "\xF0\x90\x93\xA8" }, { 0x104C1, "\xF0\x90\x93\xA9" }, { 0x104C2, "\xF0\x90\x93\xAA" }, { 0x104C3, "\xF0\x90\x93\xAB" },
+    { 0x104C4, "\xF0\x90\x93\xAC" }, { 0x104C5, "\xF0\x90\x93\xAD" }, { 0x104C6, "\xF0\x90\x93\xAE" }, { 0x104C7, "\xF0\x90\x93\xAF" },
+    { 0x104C8, "\xF0\x90\x93\xB0" }, { 0x104C9, "\xF0\x90\x93\xB1" }, { 0x104CA, "\xF0\x90\x93\xB2" }, { 0x104CB, "\xF0\x90\x93\xB3" },
+    { 0x104CC, "\xF0\x90\x93\xB4" }, { 0x104CD, "\xF0\x90\x93\xB5" }, { 0x104CE, "\xF0\x90\x93\xB6" }, { 0x104CF, "\xF0\x90\x93\xB7" },
+    { 0x104D0, "\xF0\x90\x93\xB8" }, { 0x104D1, "\xF0\x90\x93\xB9" }, { 0x104D2, "\xF0\x90\x93\xBA" }, { 0x104D3, "\xF0\x90\x93\xBB" },
+    { 0x10570, "\xF0\x90\x96\x97" }, { 0x10571, "\xF0\x90\x96\x98" }, { 0x10572, "\xF0\x90\x96\x99" }, { 0x10573, "\xF0\x90\x96\x9A" },
+    { 0x10574, "\xF0\x90\x96\x9B" }, { 0x10575, "\xF0\x90\x96\x9C" }, { 0x10576, "\xF0\x90\x96\x9D" }, { 0x10577, "\xF0\x90\x96\x9E" },
+    { 0x10578, "\xF0\x90\x96\x9F" }, { 0x10579, "\xF0\x90\x96\xA0" }, { 0x1057A, "\xF0\x90\x96\xA1" }, { 0x1057C, "\xF0\x90\x96\xA3" },
+    { 0x1057D, "\xF0\x90\x96\xA4" }, { 0x1057E, "\xF0\x90\x96\xA5" }, { 0x1057F, "\xF0\x90\x96\xA6" }, { 0x10580, "\xF0\x90\x96\xA7" },
+    { 0x10581, "\xF0\x90\x96\xA8" }, { 0x10582, "\xF0\x90\x96\xA9" }, { 0x10583, "\xF0\x90\x96\xAA" }, { 0x10584, "\xF0\x90\x96\xAB" },
+    { 0x10585, "\xF0\x90\x96\xAC" }, { 0x10586, "\xF0\x90\x96\xAD" }, { 0x10587, "\xF0\x90\x96\xAE" }, { 0x10588, "\xF0\x90\x96\xAF" },
+    { 0x10589, "\xF0\x90\x96\xB0" }, { 0x1058A, "\xF0\x90\x96\xB1" }, { 0x1058C, "\xF0\x90\x96\xB3" }, { 0x1058D, "\xF0\x90\x96\xB4" },
+    { 0x1058E, "\xF0\x90\x96\xB5" }, { 0x1058F, "\xF0\x90\x96\xB6" }, { 0x10590, "\xF0\x90\x96\xB7" }, { 0x10591, "\xF0\x90\x96\xB8" },
+    { 0x10592, "\xF0\x90\x96\xB9" }, { 0x10594, "\xF0\x90\x96\xBB" }, { 0x10595, "\xF0\x90\x96\xBC" }, { 0x10C80, "\xF0\x90\xB3\x80" },
+    { 0x10C81, "\xF0\x90\xB3\x81" }, { 0x10C82, "\xF0\x90\xB3\x82" }, { 0x10C83, "\xF0\x90\xB3\x83" }, { 0x10C84, "\xF0\x90\xB3\x84" },
+    { 0x10C85, "\xF0\x90\xB3\x85" }, { 0x10C86, "\xF0\x90\xB3\x86" }, { 0x10C87, "\xF0\x90\xB3\x87" }, { 0x10C88, "\xF0\x90\xB3\x88" },
+    { 0x10C89, "\xF0\x90\xB3\x89" }, { 0x10C8A, "\xF0\x90\xB3\x8A" }, { 0x10C8B, "\xF0\x90\xB3\x8B" }, { 0x10C8C, "\xF0\x90\xB3\x8C" },
+    { 0x10C8D, "\xF0\x90\xB3\x8D" }, { 0x10C8E, "\xF0\x90\xB3\x8E" }, { 0x10C8F, "\xF0\x90\xB3\x8F" }, { 0x10C90, "\xF0\x90\xB3\x90" },
+    { 0x10C91, "\xF0\x90\xB3\x91" }, { 0x10C92, "\xF0\x90\xB3\x92" }, { 0x10C93, "\xF0\x90\xB3\x93" }, { 0x10C94, "\xF0\x90\xB3\x94" },
+    { 0x10C95, "\xF0\x90\xB3\x95" }, { 0x10C96, "\xF0\x90\xB3\x96" }, { 0x10C97, "\xF0\x90\xB3\x97" }, { 0x10C98, "\xF0\x90\xB3\x98" },
+    { 0x10C99, "\xF0\x90\xB3\x99" }, { 0x10C9A, "\xF0\x90\xB3\x9A" }, { 0x10C9B, "\xF0\x90\xB3\x9B" }, { 0x10C9C, "\xF0\x90\xB3\x9C" },
+    { 0x10C9D, "\xF0\x90\xB3\x9D" }, { 0x10C9E, "\xF0\x90\xB3\x9E" }, { 0x10C9F, "\xF0\x90\xB3\x9F" }, { 0x10CA0, "\xF0\x90\xB3\xA0" },
+    { 0x10CA1, "\xF0\x90\xB3\xA1" }, { 0x10CA2, "\xF0\x90\xB3\xA2" }, { 0x10CA3, "\xF0\x90\xB3\xA3" }, { 0x10CA4, "\xF0\x90\xB3\xA4" },
+    { 0x10CA5, "\xF0\x90\xB3\xA5" }, { 0x10CA6, "\xF0\x90\xB3\xA6" }, { 0x10CA7, "\xF0\x90\xB3\xA7" }, { 0x10CA8, "\xF0\x90\xB3\xA8" },
+    { 0x10CA9, "\xF0\x90\xB3\xA9" }, { 0x10CAA, "\xF0\x90\xB3\xAA" }, { 0x10CAB, "\xF0\x90\xB3\xAB" }, { 0x10CAC, "\xF0\x90\xB3\xAC" },
+    { 0x10CAD, "\xF0\x90\xB3\xAD" }, { 0x10CAE, "\xF0\x90\xB3\xAE" }, { 0x10CAF, "\xF0\x90\xB3\xAF" }, { 0x10CB0, "\xF0\x90\xB3\xB0" },
+    { 0x10CB1, "\xF0\x90\xB3\xB1" }, { 0x10CB2, "\xF0\x90\xB3\xB2" }, { 0x118A0, "\xF0\x91\xA3\x80" }, { 0x118A1, "\xF0\x91\xA3\x81" },
+    { 0x118A2, "\xF0\x91\xA3\x82" }, { 0x118A3, "\xF0\x91\xA3\x83" }, { 0x118A4, "\xF0\x91\xA3\x84" }, { 0x118A5, "\xF0\x91\xA3\x85" },
+    { 0x118A6, "\xF0\x91\xA3\x86" }, { 0x118A7, "\xF0\x91\xA3\x87" }, { 0x118A8, "\xF0\x91\xA3\x88" }, { 0x118A9, "\xF0\x91\xA3\x89" },
+    { 0x118AA, "\xF0\x91\xA3\x8A" }, { 0x118AB, "\xF0\x91\xA3\x8B" }, { 0x118AC, "\xF0\x91\xA3\x8C" }, { 0x118AD, "\xF0\x91\xA3\x8D" },
+    { 0x118AE, "\xF0\x91\xA3\x8E" }, { 0x118AF, "\xF0\x91\xA3\x8F" }, { 0x118B0, "\xF0\x91\xA3\x90" }, { 0x118B1, "\xF0\x91\xA3\x91" },
+    { 0x118B2, "\xF0\x91\xA3\x92" }, { 0x118B3, "\xF0\x91\xA3\x93" }, { 0x118B4, "\xF0\x91\xA3\x94" }, { 0x118B5, "\xF0\x91\xA3\x95" },
+    { 0x118B6, "\xF0\x91\xA3\x96" }, { 0x118B7, "\xF0\x91\xA3\x97" }, { 0x118B8, "\xF0\x91\xA3\x98" }, { 0x118B9, "\xF0\x91\xA3\x99" },
+    { 0x118BA, "\xF0\x91\xA3\x9A" }, { 0x118BB, "\xF0\x91\xA3\x9B" }, { 0x118BC, "\xF0\x91\xA3\x9C" }, { 0x118BD, "\xF0\x91\xA3\x9D" },
+    { 0x118BE, "\xF0\x91\xA3\x9E" }, { 0x118BF, "\xF0\x91\xA3\x9F" }, { 0x16E40, "\xF0\x96\xB9\xA0" }, { 0x16E41, "\xF0\x96\xB9\xA1" },
+    { 0x16E42, "\xF0\x96\xB9\xA2" }, { 0x16E43, "\xF0\x96\xB9\xA3" }, { 0x16E44, "\xF0\x96\xB9\xA4" }, { 0x16E45, "\xF0\x96\xB9\xA5" },
+    { 0x16E46, "\xF0\x96\xB9\xA6" }, { 0x16E47, "\xF0\x96\xB9\xA7" }, { 0x16E48, "\xF0\x96\xB9\xA8" }, { 0x16E49, "\xF0\x96\xB9\xA9" },
+    { 0x16E4A, "\xF0\x96\xB9\xAA" }, { 0x16E4B, "\xF0\x96\xB9\xAB" }, { 0x16E4C, "\xF0\x96\xB9\xAC" }, { 0x16E4D, "\xF0\x96\xB9\xAD" },
+    { 0x16E4E, "\xF0\x96\xB9\xAE" }, { 0x16E4F, "\xF0\x96\xB9\xAF" }, { 0x16E50, "\xF0\x96\xB9\xB0" }, { 0x16E51, "\xF0\x96\xB9\xB1" },
+    { 0x16E52, "\xF0\x96\xB9\xB2" }, { 0x16E53, "\xF0\x96\xB9\xB3" }, { 0x16E54, "\xF0\x96\xB9\xB4" }, { 0x16E55, "\xF0\x96\xB9\xB5" },
+    { 0x16E56, "\xF0\x96\xB9\xB6" }, { 0x16E57, "\xF0\x96\xB9\xB7" }, { 0x16E58, "\xF0\x96\xB9\xB8" }, { 0x16E59, "\xF0\x96\xB9\xB9" },
+    { 0x16E5A, "\xF0\x96\xB9\xBA" }, { 0x16E5B, "\xF0\x96\xB9\xBB" }, { 0x16E5C, "\xF0\x96\xB9\xBC" }, { 0x16E5D, "\xF0\x96\xB9\xBD" },
+    { 0x16E5E, "\xF0\x96\xB9\xBE" }, { 0x16E5F, "\xF0\x96\xB9\xBF" }, { 0x1E900, "\xF0\x9E\xA4\xA2" }, { 0x1E901, "\xF0\x9E\xA4\xA3" },
+    { 0x1E902, "\xF0\x9E\xA4\xA4" }, { 0x1E903, "\xF0\x9E\xA4\xA5" }, { 0x1E904, "\xF0\x9E\xA4\xA6" }, { 0x1E905, "\xF0\x9E\xA4\xA7" },
+    { 0x1E906, "\xF0\x9E\xA4\xA8" }, { 0x1E907, "\xF0\x9E\xA4\xA9" }, { 0x1E908, "\xF0\x9E\xA4\xAA" }, { 0x1E909, "\xF0\x9E\xA4\xAB" },
+    { 0x1E90A, "\xF0\x9E\xA4\xAC" }, { 0x1E90B, "\xF0\x9E\xA4\xAD" }, { 0x1E90C, "\xF0\x9E\xA4\xAE" }, { 0x1E90D, "\xF0\x9E\xA4\xAF" },
+    { 0x1E90E, "\xF0\x9E\xA4\xB0" }, { 0x1E90F, "\xF0\x9E\xA4\xB1" }, { 0x1E910, "\xF0\x9E\xA4\xB2" }, { 0x1E911, "\xF0\x9E\xA4\xB3" },
+    { 0x1E912, "\xF0\x9E\xA4\xB4" }, { 0x1E913, "\xF0\x9E\xA4\xB5" }, { 0x1E914, "\xF0\x9E\xA4\xB6" }, { 0x1E915, "\xF0\x9E\xA4\xB7" },
+    { 0x1E916, "\xF0\x9E\xA4\xB8" }, { 0x1E917, "\xF0\x9E\xA4\xB9" }, { 0x1E918, "\xF0\x9E\xA4\xBA" }, { 0x1E919, "\xF0\x9E\xA4\xBB" },
+    { 0x1E91A, "\xF0\x9E\xA4\xBC" }, { 0x1E91B, "\xF0\x9E\xA4\xBD" }, { 0x1E91C, "\xF0\x9E\xA4\xBE" }, { 0x1E91D, "\xF0\x9E\xA4\xBF" },
+    { 0x1E91E, "\xF0\x9E\xA5\x80" }, { 0x1E91F, "\xF0\x9E\xA5\x81" }, { 0x1E920, "\xF0\x9E\xA5\x82" }, { 0x1E921, "\xF0\x9E\xA5\x83" },
+};
+
+static const char asciiFolded[128] = {
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F,
+    0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F,
+    ' ', '!', '"', '#', '$', '%', '&', '\'', '(', ')', '*', '+', ',', '-', '.', '/',
+    '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', ':', ';', '<', '=', '>', '?',
+    '@', 'a', 'b', 'c', 'd', 'e', 'f', 'g', 'h', 'i', 'j', 'k', 'l', 'm', 'n', 'o',
+    'p', 'q', 'r', 's', 't', 'u', 'v', 'w', 'x', 'y', 'z', '[', '\\', ']', '^', '_',
+    '`', 'a', 'b', 'c', 'd', 'e', 'f', 'g', 'h', 'i', 'j', 'k', 'l', 'm', 'n', 'o',
+    'p', 'q', 'r', 's', 't', 'u', 'v', 'w', 'x', 'y', 'z', '{', '|', '}', '~', 0x7F,
+};
+
+static std::string encodeUtf8(unsigned int cp) {
+    std::string bytes;
+    if (cp < 0x80) {
+        bytes += static_cast<char>(cp);
+    }
+    else if (cp < 0x800) {
+        bytes += static_cast<char>(0xC0 | (cp >> 6));
+        bytes += static_cast<char>(0x80 | (cp & 0x3F));
+    }
+    else if (cp < 0x10000) {
+        bytes += static_cast<char>(0xE0 | (cp >> 12));
+        bytes += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        bytes += static_cast<char>(0x80 | (cp & 0x3F));
+    }
+    else {
+        bytes += static_cast<char>(0xF0 | (cp >> 18));
+        bytes += static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+        bytes += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        bytes += static_cast<char>(0x80 | (cp & 0x3F));
+    }
+    return bytes;
+}
+
+size_t CaseFolding::decode(const char* text, size_t textLength, size_t pos, unsigned int& codePoint) {
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(text) + pos;
+    unsigned char lead = bytes[0];
+    codePoint = INVALID;
+    if (lead < 0x80) {
+        codePoint = lead;
+        return 1;
+    }
+
+    // Same rules as Scintilla's UTF8Classify: no overlong forms, no surrogates, nothing above U+10FFFF
+    size_t width = (lead >= 0xF5) ? 0 : (lead >= 0xF0) ? 4 : (lead >= 0xE0) ? 3 : (lead >= 0xC2) ? 2 : 0;
+    if (width == 0 || pos + width > textLength) {
+        return 1;
+    }
+    for (size_t i = 1; i < width; ++i) {
+        if ((bytes[i] & 0xC0) != 0x80) {
+            return 1;
+        }
+    }
+    if ((lead == 0xE0 && bytes[1] < 0xA0) || (lead == 0xED && bytes[1] > 0x9F) ||
+        (lead == 0xF0 && bytes[1] < 0x90) || (lead == 0xF4 && bytes[1] > 0x8F)) {
+        return 1;
+    }
+
+    unsigned int cp = lead & (0x7F >> width);
+    for (size_t i = 1; i < width; ++i) {
+        cp = (cp << 6) | (bytes[i] & 0x3F);
+    }
+    codePoint = cp;
+    return width;
+}
+
+const char* CaseFolding::find(unsigned int codePoint) {
+    const FoldEntry* end = foldTable + sizeof(foldTable) / sizeof(foldTable[0]);
+    const FoldEntry* entry = std::lower_bound(foldTable, end, codePoint,
+        [](const FoldEntry& item, unsigned int cp) { return item.codePoint < cp; });
+    return (entry != end && entry->codePoint == codePoint) ? entry->folded : nullptr;
+}
+
+size_t CaseFolding::foldCharacter(const char* text, size_t textLength, size_t pos, const char*& folded, size_t& foldedLength) {
+    unsigned char lead = static_cast<unsigned char>(text[pos]);
+    if (lead < 0x80) {
+        folded = asciiFolded + lead;
+        foldedLength = 1;
+        return 1;
+    }
+
+    unsigned int codePoint;
+    size_t width = decode(text, textLength, pos, codePoint);
+    const char* mapped = (codePoint != INVALID) ? find(codePoint) : nullptr;
+    if (mapped != nullptr) {
+        folded = mapped;
+        foldedLength = std::strlen(mapped);
+    }
+    else {
+        folded = text + pos;
+        foldedLength = width;
+    }
+    return width;
+}
+
+std::string CaseFolding::fold(const std::string& text) {
+    std::string result;
+    result.reserve(text.size());
+    for (size_t pos = 0; pos < text.size();) {
+        const char* folded;
+        size_t foldedLength;
+        pos += foldCharacter(text.data(), text.size(), pos, folded, foldedLength);
+        result.append(folded, foldedLength);
+    }
+    return result;
+}
+
+bool CaseFolding::isValid(const std::string& text) {
+    for (size_t pos = 0; pos < text.size();) {
+        unsigned int codePoint;
+        pos += decode(text.data(), text.size(), pos, codePoint);
+        if (codePoint == INVALID) {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::vector<std::string> CaseFolding::charactersFoldingInto(const std::string& folded) {
+    std::vector<std::string> characters;
+    for (const FoldEntry& entry : foldTable) {
+        if (folded.find(entry.folded) != std::string::npos) {
+            characters.push_back(encodeUtf8(entry.codePoint));
+        }
+    }
+    return characters;
+}
+
+std::string CaseFolding::leadBytesFoldingTo(const std::string& folded) {
+    std::string leads;
+    if (folded.empty()) {
+        return leads;
+    }
+
+    auto add = [&leads](char lead) {
+        if (leads.find(lead) == std::string::npos) {
+            leads += lead;
+        }
+    };
+    add(folded[0]);
+    if (folded[0] >= 'a' && folded[0] <= 'z') {
+        add(static_cast<char>(folded[0] - 32));
+    }
+    for (const FoldEntry& entry : foldTable) {
+        if (folded.compare(0, std::strlen(entry.folded), entry.folded) == 0) {
+            add(encodeUtf8(entry.codePoint)[0]);
+        }
+    }
+    return leads;
+}
+
+bool CaseFolding::foldsAcross(const std::string& foldedBefore, const std::string& foldedAfter) {
+    for (const FoldEntry& entry : foldTable) {
+        size_t length = std::strlen(entry.folded);
+        for (size_t split = 1; split < length; ++split) {
+            // Only splits between two characters of the folding
+            if ((static_cast<unsigned char>(entry.folded[split]) & 0xC0) == 0x80) {
+                continue;
+            }
+            if (foldedBefore.size() >= split && foldedBefore.compare(foldedBefore.size() - split, split, entry.folded, split) == 0 &&
+                foldedAfter.compare(0, length - split, entry.folded + split) == 0) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
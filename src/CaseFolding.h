@@ -0,0 +1,59 @@
+// This file is part of Notepad++ project
+// Copyright (C)2023 Thomas Knoefel
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef CASE_FOLDING_H
+#define CASE_FOLDING_H
+
+// Full Unicode case folding of UTF-8 text, the folding Scintilla compares in a search without SCFIND_MATCHCASE.
+// Characters are decoded the way Scintilla decodes them: a byte that does not start a valid sequence
+// is a character of its own and folds to itself.
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+class CaseFolding
+{
+public:
+    static const unsigned int INVALID = 0xFFFFFFFF;
+
+    // Width in bytes of the character at pos; codePoint is INVALID for a byte outside a valid sequence
+    static size_t decode(const char* text, size_t textLength, size_t pos, unsigned int& codePoint);
+
+    // Folding of the character at pos, pointing into the table or into text if the character folds to itself.
+    // Returns the width of the character in text.
+    static size_t foldCharacter(const char* text, size_t textLength, size_t pos, const char*& folded, size_t& foldedLength);
+
+    static std::string fold(const std::string& text);
+
+    static bool isValid(const std::string& text);
+
+    // Non-ASCII characters (UTF-8) whose folding occurs somewhere in the folded text. Without them in the
+    // document, comparing ASCII letters in either case finds exactly what Scintilla finds.
+    static std::vector<std::string> charactersFoldingInto(const std::string& folded);
+
+    // Distinct first bytes of all characters whose folding starts the folded text
+    static std::string leadBytesFoldingTo(const std::string& folded);
+
+    // True if one character folds to more than one character, the first of them ending foldedBefore and the
+    // rest starting foldedAfter (U+00DF folds to "ss"). Text found for foldedBefore + foldedAfter then need not
+    // begin with text found for foldedBefore.
+    static bool foldsAcross(const std::string& foldedBefore, const std::string& foldedAfter);
+
+private:
+    static const char* find(unsigned int codePoint);
+};
+
+#endif // CASE_FOLDING_H
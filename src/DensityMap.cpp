@@ -0,0 +1,129 @@
+// This file is part of Notepad++ project
+// Copyright (C)2023 Thomas Knoefel
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "DensityMap.h"
+
+#include <algorithm>
+#include "ListMatcher.h"
+
+void DensityMap::reset(size_t textSize, size_t entryCount, size_t maxMatchLength) {
+    size_t bucketLength = (textSize + BUCKET_COUNT - 1) / BUCKET_COUNT;
+    if (bucketLength < MIN_BUCKET_LENGTH) {
+        bucketLength = MIN_BUCKET_LENGTH;
+    }
+    size_t buckets = std::max<size_t>(1, (textSize + bucketLength - 1) / bucketLength);
+
+    // A long list gets fewer buckets, so the map stays within MAX_CELLS counts
+    size_t bucketLimit = std::max<size_t>(1, MAX_CELLS / std::max<size_t>(1, entryCount));
+    if (buckets > bucketLimit) {
+        buckets = bucketLimit;
+        bucketLength = (textSize + buckets - 1) / buckets;
+    }
+
+    starts.resize(buckets);
+    for (size_t i = 0; i < buckets; ++i) {
+        starts[i] = std::min(i * bucketLength, textSize);
+    }
+    entries = entryCount;
+    counts.assign(buckets * entries, 0);
+    totals.assign(buckets, 0);
+    entryTotals.assign(entries, 0);
+    textLength = textSize;
+    reach = maxMatchLength + ListMatcher::CONTEXT_LENGTH;
+    edited = false;
+    active = true;
+}
+
+void DensityMap::clear() {
+    starts.clear();
+    counts.clear();
+    counts.shrink_to_fit();
+    totals.clear();
+    entryTotals.clear();
+    entries = 0;
+    textLength = 0;
+    edited = false;
+    active = false;
+}
+
+size_t DensityMap::bucketAt(size_t pos) const {
+    // Buckets emptied by an edit share their start with the next one and are skipped
+    return static_cast<size_t>(std::upper_bound(starts.begin(), starts.end(), pos) - starts.begin()) - 1;
+}
+
+void DensityMap::add(size_t pos, size_t entry) {
+    size_t bucket = bucketAt(pos);
+    counts[bucket * entries + entry]++;
+    totals[bucket]++;
+    entryTotals[entry]++;
+}
+
+void DensityMap::replaced(size_t pos, size_t length, size_t newLength) {
+    if (!active) {
+        return;
+    }
+
+    // Buckets starting in the replaced text start behind the new one, so it belongs to the bucket in front
+    size_t oldEnd = pos + length;
+    for (auto it = std::upper_bound(starts.begin() + 1, starts.end(), pos); it != starts.end(); ++it) {
+        *it = (*it >= oldEnd) ? *it - length + newLength : pos + newLength;
+    }
+
+    // Text edited before moves along; only occurrences seeing the changed text can differ
+    if (edited) {
+        if (editedStart > pos) {
+            editedStart = (editedStart >= oldEnd) ? editedStart - length + newLength : pos;
+        }
+        if (editedEnd > pos) {
+            editedEnd = (editedEnd >= oldEnd) ? editedEnd - length + newLength : pos + newLength;
+        }
+    }
+    size_t start = (pos > reach) ? pos - reach : 0;
+    size_t end = pos + newLength + reach;
+    editedStart = edited ? std::min(editedStart, start) : start;
+    editedEnd = edited ? std::max(editedEnd, end) : end;
+    edited = true;
+    textLength = textLength - length + newLength;
+}
+
+bool DensityMap::takeEdited(size_t& start, size_t& end) {
+    if (!active || !edited) {
+        return false;
+    }
+    edited = false;
+
+    // Buckets emptied by the edits are cleared with the one sharing their start
+    size_t first = bucketAt(editedStart);
+    while (first > 0 && starts[first - 1] == starts[first]) {
+        --first;
+    }
+    size_t last = (editedEnd >= textLength) ? starts.size() - 1 : bucketAt(editedEnd - 1);
+    for (size_t bucket = first; bucket <= last; ++bucket) {
+        clearBucket(bucket);
+    }
+    start = bucketStart(first);
+    end = bucketEnd(last);
+    return true;
+}
+
+void DensityMap::clearBucket(size_t bucket) {
+    size_t* bucketCounts = counts.data() + bucket * entries;
+    for (size_t entry = 0; entry < entries; ++entry) {
+        entryTotals[entry] -= bucketCounts[entry];
+        bucketCounts[entry] = 0;
+    }
+    totals[bucket] = 0;
+}
@@ -0,0 +1,82 @@
+// This file is part of Notepad++ project
+// Copyright (C)2023 Thomas Knoefel
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef DENSITY_MAP_H
+#define DENSITY_MAP_H
+
+// Occurrences of every counted list entry per stretch (bucket) of the document, so the panel can show where
+// they cluster without keeping their positions. The buckets move along with edits; only the ones an edit
+// can have changed are cleared, for the owner to count them again in the current text.
+
+#include <cstddef>
+#include <vector>
+
+class DensityMap
+{
+public:
+    // Buckets of a new map, fewer for short texts or long lists
+    static const size_t BUCKET_COUNT = 1024;
+    static const size_t MIN_BUCKET_LENGTH = 64;
+    // Upper limit for buckets times entries
+    static const size_t MAX_CELLS = 1 << 20;
+
+    // Even buckets over textSize bytes, all counts zero; maxMatchLength is the longest occurrence counted
+    void reset(size_t textSize, size_t entryCount, size_t maxMatchLength);
+    void clear();
+
+    bool isActive() const { return active; }
+    size_t length() const { return textLength; }
+    size_t bucketCount() const { return starts.size(); }
+    size_t bucketStart(size_t bucket) const { return starts[bucket]; }
+    size_t bucketEnd(size_t bucket) const { return (bucket + 1 < starts.size()) ? starts[bucket + 1] : textLength; }
+
+    // The bucket holding pos; the last one for the end of the text
+    size_t bucketAt(size_t pos) const;
+
+    // Occurrences starting in a bucket, of one entry or of all together
+    size_t count(size_t bucket, size_t entry) const { return counts[bucket * entries + entry]; }
+    size_t total(size_t bucket) const { return totals[bucket]; }
+
+    // Occurrences of one entry in the whole text, overlapping ones counted separately
+    size_t entryTotal(size_t entry) const { return (entry < entryTotals.size()) ? entryTotals[entry] : 0; }
+
+    // Counts an occurrence of entry starting at pos
+    void add(size_t pos, size_t entry);
+
+    // Text of length bytes at pos was replaced by newLength bytes. Moves the buckets behind it and notes the
+    // text whose occurrences may have changed.
+    void replaced(size_t pos, size_t length, size_t newLength);
+
+    // Clears the counts of the buckets touched by the edits since the last call and returns the text they
+    // cover, [start, end). The owner adds the occurrences starting there again. False if nothing was edited.
+    bool takeEdited(size_t& start, size_t& end);
+
+private:
+    std::vector<size_t> starts;         // Per bucket, ascending, the first one at 0
+    std::vector<size_t> counts;         // Per bucket and entry
+    std::vector<size_t> totals;         // Per bucket
+    std::vector<size_t> entryTotals;    // Per entry
+    size_t entries = 0;
+    size_t textLength = 0;
+    size_t reach = 0;                   // Bytes around an edit that decide whether an occurrence still matches
+    size_t editedStart = 0;             // Text edited since the last takeEdited(), widened by reach
+    size_t editedEnd = 0;
+    bool edited = false;
+    bool active = false;
+
+    void clearBucket(size_t bucket);
+};
+
+#endif // DENSITY_MAP_H
@@ -0,0 +1,91 @@
+//this file is part of notepad++
+//Copyright (C)2023 Thomas Knoefel
+//
+//This program is free software; you can redistribute it and/or
+//modify it under the terms of the GNU General Public License
+//as published by the Free Software Foundation; either
+//version 2 of the License, or (at your option) any later version.
+//
+//This program is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//GNU General Public License for more details.
+//
+//You should have received a copy of the GNU General Public License
+//along with this program; if not, write to the Free Software
+//Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+#include <windows.h>
+#include "StaticDialog/resource.h"
+#include "ExportMarksDialog.h"
+#include "ProgressDialog.h"
+
+ExportMarksDialog::ExportMarksDialog(HWND owner, HWND panel)
+    : _hOwner(owner), _hPanel(panel)
+{
+}
+
+bool ExportMarksDialog::show(MarkedTextFormat& format, bool& toFile)
+{
+    _format = format;
+    _toFile = toFile;
+
+    INT_PTR result = runModalDialog(_hOwner, _hPanel, IDD_EXPORT_MARKS_DIALOG, dlgProc, reinterpret_cast<LPARAM>(this));
+
+    if (result != IDOK) {
+        return false;
+    }
+    format = _format;
+    toFile = _toFile;
+    return true;
+}
+
+INT_PTR CALLBACK ExportMarksDialog::dlgProc(HWND hwnd, UINT message, WPARAM wParam, LPARAM lParam)
+{
+    ExportMarksDialog* dialog = reinterpret_cast<ExportMarksDialog*>(GetWindowLongPtr(hwnd, GWLP_USERDATA));
+
+    switch (message)
+    {
+    case WM_INITDIALOG:
+    {
+        SetWindowLongPtr(hwnd, GWLP_USERDATA, lParam);
+        dialog = reinterpret_cast<ExportMarksDialog*>(lParam);
+
+        int formatRadio = IDC_EXPORT_LINES_RADIO;
+        if (dialog->_format == MarkedTextFormat::Positions) {
+            formatRadio = IDC_EXPORT_POSITIONS_RADIO;
+        }
+        else if (dialog->_format == MarkedTextFormat::Csv) {
+            formatRadio = IDC_EXPORT_CSV_RADIO;
+        }
+        CheckRadioButton(hwnd, IDC_EXPORT_LINES_RADIO, IDC_EXPORT_CSV_RADIO, formatRadio);
+        CheckRadioButton(hwnd, IDC_EXPORT_FILE_RADIO, IDC_EXPORT_CLIPBOARD_RADIO, dialog->_toFile ? IDC_EXPORT_FILE_RADIO : IDC_EXPORT_CLIPBOARD_RADIO);
+        return TRUE;
+    }
+
+    case WM_COMMAND:
+        switch (LOWORD(wParam))
+        {
+        case IDOK:
+            if (IsDlgButtonChecked(hwnd, IDC_EXPORT_POSITIONS_RADIO) == BST_CHECKED) {
+                dialog->_format = MarkedTextFormat::Positions;
+            }
+            else if (IsDlgButtonChecked(hwnd, IDC_EXPORT_CSV_RADIO) == BST_CHECKED) {
+                dialog->_format = MarkedTextFormat::Csv;
+            }
+            else {
+                dialog->_format = MarkedTextFormat::Lines;
+            }
+            dialog->_toFile = (IsDlgButtonChecked(hwnd, IDC_EXPORT_FILE_RADIO) == BST_CHECKED);
+            EndDialog(hwnd, IDOK);
+            return TRUE;
+
+        case IDCANCEL:
+            EndDialog(hwnd, IDCANCEL);
+            return TRUE;
+        }
+        break;
+    }
+
+    return FALSE;
+}
@@ -0,0 +1,40 @@
+//this file is part of notepad++
+//Copyright (C)2023 Thomas Knoefel
+//
+//This program is free software; you can redistribute it and/or
+//modify it under the terms of the GNU General Public License
+//as published by the Free Software Foundation; either
+//version 2 of the License, or (at your option) any later version.
+//
+//This program is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//GNU General Public License for more details.
+//
+//You should have received a copy of the GNU General Public License
+//along with this program; if not, write to the Free Software
+//Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+#pragma once
+
+#include <windows.h>
+#include "MarkedTextWriter.h"
+extern HINSTANCE hInst;
+
+// Modal choice of format and destination for Export Marked Text
+class ExportMarksDialog
+{
+public:
+    ExportMarksDialog(HWND owner, HWND panel);
+
+    // Shows the dialog with format and toFile preselected, and returns them as chosen unless it was cancelled
+    bool show(MarkedTextFormat& format, bool& toFile);
+
+private:
+    HWND _hOwner;
+    HWND _hPanel;
+    MarkedTextFormat _format = MarkedTextFormat::Lines;
+    bool _toFile = true;
+
+    static INT_PTR CALLBACK dlgProc(HWND hwnd, UINT message, WPARAM wParam, LPARAM lParam);
+};
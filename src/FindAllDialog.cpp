@@ -0,0 +1,176 @@
+//this file is part of notepad++
+//Copyright (C)2023 Thomas Knoefel
+//
+//This program is free software; you can redistribute it and/or
+//modify it under the terms of the GNU General Public License
+//as published by the Free Software Foundation; either
+//version 2 of the License, or (at your option) any later version.
+//
+//This program is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//GNU General Public License for more details.
+//
+//You should have received a copy of the GNU General Public License
+//along with this program; if not, write to the Free Software
+//Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+#include <windows.h>
+#include <commctrl.h>
+#include <algorithm>
+#include <climits>
+#include "StaticDialog/resource.h"
+#include "FindAllDialog.h"
+#include "ProgressDialog.h"
+
+static const size_t FIND_ALL_CONTEXT_BEFORE = 60;   // Bytes of the line shown in front of an occurrence
+static const size_t FIND_ALL_CONTEXT_AFTER = 240;   // Bytes shown from the start of an occurrence on
+
+FindAllDialog::FindAllDialog(HWND owner, HWND panel, const FindAllResults& results, const char* text, size_t textLength, int codepage,
+    const std::vector<std::wstring>& entryNames, std::function<void(size_t, size_t)> showMatch)
+    : _hOwner(owner), _hPanel(panel), _results(results), _text(text), _textLength(textLength), _codepage(codepage),
+    _entryNames(entryNames), _showMatch(std::move(showMatch))
+{
+}
+
+void FindAllDialog::show(const std::wstring& summary)
+{
+    _summary = summary;
+
+    runModalDialog(_hOwner, _hPanel, IDD_FINDALL_DIALOG, dlgProc, reinterpret_cast<LPARAM>(this));
+}
+
+INT_PTR CALLBACK FindAllDialog::dlgProc(HWND hwnd, UINT message, WPARAM wParam, LPARAM lParam)
+{
+    FindAllDialog* dialog = reinterpret_cast<FindAllDialog*>(GetWindowLongPtr(hwnd, GWLP_USERDATA));
+
+    switch (message)
+    {
+    case WM_INITDIALOG:
+    {
+        SetWindowLongPtr(hwnd, GWLP_USERDATA, lParam);
+        dialog = reinterpret_cast<FindAllDialog*>(lParam);
+        SetDlgItemText(hwnd, IDC_FINDALL_SUMMARY_STATIC, dialog->_summary.c_str());
+        dialog->initList(hwnd);
+        return TRUE;
+    }
+
+    case WM_NOTIFY:
+    {
+        NMHDR* header = reinterpret_cast<NMHDR*>(lParam);
+        if (header->idFrom != IDC_FINDALL_LIST) {
+            break;
+        }
+
+        switch (header->code)
+        {
+        case LVN_GETDISPINFO:
+        {
+            // Cells are built when the list paints them
+            NMLVDISPINFO* plvdi = reinterpret_cast<NMLVDISPINFO*>(lParam);
+            if ((plvdi->item.mask & LVIF_TEXT) && plvdi->item.iItem >= 0 && static_cast<size_t>(plvdi->item.iItem) < dialog->_results.size()) {
+                std::wstring text = dialog->cellText(static_cast<size_t>(plvdi->item.iItem), plvdi->item.iSubItem);
+                lstrcpynW(plvdi->item.pszText, text.c_str(), plvdi->item.cchTextMax);
+            }
+            return TRUE;
+        }
+
+        case LVN_ITEMCHANGED:
+        {
+            // Arrow keys and clicks walk through the occurrences in the document
+            NMLISTVIEW* pnmv = reinterpret_cast<NMLISTVIEW*>(lParam);
+            if (pnmv->iItem >= 0 && (pnmv->uChanged & LVIF_STATE) && (pnmv->uNewState & LVIS_SELECTED) && !(pnmv->uOldState & LVIS_SELECTED)) {
+                const FindAllHit& hit = dialog->_results.hit(static_cast<size_t>(pnmv->iItem));
+                dialog->_showMatch(hit.pos, hit.length);
+            }
+            return TRUE;
+        }
+        }
+        break;
+    }
+
+    case WM_COMMAND:
+        switch (LOWORD(wParam))
+        {
+        case IDOK:
+        case IDCANCEL:
+            EndDialog(hwnd, LOWORD(wParam));
+            return TRUE;
+        }
+        break;
+    }
+
+    return FALSE;
+}
+
+void FindAllDialog::initList(HWND hwnd)
+{
+    HWND list = GetDlgItem(hwnd, IDC_FINDALL_LIST);
+    ListView_SetExtendedListViewStyle(list, LVS_EX_FULLROWSELECT | LVS_EX_GRIDLINES);
+
+    struct ColumnInfo { const wchar_t* title; int width; int format; };
+    const ColumnInfo columns[] = {
+        { L"Line", 60, LVCFMT_RIGHT },
+        { L"Column", 55, LVCFMT_RIGHT },
+        { L"Entry", 150, LVCFMT_LEFT },
+        { L"Text", 470, LVCFMT_LEFT },
+    };
+
+    LVCOLUMN lvc = {};
+    lvc.mask = LVCF_TEXT | LVCF_WIDTH | LVCF_FMT | LVCF_SUBITEM;
+    for (int i = 0; i < static_cast<int>(sizeof(columns) / sizeof(columns[0])); ++i) {
+        lvc.iSubItem = i;
+        lvc.pszText = const_cast<LPWSTR>(columns[i].title);
+        lvc.cx = columns[i].width;
+        lvc.fmt = columns[i].format;
+        ListView_InsertColumn(list, i, &lvc);
+    }
+
+    // Only the count is handed over, the list keeps no rows of its own
+    size_t rowCount = std::min<size_t>(_results.size(), INT_MAX);
+    ListView_SetItemCountEx(list, static_cast<int>(rowCount), LVSICF_NOINVALIDATEALL);
+}
+
+std::wstring FindAllDialog::cellText(size_t row, int column) const
+{
+    const FindAllHit& hit = _results.hit(row);
+    switch (column)
+    {
+    case 0:
+        return std::to_wstring(hit.line + 1);
+    case 1:
+        return std::to_wstring(hit.column + 1);
+    case 2:
+        return (hit.entry < _entryNames.size()) ? _entryNames[hit.entry] : std::wstring();
+    case 3:
+    {
+        bool cutBefore = false;
+        bool cutAfter = false;
+        std::string context = _results.context(_text, _textLength, row, FIND_ALL_CONTEXT_BEFORE, FIND_ALL_CONTEXT_AFTER, cutBefore, cutAfter);
+        return (cutBefore ? L"..." : L"") + toDisplayText(context) + (cutAfter ? L"..." : L"");
+    }
+    }
+    return std::wstring();
+}
+
+std::wstring FindAllDialog::toDisplayText(const std::string& text) const
+{
+    int codepage = (_codepage == 0) ? CP_ACP : _codepage;
+    std::wstring result;
+    int length = MultiByteToWideChar(codepage, 0, text.data(), static_cast<int>(text.size()), NULL, 0);
+    if (length > 0) {
+        result.resize(static_cast<size_t>(length));
+        MultiByteToWideChar(codepage, 0, text.data(), static_cast<int>(text.size()), &result[0], length);
+    }
+
+    // Line breaks inside an occurrence are shown as a symbol, tabs as a space
+    for (wchar_t& ch : result) {
+        if (ch == L'\n') {
+            ch = L'\u21B5';
+        }
+        else if (ch == L'\r' || ch == L'\t') {
+            ch = L' ';
+        }
+    }
+    return result;
+}
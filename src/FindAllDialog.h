@@ -0,0 +1,54 @@
+//this file is part of notepad++
+//Copyright (C)2023 Thomas Knoefel
+//
+//This program is free software; you can redistribute it and/or
+//modify it under the terms of the GNU General Public License
+//as published by the Free Software Foundation; either
+//version 2 of the License, or (at your option) any later version.
+//
+//This program is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//GNU General Public License for more details.
+//
+//You should have received a copy of the GNU General Public License
+//along with this program; if not, write to the Free Software
+//Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+#pragma once
+
+#include <windows.h>
+#include <functional>
+#include <string>
+#include <vector>
+#include "FindAllResults.h"
+extern HINSTANCE hInst;
+
+// Modal list of all occurrences of a Find All run. The rows are virtual: the list asks for the cells it
+// paints, so a row costs no memory before it is shown. Selecting a row shows the occurrence in the document;
+// Notepad++ and the panel are disabled meanwhile, so the document stays as it was searched.
+class FindAllDialog
+{
+public:
+    FindAllDialog(HWND owner, HWND panel, const FindAllResults& results, const char* text, size_t textLength, int codepage,
+        const std::vector<std::wstring>& entryNames, std::function<void(size_t, size_t)> showMatch);
+
+    void show(const std::wstring& summary);
+
+private:
+    HWND _hOwner;
+    HWND _hPanel;
+    const FindAllResults& _results;
+    const char* _text;
+    size_t _textLength;
+    int _codepage;
+    const std::vector<std::wstring>& _entryNames;   // By entry number of the results
+    std::function<void(size_t, size_t)> _showMatch;
+    std::wstring _summary;
+
+    void initList(HWND hwnd);
+    std::wstring cellText(size_t row, int column) const;
+    std::wstring toDisplayText(const std::string& text) const;
+
+    static INT_PTR CALLBACK dlgProc(HWND hwnd, UINT message, WPARAM wParam, LPARAM lParam);
+};
@@ -0,0 +1,152 @@
+// This file is part of Notepad++ project
+// Copyright (C)2023 Thomas Knoefel
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "FindAllResults.h"
+
+#include <algorithm>
+#include <thread>
+
+void FindAllResults::assign(std::vector<ListMatch> matches, const char* text, size_t textLength, bool utf8Text,
+    size_t threadCount, size_t minChunkLength) {
+    std::sort(matches.begin(), matches.end(), [](const ListMatch& a, const ListMatch& b) {
+        return a.pos != b.pos ? a.pos < b.pos : a.pattern < b.pattern;
+        });
+
+    utf8 = utf8Text;
+    hits.clear();
+    hits.shrink_to_fit();
+    hits.reserve(matches.size());
+    std::vector<bool> seen;
+    entries = 0;
+    for (const ListMatch& match : matches) {
+        FindAllHit hit;
+        hit.pos = match.pos;
+        hit.length = match.length;
+        hit.entry = match.pattern;
+        hits.push_back(hit);
+
+        if (match.pattern >= seen.size()) {
+            seen.resize(match.pattern + 1, false);
+        }
+        if (!seen[match.pattern]) {
+            seen[match.pattern] = true;
+            ++entries;
+        }
+    }
+    if (hits.empty()) {
+        return;
+    }
+
+    // Every chunk counts from its own start; the lines and columns in front of it are added afterwards
+    size_t chunkCount = std::max<size_t>(1, std::min(threadCount, textLength / std::max<size_t>(minChunkLength, 1)));
+    size_t chunkLength = (textLength + chunkCount - 1) / chunkCount;
+    std::vector<ChunkCount> counts(chunkCount);
+    std::vector<size_t> firstHits(chunkCount + 1, hits.size());
+    for (size_t chunk = 0; chunk < chunkCount; ++chunk) {
+        size_t chunkStart = std::min(chunk * chunkLength, textLength);
+        firstHits[chunk] = static_cast<size_t>(std::lower_bound(hits.begin(), hits.end(), chunkStart,
+            [](const FindAllHit& hit, size_t pos) { return hit.pos < pos; }) - hits.begin());
+    }
+
+    auto countChunk = [this, text, textLength, chunkLength, &counts, &firstHits](size_t chunk) {
+        size_t pos = std::min(chunk * chunkLength, textLength);
+        size_t chunkEnd = std::min(pos + chunkLength, textLength);
+        ChunkCount& count = counts[chunk];
+        auto countTo = [&](size_t end) {
+            for (; pos < end; ++pos) {
+                unsigned char ch = static_cast<unsigned char>(text[pos]);
+                // A CR ends the line unless the LF of a CRLF follows
+                if (ch == '\n' || (ch == '\r' && (pos + 1 >= textLength || text[pos + 1] != '\n'))) {
+                    ++count.lines;
+                    count.columns = 0;
+                }
+                else if (!utf8 || (ch & 0xC0) != 0x80) {
+                    ++count.columns;
+                }
+            }
+        };
+
+        for (size_t i = firstHits[chunk]; i < firstHits[chunk + 1]; ++i) {
+            FindAllHit& hit = hits[i];
+            countTo(hit.pos);
+            hit.line = count.lines;
+            hit.column = count.columns;
+        }
+        countTo(chunkEnd);
+    };
+
+    if (chunkCount < 2) {
+        countChunk(0);
+    }
+    else {
+        std::vector<std::thread> workers;
+        workers.reserve(chunkCount);
+        for (size_t chunk = 0; chunk < chunkCount; ++chunk) {
+            workers.emplace_back(countChunk, chunk);
+        }
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+    }
+
+    size_t linesBefore = 0;
+    size_t columnsBefore = 0;
+    for (size_t chunk = 0; chunk < chunkCount; ++chunk) {
+        for (size_t i = firstHits[chunk]; i < firstHits[chunk + 1]; ++i) {
+            FindAllHit& hit = hits[i];
+            if (hit.line == 0) {
+                hit.column += columnsBefore;
+            }
+            hit.line += linesBefore;
+        }
+        columnsBefore = (counts[chunk].lines > 0) ? counts[chunk].columns : columnsBefore + counts[chunk].columns;
+        linesBefore += counts[chunk].lines;
+    }
+}
+
+std::string FindAllResults::context(const char* text, size_t textLength, size_t index, size_t maxBefore, size_t maxAfter,
+    bool& cutBefore, bool& cutAfter) const {
+    const FindAllHit& hit = hits[index];
+    size_t pos = std::min(hit.pos, textLength);
+
+    size_t start = pos;
+    size_t limit = (pos > maxBefore) ? pos - maxBefore : 0;
+    while (start > limit && text[start - 1] != '\n' && text[start - 1] != '\r') {
+        --start;
+    }
+    cutBefore = (start == limit && start > 0 && text[start - 1] != '\n' && text[start - 1] != '\r');
+
+    // An occurrence over several lines is shown up to the end of its last line
+    size_t end = std::min(pos + hit.length, textLength);
+    limit = std::min(pos + maxAfter, textLength);
+    end = std::min(end, limit);
+    while (end < limit && text[end] != '\n' && text[end] != '\r') {
+        ++end;
+    }
+    cutAfter = (end == limit && end < textLength && text[end] != '\n' && text[end] != '\r');
+
+    while (cutBefore && start < pos && !isCharacterStart(text, start)) {
+        ++start;
+    }
+    while (cutAfter && end > pos && !isCharacterStart(text, end)) {
+        --end;
+    }
+    return std::string(text + start, end - start);
+}
+
+bool FindAllResults::isCharacterStart(const char* text, size_t pos) const {
+    return !utf8 || (static_cast<unsigned char>(text[pos]) & 0xC0) != 0x80;
+}
@@ -0,0 +1,69 @@
+// This file is part of Notepad++ project
+// Copyright (C)2023 Thomas Knoefel
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef FIND_ALL_RESULTS_H
+#define FIND_ALL_RESULTS_H
+
+// Every occurrence of a Find All run with its line and column, ordered by position.
+// Only positions are kept per occurrence; the text around one is read from the unchanged document when it is shown.
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "ListMatcher.h"
+
+struct FindAllHit {
+    size_t pos = 0;
+    size_t length = 0;
+    size_t entry = 0;       // Caller's entry number, the list row
+    size_t line = 0;        // Zero based
+    size_t column = 0;      // Zero based, in characters
+};
+
+class FindAllResults
+{
+public:
+    // Takes the occurrences with pattern set to the entry number and computes lines and columns,
+    // split into chunks of at least minChunkLength bytes counted by up to threadCount threads.
+    // The text must not change until the call returns.
+    void assign(std::vector<ListMatch> matches, const char* text, size_t textLength, bool utf8,
+        size_t threadCount, size_t minChunkLength);
+
+    size_t size() const { return hits.size(); }
+    const FindAllHit& hit(size_t index) const { return hits[index]; }
+
+    // Entries with at least one occurrence
+    size_t entryCount() const { return entries; }
+
+    // The line of an occurrence from at most maxBefore bytes in front of it to at most maxAfter bytes behind
+    // its start, cut at character starts. cutBefore and cutAfter are set if the line goes on.
+    std::string context(const char* text, size_t textLength, size_t index, size_t maxBefore, size_t maxAfter,
+        bool& cutBefore, bool& cutAfter) const;
+
+private:
+    // Line breaks in a chunk of the text and the characters behind the last one, or all of them without one
+    struct ChunkCount {
+        size_t lines = 0;
+        size_t columns = 0;
+    };
+
+    std::vector<FindAllHit> hits;
+    size_t entries = 0;
+    bool utf8 = false;
+
+    bool isCharacterStart(const char* text, size_t pos) const;
+};
+
+#endif // FIND_ALL_RESULTS_H
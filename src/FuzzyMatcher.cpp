@@ -0,0 +1,457 @@
+// This file is part of Notepad++ project
+// Copyright (C)2023 Thomas Knoefel
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "FuzzyMatcher.h"
+#include "CaseFolding.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <thread>
+
+static const size_t MIN_PIECE_LENGTH = 3;           // Shorter pieces hit too often to save any comparing
+static const size_t FIRST_CHUNK_LENGTH = 1 << 16;   // findFirst() searches pieces in doubling chunks from here
+static const uint64_t HIGH_BIT = uint64_t(1) << 63;
+
+static unsigned char foldAscii(unsigned char c) {
+    return (c >= 'A' && c <= 'Z') ? static_cast<unsigned char>(c + 32) : c;
+}
+
+static bool isContinuationByte(char c) {
+    return (static_cast<unsigned char>(c) & 0xC0) == 0x80;
+}
+
+// One 64 character block of Myers' algorithm (in Hyyro's block form): hin is the change of the edit distance
+// in the row above the block, the return value the change in its last row
+static int advanceBlock(uint64_t& pv, uint64_t& mv, uint64_t eq, uint64_t highBit, int hin) {
+    uint64_t xv = eq | mv;
+    if (hin < 0) {
+        eq |= 1;
+    }
+    uint64_t xh = (((eq & pv) + pv) ^ pv) | eq;
+    uint64_t ph = mv | ~(xh | pv);
+    uint64_t mh = pv & xh;
+    int hout = (ph & highBit) ? 1 : ((mh & highBit) ? -1 : 0);
+    ph <<= 1;
+    mh <<= 1;
+    if (hin < 0) {
+        mh |= 1;
+    }
+    else if (hin > 0) {
+        ph |= 1;
+    }
+    pv = mh | ~(xv | ph);
+    mv = ph & xv;
+    return hout;
+}
+
+void FuzzyMatcher::build(const std::vector<FuzzyPattern>& patterns, bool utf8) {
+    isUtf8 = utf8;
+    entries.clear();
+    pieces.clear();
+
+    std::vector<ListPattern> pieceTexts;
+    for (const FuzzyPattern& source : patterns) {
+        Entry entry;
+        entry.matchCase = source.matchCase;
+
+        std::vector<std::string> keys;
+        std::vector<size_t> charStarts;
+        for (size_t pos = 0; pos < source.findText.size();) {
+            charStarts.push_back(pos);
+            std::string key;
+            pos += characterKey(source.findText, pos, source.matchCase, key);
+            keys.push_back(key);
+        }
+        charStarts.push_back(source.findText.size());
+
+        entry.length = keys.size();
+        entry.distance = std::min(source.distance, entry.length > 0 ? entry.length - 1 : 0);
+        if (entry.length > 0) {
+            buildBitPattern(keys, entry.forward);
+            std::reverse(keys.begin(), keys.end());
+            buildBitPattern(keys, entry.backward);
+        }
+
+        // Pieces of (nearly) equal character count; an entry with a too short piece is compared everywhere
+        size_t pieceCount = entry.distance + 1;
+        entry.filtered = (entry.length > 0);
+        for (size_t i = 0; i < pieceCount && entry.filtered; ++i) {
+            size_t first = i * entry.length / pieceCount;
+            size_t last = (i + 1) * entry.length / pieceCount;
+            entry.filtered = (charStarts[last] - charStarts[first] >= MIN_PIECE_LENGTH);
+        }
+        if (entry.filtered) {
+            size_t width = isUtf8 ? 4 : 1;
+            for (size_t i = 0; i < pieceCount; ++i) {
+                size_t first = i * entry.length / pieceCount;
+                size_t last = (i + 1) * entry.length / pieceCount;
+                Piece piece;
+                piece.entry = entries.size();
+                piece.charsBefore = first;
+                piece.charsAfter = entry.length - last;
+                pieces.push_back(piece);
+                pieceTexts.push_back({ source.findText.substr(charStarts[first], charStarts[last] - charStarts[first]), false, source.matchCase });
+                entry.reach = std::max(entry.reach, (first + entry.distance) * width);
+            }
+        }
+        entries.push_back(std::move(entry));
+    }
+
+    // Pieces are never whole words, only the encoding matters for them
+    CharClass classes[256];
+    std::fill(classes, classes + 256, CharClass::Word);
+    pieceMatcher = ListMatcher();
+    pieceMatcher.setCharClasses(classes, utf8);
+    pieceMatcher.build(pieceTexts);
+}
+
+size_t FuzzyMatcher::characterKey(const std::string& text, size_t pos, bool matchCase, std::string& key) const {
+    // Single bytes and characters folding to one byte share the byte table, see lookup()
+    unsigned char lead = static_cast<unsigned char>(text[pos]);
+    if (lead < 0x80 || !isUtf8) {
+        key.assign(1, static_cast<char>(matchCase ? lead : foldAscii(lead)));
+        return 1;
+    }
+    if (matchCase) {
+        unsigned int codePoint = 0;
+        size_t width = CaseFolding::decode(text.data(), text.size(), pos, codePoint);
+        key.assign(text, pos, width);
+        return width;
+    }
+    const char* folded = nullptr;
+    size_t foldedLength = 0;
+    size_t width = CaseFolding::foldCharacter(text.data(), text.size(), pos, folded, foldedLength);
+    key.assign(folded, foldedLength);
+    return width;
+}
+
+void FuzzyMatcher::buildBitPattern(const std::vector<std::string>& keys, BitPattern& bits) const {
+    bits.blocks = (keys.size() + 63) / 64;
+    bits.lastBit = uint64_t(1) << ((keys.size() - 1) % 64);
+    bits.byteEq.assign(256 * bits.blocks, 0);
+    bits.noEq.assign(bits.blocks, 0);
+
+    bits.keys.clear();
+    for (const std::string& key : keys) {
+        if (key.size() > 1) {
+            bits.keys.push_back(key);
+        }
+    }
+    std::sort(bits.keys.begin(), bits.keys.end());
+    bits.keys.erase(std::unique(bits.keys.begin(), bits.keys.end()), bits.keys.end());
+    bits.keyEq.assign(bits.keys.size() * bits.blocks, 0);
+
+    for (size_t i = 0; i < keys.size(); ++i) {
+        uint64_t* eq = nullptr;
+        if (keys[i].size() == 1) {
+            eq = &bits.byteEq[static_cast<unsigned char>(keys[i][0]) * bits.blocks];
+        }
+        else {
+            size_t index = static_cast<size_t>(std::lower_bound(bits.keys.begin(), bits.keys.end(), keys[i]) - bits.keys.begin());
+            eq = &bits.keyEq[index * bits.blocks];
+        }
+        eq[i / 64] |= uint64_t(1) << (i % 64);
+    }
+}
+
+const uint64_t* FuzzyMatcher::lookupCharacter(const BitPattern& bits, bool matchCase, const char* text, size_t textLength, size_t pos, size_t& width) const {
+    const char* key = text + pos;
+    size_t keyLength = 0;
+    if (matchCase) {
+        unsigned int codePoint = 0;
+        width = CaseFolding::decode(text, textLength, pos, codePoint);
+        keyLength = width;
+    }
+    else {
+        width = CaseFolding::foldCharacter(text, textLength, pos, key, keyLength);
+    }
+    if (keyLength == 1) {
+        return &bits.byteEq[static_cast<unsigned char>(key[0]) * bits.blocks];
+    }
+
+    auto it = std::lower_bound(bits.keys.begin(), bits.keys.end(), key, [keyLength](const std::string& a, const char* b) {
+        return a.compare(0, a.size(), b, keyLength) < 0;
+        });
+    if (it != bits.keys.end() && it->size() == keyLength && std::memcmp(it->data(), key, keyLength) == 0) {
+        return &bits.keyEq[static_cast<size_t>(it - bits.keys.begin()) * bits.blocks];
+    }
+    return bits.noEq.data();
+}
+
+size_t FuzzyMatcher::advance(const BitPattern& bits, uint64_t* pv, uint64_t* mv, const uint64_t* eq, bool anchored, size_t score) {
+    // A search may start anywhere; an anchored comparison pays for every character it skips at its start
+    int carry = anchored ? 1 : 0;
+    for (size_t block = 0; block < bits.blocks; ++block) {
+        uint64_t highBit = (block + 1 == bits.blocks) ? bits.lastBit : HIGH_BIT;
+        carry = advanceBlock(pv[block], mv[block], eq[block], highBit, carry);
+    }
+    return (carry < 0) ? score - 1 : score + static_cast<size_t>(carry);
+}
+
+void FuzzyMatcher::findAll(const char* text, size_t textLength, size_t rangeStart, size_t rangeEnd, std::vector<ListMatch>& matches) const {
+    findAllParallel(text, textLength, rangeStart, rangeEnd, 1, 0, matches);
+}
+
+void FuzzyMatcher::findAllParallel(const char* text, size_t textLength, size_t rangeStart, size_t rangeEnd,
+    size_t threadCount, size_t minChunkLength, std::vector<ListMatch>& matches) const {
+    if (entries.empty() || rangeStart >= rangeEnd) {
+        return;
+    }
+
+    std::vector<ListMatch> hits;
+    if (!pieceMatcher.empty()) {
+        pieceMatcher.findAllParallel(text, textLength, rangeStart, rangeEnd, threadCount, std::max<size_t>(minChunkLength, 1), hits);
+    }
+    std::vector<std::vector<Region>> regions(entries.size());
+    addRegions(hits, text, rangeStart, rangeEnd, entries.size(), regions);
+    hits.clear();
+    hits.shrink_to_fit();
+
+    // Entries are compared independently, one thread takes the next entry
+    std::vector<std::vector<ListMatch>> found(entries.size());
+    std::atomic<size_t> nextEntry(0);
+    auto compare = [&]() {
+        Scratch scratch;
+        for (size_t index = nextEntry++; index < entries.size(); index = nextEntry++) {
+            for (const Region& region : regions[index]) {
+                scanRegion(index, text, textLength, region, false, scratch, found[index]);
+            }
+        }
+    };
+
+    size_t workerCount = (minChunkLength > 0 && rangeEnd - rangeStart >= minChunkLength) ? std::min(threadCount, entries.size()) : 1;
+    std::vector<std::thread> workers;
+    for (size_t i = 1; i < workerCount; ++i) {
+        workers.emplace_back(compare);
+    }
+    compare();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+
+    for (const std::vector<ListMatch>& entryMatches : found) {
+        matches.insert(matches.end(), entryMatches.begin(), entryMatches.end());
+    }
+}
+
+bool FuzzyMatcher::findFirst(const char* text, size_t textLength, size_t rangeStart, size_t rangeEnd, size_t pattern, ListMatch& match) const {
+    if (pattern >= entries.size() || rangeStart >= rangeEnd) {
+        return false;
+    }
+
+    Scratch scratch;
+    std::vector<ListMatch> found;
+    const Entry& entry = entries[pattern];
+    if (!entry.filtered) {
+        scanRegion(pattern, text, textLength, { rangeStart, rangeEnd }, true, scratch, found);
+    }
+
+    // Pieces are searched in growing chunks. A region is final once no hit behind the chunk can reach it;
+    // regions compared in an earlier round are not compared again.
+    size_t chunkLength = FIRST_CHUNK_LENGTH;
+    size_t compared = rangeStart;
+    while (entry.filtered && found.empty()) {
+        size_t limit = (rangeEnd - rangeStart > chunkLength) ? rangeStart + chunkLength : rangeEnd;
+        std::vector<ListMatch> hits;
+        pieceMatcher.findAll(text, textLength, rangeStart, limit, hits);
+        std::vector<std::vector<Region>> regions(entries.size());
+        addRegions(hits, text, rangeStart, limit, pattern, regions);
+
+        size_t margin = pieceMatcher.maxPatternLength() + entry.reach;
+        size_t finalEnd = (limit == rangeEnd) ? rangeEnd : (limit - rangeStart > margin ? limit - margin : rangeStart);
+        for (const Region& region : regions[pattern]) {
+            if (limit != rangeEnd && region.end >= finalEnd) {
+                break;
+            }
+            if (region.end > compared && scanRegion(pattern, text, textLength, region, true, scratch, found)) {
+                break;
+            }
+            compared = region.end;
+        }
+        if (limit == rangeEnd) {
+            break;
+        }
+        chunkLength *= 2;
+    }
+
+    if (found.empty()) {
+        return false;
+    }
+    match = found.front();
+    return true;
+}
+
+void FuzzyMatcher::addRegions(const std::vector<ListMatch>& hits, const char* text, size_t rangeStart, size_t rangeEnd,
+    size_t onlyEntry, std::vector<std::vector<Region>>& regions) const {
+    // Every hit spans the text an occurrence around the unchanged piece can cover
+    size_t width = isUtf8 ? 4 : 1;
+    for (const ListMatch& hit : hits) {
+        const Piece& piece = pieces[hit.pattern];
+        if (onlyEntry < entries.size() && piece.entry != onlyEntry) {
+            continue;
+        }
+        const Entry& entry = entries[piece.entry];
+        size_t before = (piece.charsBefore + entry.distance) * width;
+        size_t after = (piece.charsAfter + entry.distance) * width;
+        size_t hitEnd = hit.pos + hit.length;
+
+        Region region;
+        region.start = (hit.pos - rangeStart > before) ? hit.pos - before : rangeStart;
+        region.end = (rangeEnd - hitEnd > after) ? hitEnd + after : rangeEnd;
+        while (isUtf8 && region.start > rangeStart && isContinuationByte(text[region.start])) {
+            --region.start;
+        }
+        while (isUtf8 && region.end < rangeEnd && isContinuationByte(text[region.end])) {
+            ++region.end;
+        }
+        regions[piece.entry].push_back(region);
+    }
+
+    // Overlapping or touching spans are compared as one, so each region starts where no occurrence can cross
+    for (size_t index = 0; index < entries.size(); ++index) {
+        std::vector<Region>& list = regions[index];
+        if (!entries[index].filtered) {
+            if (onlyEntry >= entries.size() && entries[index].length > 0) {
+                list.assign(1, { rangeStart, rangeEnd });
+            }
+            continue;
+        }
+        std::sort(list.begin(), list.end(), [](const Region& a, const Region& b) { return a.start < b.start; });
+        size_t merged = 0;
+        for (size_t i = 0; i < list.size(); ++i) {
+            if (merged > 0 && list[i].start <= list[merged - 1].end) {
+                list[merged - 1].end = std::max(list[merged - 1].end, list[i].end);
+            }
+            else {
+                list[merged++] = list[i];
+            }
+        }
+        list.resize(merged);
+    }
+}
+
+bool FuzzyMatcher::scanRegion(size_t index, const char* text, size_t textLength, Region region, bool firstOnly,
+    Scratch& scratch, std::vector<ListMatch>& matches) const {
+    const Entry& entry = entries[index];
+    const BitPattern& bits = entry.forward;
+    size_t length = entry.length;
+    size_t distance = entry.distance;
+    if (length == 0) {
+        return false;
+    }
+
+    // Candidate ends run up to one entry length behind the first; each needs the last length + distance character starts
+    scratch.pv.resize(bits.blocks);
+    scratch.mv.resize(bits.blocks);
+    size_t ringSize = 1;
+    while (ringSize < 2 * length + distance + 2) {
+        ringSize *= 2;
+    }
+    scratch.ring.resize(ringSize);
+
+    bool found = false;
+    size_t pos = region.start;
+    while (pos < region.end) {
+        std::fill(scratch.pv.begin(), scratch.pv.end(), ~uint64_t(0));
+        std::fill(scratch.mv.begin(), scratch.mv.end(), uint64_t(0));
+        scratch.candidates.clear();
+        size_t score = length;
+        size_t chars = 0;
+        size_t runLimit = 0;
+
+        // The first end within the distance, and the ends behind it that stay within
+        while (pos < region.end) {
+            size_t width = 0;
+            const uint64_t* eq = lookup(bits, entry.matchCase, text, textLength, pos, width);
+            if (width > region.end - pos) {
+                break;
+            }
+            scratch.ring[chars & (ringSize - 1)] = pos;
+            score = advance(bits, scratch.pv.data(), scratch.mv.data(), eq, false, score);
+            pos += width;
+            ++chars;
+
+            if (score <= distance) {
+                if (scratch.candidates.empty()) {
+                    runLimit = chars + length;
+                }
+                scratch.candidates.push_back({ pos, chars, score });
+                if (chars >= runLimit) {
+                    break;
+                }
+            }
+            else if (!scratch.candidates.empty()) {
+                break;
+            }
+        }
+        if (scratch.candidates.empty()) {
+            break;
+        }
+
+        // Fewest edits, then the earliest start, then the longest occurrence
+        size_t best = length;
+        for (const Candidate& candidate : scratch.candidates) {
+            best = std::min(best, candidate.score);
+        }
+        ListMatch match;
+        match.pattern = index;
+        bool chosen = false;
+        for (size_t i = 0; i < scratch.candidates.size(); ++i) {
+            const Candidate candidate = scratch.candidates[i];
+            if (candidate.score != best) {
+                continue;
+            }
+            size_t start = findStart(entry, text, textLength, candidate, scratch);
+            if (!chosen || start <= match.pos) {
+                match.pos = start;
+                match.length = candidate.end - start;
+                chosen = true;
+            }
+        }
+        matches.push_back(match);
+        found = true;
+        if (firstOnly) {
+            break;
+        }
+        pos = match.pos + match.length;
+    }
+    return found;
+}
+
+size_t FuzzyMatcher::findStart(const Entry& entry, const char* text, size_t textLength, const Candidate& candidate, Scratch& scratch) const {
+    // The reversed entry compared backwards from the end; every character left out at the end costs an edit
+    const BitPattern& bits = entry.backward;
+    size_t ringMask = scratch.ring.size() - 1;
+    scratch.backPv.assign(bits.blocks, ~uint64_t(0));
+    scratch.backMv.assign(bits.blocks, 0);
+
+    size_t score = entry.length;
+    size_t bestScore = entry.length + 1;
+    size_t bestStart = candidate.end;
+    size_t first = (candidate.chars > entry.length + entry.distance) ? candidate.chars - entry.length - entry.distance : 0;
+    for (size_t chars = candidate.chars; chars > first; --chars) {
+        size_t start = scratch.ring[(chars - 1) & ringMask];
+        size_t width = 0;
+        const uint64_t* eq = lookup(bits, entry.matchCase, text, textLength, start, width);
+        score = advance(bits, scratch.backPv.data(), scratch.backMv.data(), eq, true, score);
+        if (score <= bestScore) {
+            bestScore = score;
+            bestStart = start;
+        }
+    }
+    return bestStart;
+}
@@ -0,0 +1,138 @@
+// This file is part of Notepad++ project
+// Copyright (C)2023 Thomas Knoefel
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef FUZZY_MATCHER_H
+#define FUZZY_MATCHER_H
+
+// Approximate search for the Fuzzy entries of the replace list: occurrences that differ from the entry by at most
+// a given number of edits (one character inserted, deleted or replaced). Entries are compared with Myers'
+// bit-parallel edit distance, 64 characters of an entry per machine word.
+// An entry split into distance + 1 pieces keeps one piece unchanged in every occurrence, so the pieces of all
+// entries are searched together with the list automaton and only the text around their hits is compared.
+// Works on plain byte buffers only, like ListMatcher.
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "ListMatcher.h"
+
+struct FuzzyPattern {
+    std::string findText;   // Search bytes, already in document encoding
+    size_t distance = 1;    // Edits an occurrence may differ by; limited to the length of the text minus one
+    bool matchCase = false;
+};
+
+class FuzzyMatcher
+{
+public:
+    // UTF-8 text is compared by characters, other text by bytes. Without matchCase ASCII letters match in either
+    // case, in UTF-8 text all characters with the same Unicode case folding.
+    void build(const std::vector<FuzzyPattern>& patterns, bool utf8);
+
+    bool empty() const { return entries.empty(); }
+    size_t patternCount() const { return entries.size(); }
+
+    // Occurrences of every pattern lying completely inside [rangeStart, rangeEnd). Each pattern steps over its own
+    // occurrences from rangeStart on like a document search. Appended grouped by pattern, ordered by position.
+    void findAll(const char* text, size_t textLength, size_t rangeStart, size_t rangeEnd, std::vector<ListMatch>& matches) const;
+
+    // Same result as findAll(); the pieces are searched in chunks of at least minChunkLength bytes and the patterns
+    // compared by up to threadCount threads. The text must not change until the call returns.
+    void findAllParallel(const char* text, size_t textLength, size_t rangeStart, size_t rangeEnd,
+        size_t threadCount, size_t minChunkLength, std::vector<ListMatch>& matches) const;
+
+    // The first occurrence of one pattern findAll() reports; the cost follows the distance to it
+    bool findFirst(const char* text, size_t textLength, size_t rangeStart, size_t rangeEnd, size_t pattern, ListMatch& match) const;
+
+private:
+    // Match masks of the characters of one entry, in entry or in reverse order
+    struct BitPattern {
+        size_t blocks = 0;
+        uint64_t lastBit = 0;               // Bit of the last character in the last block
+        std::vector<uint64_t> byteEq;       // 256 * blocks; single byte characters and foldings
+        std::vector<std::string> keys;      // Other characters (folded without matchCase), sorted
+        std::vector<uint64_t> keyEq;        // keys.size() * blocks
+        std::vector<uint64_t> noEq;         // blocks zero words for characters not in the entry
+    };
+
+    struct Entry {
+        size_t length = 0;      // In characters
+        size_t distance = 0;
+        bool matchCase = false;
+        bool filtered = false;  // Pieces long enough to be searched for; otherwise all text is compared
+        size_t reach = 0;       // Bytes an occurrence can start in front of a piece hit
+        BitPattern forward;
+        BitPattern backward;
+    };
+
+    struct Piece {
+        size_t entry = 0;
+        size_t charsBefore = 0; // Characters of the entry in front of and behind the piece
+        size_t charsAfter = 0;
+    };
+
+    struct Region {
+        size_t start = 0;
+        size_t end = 0;
+    };
+
+    // Candidate end of an occurrence and the edits up to it
+    struct Candidate {
+        size_t end = 0;
+        size_t chars = 0;
+        size_t score = 0;
+    };
+
+    struct Scratch {
+        std::vector<uint64_t> pv;
+        std::vector<uint64_t> mv;
+        std::vector<uint64_t> backPv;
+        std::vector<uint64_t> backMv;
+        std::vector<size_t> ring;   // Starts of the last characters read, by character number
+        std::vector<Candidate> candidates;
+    };
+
+    std::vector<Entry> entries;
+    std::vector<Piece> pieces;
+    ListMatcher pieceMatcher;
+    bool isUtf8 = true;
+
+    size_t characterKey(const std::string& text, size_t pos, bool matchCase, std::string& key) const;
+    void buildBitPattern(const std::vector<std::string>& keys, BitPattern& bits) const;
+    const uint64_t* lookupCharacter(const BitPattern& bits, bool matchCase, const char* text, size_t textLength, size_t pos, size_t& width) const;
+    static size_t advance(const BitPattern& bits, uint64_t* pv, uint64_t* mv, const uint64_t* eq, bool anchored, size_t score);
+
+    // Match mask of the character at pos; single bytes are looked up directly
+    const uint64_t* lookup(const BitPattern& bits, bool matchCase, const char* text, size_t textLength, size_t pos, size_t& width) const {
+        unsigned char lead = static_cast<unsigned char>(text[pos]);
+        if (lead < 0x80 || !isUtf8) {
+            width = 1;
+            if (!matchCase && lead >= 'A' && lead <= 'Z') {
+                lead = static_cast<unsigned char>(lead + 32);
+            }
+            return &bits.byteEq[lead * bits.blocks];
+        }
+        return lookupCharacter(bits, matchCase, text, textLength, pos, width);
+    }
+
+    void addRegions(const std::vector<ListMatch>& hits, const char* text, size_t rangeStart, size_t rangeEnd,
+        size_t onlyEntry, std::vector<std::vector<Region>>& regions) const;
+    bool scanRegion(size_t index, const char* text, size_t textLength, Region region, bool firstOnly,
+        Scratch& scratch, std::vector<ListMatch>& matches) const;
+    size_t findStart(const Entry& entry, const char* text, size_t textLength, const Candidate& candidate, Scratch& scratch) const;
+};
+
+#endif // FUZZY_MATCHER_H
@@ -0,0 +1,105 @@
+// This file is part of Notepad++ project
+// Copyright (C)2023 Thomas Knoefel
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "HitCounter.h"
+
+#include <algorithm>
+
+void HitCounter::start(const ListMatcher& patternMatcher, std::string snapshot, size_t threadCount, size_t minChunkLength,
+    std::function<void()> finished) {
+    cancel();
+    matcher = patternMatcher;
+    text = std::move(snapshot);
+    cancelled = false;
+    worker = std::thread([this, threadCount, minChunkLength, finished]() {
+        run(threadCount, minChunkLength);
+        finished();
+        });
+}
+
+void HitCounter::cancel() {
+    cancelled = true;
+    if (worker.joinable()) {
+        worker.join();
+    }
+}
+
+bool HitCounter::take(DensityMap& hitDensity, std::vector<ListMatch>& positions, bool& positionsKept) {
+    if (worker.joinable()) {
+        worker.join();
+    }
+    bool complete = !cancelled;
+    if (complete) {
+        hitDensity = std::move(density);
+        positions = std::move(matches);
+        positionsKept = kept;
+    }
+
+    // The copy of the document is not needed any more
+    text.clear();
+    text.shrink_to_fit();
+    density.clear();
+    matches.clear();
+    matches.shrink_to_fit();
+    return complete;
+}
+
+void HitCounter::countEdited(const ListMatcher& patternMatcher, const ListMatcher::TextReader& read, size_t textLength,
+    size_t start, size_t end, DensityMap& hitDensity) {
+    size_t searchEnd = std::min(end + patternMatcher.maxPatternLength(), textLength);
+    size_t readStart = (start > ListMatcher::CONTEXT_LENGTH) ? start - ListMatcher::CONTEXT_LENGTH : 0;
+    size_t readEnd = std::min(searchEnd + ListMatcher::CONTEXT_LENGTH, textLength);
+    if (readEnd <= readStart) {
+        return;
+    }
+    std::vector<ListMatch> found;
+    patternMatcher.findAll(read(readStart, readEnd - readStart), readEnd - readStart, start - readStart, searchEnd - readStart, found);
+    for (const ListMatch& match : found) {
+        if (match.pos + readStart < end) {
+            hitDensity.add(match.pos + readStart, match.pattern);
+        }
+    }
+}
+
+void HitCounter::run(size_t threadCount, size_t minChunkLength) {
+    density.reset(text.size(), matcher.patternCount(), matcher.maxPatternLength());
+    matches.clear();
+    kept = true;
+
+    // Each slice takes the occurrences starting in it, reading on by the longest one
+    std::vector<ListMatch> found;
+    for (size_t sliceStart = 0; sliceStart < text.size() && !cancelled; sliceStart += SLICE_LENGTH) {
+        size_t sliceEnd = std::min(sliceStart + SLICE_LENGTH, text.size());
+        size_t scanEnd = std::min(sliceEnd + matcher.maxPatternLength(), text.size());
+
+        found.clear();
+        matcher.findAllParallel(text.data(), text.size(), sliceStart, scanEnd, threadCount, minChunkLength, found);
+        found.erase(std::remove_if(found.begin(), found.end(),
+            [sliceEnd](const ListMatch& match) { return match.pos >= sliceEnd; }), found.end());
+
+        for (const ListMatch& match : found) {
+            density.add(match.pos, match.pattern);
+        }
+        if (kept && matches.size() + found.size() > MAX_KEPT_MATCHES) {
+            kept = false;
+            matches.clear();
+            matches.shrink_to_fit();
+        }
+        if (kept) {
+            matches.insert(matches.end(), found.begin(), found.end());
+        }
+    }
+}
@@ -0,0 +1,74 @@
+// This file is part of Notepad++ project
+// Copyright (C)2023 Thomas Knoefel
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef HIT_COUNTER_H
+#define HIT_COUNTER_H
+
+// Occurrences of every literal list entry, counted on a worker thread in a copy of the document, so the
+// list and the editor stay usable while a large file is searched. The counts are kept per stretch of the
+// text in a DensityMap; the owner keeps the result up to date after edits, with the positions in a
+// MatchIndex where there are not too many of them.
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+#include "DensityMap.h"
+#include "ListMatcher.h"
+
+class HitCounter
+{
+public:
+    // Positions of more occurrences than this are not kept, the result then only holds the counts
+    static const size_t MAX_KEPT_MATCHES = 1 << 22;
+    // Text searched at once, so frequent entries cost no more memory than the kept positions
+    static const size_t SLICE_LENGTH = 1 << 24;
+
+    ~HitCounter() { cancel(); }
+
+    // Starts counting the patterns of matcher in text, stopping a count still running. finished is called
+    // on the worker thread once the count is complete or cancelled.
+    void start(const ListMatcher& patternMatcher, std::string snapshot, size_t threadCount, size_t minChunkLength,
+        std::function<void()> finished);
+
+    // Stops a running count and waits for the worker
+    void cancel();
+
+    bool isRunning() const { return worker.joinable(); }
+
+    // Waits for the worker and hands over its result: occurrences per pattern and bucket as ListMatcher::findAll()
+    // reports them and, unless there are too many, their positions. False if the count was cancelled.
+    bool take(DensityMap& hitDensity, std::vector<ListMatch>& positions, bool& positionsKept);
+
+    // Adds to hitDensity the occurrences of matcher starting in [start, end), the text DensityMap::takeEdited()
+    // returned, reading on by the longest one
+    static void countEdited(const ListMatcher& patternMatcher, const ListMatcher::TextReader& read, size_t textLength,
+        size_t start, size_t end, DensityMap& hitDensity);
+
+private:
+    std::thread worker;
+    std::atomic<bool> cancelled{ false };
+    ListMatcher matcher;
+    std::string text;
+    DensityMap density;
+    std::vector<ListMatch> matches;
+    bool kept = false;
+
+    void run(size_t threadCount, size_t minChunkLength);
+};
+
+#endif // HIT_COUNTER_H
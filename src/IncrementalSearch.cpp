@@ -0,0 +1,311 @@
+// This file is part of Notepad++ project
+// Copyright (C)2023 Thomas Knoefel
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "IncrementalSearch.h"
+#include "CaseFolding.h"
+
+#include <algorithm>
+
+static bool isOrderedBefore(const ListMatch& a, const ListMatch& b) {
+    return a.pos != b.pos ? a.pos < b.pos : a.length < b.length;
+}
+
+// Occurrences starting in front of sliceEnd, by position
+static void keepStartingBefore(std::vector<ListMatch>& matches, size_t sliceEnd) {
+    matches.erase(std::remove_if(matches.begin(), matches.end(),
+        [sliceEnd](const ListMatch& match) { return match.pos >= sliceEnd; }), matches.end());
+    std::sort(matches.begin(), matches.end(), isOrderedBefore);
+}
+
+// Compares the pattern with the text at pos byte by byte. Returns 1 for an occurrence, 0 for none and -1 if only
+// the matcher can tell, because caseless UTF-8 text holds other characters than ASCII there.
+static int compareAt(const ListPattern& pattern, bool utf8, const char* text, size_t textLength, size_t pos) {
+    const std::string& find = pattern.findText;
+    if (find.size() > textLength - pos) {
+        return (pattern.matchCase || !utf8) ? 0 : -1;
+    }
+    for (size_t i = 0; i < find.size(); ++i) {
+        unsigned char a = static_cast<unsigned char>(text[pos + i]);
+        unsigned char b = static_cast<unsigned char>(find[i]);
+        if (pattern.matchCase) {
+            if (a != b) {
+                return 0;
+            }
+            continue;
+        }
+        if (utf8 && (a >= 0x80 || b >= 0x80)) {
+            return -1;
+        }
+        if (a != b && !(a >= 'A' && a <= 'Z' && a + 32 == b) && !(b >= 'A' && b <= 'Z' && b + 32 == a)) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+// The occurrence of matcher starting at pos, if there is one
+static bool matchAt(const ListMatcher& matcher, const char* text, size_t textLength, size_t pos, size_t window,
+    std::vector<ListMatch>& scratch, ListMatch& match) {
+    scratch.clear();
+    matcher.findAll(text, textLength, pos, std::min(pos + window, textLength), scratch);
+    for (const ListMatch& found : scratch) {
+        if (found.pos == pos) {
+            match = found;
+            return true;
+        }
+    }
+    return false;
+}
+
+void IncrementalSearch::clear() {
+    candidates.clear();
+    candidates.shrink_to_fit();
+    words.clear();
+    words.shrink_to_fit();
+    candidateMatcher = ListMatcher();
+    wordMatcher = ListMatcher();
+    active = false;
+    kept = false;
+    total = 0;
+    counted = true;
+    narrowed = false;
+}
+
+void IncrementalSearch::search(const ListPattern& pattern, const CharClass classes[256], bool utf8,
+    const char* text, size_t textLength, size_t threadCount, size_t minChunkLength) {
+    narrowed = canNarrow(pattern, utf8, textLength);
+
+    ListPattern anyWord = pattern;
+    anyWord.wholeWord = false;
+    candidateMatcher = ListMatcher();
+    candidateMatcher.setCharClasses(classes, utf8);
+    candidateMatcher.build({ anyWord });
+    wordMatcher = ListMatcher();
+    wordMatcher.setCharClasses(classes, utf8);
+    wordMatcher.build({ pattern });
+
+    current = pattern;
+    isUtf8 = utf8;
+    length = textLength;
+    active = true;
+    if (narrowed) {
+        narrow(text, textLength);
+    }
+    else {
+        searchAll(text, textLength, threadCount, minChunkLength);
+    }
+}
+
+bool IncrementalSearch::canNarrow(const ListPattern& pattern, bool utf8, size_t textLength) const {
+    const std::string& before = current.findText;
+    if (!active || !kept || utf8 != isUtf8 || textLength != length || pattern.matchCase != current.matchCase ||
+        pattern.findText.size() <= before.size() || pattern.findText.compare(0, before.size(), before) != 0) {
+        return false;
+    }
+    if (!utf8) {
+        return true;
+    }
+
+    // The appended text has to start a character, and without matchCase no character may fold into both parts
+    std::string appended = pattern.findText.substr(before.size());
+    if ((static_cast<unsigned char>(appended[0]) & 0xC0) == 0x80) {
+        return false;
+    }
+    return pattern.matchCase || !CaseFolding::foldsAcross(CaseFolding::fold(before), CaseFolding::fold(appended));
+}
+
+size_t IncrementalSearch::matchWindow() const {
+    // A character takes at most three times the bytes of its folding (U+212A KELVIN SIGN folds to 'k')
+    return 3 * candidateMatcher.maxPatternLength();
+}
+
+void IncrementalSearch::searchAll(const char* text, size_t textLength, size_t threadCount, size_t minChunkLength) {
+    candidates.clear();
+    words.clear();
+    kept = true;
+    total = 0;
+    counted = true;
+
+    // Each slice takes the occurrences starting in it, reading on by the longest one
+    size_t window = matchWindow();
+    size_t nextStart = 0;
+    std::vector<ListMatch> found;
+    std::vector<ListMatch> sliceWords;
+    for (size_t sliceStart = 0; sliceStart < textLength; sliceStart += SLICE_LENGTH) {
+        size_t sliceEnd = std::min(sliceStart + SLICE_LENGTH, textLength);
+        size_t scanEnd = std::min(sliceEnd + window, textLength);
+
+        found.clear();
+        candidateMatcher.findAllParallel(text, textLength, sliceStart, scanEnd, threadCount, minChunkLength, found);
+        keepStartingBefore(found, sliceEnd);
+        if (kept && candidates.size() + found.size() > MAX_CANDIDATES) {
+            kept = false;
+            candidates.clear();
+            candidates.shrink_to_fit();
+            words.clear();
+            words.shrink_to_fit();
+        }
+        if (kept) {
+            candidates.insert(candidates.end(), found.begin(), found.end());
+        }
+
+        if (current.wholeWord) {
+            sliceWords.clear();
+            wordMatcher.findAllParallel(text, textLength, sliceStart, scanEnd, threadCount, minChunkLength, sliceWords);
+            keepStartingBefore(sliceWords, sliceEnd);
+            total += countSteps(sliceWords, nextStart);
+            if (kept) {
+                words.insert(words.end(), sliceWords.begin(), sliceWords.end());
+            }
+        }
+        else {
+            total += countSteps(found, nextStart);
+        }
+    }
+}
+
+void IncrementalSearch::narrow(const char* text, size_t textLength) {
+    size_t window = matchWindow();
+    std::vector<ListMatch> scratch;
+    std::vector<ListMatch> remaining;
+    words.clear();
+    for (const ListMatch& candidate : candidates) {
+        // Mostly the bytes decide; an occurrence of ASCII bytes has no other length
+        ListMatch match;
+        int compared = compareAt(current, isUtf8, text, textLength, candidate.pos);
+        if (compared == 1) {
+            match.pos = candidate.pos;
+            match.length = current.findText.size();
+        }
+        else if (compared == 0 || !matchAt(candidateMatcher, text, textLength, candidate.pos, window, scratch, match)) {
+            continue;
+        }
+        remaining.push_back(match);
+        if (current.wholeWord && matchAt(wordMatcher, text, textLength, candidate.pos, window, scratch, match)) {
+            words.push_back(match);
+        }
+    }
+    candidates = std::move(remaining);
+
+    size_t nextStart = 0;
+    total = countSteps(current.wholeWord ? words : candidates, nextStart);
+    counted = true;
+}
+
+size_t IncrementalSearch::count() const {
+    // Counted once after a run of edits, not for each of them
+    if (!counted) {
+        size_t nextStart = 0;
+        total = countSteps(current.wholeWord ? words : candidates, nextStart);
+        counted = true;
+    }
+    return total;
+}
+
+bool IncrementalSearch::replaced(const ListMatcher::TextReader& read, size_t textLength, size_t pos, size_t oldLength, size_t newLength) {
+    if (!active || !kept) {
+        return false;
+    }
+
+    size_t window = matchWindow();
+    repair(candidates, candidateMatcher, read, textLength, pos, oldLength, newLength, window);
+    if (current.wholeWord) {
+        repair(words, wordMatcher, read, textLength, pos, oldLength, newLength, window);
+    }
+    length = textLength;
+    counted = false;
+    if (candidates.size() > MAX_CANDIDATES) {
+        clear();
+        return false;
+    }
+    return true;
+}
+
+void IncrementalSearch::repair(std::vector<ListMatch>& matches, const ListMatcher& matcher, const ListMatcher::TextReader& read,
+    size_t textLength, size_t pos, size_t oldLength, size_t newLength, size_t window) {
+    // Occurrences reaching into [touchStart, touchEnd] may have changed; the ones behind move along
+    size_t edge = ListMatcher::CONTEXT_LENGTH;
+    size_t touchStart = (pos > edge) ? pos - edge : 0;
+    size_t touchEnd = pos + oldLength + edge;
+    auto touches = [&touchStart, &touchEnd](const ListMatch& match) {
+        return match.pos <= touchEnd && match.pos + match.length >= touchStart;
+    };
+
+    size_t reach = (touchStart > window) ? touchStart - window : 0;
+    auto first = std::lower_bound(matches.begin(), matches.end(), reach,
+        [](const ListMatch& match, size_t start) { return match.pos < start; });
+    auto last = std::upper_bound(first, matches.end(), touchEnd,
+        [](size_t end, const ListMatch& match) { return end < match.pos; });
+    auto kept = std::remove_if(first, last, touches);
+    size_t tail = static_cast<size_t>(kept - matches.begin());
+    matches.erase(kept, last);
+    for (size_t i = tail; i < matches.size(); ++i) {
+        matches[i].pos = matches[i].pos - oldLength + newLength;
+    }
+
+    // The text around the edit is searched again, the occurrences kept there are skipped
+    touchEnd = pos + newLength + edge;
+    size_t searchEnd = std::min(touchEnd + window, textLength);
+    size_t readStart = (reach > edge) ? reach - edge : 0;
+    size_t readEnd = std::min(searchEnd + edge, textLength);
+    if (searchEnd <= reach) {
+        return;
+    }
+    const char* text = read(readStart, readEnd - readStart);
+    std::vector<ListMatch> found;
+    matcher.findAll(text, readEnd - readStart, reach - readStart, searchEnd - readStart, found);
+
+    std::vector<ListMatch> added;
+    for (ListMatch& match : found) {
+        match.pos += readStart;
+        if (touches(match)) {
+            added.push_back(match);
+        }
+    }
+    std::sort(added.begin(), added.end(), isOrderedBefore);
+    size_t middle = matches.size();
+    matches.insert(matches.end(), added.begin(), added.end());
+    std::inplace_merge(matches.begin(), matches.begin() + middle, matches.end(), isOrderedBefore);
+}
+
+void IncrementalSearch::findInRange(const char* text, size_t textLength, size_t rangeStart, size_t rangeEnd, std::vector<ListMatch>& matches) const {
+    if (!active) {
+        return;
+    }
+
+    std::vector<ListMatch> found;
+    wordMatcher.findAll(text, textLength, rangeStart, rangeEnd, found);
+    keepStartingBefore(found, rangeEnd);
+
+    size_t nextStart = rangeStart;
+    for (const ListMatch& match : found) {
+        if (match.pos >= nextStart) {
+            matches.push_back(match);
+            nextStart = match.pos + std::max<size_t>(match.length, 1);
+        }
+    }
+}
+
+size_t IncrementalSearch::countSteps(const std::vector<ListMatch>& matches, size_t& nextStart) {
+    size_t steps = 0;
+    for (const ListMatch& match : matches) {
+        if (match.pos >= nextStart) {
+            steps++;
+            nextStart = match.pos + std::max<size_t>(match.length, 1);
+        }
+    }
+    return steps;
+}
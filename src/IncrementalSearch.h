@@ -0,0 +1,85 @@
+// This file is part of Notepad++ project
+// Copyright (C)2023 Thomas Knoefel
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef INCREMENTAL_SEARCH_H
+#define INCREMENTAL_SEARCH_H
+
+// Occurrences of the Find field while it is typed. The first text is searched in the whole document; a text
+// that only appends characters is checked at the occurrences of the previous one, since each of its
+// occurrences starts with one of them. Edits only drop and search again the occurrences close to the changed
+// text, as in MatchIndex. Works on plain byte buffers only, like ListMatcher.
+
+#include <cstddef>
+#include <vector>
+#include "ListMatcher.h"
+
+class IncrementalSearch
+{
+public:
+    // Occurrences kept for the next, longer text; with more of them the next text is searched again
+    static const size_t MAX_CANDIDATES = 1 << 21;
+    // Text searched at once, so frequent text costs no more memory than the kept occurrences
+    static const size_t SLICE_LENGTH = 1 << 24;
+
+    void clear();
+    bool isActive() const { return active; }
+
+    // Counts the occurrences of pattern in the text, narrowing the last result if the text is unchanged and
+    // the pattern only appends to the last one. The slices are split into chunks of at least minChunkLength
+    // bytes searched by up to threadCount threads. The text must not change until the call returns.
+    void search(const ListPattern& pattern, const CharClass classes[256], bool utf8,
+        const char* text, size_t textLength, size_t threadCount, size_t minChunkLength);
+
+    // Occurrences Find Next steps over from the start of the text
+    size_t count() const;
+
+    // Text of oldLength bytes at pos was replaced by newLength bytes, leaving textLength bytes. Moves the kept
+    // occurrences along and searches the text around the edit again. False if the occurrences are not kept;
+    // the caller searches the whole text again then.
+    bool replaced(const ListMatcher::TextReader& read, size_t textLength, size_t pos, size_t oldLength, size_t newLength);
+
+    // True if the last search only checked the occurrences of the one before
+    bool wasNarrowed() const { return narrowed; }
+
+    // Occurrences of the last pattern lying in [rangeStart, rangeEnd), stepping over each other like Find Next
+    // from rangeStart, ordered by position
+    void findInRange(const char* text, size_t textLength, size_t rangeStart, size_t rangeEnd, std::vector<ListMatch>& matches) const;
+
+    // Bytes an occurrence of the last pattern spans at most
+    size_t matchWindow() const;
+
+private:
+    ListPattern current;
+    bool isUtf8 = true;
+    size_t length = 0;                  // Length of the searched text
+    bool active = false;
+    bool kept = false;                  // candidates and words hold all occurrences
+    std::vector<ListMatch> candidates;  // Occurrences without the whole word condition, overlapping, by position
+    std::vector<ListMatch> words;       // Occurrences as entered, by position; only with whole word
+    ListMatcher candidateMatcher;       // The pattern without whole word
+    ListMatcher wordMatcher;            // The pattern as entered
+    mutable size_t total = 0;
+    mutable bool counted = true;        // total is up to date with the edits
+    bool narrowed = false;
+
+    bool canNarrow(const ListPattern& pattern, bool utf8, size_t textLength) const;
+    void searchAll(const char* text, size_t textLength, size_t threadCount, size_t minChunkLength);
+    void narrow(const char* text, size_t textLength);
+    static void repair(std::vector<ListMatch>& matches, const ListMatcher& matcher, const ListMatcher::TextReader& read,
+        size_t textLength, size_t pos, size_t oldLength, size_t newLength, size_t window);
+    static size_t countSteps(const std::vector<ListMatch>& matches, size_t& nextStart);
+};
+
+#endif // INCREMENTAL_SEARCH_H
@@ -0,0 +1,322 @@
+// This file is part of Notepad++ project
+// Copyright (C)2023 Thomas Knoefel
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "LazyMarker.h"
+
+#include <algorithm>
+
+// Text searched in front of a region at first to find where the entries step from
+static const size_t LAZY_LOOKBACK = 4096;
+
+static bool isOrderedByPattern(const ListMatch& a, const ListMatch& b) {
+    if (a.pattern != b.pattern) {
+        return a.pattern < b.pattern;
+    }
+    return a.pos != b.pos ? a.pos < b.pos : a.length < b.length;
+}
+
+// Reads [rangeStart, rangeEnd) with the context ListMatcher looks at around it
+static const char* readWindow(const LazyMarker::TextReader& read, size_t textLength, size_t rangeStart, size_t rangeEnd,
+    size_t& readStart, size_t& readLength) {
+    readStart = (rangeStart > ListMatcher::CONTEXT_LENGTH) ? rangeStart - ListMatcher::CONTEXT_LENGTH : 0;
+    readLength = std::min(rangeEnd + ListMatcher::CONTEXT_LENGTH, textLength) - readStart;
+    return read(readStart, readLength);
+}
+
+void LazyMarker::start(const std::vector<ListPattern>& patterns, const CharClass classes[256], bool utf8) {
+    matcher = ListMatcher();
+    matcher.setCharClasses(classes, utf8);
+    matcher.build(patterns);
+    done.clear();
+    countPos = 0;
+    countNext.assign(patterns.size(), 0);
+    total = 0;
+    counted = false;
+    edited = false;
+    active = true;
+}
+
+void LazyMarker::clear() {
+    matcher = ListMatcher();
+    done.clear();
+    done.shrink_to_fit();
+    countNext.clear();
+    total = 0;
+    counted = false;
+    edited = false;
+    active = false;
+}
+
+void LazyMarker::takeRange(const TextReader& read, size_t textLength, size_t rangeStart, size_t rangeEnd, std::vector<ListMatch>& matches) {
+    rangeEnd = std::min(rangeEnd, textLength);
+    if (!active || rangeStart >= rangeEnd) {
+        return;
+    }
+
+    // The gaps between the regions done before
+    size_t pos = rangeStart;
+    for (const Range& range : done) {
+        if (range.end <= pos) {
+            continue;
+        }
+        if (range.start >= rangeEnd) {
+            break;
+        }
+        if (range.start > pos) {
+            findStepped(read, textLength, pos, range.start, matches);
+        }
+        pos = range.end;
+    }
+    if (pos < rangeEnd) {
+        findStepped(read, textLength, pos, rangeEnd, matches);
+    }
+    addDone(rangeStart, rangeEnd);
+}
+
+void LazyMarker::retakeRange(const TextReader& read, size_t textLength, size_t rangeStart, size_t rangeEnd, std::vector<ListMatch>& matches) {
+    rangeEnd = std::min(rangeEnd, textLength);
+    if (!active || rangeStart >= rangeEnd) {
+        return;
+    }
+    findStepped(read, textLength, rangeStart, rangeEnd, matches);
+    addDone(rangeStart, rangeEnd);
+}
+
+void LazyMarker::takeAll(size_t textLength, size_t occurrences) {
+    done.clear();
+    if (textLength > 0) {
+        done.push_back({ 0, textLength });
+    }
+    countPos = textLength;
+    total = occurrences;
+    counted = true;
+}
+
+void LazyMarker::findStepped(const TextReader& read, size_t textLength, size_t rangeStart, size_t rangeEnd, std::vector<ListMatch>& matches) const {
+    size_t maxLength = matcher.maxPatternLength();
+    size_t lookback = std::max(LAZY_LOOKBACK, 4 * maxLength);
+    std::vector<ListMatch> found;
+    std::vector<ListMatch> selected;
+    for (;;) {
+        size_t searchStart = (rangeStart > lookback) ? rangeStart - lookback : 0;
+        size_t searchEnd = std::min(textLength, rangeEnd + maxLength);
+        size_t readStart = 0;
+        size_t readLength = 0;
+        const char* text = readWindow(read, textLength, searchStart, searchEnd, readStart, readLength);
+        found.clear();
+        matcher.findAll(text, readLength, searchStart - readStart, searchEnd - readStart, found);
+        for (ListMatch& match : found) {
+            match.pos += readStart;
+        }
+        std::sort(found.begin(), found.end(), isOrderedByPattern);
+
+        selected.clear();
+        bool complete = true;
+        for (size_t first = 0; first < found.size() && complete; ) {
+            size_t last = first;
+            while (last < found.size() && found[last].pattern == found[first].pattern) {
+                ++last;
+            }
+
+            // The entry steps from a point in front of the range no occurrence of it runs across, as it does
+            // coming from the start of the text: the start of the chain of overlapping occurrences the range
+            // starts in. It has to lie far enough behind the search start that earlier occurrences end before it.
+            size_t chainStart = rangeStart;
+            size_t chainEnd = 0;
+            for (size_t i = first; i < last && found[i].pos < rangeStart; ++i) {
+                if (found[i].pos >= chainEnd) {
+                    chainStart = found[i].pos;
+                }
+                chainEnd = std::max(chainEnd, found[i].pos + found[i].length);
+            }
+            size_t stepStart = (chainEnd > rangeStart) ? chainStart : rangeStart;
+            if (searchStart > 0 && stepStart < searchStart + maxLength) {
+                complete = false;
+                break;
+            }
+
+            size_t next = stepStart;
+            for (size_t i = first; i < last && found[i].pos < rangeEnd; ++i) {
+                if (found[i].pos < next) {
+                    continue;
+                }
+                next = found[i].pos + found[i].length;
+                if (found[i].pos >= rangeStart) {
+                    selected.push_back(found[i]);
+                }
+            }
+            first = last;
+        }
+
+        if (complete || searchStart == 0) {
+            matches.insert(matches.end(), selected.begin(), selected.end());
+            return;
+        }
+        lookback *= 2;
+    }
+}
+
+void LazyMarker::addDone(size_t start, size_t end) {
+    // Merged with every region it touches
+    auto first = std::lower_bound(done.begin(), done.end(), start,
+        [](const Range& range, size_t value) { return range.end < value; });
+    auto last = first;
+    while (last != done.end() && last->start <= end) {
+        start = std::min(start, last->start);
+        end = std::max(end, last->end);
+        ++last;
+    }
+    first = done.erase(first, last);
+    done.insert(first, Range{ start, end });
+}
+
+void LazyMarker::replaced(size_t pos, size_t length, size_t newLength) {
+    // The text around the edit is handed out again, together with the edits before it
+    if (!edited) {
+        editedSpan = { pos, pos + newLength };
+    }
+    else if (editedSpan.end < pos) {
+        editedSpan.end = pos + newLength;
+    }
+    else if (editedSpan.start > pos + length) {
+        editedSpan = { pos, editedSpan.end - length + newLength };
+    }
+    else {
+        editedSpan = { std::min(editedSpan.start, pos), std::max(editedSpan.end, pos + length) - length + newLength };
+    }
+    edited = true;
+
+    std::vector<Range> moved;
+    moved.reserve(done.size());
+    for (const Range& range : done) {
+        if (range.end < pos) {
+            moved.push_back(range);
+        }
+        else if (range.start > pos + length) {
+            moved.push_back({ range.start - length + newLength, range.end - length + newLength });
+        }
+        else {
+            // The region reaches the edit and takes in the new text
+            size_t start = std::min(range.start, pos);
+            size_t end = std::max(range.end, pos + length) - length + newLength;
+            if (!moved.empty() && moved.back().end >= start) {
+                moved.back().end = std::max(moved.back().end, end);
+            }
+            else {
+                moved.push_back({ start, end });
+            }
+        }
+    }
+    done = std::move(moved);
+
+    if (!counted) {
+        countPos = 0;
+        countNext.assign(matcher.patternCount(), 0);
+        total = 0;
+    }
+}
+
+bool LazyMarker::takeEdited(size_t& editStart, size_t& editEnd) {
+    if (!edited) {
+        return false;
+    }
+    editStart = editedSpan.start;
+    editEnd = editedSpan.end;
+    edited = false;
+    return true;
+}
+
+bool LazyMarker::takeEditedLines(const LineBounds& lineBounds, size_t textLength, size_t& rangeStart, size_t& rangeEnd) {
+    size_t editStart = 0;
+    size_t editEnd = 0;
+    if (!takeEdited(editStart, editEnd)) {
+        return false;
+    }
+    size_t lineStart = 0;
+    size_t lineEnd = 0;
+    size_t unused = 0;
+    lineBounds(std::min(editStart, textLength), lineStart, unused);
+    lineBounds(std::min(editEnd, textLength), unused, lineEnd);
+    size_t maxLength = matcher.maxPatternLength();
+    rangeStart = (lineStart > maxLength) ? lineStart - maxLength : 0;
+    rangeEnd = std::min(textLength, lineEnd + maxLength);
+    return true;
+}
+
+void LazyMarker::remarkRange(const TextReader& read, size_t textLength, size_t styleCount, const MarkRun& markRun,
+    size_t& rangeStart, size_t& rangeEnd, std::vector<ListMatch>& matches) {
+    for (;;) {
+        bool moved = true;
+        while (moved) {
+            moved = false;
+            for (size_t style = 0; style < styleCount; ++style) {
+                size_t runStart = 0;
+                size_t runEnd = 0;
+                if (rangeStart > 0 && rangeStart < textLength && markRun(style, rangeStart - 1, runStart, runEnd) && runEnd > rangeStart) {
+                    rangeStart = runStart;
+                    moved = true;
+                }
+                if (rangeEnd > 0 && rangeEnd < textLength && markRun(style, rangeEnd, runStart, runEnd) && runStart < rangeEnd) {
+                    rangeEnd = runEnd;
+                    moved = true;
+                }
+            }
+        }
+
+        matches.clear();
+        retakeRange(read, textLength, rangeStart, rangeEnd, matches);
+        size_t foundEnd = rangeEnd;
+        for (const ListMatch& match : matches) {
+            foundEnd = std::max(foundEnd, match.pos + match.length);
+        }
+        if (foundEnd <= rangeEnd) {
+            return;
+        }
+        rangeEnd = foundEnd;
+    }
+}
+
+bool LazyMarker::countSlice(const TextReader& read, size_t textLength, size_t sliceLength, size_t threadCount, size_t minChunkLength) {
+    if (!active || counted) {
+        return counted;
+    }
+
+    // Occurrences starting in the slice, each entry stepping on from the slices before
+    size_t sliceEnd = std::min(countPos + sliceLength, textLength);
+    size_t scanEnd = std::min(sliceEnd + matcher.maxPatternLength(), textLength);
+    size_t readStart = 0;
+    size_t readLength = 0;
+    const char* text = readWindow(read, textLength, countPos, scanEnd, readStart, readLength);
+    std::vector<ListMatch> found;
+    matcher.findAllParallel(text, readLength, countPos - readStart, scanEnd - readStart, threadCount, minChunkLength, found);
+    for (ListMatch& match : found) {
+        match.pos += readStart;
+    }
+    found.erase(std::remove_if(found.begin(), found.end(),
+        [sliceEnd](const ListMatch& match) { return match.pos >= sliceEnd; }), found.end());
+    std::sort(found.begin(), found.end(), isOrderedByPattern);
+
+    for (const ListMatch& match : found) {
+        if (match.pos >= countNext[match.pattern]) {
+            total++;
+            countNext[match.pattern] = match.pos + match.length;
+        }
+    }
+
+    countPos = sliceEnd;
+    counted = (countPos >= textLength);
+    return counted;
+}
@@ -0,0 +1,102 @@
+// This file is part of Notepad++ project
+// Copyright (C)2023 Thomas Knoefel
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef LAZY_MARKER_H
+#define LAZY_MARKER_H
+
+// Mark of literal entries, kept while the document is edited. A very large document is marked where the
+// user looks: the occurrences are handed out region by region as the view reaches them, and counted slice by
+// slice in between. Edited text is handed out again, so the marks can be repaired around the edit.
+// Each entry steps over its own occurrences like a search from the start of the document, so the regions
+// together mark what marking the whole document at once does. The text is read in windows around the
+// searched ranges, so the editor need not join its buffer for a search.
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+#include "ListMatcher.h"
+
+class LazyMarker
+{
+public:
+    using TextReader = ListMatcher::TextReader;
+    // Start of the line holding pos and the end of that line in front of its line break
+    using LineBounds = std::function<void(size_t pos, size_t& lineStart, size_t& lineEnd)>;
+    // The run of one mark style holding pos, [runStart, runEnd); false if pos is not marked in that style
+    using MarkRun = std::function<bool(size_t style, size_t pos, size_t& runStart, size_t& runEnd)>;
+
+    void start(const std::vector<ListPattern>& patterns, const CharClass classes[256], bool utf8);
+    void clear();
+
+    bool isActive() const { return active; }
+    size_t patternCount() const { return matcher.patternCount(); }
+    const ListPattern& pattern(size_t index) const { return matcher.pattern(index); }
+    size_t maxPatternLength() const { return matcher.maxPatternLength(); }
+
+    // Appends the occurrences starting in the parts of [rangeStart, rangeEnd) not handed out before and
+    // remembers these parts as done
+    void takeRange(const TextReader& read, size_t textLength, size_t rangeStart, size_t rangeEnd, std::vector<ListMatch>& matches);
+
+    // Appends all occurrences starting in [rangeStart, rangeEnd), handed out before or not, and remembers the range as done
+    void retakeRange(const TextReader& read, size_t textLength, size_t rangeStart, size_t rangeEnd, std::vector<ListMatch>& matches);
+
+    // Remembers the whole text as done and counted, for a document marked at once
+    void takeAll(size_t textLength, size_t occurrences);
+
+    // Text of length bytes at pos was replaced by newLength bytes. Regions done move along and take in
+    // text inserted into or next to them; a count not finished yet starts again.
+    void replaced(size_t pos, size_t length, size_t newLength);
+
+    // The span of text changed since the last call, around every edit; false without edits
+    bool takeEdited(size_t& editStart, size_t& editEnd);
+
+    // Like takeEdited(), widened to the edited lines and the longest entry on either side: the text to mark again
+    bool takeEditedLines(const LineBounds& lineBounds, size_t textLength, size_t& rangeStart, size_t& rangeEnd);
+
+    // Widens [rangeStart, rangeEnd) until neither a mark of the styleCount styles nor a new occurrence reaches
+    // over its ends and puts the occurrences starting there into matches. Entries step over their occurrences,
+    // so once the caller clears the marks of the range and sets these, the marks outside stay as they were.
+    void remarkRange(const TextReader& read, size_t textLength, size_t styleCount, const MarkRun& markRun,
+        size_t& rangeStart, size_t& rangeEnd, std::vector<ListMatch>& matches);
+
+    // Counts the occurrences of the next slice of sliceLength bytes, searched by up to threadCount threads
+    // in chunks of at least minChunkLength bytes. True once the whole text is counted.
+    bool countSlice(const TextReader& read, size_t textLength, size_t sliceLength, size_t threadCount, size_t minChunkLength);
+
+    bool isCounted() const { return counted; }
+    size_t count() const { return total; }
+    size_t countedLength() const { return countPos; }
+
+private:
+    struct Range {
+        size_t start = 0;
+        size_t end = 0;
+    };
+
+    ListMatcher matcher;
+    std::vector<Range> done;            // Sorted, neither touching nor overlapping
+    bool active = false;
+    size_t countPos = 0;                // Text in front of it is counted
+    std::vector<size_t> countNext;      // Per pattern, where its next occurrence may start
+    size_t total = 0;
+    bool counted = false;
+    bool edited = false;
+    Range editedSpan;
+
+    void findStepped(const TextReader& read, size_t textLength, size_t rangeStart, size_t rangeEnd, std::vector<ListMatch>& matches) const;
+    void addDone(size_t start, size_t end);
+};
+
+#endif // LAZY_MARKER_H
@@ -0,0 +1,775 @@
+// This file is part of Notepad++ project
+// Copyright (C)2023 Thomas Knoefel
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "ListMatcher.h"
+#include "CaseFolding.h"
+
+#include <algorithm>
+#include <cstring>
+#include <thread>
+
+static const size_t STEP_WINDOW = 4096;  // Bytes searched per step when an entry changes its own word boundaries
+
+ListMatcher::ListMatcher() {
+    std::fill(std::begin(byteClass), std::end(byteClass), static_cast<unsigned short>(0));
+
+    // Scintilla defaults: control chars are space, alnum and '_' and all bytes >= 0x80 are word chars
+    for (int c = 0; c < 256; ++c) {
+        if (c == '\r' || c == '\n') {
+            charClasses[c] = CharClass::NewLine;
+        }
+        else if (c < 0x20 || c == ' ') {
+            charClasses[c] = CharClass::Space;
+        }
+        else if (c >= 0x80 || (c >= '0' && c <= '9') || (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || c == '_') {
+            charClasses[c] = CharClass::Word;
+        }
+        else {
+            charClasses[c] = CharClass::Punctuation;
+        }
+    }
+}
+
+void ListMatcher::setCharClasses(const CharClass classes[256], bool utf8) {
+    std::copy(classes, classes + 256, charClasses);
+    isUtf8 = utf8;
+}
+
+void ListMatcher::build(const std::vector<ListPattern>& patternList) {
+    patterns = patternList;
+    maxLength = 0;
+
+    // Caseless UTF-8 patterns enter the automaton Unicode folded. Text holding a character that folds into
+    // one of them is searched for these patterns with full folding, all other text matches byte by byte.
+    std::vector<std::string> trieTexts(patterns.size());
+    foldScanners.assign(patterns.size(), LiteralScanner());
+    foldTriggers.clear();
+    foldTriggerLeads.clear();
+    foldAlways = false;
+    for (size_t i = 0; i < patterns.size(); ++i) {
+        const ListPattern& pat = patterns[i];
+        trieTexts[i] = pat.findText;
+        maxLength = std::max(maxLength, pat.findText.size());
+        if (pat.matchCase || !isUtf8) {
+            continue;
+        }
+
+        foldScanners[i].setPattern(pat.findText, false, true);
+        if (foldScanners[i].foldsUnicode()) {
+            trieTexts[i] = CaseFolding::fold(pat.findText);
+            maxLength = std::max(maxLength, foldScanners[i].maxMatchLength());
+            foldAlways = foldAlways || !CaseFolding::isValid(pat.findText);
+            for (const std::string& character : CaseFolding::charactersFoldingInto(trieTexts[i])) {
+                if (std::find(foldTriggers.begin(), foldTriggers.end(), character) == foldTriggers.end()) {
+                    foldTriggers.push_back(character);
+                }
+                if (foldTriggerLeads.find(character[0]) == std::string::npos) {
+                    foldTriggerLeads += character[0];
+                }
+            }
+        }
+    }
+
+    // Compress the alphabet to the bytes used by the patterns, everything else shares class 0
+    std::fill(std::begin(byteClass), std::end(byteClass), static_cast<unsigned short>(0));
+    classCount = 1;
+    for (const std::string& trieText : trieTexts) {
+        for (char ch : trieText) {
+            unsigned char folded = fold(static_cast<unsigned char>(ch));
+            if (byteClass[folded] == 0) {
+                byteClass[folded] = static_cast<unsigned short>(classCount++);
+            }
+        }
+    }
+    for (int c = 'A'; c <= 'Z'; ++c) {
+        byteClass[c] = byteClass[c + 32];
+    }
+
+    std::fill(std::begin(wordPatternFirstByte), std::end(wordPatternFirstByte), false);
+    std::fill(std::begin(wordPatternLastByte), std::end(wordPatternLastByte), false);
+    for (size_t i = 0; i < patterns.size(); ++i) {
+        if (patterns[i].wholeWord && !trieTexts[i].empty()) {
+            wordPatternFirstByte[fold(static_cast<unsigned char>(trieTexts[i].front()))] = true;
+            wordPatternLastByte[fold(static_cast<unsigned char>(trieTexts[i].back()))] = true;
+            if (foldScanners[i].foldsUnicode()) {
+                std::fill(wordPatternFirstByte + 0x80, std::end(wordPatternFirstByte), true);
+                std::fill(wordPatternLastByte + 0x80, std::end(wordPatternLastByte), true);
+            }
+        }
+    }
+
+    singleLiteral = (patterns.size() == 1 && !patterns[0].findText.empty());
+    if (singleLiteral) {
+        literal.setPattern(patterns[0].findText, patterns[0].matchCase, isUtf8);
+    }
+
+    transitions.assign(classCount, -1);
+    stateOutput.assign(1, -1);
+    stateDepth.assign(1, 0);
+    samePattern.assign(patterns.size(), -1);
+    std::vector<int> lastOutput(1, -1);
+
+    // Trie of the folded patterns
+    for (size_t i = 0; i < patterns.size(); ++i) {
+        const std::string& findText = trieTexts[i];
+        if (findText.empty()) {
+            continue;
+        }
+
+        int state = 0;
+        for (char ch : findText) {
+            size_t cls = byteClass[fold(static_cast<unsigned char>(ch))];
+            int next = transitions[state * classCount + cls];
+            if (next < 0) {
+                next = static_cast<int>(stateOutput.size());
+                transitions[state * classCount + cls] = next;
+                transitions.resize(transitions.size() + classCount, -1);
+                stateOutput.push_back(-1);
+                lastOutput.push_back(-1);
+                stateDepth.push_back(stateDepth[state] + 1);
+            }
+            state = next;
+        }
+
+        // Keep identical patterns in list order
+        if (stateOutput[state] < 0) {
+            stateOutput[state] = static_cast<int>(i);
+        }
+        else {
+            samePattern[lastOutput[state]] = static_cast<int>(i);
+        }
+        lastOutput[state] = static_cast<int>(i);
+    }
+
+    // Failure links folded into a complete transition table (breadth first)
+    size_t stateCount = stateOutput.size();
+    std::vector<int> failure(stateCount, 0);
+    dictionaryLink.assign(stateCount, -1);
+    std::vector<int> queue;
+    queue.reserve(stateCount);
+
+    for (size_t cls = 0; cls < classCount; ++cls) {
+        int next = transitions[cls];
+        if (next < 0) {
+            transitions[cls] = 0;
+        }
+        else {
+            failure[next] = 0;
+            queue.push_back(next);
+        }
+    }
+
+    for (size_t head = 0; head < queue.size(); ++head) {
+        int state = queue[head];
+        int fail = failure[state];
+        dictionaryLink[state] = (stateOutput[fail] >= 0) ? fail : dictionaryLink[fail];
+
+        for (size_t cls = 0; cls < classCount; ++cls) {
+            int next = transitions[state * classCount + cls];
+            int fallback = transitions[fail * classCount + cls];
+            if (next < 0) {
+                transitions[state * classCount + cls] = fallback;
+            }
+            else {
+                failure[next] = fallback;
+                queue.push_back(next);
+            }
+        }
+    }
+}
+
+void ListMatcher::findAll(const char* text, size_t textLength, size_t rangeStart, size_t rangeEnd, std::vector<ListMatch>& matches) const {
+    scan(text, textLength, rangeStart, rangeEnd, true, matches);
+}
+
+bool ListMatcher::findInChunk(const TextReader& read, size_t textLength, size_t rangeStart, size_t rangeEnd, bool last, ListMatch& found) const {
+    size_t readStart = (rangeStart > CONTEXT_LENGTH) ? rangeStart - CONTEXT_LENGTH : 0;
+    size_t readEnd = std::min(rangeEnd + CONTEXT_LENGTH, textLength);
+    const char* text = read(readStart, readEnd - readStart);
+
+    std::vector<ListMatch> matches;
+    findAll(text, readEnd - readStart, rangeStart - readStart, rangeEnd - readStart, matches);
+    const ListMatch* best = nullptr;
+    for (const ListMatch& match : matches) {
+        if (best == nullptr || (last ? match.pos > best->pos : match.pos < best->pos)) {
+            best = &match;
+        }
+    }
+    if (best == nullptr) {
+        return false;
+    }
+    found = *best;
+    found.pos += readStart;
+    return true;
+}
+
+bool ListMatcher::findFirstChunked(const TextReader& read, size_t textLength, size_t rangeStart, size_t rangeEnd, size_t firstChunk, ListMatch& found) const {
+    // Every chunk starts at rangeStart and is read on by the longest entry, so all occurrences starting in it are
+    // seen. One starting behind it may follow a longer one cut off by the read end; it is left to the next chunk.
+    size_t chunkLength = std::max<size_t>(firstChunk, 1);
+    size_t chunkEnd;
+    do {
+        chunkEnd = (rangeEnd - rangeStart > chunkLength) ? rangeStart + chunkLength : rangeEnd;
+        size_t scanEnd = std::min(chunkEnd + std::max<size_t>(maxLength, 1) - 1, rangeEnd);
+        if (findInChunk(read, textLength, rangeStart, scanEnd, false, found) && found.pos < chunkEnd) {
+            return true;
+        }
+        chunkLength *= 2;
+    } while (chunkEnd < rangeEnd);
+    return false;
+}
+
+bool ListMatcher::findLastChunked(const TextReader& read, size_t textLength, size_t rangeStart, size_t rangeEnd, size_t firstChunk, ListMatch& found) const {
+    size_t chunkLength = std::max<size_t>(firstChunk, 1);
+    size_t chunkStart;
+    do {
+        chunkStart = (rangeEnd - rangeStart > chunkLength) ? rangeEnd - chunkLength : rangeStart;
+        if (findInChunk(read, textLength, chunkStart, rangeEnd, true, found)) {
+            return true;
+        }
+        chunkLength *= 2;
+    } while (chunkStart > rangeStart);
+    return false;
+}
+
+void ListMatcher::findAllParallel(const char* text, size_t textLength, size_t rangeStart, size_t rangeEnd,
+    size_t threadCount, size_t minChunkLength, std::vector<ListMatch>& matches) const {
+    rangeEnd = std::min(rangeEnd, textLength);
+    if (rangeStart >= rangeEnd || patterns.empty()) {
+        return;
+    }
+
+    size_t rangeLength = rangeEnd - rangeStart;
+    size_t chunkCount = std::min(threadCount, rangeLength / std::max<size_t>(minChunkLength, 1));
+    if (chunkCount < 2) {
+        findAll(text, textLength, rangeStart, rangeEnd, matches);
+        return;
+    }
+
+    size_t chunkLength = (rangeLength + chunkCount - 1) / chunkCount;
+    std::vector<std::vector<ListMatch>> chunkMatches(chunkCount);
+    std::vector<std::thread> workers;
+    workers.reserve(chunkCount);
+
+    for (size_t chunk = 0; chunk < chunkCount; ++chunk) {
+        workers.emplace_back([this, text, textLength, rangeStart, rangeEnd, chunkLength, chunk, &chunkMatches]() {
+            size_t chunkStart = rangeStart + chunk * chunkLength;
+            size_t chunkEnd = std::min(chunkStart + chunkLength, rangeEnd);
+
+            // Scan into the next chunk to see occurrences crossing the boundary; each belongs to the chunk it starts in
+            size_t scanEnd = std::min(chunkEnd + maxLength - 1, rangeEnd);
+            std::vector<ListMatch>& found = chunkMatches[chunk];
+            findAll(text, textLength, chunkStart, scanEnd, found);
+            found.erase(std::remove_if(found.begin(), found.end(),
+                [chunkEnd](const ListMatch& match) { return match.pos >= chunkEnd; }), found.end());
+            });
+    }
+
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    for (const std::vector<ListMatch>& found : chunkMatches) {
+        matches.insert(matches.end(), found.begin(), found.end());
+    }
+}
+
+void ListMatcher::scan(const char* text, size_t textLength, size_t rangeStart, size_t rangeEnd, bool checkWords, std::vector<ListMatch>& matches) const {
+    if (patterns.empty() || stateOutput.empty()) {
+        return;
+    }
+
+    rangeEnd = std::min(rangeEnd, textLength);
+    if (singleLiteral) {
+        const ListPattern& pat = patterns[0];
+        size_t length;
+        for (size_t pos = literal.find(text, rangeStart, rangeEnd, length); pos < rangeEnd; pos = literal.find(text, pos + 1, rangeEnd, length)) {
+            if (!checkWords || !pat.wholeWord || isWordAt(text, textLength, pos, pos + length)) {
+                matches.push_back({ pos, length, 0 });
+            }
+        }
+        return;
+    }
+
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(text);
+    int state = 0;
+    size_t firstMatch = matches.size();
+    bool folding = foldAlways || (!foldTriggers.empty() && hasFoldTrigger(text, rangeStart, rangeEnd));
+
+    for (size_t i = rangeStart; i < rangeEnd; ++i) {
+        state = transitions[state * classCount + byteClass[bytes[i]]];
+
+        int out = (stateOutput[state] >= 0) ? state : dictionaryLink[state];
+        while (out >= 0) {
+            size_t length = stateDepth[out];
+            size_t pos = i + 1 - length;
+            for (int p = stateOutput[out]; p >= 0; p = samePattern[p]) {
+                if (folding && foldScanners[p].foldsUnicode()) {
+                    continue;
+                }
+                if (verify(text, textLength, pos, length, patterns[p], checkWords)) {
+                    matches.push_back({ pos, length, static_cast<size_t>(p) });
+                }
+            }
+            out = dictionaryLink[out];
+        }
+    }
+
+    if (folding) {
+        for (size_t p = 0; p < patterns.size(); ++p) {
+            const LiteralScanner& scanner = foldScanners[p];
+            if (!scanner.foldsUnicode()) {
+                continue;
+            }
+            size_t length;
+            for (size_t pos = scanner.find(text, rangeStart, rangeEnd, length); pos < rangeEnd; pos = scanner.find(text, pos + 1, rangeEnd, length)) {
+                if (!checkWords || !patterns[p].wholeWord || isWordAt(text, textLength, pos, pos + length)) {
+                    matches.push_back({ pos, length, p });
+                }
+            }
+        }
+        std::stable_sort(matches.begin() + firstMatch, matches.end(), [](const ListMatch& a, const ListMatch& b) {
+            return a.pos + a.length < b.pos + b.length;
+            });
+    }
+}
+
+bool ListMatcher::hasFoldTrigger(const char* text, size_t rangeStart, size_t rangeEnd) const {
+    for (size_t pos = LiteralScanner::findAnyByte(text, rangeStart, rangeEnd, foldTriggerLeads); pos < rangeEnd;
+        pos = LiteralScanner::findAnyByte(text, pos + 1, rangeEnd, foldTriggerLeads)) {
+        for (const std::string& character : foldTriggers) {
+            if (character[0] == text[pos] && character.size() <= rangeEnd - pos &&
+                std::memcmp(text + pos, character.data(), character.size()) == 0) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+std::vector<ListMatch> ListMatcher::selectSequentialMatches(std::vector<ListMatch> candidates) const {
+    std::sort(candidates.begin(), candidates.end(), [](const ListMatch& a, const ListMatch& b) {
+        return a.pos != b.pos ? a.pos < b.pos : a.pattern < b.pattern;
+        });
+
+    // Common case: no occurrences overlap, so every entry gets all of its occurrences
+    bool overlapping = false;
+    size_t textEnd = 0;
+    for (const ListMatch& candidate : candidates) {
+        if (candidate.pos < textEnd) {
+            overlapping = true;
+        }
+        textEnd = std::max(textEnd, candidate.pos + candidate.length);
+    }
+    if (!overlapping) {
+        return candidates;
+    }
+
+    std::stable_sort(candidates.begin(), candidates.end(), [](const ListMatch& a, const ListMatch& b) {
+        return a.pattern < b.pattern;
+        });
+
+    // Entries are applied in list order; each scans left to right and skips text already taken by an earlier entry
+    std::vector<bool> taken(textEnd, false);
+    std::vector<ListMatch> selected;
+    size_t currentPattern = static_cast<size_t>(-1);
+    size_t scanPos = 0;
+
+    for (const ListMatch& candidate : candidates) {
+        if (candidate.pattern != currentPattern) {
+            currentPattern = candidate.pattern;
+            scanPos = 0;
+        }
+        if (candidate.pos < scanPos) {
+            continue;
+        }
+
+        size_t candidateEnd = candidate.pos + candidate.length;
+        bool free = true;
+        for (size_t i = candidate.pos; i < candidateEnd && free; ++i) {
+            free = !taken[i];
+        }
+        if (!free) {
+            continue;
+        }
+
+        std::fill(taken.begin() + candidate.pos, taken.begin() + candidateEnd, true);
+        selected.push_back(candidate);
+        scanPos = candidateEnd;
+    }
+
+    std::sort(selected.begin(), selected.end(), [](const ListMatch& a, const ListMatch& b) {
+        return a.pos < b.pos;
+        });
+    return selected;
+}
+
+std::vector<ListMatch> ListMatcher::selectPatternMatches(std::vector<ListMatch> candidates) {
+    std::sort(candidates.begin(), candidates.end(), [](const ListMatch& a, const ListMatch& b) {
+        return a.pattern != b.pattern ? a.pattern < b.pattern : a.pos < b.pos;
+        });
+
+    std::vector<ListMatch> selected;
+    selected.reserve(candidates.size());
+    size_t currentPattern = static_cast<size_t>(-1);
+    size_t scanPos = 0;
+
+    for (const ListMatch& candidate : candidates) {
+        if (candidate.pattern != currentPattern) {
+            currentPattern = candidate.pattern;
+            scanPos = 0;
+        }
+        if (candidate.pos < scanPos) {
+            continue;
+        }
+        selected.push_back(candidate);
+        scanPos = candidate.pos + candidate.length;
+    }
+    return selected;
+}
+
+std::vector<ListMatch> ListMatcher::selectLeftmostLongestMatches(std::vector<ListMatch> candidates) {
+    std::sort(candidates.begin(), candidates.end(), [](const ListMatch& a, const ListMatch& b) {
+        if (a.pos != b.pos) {
+            return a.pos < b.pos;
+        }
+        return a.length != b.length ? a.length > b.length : a.pattern < b.pattern;
+        });
+
+    std::vector<ListMatch> selected;
+    selected.reserve(candidates.size());
+    size_t scanPos = 0;
+    for (const ListMatch& candidate : candidates) {
+        if (candidate.pos < scanPos) {
+            continue;
+        }
+        selected.push_back(candidate);
+        scanPos = candidate.pos + candidate.length;
+    }
+    return selected;
+}
+
+void ListMatcher::buildReplacedText(const char* text, size_t textLength, const std::vector<ListMatch>& selected,
+    const std::vector<std::string>& replacements, std::string& output, std::vector<size_t>& outputPositions) {
+
+    size_t outputLength = textLength;
+    for (const ListMatch& match : selected) {
+        outputLength = outputLength - match.length + replacements[match.pattern].size();
+    }
+
+    output.clear();
+    output.reserve(outputLength);
+    outputPositions.clear();
+    outputPositions.reserve(selected.size());
+
+    size_t copied = 0;
+    for (const ListMatch& match : selected) {
+        output.append(text + copied, match.pos - copied);
+        outputPositions.push_back(output.size());
+        output.append(replacements[match.pattern]);
+        copied = match.pos + match.length;
+    }
+    output.append(text + copied, textLength - copied);
+}
+
+void ListMatcher::buildEdits(const char* text, const std::vector<ListMatch>& selected, const std::vector<std::string>& replacements,
+    size_t maxGap, size_t maxSpan, std::vector<ListEdit>& edits, std::string& buffer) {
+
+    edits.clear();
+    size_t bufferLength = 0;
+
+    for (const ListMatch& match : selected) {
+        size_t matchEnd = match.pos + match.length;
+        if (!edits.empty()) {
+            ListEdit& edit = edits.back();
+            size_t editEnd = edit.pos + edit.length;
+            if (match.pos - editEnd <= maxGap && matchEnd - edit.pos <= maxSpan) {
+                bufferLength += (match.pos - editEnd) + replacements[match.pattern].size();
+                edit.length = matchEnd - edit.pos;
+                ++edit.matchCount;
+                continue;
+            }
+        }
+        bufferLength += replacements[match.pattern].size();
+        edits.push_back({ match.pos, match.length, 0, 0, 1 });
+    }
+
+    buffer.clear();
+    buffer.reserve(bufferLength);
+
+    auto match = selected.begin();
+    for (ListEdit& edit : edits) {
+        edit.bufferPos = buffer.size();
+        size_t copied = edit.pos;
+        for (size_t i = 0; i < edit.matchCount; ++i, ++match) {
+            buffer.append(text + copied, match->pos - copied);
+            buffer.append(replacements[match->pattern]);
+            copied = match->pos + match->length;
+        }
+        edit.bufferLength = buffer.size() - edit.bufferPos;
+    }
+}
+
+bool ListMatcher::hasCascadingMatches(const char* text, size_t textLength, const std::vector<ListMatch>& selected,
+    const std::vector<std::string>& replacements) const {
+
+    size_t reach = maxLength + 3;  // Longest occurrence plus room to decode a UTF-8 neighbour
+    std::vector<ListMatch> found;
+    std::vector<size_t> laterEntries;
+    std::string window;
+
+    for (size_t index = 0; index < selected.size(); ++index) {
+        const ListMatch& match = selected[index];
+        size_t entry = match.pattern;
+        size_t matchEnd = match.pos + match.length;
+
+        // A whole word occurrence touching the match may gain or lose its word boundary once the match is replaced
+        bool touchBefore = match.pos > 0 && wordPatternLastByte[fold(static_cast<unsigned char>(text[match.pos - 1]))];
+        bool touchAfter = matchEnd < textLength && wordPatternFirstByte[fold(static_cast<unsigned char>(text[matchEnd]))];
+        if (touchBefore || touchAfter) {
+            found.clear();
+            scan(text, textLength, match.pos > maxLength ? match.pos - maxLength : 0, std::min(textLength, matchEnd + maxLength), false, found);
+            for (const ListMatch& other : found) {
+                if (patterns[other.pattern].wholeWord && other.pattern >= entry && (other.pos + other.length == match.pos || other.pos == matchEnd)) {
+                    return true;
+                }
+            }
+        }
+
+        // Surrounding text, extended over neighbouring matches until enough unchanged text is left on each side
+        size_t first = index;
+        size_t left = match.pos;
+        for (size_t kept = 0; kept < reach && left > 0;) {
+            if (first > 0 && selected[first - 1].pos + selected[first - 1].length == left) {
+                --first;
+                kept += std::min(selected[first].length, replacements[selected[first].pattern].size());
+                left = selected[first].pos;
+            }
+            else {
+                --left;
+                ++kept;
+            }
+        }
+        size_t last = index + 1;
+        size_t right = matchEnd;
+        for (size_t kept = 0; kept < reach && right < textLength;) {
+            if (last < selected.size() && selected[last].pos == right) {
+                kept += std::min(selected[last].length, replacements[selected[last].pattern].size());
+                right = selected[last].pos + selected[last].length;
+                ++last;
+            }
+            else {
+                ++right;
+                ++kept;
+            }
+        }
+
+        // Later entries see this neighbourhood in one state per neighbouring entry that comes after this one
+        laterEntries.clear();
+        for (size_t n = first; n < last; ++n) {
+            if (selected[n].pattern > entry) {
+                laterEntries.push_back(selected[n].pattern);
+            }
+        }
+        std::sort(laterEntries.begin(), laterEntries.end());
+        laterEntries.erase(std::unique(laterEntries.begin(), laterEntries.end()), laterEntries.end());
+
+        for (size_t state = 0; state <= laterEntries.size(); ++state) {
+            size_t applied = (state == 0) ? entry : laterEntries[state - 1];
+            size_t lowest = applied + 1;
+            size_t highest = (state < laterEntries.size()) ? laterEntries[state] : static_cast<size_t>(-1);
+
+            window.clear();
+            size_t copied = left;
+            size_t regionStart = 0;
+            size_t regionEnd = 0;
+            for (size_t n = first; n < last; ++n) {
+                const ListMatch& neighbour = selected[n];
+                window.append(text + copied, neighbour.pos - copied);
+                if (n == index) {
+                    regionStart = window.size();
+                }
+                if (neighbour.pattern <= applied) {
+                    window.append(replacements[neighbour.pattern]);
+                }
+                else {
+                    window.append(text + neighbour.pos, neighbour.length);
+                }
+                if (n == index) {
+                    regionEnd = window.size();
+                }
+                copied = neighbour.pos + neighbour.length;
+            }
+            window.append(text + copied, right - copied);
+
+            found.clear();
+            findAll(window.data(), window.size(), 0, window.size(), found);
+            for (const ListMatch& other : found) {
+                if (other.pattern < lowest || other.pattern > highest) {
+                    continue;
+                }
+                size_t otherEnd = other.pos + other.length;
+                bool overlaps = (regionEnd > regionStart)
+                    ? (other.pos < regionEnd && otherEnd > regionStart)
+                    : (other.pos < regionStart && otherEnd > regionStart);  // Joined by a deletion
+                if (overlaps) {
+                    return true;
+                }
+            }
+        }
+    }
+
+    return false;
+}
+
+bool ListMatcher::isAscii(const std::string& str) {
+    for (char ch : str) {
+        if (static_cast<unsigned char>(ch) >= 0x80) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool ListMatcher::isSupported(const ListPattern& pattern, bool utf8) {
+    return pattern.matchCase || utf8 || isAscii(pattern.findText);
+}
+
+CharClass ListMatcher::classifyCodePoint(unsigned int cp) {
+    // Mirrors Scintilla's Unicode categories for the common blocks: Zl/Zp newline, Zs/C* space, P*/S* punctuation
+    if (cp == 0x2028 || cp == 0x2029) {
+        return CharClass::NewLine;
+    }
+    if (cp <= 0xA0 || cp == 0xAD || cp == 0x1680 || (cp >= 0x2000 && cp <= 0x200F) || (cp >= 0x202A && cp <= 0x202F) ||
+        (cp >= 0x205F && cp <= 0x2064) || cp == 0x3000 || cp == 0xFEFF) {
+        return CharClass::Space;
+    }
+    if ((cp >= 0xA1 && cp <= 0xBF && cp != 0xAA && cp != 0xB2 && cp != 0xB3 && cp != 0xB5 && cp != 0xB9 && cp != 0xBA && !(cp >= 0xBC && cp <= 0xBE)) ||
+        cp == 0xD7 || cp == 0xF7 || (cp >= 0x2010 && cp <= 0x2027) || (cp >= 0x2030 && cp <= 0x205E) || (cp >= 0x20A0 && cp <= 0x20CF) ||
+        (cp >= 0x2190 && cp <= 0x23FF) || (cp >= 0x2500 && cp <= 0x27BF) || (cp >= 0x3001 && cp <= 0x3003) || (cp >= 0x3008 && cp <= 0x3011) ||
+        (cp >= 0x3014 && cp <= 0x301F) || (cp >= 0xFF01 && cp <= 0xFF0F) || (cp >= 0xFF1A && cp <= 0xFF20) || (cp >= 0xFF3B && cp <= 0xFF40) ||
+        (cp >= 0xFF5B && cp <= 0xFF65)) {
+        return CharClass::Punctuation;
+    }
+    return CharClass::Word;
+}
+
+CharClass ListMatcher::classAfter(const char* text, size_t textLength, size_t pos) const {
+    unsigned char lead = static_cast<unsigned char>(text[pos]);
+    if (lead < 0x80 || !isUtf8) {
+        return charClasses[lead];
+    }
+
+    size_t trail = (lead >= 0xF0) ? 3 : (lead >= 0xE0) ? 2 : (lead >= 0xC0) ? 1 : 0;
+    if (trail == 0 || pos + trail >= textLength) {
+        return charClasses[lead];
+    }
+
+    unsigned int cp = lead & (0x3F >> trail);
+    for (size_t i = 1; i <= trail; ++i) {
+        cp = (cp << 6) | (static_cast<unsigned char>(text[pos + i]) & 0x3F);
+    }
+    return classifyCodePoint(cp);
+}
+
+CharClass ListMatcher::classBefore(const char* text, size_t pos) const {
+    unsigned char last = static_cast<unsigned char>(text[pos - 1]);
+    if (last < 0x80 || !isUtf8) {
+        return charClasses[last];
+    }
+
+    // Step back over continuation bytes to the lead byte
+    size_t start = pos - 1;
+    while (start > 0 && pos - start < 4 && (static_cast<unsigned char>(text[start]) & 0xC0) == 0x80) {
+        --start;
+    }
+    return classAfter(text, pos, start);
+}
+
+bool ListMatcher::isWordAt(const char* text, size_t textLength, size_t start, size_t end) const {
+    // Same rules as Scintilla's Document::IsWordStartAt/IsWordEndAt, document edges count as space
+    CharClass first = classAfter(text, textLength, start);
+    CharClass before = (start > 0) ? classBefore(text, start) : CharClass::Space;
+    if ((first != CharClass::Word && first != CharClass::Punctuation) || first == before) {
+        return false;
+    }
+
+    CharClass last = classBefore(text, end);
+    CharClass after = (end < textLength) ? classAfter(text, textLength, end) : CharClass::Space;
+    return (last == CharClass::Word || last == CharClass::Punctuation) && last != after;
+}
+
+bool ListMatcher::verify(const char* text, size_t textLength, size_t pos, size_t length, const ListPattern& pat, bool checkWords) const {
+    if (pat.matchCase && std::memcmp(text + pos, pat.findText.data(), pat.findText.size()) != 0) {
+        return false;
+    }
+    if (checkWords && pat.wholeWord && !isWordAt(text, textLength, pos, pos + length)) {
+        return false;
+    }
+    return true;
+}
+
+size_t ListMatcher::replaceSequentially(std::string& text, const std::string& replacement, bool firstOnly) const {
+    std::vector<ListMatch> candidates;
+    findAll(text.data(), text.size(), 0, text.size(), candidates);
+    if (candidates.empty()) {
+        return 0;
+    }
+
+    std::vector<std::string> replacements = { replacement };
+    std::vector<ListMatch> selected;
+    if (firstOnly) {
+        selected.push_back(*std::min_element(candidates.begin(), candidates.end(),
+            [](const ListMatch& a, const ListMatch& b) { return a.pos < b.pos; }));
+    }
+    else {
+        selected = selectSequentialMatches(candidates);
+    }
+
+    if (!firstOnly && hasCascadingMatches(text.data(), text.size(), selected, replacements)) {
+        // A replacement changes the word boundary of the next occurrence: search step by step behind
+        // each replacement, the way the search in the document continues
+        size_t window = std::max(STEP_WINDOW, 2 * maxLength);
+        size_t count = 0;
+        size_t pos = 0;
+        while (pos < text.size()) {
+            size_t end = std::min(text.size(), pos + window);
+            size_t safeEnd = (end == text.size()) ? end : end - maxLength + 1;
+            candidates.clear();
+            findAll(text.data(), text.size(), pos, end, candidates);
+
+            const ListMatch* next = nullptr;
+            for (const ListMatch& candidate : candidates) {
+                if (candidate.pos < safeEnd && (next == nullptr || candidate.pos < next->pos)) {
+                    next = &candidate;
+                }
+            }
+            if (next == nullptr) {
+                pos = safeEnd;
+                continue;
+            }
+            text.replace(next->pos, next->length, replacement);
+            pos = next->pos + replacement.size();
+            ++count;
+        }
+        return count;
+    }
+
+    std::string replaced;
+    std::vector<size_t> positions;
+    ListMatcher::buildReplacedText(text.data(), text.size(), selected, replacements, replaced, positions);
+    text.swap(replaced);
+    return selected.size();
+}
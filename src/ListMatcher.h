@@ -0,0 +1,163 @@
+// This file is part of Notepad++ project
+// Copyright (C)2023 Thomas Knoefel
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef LIST_MATCHER_H
+#define LIST_MATCHER_H
+
+// Multi-pattern matcher for the literal entries of the replace list.
+// Works on plain byte buffers only (no Scintilla, no Win32), so the engine
+// can be driven from an in-memory buffer as well as from the document.
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+#include "LiteralScanner.h"
+
+// Same character classes Scintilla uses for SCFIND_WHOLEWORD
+enum class CharClass : unsigned char { Space, NewLine, Word, Punctuation };
+
+struct ListPattern {
+    std::string findText;   // Search bytes, already in document encoding
+    bool wholeWord = false;
+    bool matchCase = false;
+};
+
+struct ListMatch {
+    size_t pos = 0;
+    size_t length = 0;
+    size_t pattern = 0;     // Index into the pattern list, lower index = higher priority
+};
+
+// One range of the original text and the slice of the edit buffer that replaces it
+struct ListEdit {
+    size_t pos = 0;
+    size_t length = 0;
+    size_t bufferPos = 0;
+    size_t bufferLength = 0;
+    size_t matchCount = 0;
+};
+
+class ListMatcher
+{
+public:
+    // Bytes in front of and behind a range that decide word boundaries and UTF-8 character starts at its edges
+    static const size_t CONTEXT_LENGTH = 4;
+
+    // Returns length bytes of the text from start on, valid until the next call; for searches that read only part of it
+    using TextReader = std::function<const char*(size_t start, size_t length)>;
+
+    ListMatcher();
+
+    // Class table for single bytes; for UTF-8 text non-ASCII characters are classified by code point
+    void setCharClasses(const CharClass classes[256], bool utf8);
+    void build(const std::vector<ListPattern>& patterns);
+
+    bool empty() const { return patterns.empty(); }
+    size_t patternCount() const { return patterns.size(); }
+    size_t maxPatternLength() const { return maxLength; }
+    const ListPattern& pattern(size_t index) const { return patterns[index]; }
+
+    // Reports every occurrence of every pattern lying completely inside [rangeStart, rangeEnd).
+    // Occurrences may overlap; they are appended ordered by their end position.
+    void findAll(const char* text, size_t textLength, size_t rangeStart, size_t rangeEnd, std::vector<ListMatch>& matches) const;
+
+    // Same result as findAll(), with the range split into chunks of at least minChunkLength bytes that are
+    // scanned by up to threadCount threads. The text must not change until the call returns.
+    // Matches are appended grouped by chunk, each group ordered as findAll() orders them.
+    void findAllParallel(const char* text, size_t textLength, size_t rangeStart, size_t rangeEnd,
+        size_t threadCount, size_t minChunkLength, std::vector<ListMatch>& matches) const;
+
+    // The occurrence a forward search from rangeStart finds first: the one starting first in [rangeStart, rangeEnd).
+    // Scans chunks behind rangeStart, firstChunk bytes and doubled until one holds an occurrence, so the cost
+    // follows the distance to it. False if there is none.
+    bool findFirstChunked(const TextReader& read, size_t textLength, size_t rangeStart, size_t rangeEnd, size_t firstChunk, ListMatch& found) const;
+
+    // The occurrence a backward search from rangeEnd finds: the one starting last in [rangeStart, rangeEnd),
+    // scanning chunks in front of rangeEnd the same way
+    bool findLastChunked(const TextReader& read, size_t textLength, size_t rangeStart, size_t rangeEnd, size_t firstChunk, ListMatch& found) const;
+
+    // Picks the occurrences a sequential run (entry 1 everywhere, then entry 2, ...) would replace.
+    // Valid as long as hasCascadingMatches() reports no interaction between the entries.
+    std::vector<ListMatch> selectSequentialMatches(std::vector<ListMatch> candidates) const;
+
+    // Picks the occurrences each entry finds on its own (left to right, no overlap within the entry),
+    // ordered by pattern and position. This is what marking entry by entry produces.
+    static std::vector<ListMatch> selectPatternMatches(std::vector<ListMatch> candidates);
+
+    // Picks the occurrences of a simultaneous run that prefers the leftmost, then the longest occurrence
+    // (then the earlier entry); all entries are matched against the original text, ordered by position.
+    static std::vector<ListMatch> selectLeftmostLongestMatches(std::vector<ListMatch> candidates);
+
+    // True if an entry could match text produced (or word boundaries changed) by an earlier entry.
+    // In that case only a sequential run gives the expected result.
+    bool hasCascadingMatches(const char* text, size_t textLength, const std::vector<ListMatch>& selected,
+        const std::vector<std::string>& replacements) const;
+
+    // For a matcher of one entry: replaces its occurrences in text like a search that continues behind each
+    // replacement, or only the first one with firstOnly. Returns the number of replacements.
+    size_t replaceSequentially(std::string& text, const std::string& replacement, bool firstOnly) const;
+
+    // Builds the replaced text; outputPositions receives the start of each replacement in the output
+    static void buildReplacedText(const char* text, size_t textLength, const std::vector<ListMatch>& selected,
+        const std::vector<std::string>& replacements, std::string& output, std::vector<size_t>& outputPositions);
+
+    // Merges matches closer than maxGap into shared edits (each spanning at most maxSpan bytes) and
+    // writes the new text of all edits into one buffer, so few range replacements rebuild the document
+    static void buildEdits(const char* text, const std::vector<ListMatch>& selected, const std::vector<std::string>& replacements,
+        size_t maxGap, size_t maxSpan, std::vector<ListEdit>& edits, std::string& buffer);
+
+    static bool isAscii(const std::string& str);
+
+    // False for caseless non-ASCII patterns in single byte code pages, Scintilla folds them with the system code page
+    static bool isSupported(const ListPattern& pattern, bool utf8);
+
+    static CharClass classifyCodePoint(unsigned int codePoint);
+
+private:
+    std::vector<ListPattern> patterns;
+    size_t maxLength = 0;
+
+    // Automaton over folded bytes, transitions stored per byte class
+    unsigned short byteClass[256];
+    size_t classCount = 1;
+    std::vector<int> transitions;       // state * classCount + class
+    std::vector<int> stateOutput;       // First pattern ending in this state or -1
+    std::vector<int> dictionaryLink;    // Next suffix state with output or -1
+    std::vector<int> samePattern;       // Next pattern with identical folded text or -1
+    std::vector<size_t> stateDepth;
+    LiteralScanner literal;             // A single pattern is searched without the automaton
+    bool singleLiteral = false;
+    std::vector<LiteralScanner> foldScanners;   // Caseless UTF-8 patterns other characters fold into
+    std::vector<std::string> foldTriggers;      // Those characters; where none occurs the automaton is exact
+    std::string foldTriggerLeads;
+    bool foldAlways = false;                    // A pattern with invalid UTF-8 is never left to the automaton
+    bool wordPatternFirstByte[256];     // Folded first/last bytes of whole word patterns
+    bool wordPatternLastByte[256];
+
+    CharClass charClasses[256];
+    bool isUtf8 = true;
+
+    static unsigned char fold(unsigned char c) { return (c >= 'A' && c <= 'Z') ? static_cast<unsigned char>(c + 32) : c; }
+    CharClass classAfter(const char* text, size_t textLength, size_t pos) const;
+    CharClass classBefore(const char* text, size_t pos) const;
+    bool isWordAt(const char* text, size_t textLength, size_t start, size_t end) const;
+    void scan(const char* text, size_t textLength, size_t rangeStart, size_t rangeEnd, bool checkWords, std::vector<ListMatch>& matches) const;
+    bool verify(const char* text, size_t textLength, size_t pos, size_t length, const ListPattern& pat, bool checkWords) const;
+    bool hasFoldTrigger(const char* text, size_t rangeStart, size_t rangeEnd) const;
+    bool findInChunk(const TextReader& read, size_t textLength, size_t rangeStart, size_t rangeEnd, bool last, ListMatch& found) const;
+};
+
+#endif // LIST_MATCHER_H
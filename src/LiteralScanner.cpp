@@ -0,0 +1,407 @@
+// This file is part of Notepad++ project
+// Copyright (C)2023 Thomas Knoefel
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "LiteralScanner.h"
+#include "CaseFolding.h"
+
+#include <cstring>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define LITERAL_SCANNER_X86
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#define TARGET_AVX2
+#else
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define LITERAL_SCANNER_SSE2
+#endif
+#endif
+
+struct Needle {
+    const unsigned char* bytes;
+    size_t length;
+    bool caseless;
+    bool foldFirst;     // First and last byte are letters of a caseless needle, compared with bit 0x20 set
+    bool foldLast;
+};
+
+static const size_t MAX_VECTOR_BYTES = 8;   // Larger byte sets are looked up in a table, byte by byte
+
+static unsigned char fold(unsigned char c) {
+    return (c >= 'A' && c <= 'Z') ? static_cast<unsigned char>(c + 32) : c;
+}
+
+static bool isLowerLetter(unsigned char c) {
+    return c >= 'a' && c <= 'z';
+}
+
+static bool matchesAt(const unsigned char* text, const Needle& needle) {
+    if (!needle.caseless) {
+        return std::memcmp(text, needle.bytes, needle.length) == 0;
+    }
+    for (size_t i = 0; i < needle.length; ++i) {
+        if (fold(text[i]) != needle.bytes[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Callers guarantee rangeEnd >= from + needle.length
+static size_t findScalar(const unsigned char* text, size_t from, size_t rangeEnd, const Needle& needle) {
+    size_t lastStart = rangeEnd - needle.length;
+    unsigned char first = needle.bytes[0];
+
+    for (size_t pos = from; pos <= lastStart; ++pos) {
+        if (!needle.foldFirst) {
+            const void* hit = std::memchr(text + pos, first, lastStart - pos + 1);
+            if (hit == nullptr) {
+                break;
+            }
+            pos = static_cast<size_t>(static_cast<const unsigned char*>(hit) - text);
+        }
+        else if ((text[pos] | 0x20) != first) {
+            continue;
+        }
+
+        if (matchesAt(text + pos, needle)) {
+            return pos;
+        }
+    }
+    return rangeEnd;
+}
+
+static size_t findAnyScalar(const unsigned char* text, size_t from, size_t rangeEnd, const unsigned char* set, size_t count) {
+    if (from >= rangeEnd) {
+        return rangeEnd;
+    }
+    if (count == 1) {
+        const void* hit = std::memchr(text + from, set[0], rangeEnd - from);
+        return hit ? static_cast<size_t>(static_cast<const unsigned char*>(hit) - text) : rangeEnd;
+    }
+
+    bool member[256] = {};
+    for (size_t i = 0; i < count; ++i) {
+        member[set[i]] = true;
+    }
+    for (size_t pos = from; pos < rangeEnd; ++pos) {
+        if (member[text[pos]]) {
+            return pos;
+        }
+    }
+    return rangeEnd;
+}
+
+#ifdef LITERAL_SCANNER_X86
+
+static unsigned lowestBit(unsigned mask) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return static_cast<unsigned>(index);
+#else
+    return static_cast<unsigned>(__builtin_ctz(mask));
+#endif
+}
+
+#ifdef LITERAL_SCANNER_SSE2
+static size_t findSse2(const unsigned char* text, size_t from, size_t rangeEnd, const Needle& needle) {
+    const size_t width = 16;
+    size_t lastOffset = needle.length - 1;
+    const __m128i first = _mm_set1_epi8(static_cast<char>(needle.bytes[0]));
+    const __m128i last = _mm_set1_epi8(static_cast<char>(needle.bytes[lastOffset]));
+    const __m128i firstFold = _mm_set1_epi8(needle.foldFirst ? 0x20 : 0);
+    const __m128i lastFold = _mm_set1_epi8(needle.foldLast ? 0x20 : 0);
+
+    size_t pos = from;
+    for (; pos + lastOffset + width <= rangeEnd; pos += width) {
+        __m128i blockFirst = _mm_or_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(text + pos)), firstFold);
+        __m128i blockLast = _mm_or_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(text + pos + lastOffset)), lastFold);
+        unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(
+            _mm_and_si128(_mm_cmpeq_epi8(blockFirst, first), _mm_cmpeq_epi8(blockLast, last))));
+
+        while (mask != 0) {
+            size_t candidate = pos + lowestBit(mask);
+            if (matchesAt(text + candidate, needle)) {
+                return candidate;
+            }
+            mask &= mask - 1;
+        }
+    }
+    return findScalar(text, pos, rangeEnd, needle);
+}
+
+static size_t findAnySse2(const unsigned char* text, size_t from, size_t rangeEnd, const unsigned char* set, size_t count) {
+    const size_t width = 16;
+    if (count > MAX_VECTOR_BYTES) {
+        return findAnyScalar(text, from, rangeEnd, set, count);
+    }
+    __m128i wanted[MAX_VECTOR_BYTES];
+    for (size_t i = 0; i < count; ++i) {
+        wanted[i] = _mm_set1_epi8(static_cast<char>(set[i]));
+    }
+
+    size_t pos = from;
+    for (; pos + width <= rangeEnd; pos += width) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text + pos));
+        __m128i hits = _mm_cmpeq_epi8(block, wanted[0]);
+        for (size_t i = 1; i < count; ++i) {
+            hits = _mm_or_si128(hits, _mm_cmpeq_epi8(block, wanted[i]));
+        }
+        unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(hits));
+        if (mask != 0) {
+            return pos + lowestBit(mask);
+        }
+    }
+    return findAnyScalar(text, pos, rangeEnd, set, count);
+}
+#endif
+
+TARGET_AVX2 static size_t findAvx2(const unsigned char* text, size_t from, size_t rangeEnd, const Needle& needle) {
+    const size_t width = 32;
+    size_t lastOffset = needle.length - 1;
+    const __m256i first = _mm256_set1_epi8(static_cast<char>(needle.bytes[0]));
+    const __m256i last = _mm256_set1_epi8(static_cast<char>(needle.bytes[lastOffset]));
+    const __m256i firstFold = _mm256_set1_epi8(needle.foldFirst ? 0x20 : 0);
+    const __m256i lastFold = _mm256_set1_epi8(needle.foldLast ? 0x20 : 0);
+
+    size_t pos = from;
+    for (; pos + lastOffset + width <= rangeEnd; pos += width) {
+        __m256i blockFirst = _mm256_or_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(text + pos)), firstFold);
+        __m256i blockLast = _mm256_or_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(text + pos + lastOffset)), lastFold);
+        unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(
+            _mm256_and_si256(_mm256_cmpeq_epi8(blockFirst, first), _mm256_cmpeq_epi8(blockLast, last))));
+
+        while (mask != 0) {
+            size_t candidate = pos + lowestBit(mask);
+            if (matchesAt(text + candidate, needle)) {
+                return candidate;
+            }
+            mask &= mask - 1;
+        }
+    }
+    return findScalar(text, pos, rangeEnd, needle);
+}
+
+TARGET_AVX2 static size_t findAnyAvx2(const unsigned char* text, size_t from, size_t rangeEnd, const unsigned char* set, size_t count) {
+    const size_t width = 32;
+    if (count > MAX_VECTOR_BYTES) {
+        return findAnyScalar(text, from, rangeEnd, set, count);
+    }
+    __m256i wanted[MAX_VECTOR_BYTES];
+    for (size_t i = 0; i < count; ++i) {
+        wanted[i] = _mm256_set1_epi8(static_cast<char>(set[i]));
+    }
+
+    size_t pos = from;
+    for (; pos + width <= rangeEnd; pos += width) {
+        __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(text + pos));
+        __m256i hits = _mm256_cmpeq_epi8(block, wanted[0]);
+        for (size_t i = 1; i < count; ++i) {
+            hits = _mm256_or_si256(hits, _mm256_cmpeq_epi8(block, wanted[i]));
+        }
+        unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(hits));
+        if (mask != 0) {
+            return pos + lowestBit(mask);
+        }
+    }
+    return findAnyScalar(text, pos, rangeEnd, set, count);
+}
+
+static bool cpuHasAvx2() {
+#ifdef _MSC_VER
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) {
+        return false;
+    }
+
+    // The OS has to save the YMM registers too
+    __cpuid(info, 1);
+    bool osSavesAvx = (info[2] & (1 << 27)) != 0 && (info[2] & (1 << 28)) != 0 && (_xgetbv(0) & 6) == 6;
+    if (!osSavesAvx) {
+        return false;
+    }
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") != 0;
+#endif
+}
+
+#endif // LITERAL_SCANNER_X86
+
+typedef size_t(*FindFunction)(const unsigned char* text, size_t from, size_t rangeEnd, const Needle& needle);
+typedef size_t(*FindAnyFunction)(const unsigned char* text, size_t from, size_t rangeEnd, const unsigned char* set, size_t count);
+
+struct Kernel {
+    FindFunction find;
+    FindAnyFunction findAny;
+    const char* name;
+};
+
+static Kernel selectKernel() {
+#ifdef LITERAL_SCANNER_X86
+    if (cpuHasAvx2()) {
+        return { findAvx2, findAnyAvx2, "AVX2" };
+    }
+#endif
+#ifdef LITERAL_SCANNER_SSE2
+    return { findSse2, findAnySse2, "SSE2" };
+#else
+    return { findScalar, findAnyScalar, "scalar" };
+#endif
+}
+
+static Kernel& kernel() {
+    static Kernel selected = selectKernel();
+    return selected;
+}
+
+// Walks the characters from pos and compares their foldings with the folded needle, as Scintilla's
+// Document::FindText does: a character whose folding runs past the end of the needle does not match
+static bool matchesFoldedAt(const char* text, size_t pos, size_t rangeEnd, const std::string& folded, size_t& matchEnd) {
+    size_t index = 0;
+    while (index < folded.size()) {
+        if (pos >= rangeEnd) {
+            return false;
+        }
+        unsigned char ch = static_cast<unsigned char>(text[pos]);
+        if (ch < 0x80) {
+            if (fold(ch) != static_cast<unsigned char>(folded[index])) {
+                return false;
+            }
+            ++index;
+            ++pos;
+            continue;
+        }
+
+        const char* piece;
+        size_t pieceLength;
+        size_t width = CaseFolding::foldCharacter(text, rangeEnd, pos, piece, pieceLength);
+        if (pieceLength > folded.size() - index || std::memcmp(piece, folded.data() + index, pieceLength) != 0) {
+            return false;
+        }
+        index += pieceLength;
+        pos += width;
+    }
+    matchEnd = pos;
+    return true;
+}
+
+// Scintilla only tries positions where a character starts; a needle of invalid UTF-8 may begin with a trail byte
+static bool isCharacterStart(const char* text, size_t textLength, size_t pos) {
+    if ((static_cast<unsigned char>(text[pos]) & 0xC0) != 0x80) {
+        return true;
+    }
+    for (size_t back = 1; back <= 3 && back <= pos; ++back) {
+        unsigned int codePoint;
+        if (CaseFolding::decode(text, textLength, pos - back, codePoint) > back) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void LiteralScanner::setPattern(const std::string& findText, bool matchCase, bool utf8) {
+    needle = findText;
+    caseless = !matchCase;
+    unicode = false;
+    leadBytes.clear();
+    if (!caseless) {
+        return;
+    }
+
+    // Folding ASCII letters is enough unless some character in the text can fold into the needle,
+    // or the needle holds invalid UTF-8 that must not match inside a valid character
+    std::string folded = utf8 ? CaseFolding::fold(findText) : std::string();
+    if (utf8 && (!CaseFolding::charactersFoldingInto(folded).empty() || !CaseFolding::isValid(findText))) {
+        needle = folded;
+        leadBytes = CaseFolding::leadBytesFoldingTo(folded);
+        unicode = true;
+        return;
+    }
+    for (char& ch : needle) {
+        ch = static_cast<char>(fold(static_cast<unsigned char>(ch)));
+    }
+}
+
+size_t LiteralScanner::find(const char* text, size_t from, size_t rangeEnd, size_t& matchLength) const {
+    matchLength = needle.size();
+    if (unicode) {
+        const unsigned char* bytes = reinterpret_cast<const unsigned char*>(text);
+        const unsigned char* set = reinterpret_cast<const unsigned char*>(leadBytes.data());
+        for (size_t pos = kernel().findAny(bytes, from, rangeEnd, set, leadBytes.size()); pos < rangeEnd;
+            pos = kernel().findAny(bytes, pos + 1, rangeEnd, set, leadBytes.size())) {
+            size_t matchEnd;
+            if (isCharacterStart(text, rangeEnd, pos) && matchesFoldedAt(text, pos, rangeEnd, needle, matchEnd)) {
+                matchLength = matchEnd - pos;
+                return pos;
+            }
+        }
+        return rangeEnd;
+    }
+
+    if (needle.empty() || rangeEnd < needle.size() || from > rangeEnd - needle.size()) {
+        return rangeEnd;
+    }
+
+    Needle search;
+    search.bytes = reinterpret_cast<const unsigned char*>(needle.data());
+    search.length = needle.size();
+    search.caseless = caseless;
+    search.foldFirst = caseless && isLowerLetter(search.bytes[0]);
+    search.foldLast = caseless && isLowerLetter(search.bytes[search.length - 1]);
+    return kernel().find(reinterpret_cast<const unsigned char*>(text), from, rangeEnd, search);
+}
+
+size_t LiteralScanner::findAnyByte(const char* text, size_t from, size_t rangeEnd, const std::string& bytes) {
+    if (bytes.empty()) {
+        return rangeEnd;
+    }
+    return kernel().findAny(reinterpret_cast<const unsigned char*>(text), from, rangeEnd,
+        reinterpret_cast<const unsigned char*>(bytes.data()), bytes.size());
+}
+
+const char* LiteralScanner::kernelName() {
+    return kernel().name;
+}
+
+bool LiteralScanner::useKernel(const std::string& name) {
+    Kernel wanted;
+    if (name == "scalar") {
+        wanted = { findScalar, findAnyScalar, "scalar" };
+    }
+#ifdef LITERAL_SCANNER_SSE2
+    else if (name == "SSE2") {
+        wanted = { findSse2, findAnySse2, "SSE2" };
+    }
+#endif
+#ifdef LITERAL_SCANNER_X86
+    else if (name == "AVX2" && cpuHasAvx2()) {
+        wanted = { findAvx2, findAnyAvx2, "AVX2" };
+    }
+#endif
+    else {
+        return false;
+    }
+    kernel() = wanted;
+    return true;
+}
@@ -0,0 +1,64 @@
+// This file is part of Notepad++ project
+// Copyright (C)2023 Thomas Knoefel
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef LITERAL_SCANNER_H
+#define LITERAL_SCANNER_H
+
+// Search for one literal byte string in a contiguous buffer.
+// Candidates are found by comparing the first and the last byte of the needle against a whole
+// vector of text positions at once (AVX2 or SSE2, picked at runtime), then verified byte by byte.
+// Without SIMD support a scalar loop gives the same results.
+// Caseless needles in UTF-8 text that other characters fold into (final sigma, sharp s, Kelvin sign) are compared
+// with full Unicode case folding instead; their candidates are the positions holding a lead byte
+// of a character that can start an occurrence.
+
+#include <cstddef>
+#include <string>
+
+class LiteralScanner
+{
+public:
+    // Without matchCase ASCII letters match in either case and all other bytes must be equal,
+    // unless utf8 is set: then characters match like in Scintilla's case-insensitive UTF-8 search
+    void setPattern(const std::string& findText, bool matchCase, bool utf8 = false);
+
+    // True if occurrences are compared with Unicode case folding and may differ in length from the needle
+    bool foldsUnicode() const { return unicode; }
+
+    // Upper bound of the length of an occurrence; no character folds to less than a third of its bytes (Kelvin sign to k)
+    size_t maxMatchLength() const { return unicode ? 3 * needle.size() : needle.size(); }
+
+    // Start of the first occurrence at or behind from that ends before rangeEnd, or rangeEnd if there is none.
+    // matchLength receives the length of the occurrence.
+    size_t find(const char* text, size_t from, size_t rangeEnd, size_t& matchLength) const;
+
+    // First position in [from, rangeEnd) holding one of the given bytes, or rangeEnd
+    static size_t findAnyByte(const char* text, size_t from, size_t rangeEnd, const std::string& bytes);
+
+    // Name of the kernel find() uses on this machine
+    static const char* kernelName();
+
+    // Makes all scanners use the kernel "AVX2", "SSE2" or "scalar" instead of the one picked at runtime, for
+    // tests and benchmarks. Not thread safe. False if the kernel is not available on this machine.
+    static bool useKernel(const std::string& name);
+
+private:
+    std::string needle;     // Lower case if caseless, Unicode folded in Unicode mode
+    std::string leadBytes;  // Unicode mode: first bytes of the characters an occurrence can start with
+    bool caseless = false;
+    bool unicode = false;
+};
+
+#endif // LITERAL_SCANNER_H
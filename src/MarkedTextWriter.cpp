@@ -0,0 +1,134 @@
+// This file is part of Notepad++ project
+// Copyright (C)2023 Thomas Knoefel
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "MarkedTextWriter.h"
+
+#include <algorithm>
+
+// Bytes of the UTF-8 character starting with lead
+static size_t sequenceLength(unsigned char lead) {
+    if (lead >= 0xF0) {
+        return 4;
+    }
+    if (lead >= 0xE0) {
+        return 3;
+    }
+    return (lead >= 0xC0) ? 2 : 1;
+}
+
+MarkedTextWriter::MarkedTextWriter(MarkedTextFormat outputFormat, const std::string& lineEnd, Sink output)
+    : format(outputFormat), eol(lineEnd), sink(std::move(output)) {
+    if (format == MarkedTextFormat::Csv) {
+        buffer = "Line,Column,Entry,Text" + eol;
+    }
+}
+
+bool MarkedTextWriter::beginBlock(size_t line, size_t column, const std::string& entry) {
+    switch (format) {
+    case MarkedTextFormat::Positions:
+        buffer += std::to_string(line + 1) + ":" + std::to_string(column + 1) + "\t";
+        break;
+    case MarkedTextFormat::Csv:
+        buffer += std::to_string(line + 1) + "," + std::to_string(column + 1) + ",";
+        appendCsvField(entry.data(), entry.size());
+        buffer += ",\"";
+        break;
+    default:
+        break;
+    }
+    ++blocks;
+    return !failed;
+}
+
+bool MarkedTextWriter::appendText(const char* text, size_t length) {
+    // Long blocks are taken in pieces, so the buffer stays within a few times FLUSH_LENGTH
+    size_t done = 0;
+    while (done < length && !failed) {
+        size_t piece = std::min(length - done, FLUSH_LENGTH);
+        if (format == MarkedTextFormat::Csv) {
+            for (size_t i = done; i < done + piece; ++i) {
+                buffer += text[i];
+                if (text[i] == '"') {
+                    buffer += '"';
+                }
+            }
+        }
+        else {
+            buffer.append(text + done, piece);
+        }
+        done += piece;
+        flushIfFull();
+    }
+    return !failed;
+}
+
+bool MarkedTextWriter::endBlock() {
+    switch (format) {
+    case MarkedTextFormat::Plain:
+        break;
+    case MarkedTextFormat::Csv:
+        buffer += "\"" + eol;
+        break;
+    default:
+        buffer += eol;
+        break;
+    }
+    return flushIfFull();
+}
+
+bool MarkedTextWriter::finish() {
+    if (!failed && !buffer.empty()) {
+        failed = !sink(buffer.data(), buffer.size());
+        buffer.clear();
+    }
+    return !failed;
+}
+
+void MarkedTextWriter::appendCsvField(const char* text, size_t length) {
+    // Quoted only where needed, like the list CSV; the text field is always quoted since it comes in pieces
+    bool needsQuotes = std::any_of(text, text + length, [](char ch) { return ch == ',' || ch == '"' || ch == '\r' || ch == '\n'; });
+    if (!needsQuotes) {
+        buffer.append(text, length);
+        return;
+    }
+    buffer += '"';
+    for (size_t i = 0; i < length; ++i) {
+        buffer += text[i];
+        if (text[i] == '"') {
+            buffer += '"';
+        }
+    }
+    buffer += '"';
+}
+
+bool MarkedTextWriter::flushIfFull() {
+    if (failed || buffer.size() < FLUSH_LENGTH) {
+        return !failed;
+    }
+
+    // A character cut at the end waits for the next piece
+    size_t cut = buffer.size() - 1;
+    while (cut > 0 && (static_cast<unsigned char>(buffer[cut]) & 0xC0) == 0x80) {
+        --cut;
+    }
+    if (buffer.size() - cut >= sequenceLength(static_cast<unsigned char>(buffer[cut]))) {
+        cut = buffer.size();
+    }
+
+    failed = !sink(buffer.data(), cut);
+    buffer.erase(0, cut);
+    return !failed;
+}
@@ -0,0 +1,70 @@
+// This file is part of Notepad++ project
+// Copyright (C)2023 Thomas Knoefel
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef MARKED_TEXT_WRITER_H
+#define MARKED_TEXT_WRITER_H
+
+// Formats marked blocks of text as UTF-8 and hands them to a sink in pieces of about FLUSH_LENGTH bytes,
+// so an export of any size holds no more than one piece. A piece always ends behind a whole character.
+
+#include <cstddef>
+#include <functional>
+#include <string>
+
+enum class MarkedTextFormat {
+    Plain,      // The blocks one after the other, as Copy Marked Text always did
+    Lines,      // One block per line
+    Positions,  // One block per line behind its line and column
+    Csv         // Line, column, entry and text with a header row
+};
+
+class MarkedTextWriter
+{
+public:
+    static const size_t FLUSH_LENGTH = 1 << 20;
+
+    // Takes a piece of the output, returns false to stop the export
+    using Sink = std::function<bool(const char* data, size_t length)>;
+
+    MarkedTextWriter(MarkedTextFormat outputFormat, const std::string& lineEnd, Sink output);
+
+    // A block is written as beginBlock, any number of appendText calls with its UTF-8 text and endBlock.
+    // Line and column are zero based; entry is the list entry the block was marked for.
+    // Each call returns false once the sink has stopped the export.
+    bool beginBlock(size_t line, size_t column, const std::string& entry);
+    bool appendText(const char* text, size_t length);
+    bool endBlock();
+
+    // Hands over the rest of the output
+    bool finish();
+
+    size_t blockCount() const { return blocks; }
+
+    // True if the format shows line and column, otherwise beginBlock ignores them
+    bool writesPositions() const { return format == MarkedTextFormat::Positions || format == MarkedTextFormat::Csv; }
+
+private:
+    MarkedTextFormat format;
+    std::string eol;
+    Sink sink;
+    std::string buffer;
+    size_t blocks = 0;
+    bool failed = false;
+
+    void appendCsvField(const char* text, size_t length);
+    bool flushIfFull();
+};
+
+#endif // MARKED_TEXT_WRITER_H
@@ -0,0 +1,128 @@
+// This file is part of Notepad++ project
+// Copyright (C)2023 Thomas Knoefel
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "MatchIndex.h"
+
+#include <algorithm>
+
+static bool isOrderedBefore(const ListMatch& a, const ListMatch& b) {
+    return a.pos != b.pos ? a.pos < b.pos : a.pattern < b.pattern;
+}
+
+void MatchIndex::assign(std::vector<ListMatch> found, size_t entryCount, size_t maxMatchLength) {
+    matches = std::move(found);
+    std::sort(matches.begin(), matches.end(), isOrderedBefore);
+    entries = entryCount;
+    counts.assign(entryCount, 0);
+    for (const ListMatch& match : matches) {
+        counts[match.pattern]++;
+    }
+    maxLength = maxMatchLength;
+    touchStart = 0;
+    touchEnd = 0;
+    active = true;
+}
+
+void MatchIndex::clear() {
+    matches.clear();
+    matches.shrink_to_fit();
+    counts.clear();
+    active = false;
+}
+
+const ListMatch* MatchIndex::next(size_t pos) const {
+    auto it = std::lower_bound(matches.begin(), matches.end(), pos,
+        [](const ListMatch& match, size_t start) { return match.pos < start; });
+    return (it != matches.end()) ? &*it : nullptr;
+}
+
+const ListMatch* MatchIndex::previous(size_t pos) const {
+    auto it = std::lower_bound(matches.begin(), matches.end(), pos,
+        [](const ListMatch& match, size_t start) { return match.pos < start; });
+
+    // Walk back until no earlier occurrence can end behind the best one; the first qualifying
+    // occurrence of an entry is the one its own backward search stops at
+    const ListMatch* best = nullptr;
+    std::vector<bool> decided(entries, false);
+    while (it != matches.begin()) {
+        const ListMatch& match = *--it;
+        size_t bestEnd = best ? best->pos + best->length : 0;
+        if (best && match.pos + maxLength < bestEnd) {
+            break;
+        }
+        if (decided[match.pattern] || match.pos + match.length > pos) {
+            continue;
+        }
+        decided[match.pattern] = true;
+
+        size_t end = match.pos + match.length;
+        if (!best || end > bestEnd || (end == bestEnd && match.pattern < best->pattern)) {
+            best = &match;
+        }
+    }
+    return best;
+}
+
+bool MatchIndex::touches(const ListMatch& match) const {
+    return match.pos <= touchEnd && match.pos + match.length >= touchStart;
+}
+
+void MatchIndex::replaced(size_t pos, size_t length, size_t newLength, size_t& rescanStart, size_t& rescanEnd) {
+    touchStart = (pos > EDGE) ? pos - EDGE : 0;
+    touchEnd = pos + length + EDGE;
+
+    // Occurrences starting in reach of the edit are dropped if they come close to it
+    size_t reach = touchStart > maxLength ? touchStart - maxLength : 0;
+    auto first = std::lower_bound(matches.begin(), matches.end(), reach,
+        [](const ListMatch& match, size_t start) { return match.pos < start; });
+    auto last = std::upper_bound(first, matches.end(), touchEnd,
+        [](size_t end, const ListMatch& match) { return end < match.pos; });
+    for (auto it = first; it != last; ++it) {
+        if (touches(*it)) {
+            counts[it->pattern]--;
+        }
+    }
+    auto kept = std::remove_if(first, last, [this](const ListMatch& match) { return touches(match); });
+    size_t tail = static_cast<size_t>(kept - matches.begin());
+    matches.erase(kept, last);
+
+    for (size_t i = tail; i < matches.size(); ++i) {
+        matches[i].pos = matches[i].pos - length + newLength;
+    }
+
+    touchEnd = pos + newLength + EDGE;
+    rescanStart = reach;
+    rescanEnd = touchEnd + maxLength;
+}
+
+void MatchIndex::addRescanned(const std::vector<ListMatch>& found) {
+    std::vector<ListMatch> added;
+    for (const ListMatch& match : found) {
+        if (touches(match)) {
+            added.push_back(match);
+            counts[match.pattern]++;
+        }
+    }
+    if (added.empty()) {
+        return;
+    }
+
+    // A long new occurrence can start before a short one kept in front of the edit, so merge instead of inserting a block
+    std::sort(added.begin(), added.end(), isOrderedBefore);
+    size_t middle = matches.size();
+    matches.insert(matches.end(), added.begin(), added.end());
+    std::inplace_merge(matches.begin(), matches.begin() + middle, matches.end(), isOrderedBefore);
+}
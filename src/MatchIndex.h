@@ -0,0 +1,72 @@
+// This file is part of Notepad++ project
+// Copyright (C)2023 Thomas Knoefel
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef MATCH_INDEX_H
+#define MATCH_INDEX_H
+
+// Every occurrence of the literal list entries in one document, sorted by position, so list Find Next
+// and Find Previous are a binary search instead of one document search per entry.
+// Edits only drop and rescan the occurrences close to the changed text; the rest is moved along.
+
+#include <cstddef>
+#include <vector>
+#include "ListMatcher.h"
+
+class MatchIndex
+{
+public:
+    // Bytes around an edit that decide whether an occurrence still matches
+    static const size_t EDGE = ListMatcher::CONTEXT_LENGTH;
+
+    // Occurrences as ListMatcher::findAll() reports them, with pattern set to the list entry;
+    // maxMatchLength is the longest occurrence the matcher can report
+    void assign(std::vector<ListMatch> matches, size_t entryCount, size_t maxMatchLength);
+    void clear();
+
+    bool isActive() const { return active; }
+    size_t size() const { return matches.size(); }
+
+    // Occurrences of one entry, overlapping ones counted separately
+    size_t count(size_t entry) const { return entry < counts.size() ? counts[entry] : 0; }
+
+    // The occurrence a forward search of every entry from pos finds first: the one starting first at or
+    // behind pos, the lower entry on a tie. nullptr if there is none.
+    const ListMatch* next(size_t pos) const;
+
+    // The occurrence a backward search of every entry from pos finds: each entry contributes its last
+    // occurrence starting before pos and ending at or before it, of these the one ending last wins,
+    // the lower entry on a tie. nullptr if there is none.
+    const ListMatch* previous(size_t pos) const;
+
+    // Text of length bytes at pos was replaced by newLength bytes. Drops the occurrences the edit may
+    // have changed, moves the ones behind it and sets the range the caller has to search again.
+    void replaced(size_t pos, size_t length, size_t newLength, size_t& rescanStart, size_t& rescanEnd);
+
+    // Adds the occurrences found in the range of the last replaced() call; the ones it kept are skipped
+    void addRescanned(const std::vector<ListMatch>& found);
+
+private:
+    std::vector<ListMatch> matches;     // By position, then entry
+    std::vector<size_t> counts;         // Per entry
+    size_t entries = 0;
+    size_t maxLength = 0;
+    size_t touchStart = 0;              // Occurrences reaching into [touchStart, touchEnd] were dropped by the last edit
+    size_t touchEnd = 0;
+    bool active = false;
+
+    bool touches(const ListMatch& match) const;
+};
+
+#endif // MATCH_INDEX_H
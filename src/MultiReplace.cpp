@@ -82,6 +82,14 @@ extern "C" __declspec(dllexport) void beNotified(SCNotification * notifyCode)
         {
             MultiReplace::onSelectionChanged();
         }
+        if (notifyCode->updated & SC_UPDATE_CONTENT)
+        {
+            MultiReplace::onContentChanged();
+        }
+        if (notifyCode->updated & (SC_UPDATE_V_SCROLL | SC_UPDATE_H_SCROLL))
+        {
+            MultiReplace::onViewportChanged();
+        }
         MultiReplace::onCaretPositionChanged();
     }
     break;
@@ -92,6 +100,10 @@ extern "C" __declspec(dllexport) void beNotified(SCNotification * notifyCode)
         {
             MultiReplace::onTextChanged();
             MultiReplace::processTextChange(notifyCode);
+            MultiReplace::processMatchIndexChange(notifyCode);
+            MultiReplace::processHitChange(notifyCode);
+            MultiReplace::processLiveSearchChange(notifyCode);
+            MultiReplace::processMarkChange(notifyCode);
             MultiReplace::processLog();
         }
     }
@@ -103,6 +115,12 @@ extern "C" __declspec(dllexport) void beNotified(SCNotification * notifyCode)
     }
     break;
 
+    case NPPN_FILEBEFORECLOSE:
+    {
+        MultiReplace::onDocumentClosed();
+    }
+    break;
+
     case NPPN_DARKMODECHANGED:
     {
         ::SendMessage(nppData._nppHandle, NPPM_DARKMODESUBCLASSANDTHEME, static_cast<WPARAM>(NppDarkMode::dmfHandleChange), reinterpret_cast<LPARAM>(_MultiReplace.getHSelf()));
@@ -24,7 +24,9 @@
 
 #include <algorithm>
 #include <bitset>
+#include <cmath>
 #include <codecvt>
+#include <cstdint>
 #include <Commctrl.h>
 #include <fstream>
 #include <functional>
@@ -35,6 +37,7 @@
 #include <set>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 #include <windows.h>
@@ -58,6 +61,7 @@ bool MultiReplace::textModified = true;
 bool MultiReplace::documentSwitched = false;
 bool MultiReplace::isCaretPositionEnabled = false;
 bool MultiReplace::isLuaErrorDialogEnabled = true;
+bool MultiReplace::isBatchEditActive = false;
 int MultiReplace::scannedDelimiterBufferID = -1;
 std::map<int, ControlInfo> MultiReplace::ctrlMap;
 std::vector<MultiReplace::LogEntry> MultiReplace::logChanges;
@@ -106,10 +110,12 @@ void MultiReplace::positionAndResizeControls(int windowWidth, int windowHeight)
     ctrlMap[IDC_USE_VARIABLES_CHECKBOX] = { 20, 172, 155, 25, WC_BUTTON, L"Use Variables", BS_AUTOCHECKBOX | WS_TABSTOP, L"In 'Replace with:' e.g. `set(CNT..\" times.\")` or `cond(LINE<=10 and LPOS<3,\"Top\")`" };
     ctrlMap[IDC_WRAP_AROUND_CHECKBOX] = { 20, 201, 120, 25, WC_BUTTON, L"Wrap around", BS_AUTOCHECKBOX | WS_TABSTOP, NULL };
 
-    ctrlMap[IDC_SEARCH_MODE_GROUP] = { 195, 90, 200, 116, WC_BUTTON, L"Search Mode", BS_GROUPBOX, NULL };
+    ctrlMap[IDC_SEARCH_MODE_GROUP] = { 195, 90, 200, 145, WC_BUTTON, L"Search Mode", BS_GROUPBOX, NULL };
     ctrlMap[IDC_NORMAL_RADIO] = { 205, 114, 100, 25, WC_BUTTON, L"Normal", BS_AUTORADIOBUTTON | WS_GROUP | WS_TABSTOP, NULL };
     ctrlMap[IDC_EXTENDED_RADIO] = { 205, 143, 180, 25, WC_BUTTON, L"Extended (\\n, \\r, \\t, \\0, \\x...)", BS_AUTORADIOBUTTON | WS_TABSTOP, NULL };
     ctrlMap[IDC_REGEX_RADIO] = { 205, 172, 175, 25, WC_BUTTON, L"Regular expression", BS_AUTORADIOBUTTON | WS_TABSTOP, NULL };
+    ctrlMap[IDC_FUZZY_RADIO] = { 205, 201, 100, 25, WC_BUTTON, L"Fuzzy, edits:", BS_AUTORADIOBUTTON | WS_TABSTOP, L"Also finds text that differs by up to this many inserted, deleted or replaced characters" };
+    ctrlMap[IDC_FUZZY_DISTANCE_EDIT] = { 310, 203, 20, 20, WC_EDIT, NULL, ES_LEFT | ES_NUMBER | WS_BORDER | WS_TABSTOP, L"Edits: 1-9" };
     
     ctrlMap[IDC_SCOPE_GROUP] = { 410, 90, 247, 145, WC_BUTTON, L"Scope", BS_GROUPBOX, NULL };
     ctrlMap[IDC_ALL_TEXT_RADIO] = { 420, 114, 100, 25, WC_BUTTON, L"All Text", BS_AUTORADIOBUTTON | WS_GROUP | WS_TABSTOP, NULL };
@@ -140,7 +146,7 @@ void MultiReplace::positionAndResizeControls(int windowWidth, int windowHeight)
     ctrlMap[IDC_FIND_PREV_BUTTON] = { buttonX, 143, 35, 30, WC_BUTTON, L"\u25B2", BS_PUSHBUTTON | WS_TABSTOP, NULL };
     ctrlMap[IDC_MARK_BUTTON] = { buttonX, 178, 160, 30, WC_BUTTON, L"Mark Matches", BS_PUSHBUTTON | WS_TABSTOP, NULL };
     ctrlMap[IDC_MARK_MATCHES_BUTTON] = { buttonX, 178, 120, 30, WC_BUTTON, L"Mark Matches", BS_PUSHBUTTON | WS_TABSTOP, NULL };
-    ctrlMap[IDC_COPY_MARKED_TEXT_BUTTON] = { buttonX + 125, 178, 35, 30, WC_BUTTON, L"\U0001F5CD", BS_PUSHBUTTON | WS_TABSTOP, L"Copy to Clipboard" };
+    ctrlMap[IDC_COPY_MARKED_TEXT_BUTTON] = { buttonX + 125, 178, 35, 30, WC_BUTTON, L"\U0001F5CD", BS_PUSHBUTTON | WS_TABSTOP, L"Copy to Clipboard (Shift+Click: Export)" };
     ctrlMap[IDC_CLEAR_MARKS_BUTTON] = { buttonX, 213, 160, 30, WC_BUTTON, L"Clear all marks", BS_PUSHBUTTON | WS_TABSTOP, NULL };
     ctrlMap[IDC_LOAD_FROM_CSV_BUTTON] = { buttonX, 269, 160, 30, WC_BUTTON, L"Load List", BS_PUSHBUTTON | WS_TABSTOP, NULL };
     ctrlMap[IDC_SAVE_TO_CSV_BUTTON] = { buttonX, 304, 160, 30, WC_BUTTON, L"Save List", BS_PUSHBUTTON | WS_TABSTOP, NULL };
@@ -151,6 +157,7 @@ void MultiReplace::positionAndResizeControls(int windowWidth, int windowHeight)
     ctrlMap[IDC_SHIFT_TEXT] = { buttonX + 38, 389 + 20, 60, 20, WC_STATIC, L"Shift Lines", SS_LEFT, NULL };
     ctrlMap[IDC_STATIC_FRAME] = { frameX, 90, 285, 165, WC_BUTTON, L"", BS_GROUPBOX, NULL };
     ctrlMap[IDC_REPLACE_LIST] = { 14, 274, listWidth, listHeight, WC_LISTVIEW, NULL, LVS_REPORT | LVS_OWNERDATA | WS_BORDER | WS_TABSTOP | WS_VSCROLL | LVS_SHOWSELALWAYS, NULL };
+    ctrlMap[IDC_DENSITY_STRIP] = { 14 + listWidth + 4, 274, DENSITY_STRIP_WIDTH, listHeight, WC_STATIC, NULL, SS_OWNERDRAW | SS_NOTIFY, L"Where the Hits of the selected entry, or of all entries, lie in the document. Click: go there, Shift+Click: next dense region" };
     ctrlMap[IDC_USE_LIST_CHECKBOX] = { checkboxX, 165, 80, 25, WC_BUTTON, L"Use List", BS_AUTOCHECKBOX | WS_TABSTOP, NULL };
 }
 
@@ -184,8 +191,10 @@ void MultiReplace::initializeCtrlMap()
         SendMessage(GetDlgItem(_hSelf, pair.first), WM_SETFONT, (WPARAM)_hFont, TRUE);
     }
 
-    // Limit the input for IDC_QUOTECHAR_EDIT to one character
+    // Limit the input for IDC_QUOTECHAR_EDIT and IDC_FUZZY_DISTANCE_EDIT to one character
     SendMessage(GetDlgItem(_hSelf, IDC_QUOTECHAR_EDIT), EM_SETLIMITTEXT, (WPARAM)1, 0);
+    SendMessage(GetDlgItem(_hSelf, IDC_FUZZY_DISTANCE_EDIT), EM_SETLIMITTEXT, (WPARAM)1, 0);
+    SetDlgItemTextW(_hSelf, IDC_FUZZY_DISTANCE_EDIT, L"1");
 
     // Set the larger, bolder font for the swap, copy and refresh button
     HFONT hLargerBolderFont = CreateFont(28, 0, 0, 0, FW_BOLD, FALSE, FALSE, FALSE, DEFAULT_CHARSET, 0, 0, 0, 0, TEXT("Courier New"));
@@ -196,7 +205,7 @@ void MultiReplace::initializeCtrlMap()
     SendMessage(GetDlgItem(_hSelf, IDC_REPLACE_ALL_SMALL_BUTTON), WM_SETFONT, (WPARAM)hLargerBolderFont1, TRUE);
 
     // CheckBox to Normal
-    CheckRadioButton(_hSelf, IDC_NORMAL_RADIO, IDC_REGEX_RADIO, IDC_NORMAL_RADIO);
+    CheckRadioButton(_hSelf, IDC_NORMAL_RADIO, IDC_FUZZY_RADIO, IDC_NORMAL_RADIO);
 
     // CheckBox to All Text
     CheckRadioButton(_hSelf, IDC_ALL_TEXT_RADIO, IDC_COLUMN_MODE_RADIO, IDC_ALL_TEXT_RADIO);
@@ -323,7 +332,7 @@ void MultiReplace::moveAndResizeControls() {
         IDC_REPLACE_BUTTON, IDC_REPLACE_ALL_SMALL_BUTTON, IDC_2_BUTTONS_MODE, IDC_FIND_BUTTON, IDC_FIND_NEXT_BUTTON,
         IDC_FIND_PREV_BUTTON, IDC_MARK_BUTTON, IDC_MARK_MATCHES_BUTTON, IDC_CLEAR_MARKS_BUTTON, IDC_COPY_MARKED_TEXT_BUTTON,
         IDC_USE_LIST_CHECKBOX, IDC_LOAD_FROM_CSV_BUTTON, IDC_SAVE_TO_CSV_BUTTON, IDC_SHIFT_FRAME, IDC_UP_BUTTON, IDC_DOWN_BUTTON,
-        IDC_SHIFT_TEXT, IDC_EXPORT_BASH_BUTTON
+        IDC_SHIFT_TEXT, IDC_EXPORT_BASH_BUTTON, IDC_DENSITY_STRIP
     };
 
     std::unordered_map<int, HWND> hwndMap;  // Store HWNDs to avoid multiple calls to GetDlgItem
@@ -361,7 +370,8 @@ void MultiReplace::moveAndResizeControls() {
     const int redrawIds[] = {
         IDC_USE_LIST_CHECKBOX, IDC_COPY_TO_LIST_BUTTON, IDC_REPLACE_ALL_BUTTON, IDC_REPLACE_BUTTON, IDC_REPLACE_ALL_SMALL_BUTTON,
         IDC_2_BUTTONS_MODE, IDC_FIND_BUTTON, IDC_FIND_NEXT_BUTTON, IDC_FIND_PREV_BUTTON, IDC_MARK_BUTTON, IDC_MARK_MATCHES_BUTTON,
-        IDC_CLEAR_MARKS_BUTTON, IDC_COPY_MARKED_TEXT_BUTTON, IDC_SHIFT_FRAME, IDC_UP_BUTTON, IDC_DOWN_BUTTON, IDC_SHIFT_TEXT
+        IDC_CLEAR_MARKS_BUTTON, IDC_COPY_MARKED_TEXT_BUTTON, IDC_SHIFT_FRAME, IDC_UP_BUTTON, IDC_DOWN_BUTTON, IDC_SHIFT_TEXT,
+        IDC_DENSITY_STRIP
     };
 
     // Redraw controls using stored HWNDs
@@ -449,8 +459,8 @@ void MultiReplace::createListViewColumns(HWND listView) {
     // Calculate the remaining width for the first two columns
     int remainingWidth = windowWidth - 281;
 
-    // Calculate the total width of columns 3 to 8
-    int columns3to7Width = 30 * 7; // Assuming fixed width of 30 for columns 3 to 8
+    // Calculate the total width of columns 3 to 9
+    int columns3to7Width = 30 * 8 + HITS_COLUMN_WIDTH; // Assuming fixed width of 30 for columns 3 to 9, and the Hits column
 
     remainingWidth -= columns3to7Width;
 
@@ -509,12 +519,26 @@ void MultiReplace::createListViewColumns(HWND listView) {
     lvc.cx = 30;
     ListView_InsertColumn(listView, 8, &lvc);
 
-    // Column for Delete Button
+    // Column for Option: Fuzzy
     lvc.iSubItem = 9;
-    lvc.pszText = L"";
+    lvc.pszText = L"F";
     lvc.cx = 30;
     ListView_InsertColumn(listView, 9, &lvc);
 
+    // Column for the occurrences in the document
+    lvc.iSubItem = 10;
+    lvc.pszText = L"Hits";
+    lvc.cx = HITS_COLUMN_WIDTH;
+    lvc.fmt = LVCFMT_RIGHT | LVCFMT_FIXED_WIDTH;
+    ListView_InsertColumn(listView, 10, &lvc);
+
+    // Column for Delete Button
+    lvc.iSubItem = 11;
+    lvc.pszText = L"";
+    lvc.cx = 30;
+    lvc.fmt = LVCFMT_CENTER | LVCFMT_FIXED_WIDTH;
+    ListView_InsertColumn(listView, 11, &lvc);
+
     //Adding Tooltips
     HWND hwndHeader = ListView_GetHeader(listView);
     HWND hwndTT = CreateHeaderTooltip(hwndHeader);
@@ -528,6 +552,8 @@ void MultiReplace::createListViewColumns(HWND listView) {
         _T("Use Variables"),
         _T("Extended"),
         _T("Regex"),
+        _T("Fuzzy, allowed edits"),
+        _T("Occurrences in the document"),
         _T("")
     };
 
@@ -574,6 +600,7 @@ void MultiReplace::insertReplaceListItem(const ReplaceItemData& itemData)
 
     // Update Header if there might be any changes
     updateHeader();
+    scheduleHitCountOfNewEntries();
 }
 
 void MultiReplace::updateListViewAndColumns(HWND listView, LPARAM lParam)
@@ -582,9 +609,9 @@ void MultiReplace::updateListViewAndColumns(HWND listView, LPARAM lParam)
     int newWidth = LOWORD(lParam);
     int newHeight = HIWORD(lParam);
 
-    // Calculate the total width of columns 3 to 8
+    // Calculate the total width of columns 3 to 9
     int columns3to7Width = 0;
-    for (int i = 4; i < 10; i++)
+    for (int i = 4; i < 12; i++)
     {
         columns3to7Width += ListView_GetColumnWidth(listView, i);
     }
@@ -632,9 +659,14 @@ void MultiReplace::handleCopyBack(NMITEMACTIVATE* pnmia) {
     SendMessageW(GetDlgItem(_hSelf, IDC_WHOLE_WORD_CHECKBOX), BM_SETCHECK, itemData.wholeWord ? BST_CHECKED : BST_UNCHECKED, 0);
     SendMessageW(GetDlgItem(_hSelf, IDC_MATCH_CASE_CHECKBOX), BM_SETCHECK, itemData.matchCase ? BST_CHECKED : BST_UNCHECKED, 0);
     SendMessageW(GetDlgItem(_hSelf, IDC_USE_VARIABLES_CHECKBOX), BM_SETCHECK, itemData.useVariables ? BST_CHECKED : BST_UNCHECKED, 0);
-    SendMessageW(GetDlgItem(_hSelf, IDC_NORMAL_RADIO), BM_SETCHECK, (!itemData.regex && !itemData.extended) ? BST_CHECKED : BST_UNCHECKED, 0);
+    SendMessageW(GetDlgItem(_hSelf, IDC_NORMAL_RADIO), BM_SETCHECK, (!itemData.regex && !itemData.extended && itemData.fuzzy == 0) ? BST_CHECKED : BST_UNCHECKED, 0);
     SendMessageW(GetDlgItem(_hSelf, IDC_EXTENDED_RADIO), BM_SETCHECK, itemData.extended ? BST_CHECKED : BST_UNCHECKED, 0);
     SendMessageW(GetDlgItem(_hSelf, IDC_REGEX_RADIO), BM_SETCHECK, itemData.regex ? BST_CHECKED : BST_UNCHECKED, 0);
+    SendMessageW(GetDlgItem(_hSelf, IDC_FUZZY_RADIO), BM_SETCHECK, (itemData.fuzzy > 0) ? BST_CHECKED : BST_UNCHECKED, 0);
+    if (itemData.fuzzy > 0) {
+        SetDlgItemTextW(_hSelf, IDC_FUZZY_DISTANCE_EDIT, std::to_wstring(itemData.fuzzy).c_str());
+    }
+    EnableWindow(GetDlgItem(_hSelf, IDC_WHOLE_WORD_CHECKBOX), !itemData.regex && itemData.fuzzy == 0);
 }
 
 void MultiReplace::shiftListItem(HWND listView, const Direction& direction) {
@@ -708,6 +740,7 @@ void MultiReplace::handleDeletion(NMITEMACTIVATE* pnmia) {
 
     // Update Header if there might be any changes
     updateHeader();
+    scheduleHitCountOfNewEntries();
 
     InvalidateRect(_replaceListView, NULL, TRUE);
 
@@ -735,6 +768,7 @@ void MultiReplace::deleteSelectedLines(HWND listView) {
     }
 
     ListView_SetItemCountEx(listView, replaceListData.size(), LVSICF_NOINVALIDATEALL);
+    scheduleHitCountOfNewEntries();
 
     // Deselect all items
     for (int j = 0; j < ListView_GetItemCount(listView); ++j) {
@@ -783,6 +817,29 @@ void MultiReplace::sortReplaceListData(int column) {
         std::wstring statusMessage = L"Replace column sorted in " + std::wstring(ascending ? L"ascending" : L"descending") + L" order.";
         showStatusMessage(statusMessage, RGB(0, 0, 255));
     }
+    else if (column == 10) {
+        // Sort by the counted hits, entries without a count last
+        std::vector<std::pair<size_t, ReplaceItemData>> counted;
+        counted.reserve(replaceListData.size());
+        for (const ReplaceItemData& itemData : replaceListData) {
+            size_t hits = 0;
+            counted.emplace_back(readHits(itemData, hits) ? hits : SIZE_MAX, itemData);
+        }
+        std::stable_sort(counted.begin(), counted.end(),
+            [this](const std::pair<size_t, ReplaceItemData>& a, const std::pair<size_t, ReplaceItemData>& b) {
+                if (a.first == SIZE_MAX || b.first == SIZE_MAX)
+                    return a.first != SIZE_MAX && b.first == SIZE_MAX;
+                if (this->ascending)
+                    return a.first < b.first;
+                else
+                    return a.first > b.first;
+            });
+        for (size_t i = 0; i < counted.size(); ++i) {
+            replaceListData[i] = std::move(counted[i].second);
+        }
+        std::wstring statusMessage = L"Hits column sorted in " + std::wstring(ascending ? L"ascending" : L"descending") + L" order.";
+        showStatusMessage(statusMessage, RGB(0, 0, 255));
+    }
 
     // Update the ListView
     ListView_SetItemCountEx(_replaceListView, replaceListData.size(), LVSICF_NOINVALIDATEALL);
@@ -825,6 +882,7 @@ void MultiReplace::handleCopyToListButton() {
     itemData.useVariables = (IsDlgButtonChecked(_hSelf, IDC_USE_VARIABLES_CHECKBOX) == BST_CHECKED);
     itemData.extended = (IsDlgButtonChecked(_hSelf, IDC_EXTENDED_RADIO) == BST_CHECKED);
     itemData.regex = (IsDlgButtonChecked(_hSelf, IDC_REGEX_RADIO) == BST_CHECKED);
+    itemData.fuzzy = readFuzzyDistance();
 
     insertReplaceListItem(itemData);
 
@@ -856,6 +914,10 @@ INT_PTR CALLBACK MultiReplace::run_dlgProc(UINT message, WPARAM wParam, LPARAM l
         initializeListView();
         loadSettings();
         updateButtonVisibilityBasedOnMode();
+        // Live search highlighting gets an indicator of its own, if Notepad++ can spare one
+        if (!::SendMessage(nppData._nppHandle, NPPM_ALLOCATEINDICATOR, 1, reinterpret_cast<LPARAM>(&liveSearchIndicator))) {
+            liveSearchIndicator = -1;
+        }
         // Activate Dark Mode
         ::SendMessage(nppData._nppHandle, NPPM_DARKMODESUBCLASSANDTHEME, static_cast<WPARAM>(NppDarkMode::dmfInit), reinterpret_cast<LPARAM>(_hSelf));
          return TRUE;
@@ -887,7 +949,11 @@ INT_PTR CALLBACK MultiReplace::run_dlgProc(UINT message, WPARAM wParam, LPARAM l
 
     case WM_DESTROY:
     {
+        KillTimer(_hSelf, LIVE_SEARCH_TIMER);
+        KillTimer(_hSelf, LAZY_COUNT_TIMER);
+        dropHits();
         saveSettings();
+        closeLuaState();
         DestroyWindow(_hSelf);
         DeleteObject(_hFont);
     }
@@ -920,7 +986,7 @@ INT_PTR CALLBACK MultiReplace::run_dlgProc(UINT message, WPARAM wParam, LPARAM l
             case NM_CLICK:
             {
                 NMITEMACTIVATE* pnmia = reinterpret_cast<NMITEMACTIVATE*>(lParam);
-                if (pnmia->iSubItem == 9) { // Delete button column
+                if (pnmia->iSubItem == 11) { // Delete button column
                     handleDeletion(pnmia);
                 }
                 if (pnmia->iSubItem == 1) { // Select button column
@@ -939,6 +1005,14 @@ INT_PTR CALLBACK MultiReplace::run_dlgProc(UINT message, WPARAM wParam, LPARAM l
             }
             break;
 
+            case LVN_ITEMCHANGED:
+            case LVN_ODSTATECHANGED:
+            {
+                // The density strip shows the selected entry
+                InvalidateRect(GetDlgItem(_hSelf, IDC_DENSITY_STRIP), NULL, FALSE);
+            }
+            break;
+
             case LVN_GETDISPINFO:
             {
                 NMLVDISPINFO* plvdi = reinterpret_cast<NMLVDISPINFO*>(lParam);
@@ -995,6 +1069,21 @@ INT_PTR CALLBACK MultiReplace::run_dlgProc(UINT message, WPARAM wParam, LPARAM l
                     }
                     break;
                 case 9:
+                    if (itemData.fuzzy > 0) {
+                        plvdi->item.mask |= LVIF_TEXT;
+                        lstrcpynW(plvdi->item.pszText, std::to_wstring(itemData.fuzzy).c_str(), plvdi->item.cchTextMax);
+                    }
+                    break;
+                case 10:
+                {
+                    size_t hits = 0;
+                    if (readHits(itemData, hits)) {
+                        plvdi->item.mask |= LVIF_TEXT;
+                        lstrcpynW(plvdi->item.pszText, std::to_wstring(hits).c_str(), plvdi->item.cchTextMax);
+                    }
+                }
+                break;
+                case 11:
                     plvdi->item.mask |= LVIF_TEXT;
                     plvdi->item.pszText = L"\u2716";
                     break;
@@ -1022,6 +1111,13 @@ INT_PTR CALLBACK MultiReplace::run_dlgProc(UINT message, WPARAM wParam, LPARAM l
                     }
                     sortReplaceListData(lastColumn);
                 }
+
+                // The "Hits" header sorts the most frequent entries first
+                if (pnmv->iSubItem == 10) {
+                    ascending = (lastColumn == 10) ? !ascending : false;
+                    lastColumn = 10;
+                    sortReplaceListData(lastColumn);
+                }
                 break;
             }
 
@@ -1094,6 +1190,31 @@ INT_PTR CALLBACK MultiReplace::run_dlgProc(UINT message, WPARAM wParam, LPARAM l
                         setSelections(!currentSelectionStatus, true);
                     }
                 }
+                else if (pnkd->wVKey == VK_F9) { // F9 key
+                    switch (listReplaceMode) {
+                    case ListReplaceMode::Sequential:
+                        listReplaceMode = ListReplaceMode::Simultaneous;
+                        MessageBox(NULL,
+                            L"Simultaneous Replace Mode: ON (list priority)\n\nAll entries are matched against the original text. Where occurrences overlap, the entry higher in the list wins.",
+                            L"Feature Status",
+                            MB_OK);
+                        break;
+                    case ListReplaceMode::Simultaneous:
+                        listReplaceMode = ListReplaceMode::LeftmostLongest;
+                        MessageBox(NULL,
+                            L"Simultaneous Replace Mode: ON (leftmost-longest)\n\nAll entries are matched against the original text. Where occurrences overlap, the leftmost and then the longest one wins.",
+                            L"Feature Status",
+                            MB_OK);
+                        break;
+                    case ListReplaceMode::LeftmostLongest:
+                        listReplaceMode = ListReplaceMode::Sequential;
+                        MessageBox(NULL,
+                            L"Simultaneous Replace Mode: OFF\n\nEntries are applied one after another.",
+                            L"Feature Status",
+                            MB_OK);
+                        break;
+                    }
+                }
                 else if (pnkd->wVKey == VK_F11) { // F11 key
                     isReplaceOnceInList = !isReplaceOnceInList;
 
@@ -1126,10 +1247,52 @@ INT_PTR CALLBACK MultiReplace::run_dlgProc(UINT message, WPARAM wParam, LPARAM l
             if (!wstr.empty()) {
                 SetWindowTextW(GetDlgItem(_hSelf, IDC_FIND_EDIT), wstr.c_str());
             }
+            scheduleHitCount();
         }
         else {
             handleClearTextMarksButton();
             handleClearDelimiterState();
+            clearLiveSearch();
+            dropHits();
+        }
+    }
+    break;
+
+    case WM_TIMER:
+    {
+        if (wParam == LIVE_SEARCH_TIMER) {
+            // Keys still waiting mean the user is typing on
+            MSG pending;
+            if (PeekMessage(&pending, NULL, WM_KEYFIRST, WM_KEYLAST, PM_NOREMOVE)) {
+                return TRUE;
+            }
+            KillTimer(_hSelf, LIVE_SEARCH_TIMER);
+            runLiveSearch();
+            return TRUE;
+        }
+        if (wParam == HIT_COUNT_TIMER) {
+            startHitCount();
+            return TRUE;
+        }
+        if (wParam == LAZY_COUNT_TIMER) {
+            continueLazyCount();
+            return TRUE;
+        }
+    }
+    break;
+
+    case WM_HITS_COUNTED:
+    {
+        finishHitCount(wParam);
+        return TRUE;
+    }
+
+    case WM_DRAWITEM:
+    {
+        const DRAWITEMSTRUCT* drawItem = reinterpret_cast<const DRAWITEMSTRUCT*>(lParam);
+        if (drawItem->CtlID == IDC_DENSITY_STRIP) {
+            drawDensityStrip(drawItem);
+            return TRUE;
         }
     }
     break;
@@ -1161,18 +1324,20 @@ INT_PTR CALLBACK MultiReplace::run_dlgProc(UINT message, WPARAM wParam, LPARAM l
         break;
 
         case IDC_REGEX_RADIO:
+        case IDC_FUZZY_RADIO:
         {
-            // Check if the Regular expression radio button is checked
-            bool regexChecked = (IsDlgButtonChecked(_hSelf, IDC_REGEX_RADIO) == BST_CHECKED);
+            // Check if the Regular expression or the Fuzzy radio button is checked
+            bool regexChecked = (IsDlgButtonChecked(_hSelf, IDC_REGEX_RADIO) == BST_CHECKED) || (IsDlgButtonChecked(_hSelf, IDC_FUZZY_RADIO) == BST_CHECKED);
 
             // Enable or disable the Whole word checkbox accordingly
             EnableWindow(GetDlgItem(_hSelf, IDC_WHOLE_WORD_CHECKBOX), !regexChecked);
 
-            // If the Regular expression radio button is checked, uncheck the Whole word checkbox
+            // If the Regular expression or the Fuzzy radio button is checked, uncheck the Whole word checkbox
             if (regexChecked)
             {
                 CheckDlgButton(_hSelf, IDC_WHOLE_WORD_CHECKBOX, BST_UNCHECKED);
             }
+            scheduleLiveSearch();
         }
         break;
 
@@ -1180,6 +1345,23 @@ INT_PTR CALLBACK MultiReplace::run_dlgProc(UINT message, WPARAM wParam, LPARAM l
         case IDC_EXTENDED_RADIO:
         {
             EnableWindow(GetDlgItem(_hSelf, IDC_WHOLE_WORD_CHECKBOX), TRUE);
+            scheduleLiveSearch();
+        }
+        break;
+
+        case IDC_FIND_EDIT:
+        {
+            // Typed text or text picked from the history
+            if (HIWORD(wParam) == CBN_EDITCHANGE || HIWORD(wParam) == CBN_SELCHANGE) {
+                scheduleLiveSearch();
+            }
+        }
+        break;
+
+        case IDC_MATCH_CASE_CHECKBOX:
+        case IDC_WHOLE_WORD_CHECKBOX:
+        {
+            scheduleLiveSearch();
         }
         break;
 
@@ -1188,6 +1370,7 @@ INT_PTR CALLBACK MultiReplace::run_dlgProc(UINT message, WPARAM wParam, LPARAM l
             setElementsState(columnRadioDependentElements, false);
             setElementsState(selectionRadioDisabledButtons, true);
             handleClearDelimiterState();
+            scheduleLiveSearch();
         }
         break;
 
@@ -1196,6 +1379,7 @@ INT_PTR CALLBACK MultiReplace::run_dlgProc(UINT message, WPARAM wParam, LPARAM l
             setElementsState(columnRadioDependentElements, false);
             setElementsState(selectionRadioDisabledButtons, false);
             handleClearDelimiterState();
+            scheduleLiveSearch();
         }
         break;
 
@@ -1203,14 +1387,14 @@ INT_PTR CALLBACK MultiReplace::run_dlgProc(UINT message, WPARAM wParam, LPARAM l
         {
             setElementsState(columnRadioDependentElements, true);
             setElementsState(selectionRadioDisabledButtons, true);
+            scheduleLiveSearch();
         }
         break;
 
         case IDC_COLUMN_HIGHLIGHT_BUTTON:
         {
             if (!isColumnHighlighted) {
-                handleDelimiterPositions(DelimiterOperation::LoadAll);
-                if (columnDelimiterData.isValid()) {
+                if (handleDelimiterPositions(DelimiterOperation::LoadAll) && columnDelimiterData.isValid()) {
                     handleHighlightColumnsInDocument();
                 }
             }
@@ -1240,6 +1424,7 @@ INT_PTR CALLBACK MultiReplace::run_dlgProc(UINT message, WPARAM wParam, LPARAM l
             // Swap the content of the two text fields
             SetDlgItemTextW(_hSelf, IDC_FIND_EDIT, replaceText.c_str());
             SetDlgItemTextW(_hSelf, IDC_REPLACE_EDIT, findText.c_str());
+            scheduleLiveSearch();
         }
         break;
 
@@ -1252,52 +1437,84 @@ INT_PTR CALLBACK MultiReplace::run_dlgProc(UINT message, WPARAM wParam, LPARAM l
         case IDC_FIND_BUTTON:
         case IDC_FIND_NEXT_BUTTON:
         {
-            handleDelimiterPositions(DelimiterOperation::LoadAll);
-            handleFindNextButton();
+            if (handleDelimiterPositions(DelimiterOperation::LoadAll)) {
+                // Shift+Click lists every occurrence instead of stepping to the next one
+                if (GetKeyState(VK_SHIFT) & 0x8000) {
+                    handleFindAllButton();
+                }
+                else {
+                    handleFindNextButton();
+                }
+            }
         }
         break;
 
         case IDC_FIND_PREV_BUTTON:
         {
-            handleDelimiterPositions(DelimiterOperation::LoadAll);
-            handleFindPrevButton(); 
+            if (handleDelimiterPositions(DelimiterOperation::LoadAll)) {
+                handleFindPrevButton();
+            }
         }
         break;
 
         case IDC_REPLACE_BUTTON:
         {
-            handleDelimiterPositions(DelimiterOperation::LoadAll);
-            handleReplaceButton();
+            if (handleDelimiterPositions(DelimiterOperation::LoadAll)) {
+                handleReplaceButton();
+            }
         }
         break;
 
         case IDC_REPLACE_ALL_SMALL_BUTTON:
         case IDC_REPLACE_ALL_BUTTON:
         {
-            handleDelimiterPositions(DelimiterOperation::LoadAll);
-            handleReplaceAllButton();
+            if (handleDelimiterPositions(DelimiterOperation::LoadAll)) {
+                // Shift+Click shows what Replace All would do without touching the document
+                if (GetKeyState(VK_SHIFT) & 0x8000) {
+                    handlePreviewReplaceAllButton();
+                }
+                else {
+                    handleReplaceAllButton();
+                }
+            }
         }
         break;
 
         case IDC_MARK_MATCHES_BUTTON:
         case IDC_MARK_BUTTON:
         {
-            handleDelimiterPositions(DelimiterOperation::LoadAll);
-            handleClearTextMarksButton();
-            handleMarkMatchesButton();
+            if (handleDelimiterPositions(DelimiterOperation::LoadAll)) {
+                handleClearTextMarksButton();
+                handleMarkMatchesButton();
+            }
         }
         break;
 
         case IDC_CLEAR_MARKS_BUTTON:
         {
             handleClearTextMarksButton();
+            clearLiveSearch();
             showStatusMessage(L"All marks cleared.", RGB(0, 128, 0));
         }
         break;
 
         case IDC_COPY_MARKED_TEXT_BUTTON:
         {
-            handleCopyMarkedTextToClipboardButton();
+            // Shift+Click exports the marked text with a chosen format to a file or the Clipboard
+            if (GetKeyState(VK_SHIFT) & 0x8000) {
+                handleExportMarkedTextButton();
+            }
+            else {
+                handleCopyMarkedTextToClipboardButton();
+            }
+        }
+        break;
+
+        case IDC_DENSITY_STRIP:
+        {
+            if (HIWORD(wParam) == STN_CLICKED) {
+                handleDensityStripClick();
+            }
         }
         break;
 
@@ -1365,6 +1582,9 @@ void MultiReplace::handleReplaceAllButton() {
     }
 
     int replaceCount = 0;
+#ifdef _DEBUG
+    sciMessageCount = 0;
+#endif
     // Check if the "In List" option is enabled
     bool useListEnabled = (IsDlgButtonChecked(_hSelf, IDC_USE_LIST_CHECKBOX) == BST_CHECKED);
 
@@ -1375,13 +1595,42 @@ void MultiReplace::handleReplaceAllButton() {
             showStatusMessage(L"Add values into the list. Or uncheck 'Use in List' to replace directly.", RGB(255, 0, 0));
             return;
         }
-        ::SendMessage(_hScintilla, SCI_BEGINUNDOACTION, 0, 0);
-        for (ReplaceItemData& itemData : replaceListData) {
-            if (itemData.isSelected) {
-                replaceCount += replaceAll(itemData);
+        size_t docLength = static_cast<size_t>(send(SCI_GETLENGTH, 0, 0));
+        size_t selectedCount = static_cast<size_t>(std::count_if(replaceListData.begin(), replaceListData.end(),
+            [](const ReplaceItemData& itemData) { return itemData.isSelected; }));
+        beginProgress(L"Replace All", docLength * selectedCount);
+        beginBatchEdit();
+        bool simultaneous = (listReplaceMode != ListReplaceMode::Sequential);
+        bool supported = true;
+        if (simultaneous) {
+            // All entries see the original text, which only the single pass can do
+            supported = replaceAllSinglePass(replaceListData.data(), replaceListData.size(), replaceCount);
+        }
+        // Literal lists are applied in one pass; fall back to one sweep per entry where that would change the result
+        else if (!useSinglePassList || !replaceAllSinglePass(replaceListData.data(), replaceListData.size(), replaceCount)) {
+            size_t entryIndex = 0;
+            for (ReplaceItemData& itemData : replaceListData) {
+                if (itemData.isSelected && !isProgressCancelled()) {
+                    progressOffset = docLength * entryIndex++;
+                    progressMatches = static_cast<size_t>(replaceCount);
+                    replaceCount += replaceAll(itemData);
+                }
             }
         }
-        ::SendMessage(_hScintilla, SCI_ENDUNDOACTION, 0, 0);
+        bool cancelled = endProgress();
+        endBatchEdit(cancelled && replaceCount > 0);
+        if (cancelled) {
+            showStatusMessage(L"Replace All cancelled. No changes were made.", RGB(255, 0, 0));
+            return;
+        }
+        if (!supported) {
+            showStatusMessage(L"Simultaneous replacement needs selected Normal or Extended entries without 'Use Variables'.", RGB(255, 0, 0));
+            return;
+        }
+        if (simultaneous) {
+            showStatusMessage(std::to_wstring(replaceCount) + L" occurrences were replaced simultaneously.", RGB(0, 128, 0));
+            return;
+        }
     }
     else
     {
@@ -1393,17 +1642,119 @@ void MultiReplace::handleReplaceAllButton() {
         itemData.useVariables = (IsDlgButtonChecked(_hSelf, IDC_USE_VARIABLES_CHECKBOX) == BST_CHECKED);
         itemData.regex = (IsDlgButtonChecked(_hSelf, IDC_REGEX_RADIO) == BST_CHECKED);
         itemData.extended = (IsDlgButtonChecked(_hSelf, IDC_EXTENDED_RADIO) == BST_CHECKED);
+        itemData.fuzzy = readFuzzyDistance();
+
+        beginProgress(L"Replace All", static_cast<size_t>(send(SCI_GETLENGTH, 0, 0)));
+        beginBatchEdit();
 
-        ::SendMessage(_hScintilla, SCI_BEGINUNDOACTION, 0, 0);
-        replaceCount = replaceAll(itemData);
-        ::SendMessage(_hScintilla, SCI_ENDUNDOACTION, 0, 0);
+        // Literal text is found in the document buffer directly, Scintilla searches only for what the scan cannot do
+        if (!useSinglePassList || !replaceAllSinglePass(&itemData, 1, replaceCount)) {
+            replaceCount = replaceAll(itemData);
+        }
+        bool cancelled = endProgress();
+        endBatchEdit(cancelled && replaceCount > 0);
 
         // Add the entered text to the combo box history
         addStringToComboBoxHistory(GetDlgItem(_hSelf, IDC_FIND_EDIT), itemData.findText);
         addStringToComboBoxHistory(GetDlgItem(_hSelf, IDC_REPLACE_EDIT), itemData.replaceText);
+
+        if (cancelled) {
+            showStatusMessage(L"Replace All cancelled. No changes were made.", RGB(255, 0, 0));
+            return;
+        }
     }
     // Display status message
-    showStatusMessage(std::to_wstring(replaceCount) + L" occurrences were replaced.", RGB(0, 128, 0));
+    std::wstring statusText = std::to_wstring(replaceCount) + L" occurrences were replaced.";
+#ifdef _DEBUG
+    statusText += L" (" + std::to_wstring(sciMessageCount) + L" Scintilla messages)";
+#endif
+    showStatusMessage(statusText, RGB(0, 128, 0));
+}
+
+void MultiReplace::handlePreviewReplaceAllButton() {
+
+    bool useListEnabled = (IsDlgButtonChecked(_hSelf, IDC_USE_LIST_CHECKBOX) == BST_CHECKED);
+    std::vector<ReplaceItemData> fieldItems;
+    if (useListEnabled) {
+        if (replaceListData.empty()) {
+            showStatusMessage(L"Add values into the list. Or uncheck 'Use in List' to replace directly.", RGB(255, 0, 0));
+            return;
+        }
+    }
+    else {
+        ReplaceItemData itemData;
+        itemData.findText = getTextFromDialogItem(_hSelf, IDC_FIND_EDIT);
+        itemData.replaceText = getTextFromDialogItem(_hSelf, IDC_REPLACE_EDIT);
+        itemData.wholeWord = (IsDlgButtonChecked(_hSelf, IDC_WHOLE_WORD_CHECKBOX) == BST_CHECKED);
+        itemData.matchCase = (IsDlgButtonChecked(_hSelf, IDC_MATCH_CASE_CHECKBOX) == BST_CHECKED);
+        itemData.useVariables = (IsDlgButtonChecked(_hSelf, IDC_USE_VARIABLES_CHECKBOX) == BST_CHECKED);
+        itemData.regex = (IsDlgButtonChecked(_hSelf, IDC_REGEX_RADIO) == BST_CHECKED);
+        itemData.extended = (IsDlgButtonChecked(_hSelf, IDC_EXTENDED_RADIO) == BST_CHECKED);
+        itemData.fuzzy = readFuzzyDistance();
+        fieldItems.push_back(itemData);
+    }
+    const std::vector<ReplaceItemData>& items = useListEnabled ? replaceListData : fieldItems;
+
+    int codepage = static_cast<int>(send(SCI_GETCODEPAGE, 0, 0));
+    if (codepage != 0 && codepage != SC_CP_UTF8) {
+        showStatusMessage(L"Preview is not available for DBCS documents.", RGB(255, 0, 0));
+        return;
+    }
+
+    // Same automaton and selection as Replace All, so the counts are those of a real run
+    ListMatcher singleMatcher;
+    std::vector<std::string> singleReplacements;
+    ListMatcher& matcher = useListEnabled ? listMatcher : singleMatcher;
+    std::vector<std::string>& replacements = useListEnabled ? listMatcherReplacements : singleReplacements;
+    if (!buildListMatcher(items.data(), items.size(), matcher, replacements, codepage, useListEnabled)) {
+        showStatusMessage(L"Preview is available for Normal and Extended entries without 'Use Variables' only.", RGB(255, 0, 0));
+        return;
+    }
+
+    // Only read access from here on: the document pointer stays valid while the preview is shown
+    const char* text = reinterpret_cast<const char*>(send(SCI_GETCHARACTERPOINTER, 0, 0));
+    size_t textLength = static_cast<size_t>(send(SCI_GETLENGTH, 0, 0));
+
+    std::vector<ListMatch> candidates;
+    findListMatches(matcher, candidates);
+    bool simultaneous = useListEnabled && listReplaceMode != ListReplaceMode::Sequential;
+    std::vector<ListMatch> selected = simultaneous ? selectSimultaneousMatches(matcher, std::move(candidates))
+        : matcher.selectSequentialMatches(std::move(candidates));
+
+    ReplacePreview preview;
+    if (simultaneous || (!isReplaceOnceInList && !matcher.hasCascadingMatches(text, textLength, selected, replacements))) {
+        preview.setMatches(std::move(selected), replacements, matcher.patternCount());
+    }
+    else if (IsDlgButtonChecked(_hSelf, IDC_ALL_TEXT_RADIO) == BST_CHECKED) {
+        CharClass classes[256];
+        readCharClasses(classes);
+        preview.runSequential(text, textLength, matcher, replacements, classes, codepage == SC_CP_UTF8, isReplaceOnceInList);
+    }
+    else {
+        showStatusMessage(L"Preview of entries that build on each other needs the 'All Text' scope.", RGB(255, 0, 0));
+        return;
+    }
+
+    // One line per entry that takes part, in list order
+    std::wstring entryCounts;
+    size_t entry = 0;
+    for (size_t row = 0; row < items.size(); ++row) {
+        const ReplaceItemData& itemData = items[row];
+        if (!itemData.isSelected || itemData.findText.empty()) {
+            continue;
+        }
+        entryCounts += std::to_wstring(preview.entryHits()[entry++]) + L"\t";
+        if (useListEnabled) {
+            entryCounts += L"#" + std::to_wstring(row + 1) + L"  ";
+        }
+        entryCounts += itemData.findText + L"  \u2192  " + itemData.replaceText + L"\r\n";
+    }
+
+    std::wstring summary = std::to_wstring(preview.totalHits()) + L" occurrences would be replaced. The document is not changed.";
+    showStatusMessage(L"Preview: " + std::to_wstring(preview.totalHits()) + L" occurrences.", RGB(0, 128, 0));
+
+    PreviewDialog dialog(nppData._nppHandle, _hSelf, preview, text, textLength, codepage);
+    dialog.show(summary, entryCounts);
 }
 
 void MultiReplace::handleReplaceButton() {
@@ -1421,7 +1772,6 @@ void MultiReplace::handleReplaceButton() {
     SearchResult searchResult;
     searchResult.pos = -1;
     searchResult.length = 0;
-    searchResult.foundText = "";
 
     Sci_Position newPos = ::SendMessage(_hScintilla, SCI_GETCURRENTPOS, 0, 0);
 
@@ -1469,15 +1819,14 @@ void MultiReplace::handleReplaceButton() {
         replaceItem.useVariables = (IsDlgButtonChecked(_hSelf, IDC_USE_VARIABLES_CHECKBOX) == BST_CHECKED);
         replaceItem.regex = (IsDlgButtonChecked(_hSelf, IDC_REGEX_RADIO) == BST_CHECKED);
         replaceItem.extended = (IsDlgButtonChecked(_hSelf, IDC_EXTENDED_RADIO) == BST_CHECKED);
-
-        std::string findTextUtf8 = convertAndExtend(replaceItem.findText, replaceItem.extended);
-        int searchFlags = (replaceItem.wholeWord * SCFIND_WHOLEWORD) | (replaceItem.matchCase * SCFIND_MATCHCASE) | (replaceItem.regex * SCFIND_REGEXP);
+        replaceItem.fuzzy = readFuzzyDistance();
 
         SelectionInfo selection = getSelectionInfo();
         bool wasReplaced = replaceOne(replaceItem, selection, searchResult, newPos);
 
         if (searchResult.pos < 0 && wrapAroundEnabled) {
-            searchResult = performSearchForward(findTextUtf8, searchFlags, true, 0);
+            const CompiledReplaceItem& compiled = getCompiledItem(replaceItem);
+            searchResult = performSearchForward(compiled.findTextUtf8, compiled.searchFlags, true, 0);
         }
 
         if (wasReplaced) {
@@ -1499,13 +1848,12 @@ void MultiReplace::handleReplaceButton() {
 
 bool MultiReplace::replaceOne(const ReplaceItemData& itemData, const SelectionInfo& selection, SearchResult& searchResult, Sci_Position& newPos)
 {
-    std::string findTextUtf8 = convertAndExtend(itemData.findText, itemData.extended);
-    int searchFlags = (itemData.wholeWord * SCFIND_WHOLEWORD) | (itemData.matchCase * SCFIND_MATCHCASE) | (itemData.regex * SCFIND_REGEXP);
-    searchResult = performSearchForward(findTextUtf8, searchFlags, true, selection.startPos);
+    CompiledReplaceItem& compiled = getCompiledItem(itemData);
+    searchResult = performSearchForward(compiled.findTextUtf8, compiled.searchFlags, true, selection.startPos);
 
     if (searchResult.pos == selection.startPos && searchResult.length == selection.length) {
         bool skipReplace = false;
-        std::string replaceTextUtf8 = convertAndExtend(itemData.replaceText, itemData.extended);
+        std::string replaceTextCp = compiled.replaceTextCp;
         if (itemData.useVariables) {
             LuaVariables vars;
 
@@ -1521,27 +1869,27 @@ bool MultiReplace::replaceOne(const ReplaceItemData& itemData, const SelectionIn
             vars.APOS = static_cast<int>(searchResult.pos) + 1;
             vars.LINE = currentLineIndex + 1;
             vars.LPOS = static_cast<int>(searchResult.pos) - previousLineStartPosition + 1;
-            vars.MATCH = searchResult.foundText;
+            vars.MATCH = getMatchText(searchResult);
 
-            if (!resolveLuaSyntax(replaceTextUtf8, vars, skipReplace, itemData.regex)) {
+            std::string replaceTextUtf8;
+            if (!resolveLuaSyntax(compiled, replaceTextUtf8, vars, skipReplace)) {
                 return false;  // Exit the function if error in syntax
             }
+            replaceTextCp = utf8ToCodepage(replaceTextUtf8, compiled.codepage);
         }
 
         if (!skipReplace) {
             if (itemData.regex) {
-                newPos = performRegexReplace(replaceTextUtf8, searchResult.pos, searchResult.length);
+                newPos = performRegexReplace(replaceTextCp, searchResult.pos, searchResult.length);
             }
             else {
-                newPos = performReplace(replaceTextUtf8, searchResult.pos, searchResult.length);
+                newPos = performReplace(replaceTextCp, searchResult.pos, searchResult.length);
             }
             return true;  // A replacement was made
         }
         else {
             newPos = searchResult.pos + searchResult.length;
-            // Clear selection
-            send(SCI_SETSELECTIONSTART, newPos, 0);
-            send(SCI_SETSELECTIONEND, newPos, 0);
+            setCaretAfterReplace(newPos);
         }
     }
     return false;  // No replacement was made
@@ -1553,26 +1901,38 @@ int MultiReplace::replaceAll(const ReplaceItemData& itemData)
         return 0;
     }
 
-    int searchFlags = (itemData.wholeWord * SCFIND_WHOLEWORD) | (itemData.matchCase * SCFIND_MATCHCASE) | (itemData.regex * SCFIND_REGEXP);
+    // Literal entries are rebuilt from one read of the document instead of one replacement per match.
+    // The entry is passed in place, so a list entry keeps using its own compiled slot.
+    if (!itemData.regex && !itemData.useVariables && itemData.fuzzy == 0) {
+        int replaceCount = 0;
+        if (replaceAllSinglePass(&itemData, 1, replaceCount)) {
+            return replaceCount;
+        }
+    }
 
-    std::string findTextUtf8 = convertAndExtend(itemData.findText, itemData.extended);
-    std::string replaceTextUtf8 = convertAndExtend(itemData.replaceText, itemData.extended);
+    CompiledReplaceItem& compiled = getCompiledItem(itemData);
 
     int replaceCount = 0;
     int findCount = 0; 
     int previousLineIndex = -1;
     int lineFindCount = 0;
 
-    SearchResult searchResult = performSearchForward(findTextUtf8, searchFlags, false, 0);
+    SearchResult searchResult = performSearchForward(compiled.findTextUtf8, compiled.searchFlags, false, 0);
 
     while (searchResult.pos >= 0)
     {
         bool skipReplace = false;
-        std::string localReplaceTextUtf8 = replaceTextUtf8;;
+        std::string resolvedTextCp;
+        const std::string* replaceTextCp = &compiled.replaceTextCp;
         if (itemData.useVariables) {
             LuaVariables vars;
 
-            if (IsDlgButtonChecked(_hSelf, IDC_COLUMN_MODE_RADIO) == BST_CHECKED) {
+            // The delimiter index is not updated while cells are captured, the cell of the match knows its column
+            if (IsDlgButtonChecked(_hSelf, IDC_COLUMN_MODE_RADIO) == BST_CHECKED && searchScope.hasCells()) {
+                size_t cell = searchScope.findFrom(searchResult.pos);
+                vars.COL = (cell < searchScope.size()) ? searchScope.range(cell).column : 0;
+            }
+            else if (IsDlgButtonChecked(_hSelf, IDC_COLUMN_MODE_RADIO) == BST_CHECKED) {
                 ColumnInfo columnInfo = getColumnInfo(searchResult.pos);
                 vars.COL = static_cast<int>(columnInfo.startColumnIndex);
             }
@@ -1594,176 +1954,964 @@ int MultiReplace::replaceAll(const ReplaceItemData& itemData)
             vars.APOS = static_cast<int>(searchResult.pos) + 1;
             vars.LINE = currentLineIndex + 1;
             vars.LPOS = static_cast<int>(searchResult.pos) - previousLineStartPosition + 1;
-            vars.MATCH = searchResult.foundText;
+            vars.MATCH = getMatchText(searchResult);
 
-            if (!resolveLuaSyntax(localReplaceTextUtf8, vars, skipReplace, itemData.regex)) {
+            std::string resolvedTextUtf8;
+            if (!resolveLuaSyntax(compiled, resolvedTextUtf8, vars, skipReplace)) {
                 break;  // Exit the loop if error in syntax
             }
+            resolvedTextCp = utf8ToCodepage(resolvedTextUtf8, compiled.codepage);
+            replaceTextCp = &resolvedTextCp;
         }
 
         Sci_Position newPos;
         if (!skipReplace) {
             if (itemData.regex) {
-                newPos = performRegexReplace(localReplaceTextUtf8, searchResult.pos, searchResult.length);
+                newPos = performRegexReplace(*replaceTextCp, searchResult.pos, searchResult.length);
             }
             else {
-                newPos = performReplace(localReplaceTextUtf8, searchResult.pos, searchResult.length);
+                newPos = performReplace(*replaceTextCp, searchResult.pos, searchResult.length);
             }
             replaceCount++;
         }
         else {
             newPos = searchResult.pos + searchResult.length;
-            // Clear selection
-            send(SCI_SETSELECTIONSTART, newPos, 0);
-            send(SCI_SETSELECTIONEND, newPos, 0);
+            setCaretAfterReplace(newPos);
         }
 
         if (isReplaceOnceInList) {
             break;  // Exit the loop after the first successful replacement
         }
 
-        searchResult = performSearchForward(findTextUtf8, searchFlags, false, newPos);
+        size_t done = progressOffset + static_cast<size_t>(newPos);
+        if (!updateProgress(done, progressMatches + static_cast<size_t>(replaceCount), done)) {
+            break;
+        }
+
+        searchResult = performSearchForward(compiled.findTextUtf8, compiled.searchFlags, false, newPos);
     }
 
     return replaceCount;
 }
 
-Sci_Position MultiReplace::performReplace(const std::string& replaceTextUtf8, Sci_Position pos, Sci_Position length)
+bool MultiReplace::replaceAllSinglePass(const ReplaceItemData* items, size_t itemCount, int& replaceCount)
 {
-    // Set the target range for the replacement
-    send(SCI_SETTARGETRANGE, pos, pos + length);
+    bool isList = isWholeList(items, itemCount);
+    bool simultaneous = isList && listReplaceMode != ListReplaceMode::Sequential;
+    if (isReplaceOnceInList && !simultaneous) {
+        return false;
+    }
+
+    // DBCS codepages need character boundary checks, leave them to Scintilla's search
+    int codepage = static_cast<int>(send(SCI_GETCODEPAGE, 0, 0));
+    if (codepage != 0 && codepage != SC_CP_UTF8) {
+        return false;
+    }
 
-    // Get the codepage of the document
-    int cp = static_cast<int>(send(SCI_GETCODEPAGE, 0, 0));
+    // The automaton of the list is kept between runs, single entries get a temporary one
+    ListMatcher singleMatcher;
+    std::vector<std::string> singleReplacements;
+    ListMatcher& matcher = isList ? listMatcher : singleMatcher;
+    std::vector<std::string>& replacements = isList ? listMatcherReplacements : singleReplacements;
+    if (!buildListMatcher(items, itemCount, matcher, replacements, codepage, isList)) {
+        return false;
+    }
 
-    // Convert the string from UTF-8 to the codepage of the document
-    std::string replaceTextCp = utf8ToCodepage(replaceTextUtf8, cp);
+    // Collect the occurrences of all entries in one scan of the document
+    const char* text = reinterpret_cast<const char*>(send(SCI_GETCHARACTERPOINTER, 0, 0));
+    size_t textLength = static_cast<size_t>(send(SCI_GETLENGTH, 0, 0));
 
-    // Perform the replacement
-    send(SCI_REPLACETARGET, replaceTextCp.size(), reinterpret_cast<sptr_t>(replaceTextCp.c_str()));
+    std::vector<ListMatch> candidates;
+    findListMatches(matcher, candidates);
 
-    // Get the end position after the replacement
-    Sci_Position newTargetEnd = static_cast<Sci_Position>(send(SCI_GETTARGETEND, 0, 0));
+    std::vector<ListMatch> selected;
+    if (simultaneous) {
+        selected = selectSimultaneousMatches(matcher, std::move(candidates));
+    }
+    else {
+        selected = matcher.selectSequentialMatches(std::move(candidates));
+        if (matcher.hasCascadingMatches(text, textLength, selected, replacements)) {
+            return false;
+        }
+    }
 
-    // Set the cursor to the end of the replaced text
-    send(SCI_SETCURRENTPOS, newTargetEnd, 0);
+    // Build the new text of all nearby matches up front, the document pointer is no longer valid after the first edit
+    std::vector<ListEdit> edits;
+    std::string buffer;
+    ListMatcher::buildEdits(text, selected, replacements, EDIT_COALESCE_GAP, EDIT_MAX_SPAN, edits, buffer);
+
+    Sci_Position delta = 0;
+    size_t appliedCount = 0;
+    const ListEdit* last = nullptr;
+    for (const ListEdit& edit : edits) {
+        Sci_Position start = static_cast<Sci_Position>(edit.pos) + delta;
+        send(SCI_SETTARGETRANGE, start, start + static_cast<Sci_Position>(edit.length));
+        send(SCI_REPLACETARGET, edit.bufferLength, reinterpret_cast<sptr_t>(buffer.data() + edit.bufferPos));
+        // All matches were selected up front, so a changed column layout cannot affect this run
+        updateSearchScope(start, static_cast<Sci_Position>(edit.length), static_cast<Sci_Position>(edit.bufferLength), false);
+        delta += static_cast<Sci_Position>(edit.bufferLength) - static_cast<Sci_Position>(edit.length);
+        appliedCount += edit.matchCount;
+        last = &edit;
+
+        // All entries are applied at once, so each byte of text counts once per entry
+        size_t textDone = edit.pos + edit.length;
+        if (!updateProgress(progressOffset + textDone * matcher.patternCount(), progressMatches + appliedCount, progressOffset + textDone)) {
+            break;
+        }
+    }
 
-    // Clear selection
-    send(SCI_SETSELECTIONSTART, newTargetEnd, 0);
-    send(SCI_SETSELECTIONEND, newTargetEnd, 0);
+    if (last != nullptr) {
+        // Leave the caret behind the last replacement like the sequential run does
+        setCaretAfterReplace(static_cast<Sci_Position>(last->pos + last->length) + delta);
+    }
 
-    return newTargetEnd;
+    replaceCount = static_cast<int>(appliedCount);
+    return true;
 }
 
-Sci_Position MultiReplace::performRegexReplace(const std::string& replaceTextUtf8, Sci_Position pos, Sci_Position length)
+bool MultiReplace::isWholeList(const ReplaceItemData* items, size_t itemCount) const
 {
-    // Set the target range for the replacement
-    send(SCI_SETTARGETRANGE, pos, pos + length);
+    return !replaceListData.empty() && items == replaceListData.data() && itemCount == replaceListData.size();
+}
 
-    // Get the codepage of the document
-    int cp = static_cast<int>(send(SCI_GETCODEPAGE, 0, 0));
+bool MultiReplace::buildListMatcher(const ReplaceItemData* items, size_t itemCount, ListMatcher& matcher, std::vector<std::string>& replacements, int codepage, bool cached)
+{
+    bool columnMode = (IsDlgButtonChecked(_hSelf, IDC_COLUMN_MODE_RADIO) == BST_CHECKED && columnDelimiterData.isValid());
+    bool simultaneous = (isWholeList(items, itemCount) && listReplaceMode != ListReplaceMode::Sequential);
+
+    std::vector<ReplaceItemData> source;
+    std::vector<ListPattern> patterns;
+    std::vector<std::string> replaceTexts;
+    for (size_t i = 0; i < itemCount; ++i) {
+        const ReplaceItemData& itemData = items[i];
+        if (!itemData.isSelected || itemData.findText.empty()) {
+            continue;
+        }
+        // Regex and variables are evaluated per match by Scintilla and Lua, fuzzy entries have their own matcher
+        if (itemData.regex || itemData.useVariables || itemData.fuzzy > 0) {
+            return false;
+        }
 
-    // Convert the string from UTF-8 to the codepage of the document
-    std::string replaceTextCp = utf8ToCodepage(replaceTextUtf8, cp);
+        const CompiledReplaceItem& compiled = getCompiledItem(itemData);
+        ListPattern pattern;
+        pattern.findText = compiled.findTextUtf8;
+        pattern.wholeWord = itemData.wholeWord;
+        pattern.matchCase = itemData.matchCase;
 
-    // Perform the regex replacement
-    send(SCI_REPLACETARGETRE, static_cast<WPARAM>(-1), reinterpret_cast<sptr_t>(replaceTextCp.c_str()));
+        // Caseless non-ASCII text is folded for UTF-8 only; ANSI documents use the system code page
+        if (!ListMatcher::isSupported(pattern, codepage == SC_CP_UTF8)) {
+            return false;
+        }
 
-    // Get the end position after the replacement
-    Sci_Position newTargetEnd = static_cast<Sci_Position>(send(SCI_GETTARGETEND, 0, 0));
+        // Delimiters or line breaks in the texts move the column layout for the following entries
+        if (columnMode && !simultaneous) {
+            for (const std::string* str : { &compiled.findTextUtf8, &compiled.replaceTextCp }) {
+                if (str->find(columnDelimiterData.extendedDelimiter) != std::string::npos ||
+                    (!columnDelimiterData.quoteChar.empty() && str->find(columnDelimiterData.quoteChar) != std::string::npos) ||
+                    str->find_first_of("\r\n") != std::string::npos) {
+                    return false;
+                }
+            }
+        }
 
-    // Set the cursor to the end of the replaced text
-    send(SCI_SETCURRENTPOS, newTargetEnd, 0);
+        source.push_back(itemData);
+        patterns.push_back(pattern);
+        replaceTexts.push_back(compiled.replaceTextCp);
+    }
 
-    // Clear selection
-    send(SCI_SETSELECTIONSTART, newTargetEnd, 0);
-    send(SCI_SETSELECTIONEND, newTargetEnd, 0);
+    if (patterns.empty()) {
+        return false;
+    }
 
-    return newTargetEnd;
-}
+    CharClass classes[256];
+    readCharClasses(classes);
+    matcher.setCharClasses(classes, codepage == SC_CP_UTF8);
 
-SelectionInfo MultiReplace::getSelectionInfo() {
-    // Get selected text
-    Sci_Position selectionStart = ::SendMessage(_hScintilla, SCI_GETSELECTIONSTART, 0, 0);
-    Sci_Position selectionEnd = ::SendMessage(_hScintilla, SCI_GETSELECTIONEND, 0, 0);
-    std::vector<char> buffer(selectionEnd - selectionStart + 1);
-    ::SendMessage(_hScintilla, SCI_GETSELTEXT, 0, reinterpret_cast<LPARAM>(&buffer[0]));
-    std::string selectedText(&buffer[0]);
+    // Word characters are read on every run, the automaton itself only changes with the entries
+    if (cached && listMatcherCodepage == codepage && listMatcherSource.size() == source.size() &&
+        std::equal(source.begin(), source.end(), listMatcherSource.begin(),
+            [](const ReplaceItemData& a, const ReplaceItemData& b) { return a.hasSameContent(b); })) {
+        return true;
+    }
 
-    // Calculate the length of the selected text
-    Sci_Position selectionLength = selectionEnd - selectionStart;
+    matcher.build(patterns);
+    replacements = std::move(replaceTexts);
+    if (cached) {
+        listMatcherSource = std::move(source);
+        listMatcherCodepage = codepage;
+    }
+    return true;
+}
 
-    return SelectionInfo{ selectedText, selectionStart, selectionLength };
+std::vector<ListMatch> MultiReplace::selectSimultaneousMatches(const ListMatcher& matcher, std::vector<ListMatch> candidates)
+{
+    // Overlaps go to the earlier list entry, or to the leftmost and then longest occurrence
+    std::vector<ListMatch> selected = (listReplaceMode == ListReplaceMode::LeftmostLongest)
+        ? ListMatcher::selectLeftmostLongestMatches(std::move(candidates))
+        : matcher.selectSequentialMatches(std::move(candidates));
+
+    if (isReplaceOnceInList) {
+        std::vector<bool> seen(matcher.patternCount(), false);
+        selected.erase(std::remove_if(selected.begin(), selected.end(), [&seen](const ListMatch& match) {
+            bool skip = seen[match.pattern];
+            seen[match.pattern] = true;
+            return skip;
+            }), selected.end());
+    }
+    return selected;
 }
 
-bool MultiReplace::resolveLuaSyntax(std::string& inputString, const LuaVariables& vars, bool& skip, bool regex)
+void MultiReplace::readCharClasses(CharClass classes[256])
 {
-    lua_State* L = luaL_newstate();  // Create a new Lua environment
-    luaL_openlibs(L);  // Load standard libraries
+    // Word boundaries as configured in Scintilla
+    std::fill(classes, classes + 256, CharClass::Punctuation);
+    for (int message : { SCI_GETWHITESPACECHARS, SCI_GETWORDCHARS }) {
+        std::vector<char> chars(static_cast<size_t>(send(message, 0, 0)) + 1, '\0');
+        send(message, 0, reinterpret_cast<sptr_t>(chars.data()));
+        chars.pop_back();  // Terminating NUL
+        for (char ch : chars) {
+            classes[static_cast<unsigned char>(ch)] = (message == SCI_GETWORDCHARS) ? CharClass::Word : CharClass::Space;
+        }
+    }
+    classes[static_cast<unsigned char>('\r')] = CharClass::NewLine;
+    classes[static_cast<unsigned char>('\n')] = CharClass::NewLine;
+}
 
-    // Set variables
-    lua_pushnumber(L, vars.CNT);
-    lua_setglobal(L, "CNT");
-    lua_pushnumber(L, vars.LCNT);
-    lua_setglobal(L, "LCNT");
-    lua_pushnumber(L, vars.LINE);
-    lua_setglobal(L, "LINE");
-    lua_pushnumber(L, vars.LPOS);
-    lua_setglobal(L, "LPOS");
-    lua_pushnumber(L, vars.APOS);
-    lua_setglobal(L, "APOS");
-    lua_pushnumber(L, vars.COL);
-    lua_setglobal(L, "COL");
-
-    // Convert numbers to integers
-    luaL_dostring(L, "CNT = math.tointeger(CNT)");
-    luaL_dostring(L, "LCNT = math.tointeger(LCNT)");
-    luaL_dostring(L, "LINE = math.tointeger(LINE)");
-    luaL_dostring(L, "LPOS = math.tointeger(LPOS)");
-    luaL_dostring(L, "APOS = math.tointeger(APOS)");
-    luaL_dostring(L, "COL = math.tointeger(COL)");
+void MultiReplace::findListMatches(const ListMatcher& matcher, std::vector<ListMatch>& matches)
+{
+    // The UI thread waits for the workers, so the document cannot change while they read it
+    const char* text = reinterpret_cast<const char*>(send(SCI_GETCHARACTERPOINTER, 0, 0));
+    size_t textLength = static_cast<size_t>(send(SCI_GETLENGTH, 0, 0));
+    size_t threadCount = std::max<size_t>(1, std::thread::hardware_concurrency());
 
-    setLuaVariable(L, "MATCH", vars.MATCH);
-    // Get CAPs from Scintilla using SCI_GETTAG
-    std::vector<std::string> caps;  // Initialize an empty vector to store the captures
+    for (const SelectionRange& range : getScopeRanges()) {
+        matcher.findAllParallel(text, textLength, static_cast<size_t>(range.start), static_cast<size_t>(range.end),
+            threadCount, SCAN_CHUNK_LENGTH, matches);
+    }
+}
 
-    if (regex) {
-        sptr_t len = 0;
-        for (int i = 1; ; ++i) {
-            char buffer[1024] = { 0 };  // Buffer to hold the capture value
-            len = send(SCI_GETTAG, i, reinterpret_cast<sptr_t>(buffer), true);
+bool MultiReplace::updateMatchIndex(const std::vector<ReplaceItemData>& list)
+{
+    // Selections and columns keep the search per entry, as do DBCS documents with their lead bytes
+    int codepage = static_cast<int>(send(SCI_GETCODEPAGE, 0, 0));
+    if (IsDlgButtonChecked(_hSelf, IDC_SELECTION_RADIO) == BST_CHECKED || IsDlgButtonChecked(_hSelf, IDC_COLUMN_MODE_RADIO) == BST_CHECKED ||
+        (codepage != 0 && codepage != SC_CP_UTF8)) {
+        return false;
+    }
 
-            if (len <= 0) {
-                // If len is zero or negative, break the loop
-                break;
-            }
+    CharClass classes[256];
+    readCharClasses(classes);
+    sptr_t document = send(SCI_GETDOCPOINTER, 0, 0);
+    size_t textLength = static_cast<size_t>(send(SCI_GETLENGTH, 0, 0));
 
-            if (len < sizeof(buffer)) {
-                // If the first character is 0x00, break the loop
-                if (buffer[0] == 0x00) {
-                    break;
-                }
-                buffer[len] = '\0';  // Null-terminate the string
-                std::string cap(buffer);  // Convert to std::string
-                caps.push_back(cap);  // Add the capture to the vector
-            }
-            else {
-                // Buffer overflow detected: This should be rare, but it's good to check
-                lua_close(L);
-                return false;
-            }
-        }
+    // A length that differs from the repaired one means an edit was not seen
+    if (matchIndex.isActive() && matchIndexScintilla == _hScintilla && matchIndexDocument == document &&
+        matchIndexCodepage == codepage && matchIndexLength == textLength &&
+        std::equal(classes, classes + 256, matchIndexClasses) &&
+        std::equal(list.begin(), list.end(), matchIndexSource.begin(), matchIndexSource.end(),
+            [](const ReplaceItemData& a, const ReplaceItemData& b) { return a.isSelected == b.isSelected && a.hasSameContent(b); })) {
+        matchIndexMoved = 0;
+        return true;
     }
+    matchIndex.clear();
 
-    // Process the captures and set them as global variables
-    for (size_t i = 0; i < caps.size(); ++i) {
-        std::string cap = caps[i];
-        std::string globalVarName = "CAP" + std::to_string(i + 1);
-        setLuaVariable(L, globalVarName, cap);
-    }
+    std::vector<ListPattern> patterns;
+    std::vector<int> patternOfEntry(list.size(), -1);
+    for (size_t i = 0; i < list.size(); ++i) {
+        const ReplaceItemData& itemData = list[i];
+        if (!itemData.isSelected || itemData.findText.empty() || itemData.regex || itemData.useVariables || itemData.fuzzy > 0) {
+            continue;
+        }
+
+        ListPattern pattern;
+        pattern.findText = getCompiledItem(itemData).findTextUtf8;
+        pattern.wholeWord = itemData.wholeWord;
+        pattern.matchCase = itemData.matchCase;
+        if (ListMatcher::isSupported(pattern, codepage == SC_CP_UTF8)) {
+            patternOfEntry[i] = static_cast<int>(patterns.size());
+            patterns.push_back(pattern);
+        }
+    }
+    if (patterns.empty()) {
+        return false;
+    }
+
+    matchIndexMatcher = ListMatcher();
+    matchIndexMatcher.setCharClasses(classes, codepage == SC_CP_UTF8);
+    matchIndexMatcher.build(patterns);
+
+    // Built once by the workers while the search waits, later edits only rescan their surroundings
+    std::vector<ListMatch> matches;
+    findListMatches(matchIndexMatcher, matches);
+    matchIndex.assign(std::move(matches), patterns.size(), matchIndexMatcher.maxPatternLength());
+
+    matchIndexSource = list;
+    matchIndexPatterns = std::move(patternOfEntry);
+    std::copy(classes, classes + 256, matchIndexClasses);
+    matchIndexScintilla = _hScintilla;
+    matchIndexDocument = document;
+    matchIndexCodepage = codepage;
+    matchIndexLength = textLength;
+    matchIndexMoved = 0;
+    return true;
+}
+
+// Moves the occurrences in index along with an edit and searches the text around it again
+static void rescanAroundEdit(MatchIndex& index, const ListMatcher& matcher, HWND hScintilla, const SCNotification* notifyCode)
+{
+    size_t pos = static_cast<size_t>(notifyCode->position);
+    size_t length = static_cast<size_t>(notifyCode->length);
+    bool inserted = (notifyCode->modificationType & SC_MOD_INSERTTEXT) != 0;
+    size_t rescanStart = 0;
+    size_t rescanEnd = 0;
+    index.replaced(pos, inserted ? 0 : length, inserted ? length : 0, rescanStart, rescanEnd);
+
+    size_t textLength = static_cast<size_t>(::SendMessage(hScintilla, SCI_GETLENGTH, 0, 0));
+    rescanEnd = std::min(rescanEnd, textLength);
+    size_t readStart = (rescanStart > ListMatcher::CONTEXT_LENGTH) ? rescanStart - ListMatcher::CONTEXT_LENGTH : 0;
+    size_t readEnd = std::min(rescanEnd + ListMatcher::CONTEXT_LENGTH, textLength);
+    const char* text = reinterpret_cast<const char*>(::SendMessage(hScintilla, SCI_GETRANGEPOINTER, readStart, readEnd - readStart));
+
+    std::vector<ListMatch> found;
+    matcher.findAll(text, readEnd - readStart, rescanStart - readStart, rescanEnd - readStart, found);
+    for (ListMatch& match : found) {
+        match.pos += readStart;
+    }
+    index.addRescanned(found);
+}
+
+void MultiReplace::repairMatchIndex(const SCNotification* notifyCode)
+{
+    HWND hScintilla = static_cast<HWND>(notifyCode->nmhdr.hwndFrom);
+    if (::SendMessage(hScintilla, SCI_GETDOCPOINTER, 0, 0) != matchIndexDocument) {
+        return;
+    }
+    // Both views report an edit of a cloned document, only the one the index was built in is followed
+    if (hScintilla != matchIndexScintilla) {
+        matchIndex.clear();
+        return;
+    }
+
+    // Long runs of edits from elsewhere are cheaper to search again once
+    matchIndexMoved += matchIndex.size();
+    if (matchIndexMoved > MATCH_INDEX_REPAIR_LIMIT) {
+        matchIndex.clear();
+        return;
+    }
+
+    size_t length = static_cast<size_t>(notifyCode->length);
+    bool inserted = (notifyCode->modificationType & SC_MOD_INSERTTEXT) != 0;
+    matchIndexLength = inserted ? matchIndexLength + length : matchIndexLength - length;
+    rescanAroundEdit(matchIndex, matchIndexMatcher, hScintilla, notifyCode);
+}
+
+// Search settings of an entry as one string, so entries searching the same share a count; empty for
+// entries the Hits column does not count
+static std::wstring hitKeyOf(const ReplaceItemData& itemData)
+{
+    if (itemData.findText.empty() || itemData.regex || itemData.useVariables || itemData.fuzzy > 0) {
+        return std::wstring();
+    }
+    std::wstring key;
+    key += itemData.wholeWord ? L'W' : L'-';
+    key += itemData.matchCase ? L'C' : L'-';
+    key += itemData.extended ? L'E' : L'-';
+    return key + itemData.findText;
+}
+
+void MultiReplace::scheduleHitCount()
+{
+    // Restarted by every change, so a burst of edits is counted once
+    SetTimer(_hSelf, HIT_COUNT_TIMER, HIT_COUNT_DELAY_MS, NULL);
+}
+
+void MultiReplace::scheduleHitCountOfNewEntries()
+{
+    // Called where the list changes, so painting never starts a count. Entries neither the last count nor the
+    // running one has seen are counted with the next one; the counts of removed entries are just not read.
+    const std::unordered_map<std::wstring, size_t>& keys = hitCounter.isRunning() ? hitPendingKeys : hitPatternOfKey;
+    for (const ReplaceItemData& itemData : replaceListData) {
+        std::wstring key = hitKeyOf(itemData);
+        if (!key.empty() && keys.count(key) == 0) {
+            scheduleHitCount();
+            return;
+        }
+    }
+}
+
+void MultiReplace::startHitCount()
+{
+    KillTimer(_hSelf, HIT_COUNT_TIMER);
+    hitCounter.cancel();
+    hitGeneration++;
+    if (!IsWindowVisible(_hSelf)) {
+        return;
+    }
+
+    // Every Normal and Extended entry is counted, selected or not; DBCS documents are not counted, as in the other list scans
+    int codepage = static_cast<int>(send(SCI_GETCODEPAGE, 0, 0));
+    bool countable = (codepage == 0 || codepage == SC_CP_UTF8);
+    std::vector<ListPattern> patterns;
+    std::unordered_map<std::wstring, size_t> keys;
+    for (const ReplaceItemData& itemData : replaceListData) {
+        std::wstring key = hitKeyOf(itemData);
+        if (key.empty() || keys.count(key) > 0) {
+            continue;
+        }
+
+        ListPattern pattern;
+        pattern.findText = getCompiledItem(itemData).findTextUtf8;
+        pattern.wholeWord = itemData.wholeWord;
+        pattern.matchCase = itemData.matchCase;
+        if (!countable || pattern.findText.empty() || !ListMatcher::isSupported(pattern, codepage == SC_CP_UTF8)) {
+            keys[key] = SIZE_MAX;
+            continue;
+        }
+        keys[key] = patterns.size();
+        patterns.push_back(pattern);
+    }
+
+    // Nothing to search, the entries are known to have no count
+    if (patterns.empty()) {
+        hitIndex.clear();
+        hitDensity.clear();
+        hitPatternOfKey = std::move(keys);
+        hitDocument = send(SCI_GETDOCPOINTER, 0, 0);
+        hitsCurrent = true;
+        repaintHits();
+        return;
+    }
+
+    CharClass classes[256];
+    readCharClasses(classes);
+    hitPendingMatcher = ListMatcher();
+    hitPendingMatcher.setCharClasses(classes, codepage == SC_CP_UTF8);
+    hitPendingMatcher.build(patterns);
+    hitPendingKeys = std::move(keys);
+    hitPendingDocument = send(SCI_GETDOCPOINTER, 0, 0);
+    hitEditedWhileCounting = false;
+
+    // The worker searches a copy, so editing can go on; edits made meanwhile let the result be thrown away
+    const char* text = reinterpret_cast<const char*>(send(SCI_GETCHARACTERPOINTER, 0, 0));
+    std::string snapshot(text, static_cast<size_t>(send(SCI_GETLENGTH, 0, 0)));
+    HWND hDlg = _hSelf;
+    WPARAM generation = hitGeneration;
+    hitCounter.start(hitPendingMatcher, std::move(snapshot), std::max<size_t>(1, std::thread::hardware_concurrency()), SCAN_CHUNK_LENGTH,
+        [hDlg, generation]() { PostMessage(hDlg, WM_HITS_COUNTED, generation, 0); });
+}
+
+void MultiReplace::finishHitCount(WPARAM generation)
+{
+    // Results of counts replaced by a newer one are dropped by the newer start
+    if (generation != hitGeneration) {
+        return;
+    }
+
+    DensityMap density;
+    std::vector<ListMatch> positions;
+    bool kept = false;
+    if (!hitCounter.take(density, positions, kept)) {
+        return;
+    }
+    if (hitEditedWhileCounting || hitPendingDocument != send(SCI_GETDOCPOINTER, 0, 0)) {
+        scheduleHitCount();
+        return;
+    }
+
+    hitMatcher = std::move(hitPendingMatcher);
+    hitPatternOfKey = std::move(hitPendingKeys);
+    hitDensity = std::move(density);
+    if (kept) {
+        hitIndex.assign(std::move(positions), hitMatcher.patternCount(), hitMatcher.maxPatternLength());
+    }
+    else {
+        hitIndex.clear();
+    }
+    hitScintilla = _hScintilla;
+    hitDocument = hitPendingDocument;
+    hitIndexMoved = 0;
+    hitsCurrent = true;
+    repaintHits();
+}
+
+void MultiReplace::repairHitIndex(const SCNotification* notifyCode)
+{
+    HWND hScintilla = static_cast<HWND>(notifyCode->nmhdr.hwndFrom);
+    sptr_t document = ::SendMessage(hScintilla, SCI_GETDOCPOINTER, 0, 0);
+    if (hitCounter.isRunning()) {
+        hitEditedWhileCounting = hitEditedWhileCounting || document == hitPendingDocument;
+        return;
+    }
+    if (!hitsCurrent || document != hitDocument) {
+        return;
+    }
+
+    // During Replace All and after edits in another view the hits are counted again once the editing pauses
+    if (hScintilla != hitScintilla || isBatchEditActive) {
+        recountHits();
+        return;
+    }
+
+    // The counts per bucket follow every edit and are completed after the update; the positions only as long
+    // as moving them stays cheap, the counts are taken from the buckets then
+    size_t pos = static_cast<size_t>(notifyCode->position);
+    size_t length = static_cast<size_t>(notifyCode->length);
+    bool inserted = (notifyCode->modificationType & SC_MOD_INSERTTEXT) != 0;
+    hitDensity.replaced(pos, inserted ? 0 : length, inserted ? length : 0);
+    hitIndexMoved += hitIndex.size();
+    if (hitIndexMoved > MATCH_INDEX_REPAIR_LIMIT) {
+        hitIndex.clear();
+    }
+    if (hitIndex.isActive()) {
+        rescanAroundEdit(hitIndex, hitMatcher, hScintilla, notifyCode);
+    }
+    repaintHits();
+}
+
+void MultiReplace::recountEditedHits()
+{
+    size_t start = 0;
+    size_t end = 0;
+    if (!hitsCurrent || !hitDensity.takeEdited(start, end)) {
+        return;
+    }
+
+    // Buckets reached by long edits are left to the background count
+    size_t textLength = static_cast<size_t>(::SendMessage(hitScintilla, SCI_GETLENGTH, 0, 0));
+    if (::SendMessage(hitScintilla, SCI_GETDOCPOINTER, 0, 0) != hitDocument || hitDensity.length() != textLength || end - start > HitCounter::SLICE_LENGTH) {
+        recountHits();
+        return;
+    }
+
+    // Occurrences starting in the buckets are counted, reading on by the longest one
+    auto read = [this](size_t pos, size_t length) {
+        return reinterpret_cast<const char*>(::SendMessage(hitScintilla, SCI_GETRANGEPOINTER, pos, length));
+    };
+    HitCounter::countEdited(hitMatcher, read, textLength, start, end, hitDensity);
+    repaintHits();
+}
+
+void MultiReplace::recountHits()
+{
+    hitIndex.clear();
+    hitDensity.clear();
+    hitsCurrent = false;
+    repaintHits();
+    scheduleHitCount();
+}
+
+void MultiReplace::dropHits()
+{
+    KillTimer(_hSelf, HIT_COUNT_TIMER);
+    hitCounter.cancel();
+    hitIndex.clear();
+    hitDensity.clear();
+    hitPatternOfKey.clear();
+    hitsCurrent = false;
+    hitDocument = 0;
+    repaintHits();
+}
+
+void MultiReplace::repaintHits()
+{
+    InvalidateRect(_replaceListView, NULL, FALSE);
+    InvalidateRect(GetDlgItem(_hSelf, IDC_DENSITY_STRIP), NULL, FALSE);
+}
+
+bool MultiReplace::readHits(const ReplaceItemData& itemData, size_t& hits)
+{
+    std::wstring key = hitKeyOf(itemData);
+    if (key.empty()) {
+        return false;
+    }
+
+    // An entry the last count did not see has no count yet; the list change that added it scheduled the next one
+    auto it = hitPatternOfKey.find(key);
+    if (!hitsCurrent || it == hitPatternOfKey.end() || it->second == SIZE_MAX) {
+        return false;
+    }
+    hits = hitIndex.isActive() ? hitIndex.count(it->second) : hitDensity.entryTotal(it->second);
+    return true;
+}
+
+bool MultiReplace::isDensityShown()
+{
+    return hitsCurrent && hitDensity.isActive() && hitDensity.length() > 0 && send(SCI_GETDOCPOINTER, 0, 0) == hitDocument;
+}
+
+size_t MultiReplace::densityEntry()
+{
+    // A single selected entry is shown alone, otherwise all counted entries together
+    if (ListView_GetSelectedCount(_replaceListView) != 1) {
+        return SIZE_MAX;
+    }
+    int row = ListView_GetNextItem(_replaceListView, -1, LVNI_SELECTED);
+    if (row < 0 || static_cast<size_t>(row) >= replaceListData.size()) {
+        return SIZE_MAX;
+    }
+    auto it = hitPatternOfKey.find(hitKeyOf(replaceListData[row]));
+    return (it != hitPatternOfKey.end()) ? it->second : SIZE_MAX;
+}
+
+static size_t densityHits(const DensityMap& density, size_t bucket, size_t entry)
+{
+    return (entry == SIZE_MAX) ? density.total(bucket) : density.count(bucket, entry);
+}
+
+void MultiReplace::drawDensityStrip(const DRAWITEMSTRUCT* drawItem)
+{
+    HDC hdc = drawItem->hDC;
+    RECT rect = drawItem->rcItem;
+    FillRect(hdc, &rect, GetSysColorBrush(COLOR_WINDOW));
+    FrameRect(hdc, &rect, GetSysColorBrush(COLOR_BTNSHADOW));
+    InflateRect(&rect, -1, -1);
+    int rows = rect.bottom - rect.top;
+    if (rows <= 0 || !isDensityShown()) {
+        return;
+    }
+
+    // Each bucket spreads its occurrences evenly over the rows its text covers
+    size_t entry = densityEntry();
+    double textLength = static_cast<double>(hitDensity.length());
+    std::vector<double> rowHits(static_cast<size_t>(rows), 0.0);
+    for (size_t bucket = 0; bucket < hitDensity.bucketCount(); ++bucket) {
+        size_t hits = densityHits(hitDensity, bucket, entry);
+        double start = static_cast<double>(hitDensity.bucketStart(bucket));
+        double end = static_cast<double>(hitDensity.bucketEnd(bucket));
+        if (hits == 0 || end <= start) {
+            continue;
+        }
+        int firstRow = static_cast<int>(start * rows / textLength);
+        int lastRow = std::min(rows - 1, static_cast<int>(end * rows / textLength));
+        for (int row = firstRow; row <= lastRow; ++row) {
+            double overlap = std::min(end, (row + 1) * textLength / rows) - std::max(start, row * textLength / rows);
+            if (overlap > 0) {
+                rowHits[row] += hits * overlap / (end - start);
+            }
+        }
+    }
+
+    // Light orange for a few occurrences up to dark red for the densest rows; the square root keeps single ones visible
+    double maxHits = *std::max_element(rowHits.begin(), rowHits.end());
+    HBRUSH brush = reinterpret_cast<HBRUSH>(GetStockObject(DC_BRUSH));
+    for (int row = 0; row < rows && maxHits > 0; ++row) {
+        if (rowHits[row] <= 0) {
+            continue;
+        }
+        double heat = std::sqrt(rowHits[row] / maxHits);
+        SetDCBrushColor(hdc, RGB(static_cast<int>(255 - 63 * heat), static_cast<int>(200 * (1 - heat)), static_cast<int>(120 * (1 - heat))));
+        RECT line = { rect.left, rect.top + row, rect.right, rect.top + row + 1 };
+        FillRect(hdc, &line, brush);
+    }
+
+    // The part of the document in the view, like the thumb of a scrollbar
+    LRESULT firstVisible = send(SCI_GETFIRSTVISIBLELINE, 0, 0);
+    LRESULT firstLine = send(SCI_DOCLINEFROMVISIBLE, firstVisible, 0);
+    LRESULT lastLine = send(SCI_DOCLINEFROMVISIBLE, firstVisible + send(SCI_LINESONSCREEN, 0, 0), 0);
+    double viewStart = static_cast<double>(send(SCI_POSITIONFROMLINE, firstLine, 0));
+    double viewEnd = static_cast<double>(send(SCI_GETLINEENDPOSITION, lastLine, 0));
+    RECT view = { rect.left, rect.top + static_cast<int>(viewStart * rows / textLength), rect.right,
+        rect.top + std::min(rows, static_cast<int>(viewEnd * rows / textLength) + 1) };
+    FrameRect(hdc, &view, GetSysColorBrush(COLOR_WINDOWTEXT));
+}
+
+void MultiReplace::handleDensityStripClick()
+{
+    if (!isDensityShown()) {
+        showStatusMessage(L"No Hits counted in this document.", RGB(255, 0, 0));
+        return;
+    }
+
+    size_t entry = densityEntry();
+    size_t bucketCount = hitDensity.bucketCount();
+    ListMatch match;
+    bool found = false;
+    if (GetKeyState(VK_SHIFT) & 0x8000) {
+        // Shift+Click goes to the next region behind the caret at least half as dense as the densest one
+        std::vector<double> density(bucketCount, 0.0);
+        for (size_t bucket = 0; bucket < bucketCount; ++bucket) {
+            size_t length = hitDensity.bucketEnd(bucket) - hitDensity.bucketStart(bucket);
+            density[bucket] = (length > 0) ? static_cast<double>(densityHits(hitDensity, bucket, entry)) / length : 0.0;
+        }
+        double threshold = *std::max_element(density.begin(), density.end()) / 2;
+        size_t bucket = hitDensity.bucketAt(static_cast<size_t>(send(SCI_GETCURRENTPOS, 0, 0)));
+        size_t step = 0;
+        for (; step < bucketCount && threshold > 0 && density[bucket] >= threshold; ++step) {
+            bucket = (bucket + 1) % bucketCount;
+        }
+        for (; step < 2 * bucketCount && threshold > 0 && density[bucket] < threshold; ++step) {
+            bucket = (bucket + 1) % bucketCount;
+        }
+        found = threshold > 0 && findDensityOccurrence(bucket, entry, hitDensity.bucketStart(bucket), false, match);
+    }
+    else {
+        // The row clicked stands for a part of the document: the first occurrence at or behind it, otherwise the last one in front
+        HWND strip = GetDlgItem(_hSelf, IDC_DENSITY_STRIP);
+        POINT cursor;
+        GetCursorPos(&cursor);
+        ScreenToClient(strip, &cursor);
+        RECT rect;
+        GetClientRect(strip, &rect);
+        InflateRect(&rect, -1, -1);
+        int rows = std::max(1, static_cast<int>(rect.bottom - rect.top));
+        int row = std::min(rows - 1, std::max(0, static_cast<int>(cursor.y - rect.top)));
+        size_t pos = static_cast<size_t>(static_cast<double>(row) * hitDensity.length() / rows);
+        size_t clicked = hitDensity.bucketAt(pos);
+        for (size_t bucket = clicked; bucket < bucketCount && !found; ++bucket) {
+            found = densityHits(hitDensity, bucket, entry) > 0 && findDensityOccurrence(bucket, entry, pos, false, match);
+        }
+        for (size_t bucket = clicked + 1; bucket-- > 0 && !found; ) {
+            found = densityHits(hitDensity, bucket, entry) > 0 && findDensityOccurrence(bucket, entry, pos, true, match);
+        }
+    }
+
+    if (!found) {
+        showStatusMessage(L"No occurrences to go to.", RGB(255, 0, 0));
+        return;
+    }
+    displayResultCentered(match.pos, match.pos + match.length, true);
+    size_t bucket = hitDensity.bucketAt(match.pos);
+    LRESULT firstLine = send(SCI_LINEFROMPOSITION, hitDensity.bucketStart(bucket), 0);
+    LRESULT lastLine = send(SCI_LINEFROMPOSITION, hitDensity.bucketEnd(bucket), 0);
+    showStatusMessage(std::to_wstring(densityHits(hitDensity, bucket, entry)) + L" occurrences in lines " + std::to_wstring(firstLine + 1) + L"-"
+        + std::to_wstring(lastLine + 1) + L".", RGB(0, 128, 0));
+}
+
+bool MultiReplace::findDensityOccurrence(size_t bucket, size_t entry, size_t pos, bool before, ListMatch& match)
+{
+    // The bucket and the text an occurrence starting in it can reach
+    size_t textLength = hitDensity.length();
+    size_t start = hitDensity.bucketStart(bucket);
+    size_t end = hitDensity.bucketEnd(bucket);
+    size_t searchEnd = std::min(end + hitMatcher.maxPatternLength(), textLength);
+    size_t readStart = (start > ListMatcher::CONTEXT_LENGTH) ? start - ListMatcher::CONTEXT_LENGTH : 0;
+    size_t readEnd = std::min(searchEnd + ListMatcher::CONTEXT_LENGTH, textLength);
+    if (readEnd <= readStart) {
+        return false;
+    }
+    const char* text = reinterpret_cast<const char*>(send(SCI_GETRANGEPOINTER, readStart, readEnd - readStart));
+    std::vector<ListMatch> found;
+    hitMatcher.findAll(text, readEnd - readStart, start - readStart, searchEnd - readStart, found);
+
+    // Occurrences come ordered by their end, the nearest start is picked here
+    bool matched = false;
+    for (const ListMatch& candidate : found) {
+        size_t candidatePos = candidate.pos + readStart;
+        if (candidatePos >= end || (entry != SIZE_MAX && candidate.pattern != entry) || (before ? candidatePos >= pos : candidatePos < pos)) {
+            continue;
+        }
+        if (!matched || (before ? candidatePos > match.pos : candidatePos < match.pos)) {
+            match = candidate;
+            match.pos = candidatePos;
+            matched = true;
+        }
+    }
+    return matched;
+}
+
+std::string MultiReplace::getMatchText(const SearchResult& result)
+{
+    // Read on demand from the document, the match has to be the one of the current text
+    if (result.pos < 0 || result.length <= 0) {
+        return std::string();
+    }
+    const char* text = reinterpret_cast<const char*>(send(SCI_GETRANGEPOINTER, result.pos, result.length));
+    return (text != nullptr) ? std::string(text, static_cast<size_t>(result.length)) : std::string();
+}
+
+CompiledReplaceItem& MultiReplace::getCompiledItem(const ReplaceItemData& itemData)
+{
+    // Entries of the list keep their plan in the slot with the same index, all others share the field slot
+    CompiledReplaceItem* item = &compiledFieldItem;
+    const ReplaceItemData* listBegin = replaceListData.data();
+    if (!replaceListData.empty() && &itemData >= listBegin && &itemData < listBegin + replaceListData.size()) {
+        if (compiledListData.size() > replaceListData.size()) {
+            for (size_t i = replaceListData.size(); i < compiledListData.size(); ++i) {
+                releaseCompiledItem(compiledListData[i]);
+            }
+        }
+        compiledListData.resize(replaceListData.size());
+        item = &compiledListData[static_cast<size_t>(&itemData - listBegin)];
+    }
+
+    // Edited, moved or reloaded entries are detected by content, so the slots never go stale
+    int codepage = static_cast<int>(send(SCI_GETCODEPAGE, 0, 0));
+    if (item->codepage == codepage && item->source.hasSameContent(itemData)) {
+        return *item;
+    }
+
+    releaseCompiledItem(*item);
+    item->source = itemData;
+    item->codepage = codepage;
+    item->findTextUtf8 = convertAndExtend(itemData.findText, itemData.extended);
+    item->replaceTextUtf8 = convertAndExtend(itemData.replaceText, itemData.extended);
+    item->replaceTextCp = utf8ToCodepage(item->replaceTextUtf8, codepage);
+    item->searchFlags = (itemData.wholeWord * SCFIND_WHOLEWORD) | (itemData.matchCase * SCFIND_MATCHCASE) | (itemData.regex * SCFIND_REGEXP) |
+        (std::clamp(itemData.fuzzy, 0, MAX_FUZZY_DISTANCE) << SEARCH_FUZZY_SHIFT);
+    return *item;
+}
+
+void MultiReplace::releaseCompiledItem(CompiledReplaceItem& item)
+{
+    if (item.luaChunkRef != LUA_NOREF && luaState != nullptr) {
+        luaL_unref(luaState, LUA_REGISTRYINDEX, item.luaChunkRef);
+    }
+    item = CompiledReplaceItem();
+}
+
+void MultiReplace::clearCompiledItems()
+{
+    for (CompiledReplaceItem& item : compiledListData) {
+        releaseCompiledItem(item);
+    }
+    compiledListData.clear();
+    releaseCompiledItem(compiledFieldItem);
+
+    listMatcher = ListMatcher();
+    listMatcherSource.clear();
+    listMatcherReplacements.clear();
+    searchFuzzyMatcher = FuzzyMatcher();
+    searchFuzzyText.clear();
+    searchFuzzyCodepage = -1;
+    listMatcherCodepage = -1;
+}
+
+void MultiReplace::beginBatchEdit()
+{
+    isBatchEditActive = true;
+    batchFirstDirtyLine = -1;
+    batchCaretPos = -1;
+    captureSearchScope();
+
+    // Replace All moves too many matches to repair the position index per edit
+    matchIndex.clear();
+
+    // The delimiter index is not read while replacing outside column mode or with captured cells, so it is not kept up to date per match
+    batchLoggingSuspended = isLoggingEnabled && (IsDlgButtonChecked(_hSelf, IDC_COLUMN_MODE_RADIO) != BST_CHECKED || searchScope.hasCells());
+    if (batchLoggingSuspended) {
+        isLoggingEnabled = false;
+    }
+
+    send(SCI_BEGINUNDOACTION, 0, 0);
+}
+
+void MultiReplace::endBatchEdit(bool rollback)
+{
+    send(SCI_ENDUNDOACTION, 0, 0);
+
+    // The whole Replace All is one undo step, undoing it restores the text from before the run
+    if (rollback) {
+        send(SCI_UNDO, 0, 0);
+        batchCaretPos = -1;
+    }
+    isBatchEditActive = false;
+    releaseSearchScope();
+
+    if (batchCaretPos >= 0) {
+        setCaretAfterReplace(batchCaretPos);
+    }
+
+    // One rebuild of the delimiter index instead of an update per match
+    if (batchLoggingSuspended) {
+        isLoggingEnabled = true;
+        if (!lineDelimiterPositions.empty() && columnDelimiterData.isValid()) {
+            findAllDelimitersInDocument();
+            batchFirstDirtyLine = 0;
+        }
+        else {
+            logChanges.clear();
+            textModified = false;
+        }
+        batchLoggingSuspended = false;
+    }
+
+    // Column highlighting of the changed lines was deferred, refresh it in one go
+    if (isColumnHighlighted && batchFirstDirtyLine >= 0) {
+        for (LRESULT line = batchFirstDirtyLine; line < static_cast<LRESULT>(lineDelimiterPositions.size()); ++line) {
+            highlightColumnsInLine(line);
+        }
+    }
+    batchFirstDirtyLine = -1;
+}
+
+void MultiReplace::setCaretAfterReplace(Sci_Position pos)
+{
+    // Within a batch edit only the last position counts
+    if (isBatchEditActive) {
+        batchCaretPos = pos;
+        return;
+    }
+
+    send(SCI_SETCURRENTPOS, pos, 0);
+
+    // Clear selection
+    send(SCI_SETSELECTIONSTART, pos, 0);
+    send(SCI_SETSELECTIONEND, pos, 0);
+}
+
+Sci_Position MultiReplace::performReplace(const std::string& replaceTextCp, Sci_Position pos, Sci_Position length)
+{
+    // Set the target range for the replacement
+    send(SCI_SETTARGETRANGE, pos, pos + length);
+    bool layoutChanged = searchScope.hasCells() && changesColumnLayout(pos, length);
+
+    // Perform the replacement, the text is already in the codepage of the document
+    send(SCI_REPLACETARGET, replaceTextCp.size(), reinterpret_cast<sptr_t>(replaceTextCp.c_str()));
+
+    // Get the end position after the replacement
+    Sci_Position newTargetEnd = static_cast<Sci_Position>(send(SCI_GETTARGETEND, 0, 0));
+    updateSearchScope(pos, length, newTargetEnd - pos, layoutChanged);
+
+    // Set the cursor to the end of the replaced text
+    setCaretAfterReplace(newTargetEnd);
+
+    return newTargetEnd;
+}
+
+Sci_Position MultiReplace::performRegexReplace(const std::string& replaceTextCp, Sci_Position pos, Sci_Position length)
+{
+    // Set the target range for the replacement
+    send(SCI_SETTARGETRANGE, pos, pos + length);
+    bool layoutChanged = searchScope.hasCells() && changesColumnLayout(pos, length);
+
+    // Perform the regex replacement, the text is already in the codepage of the document
+    send(SCI_REPLACETARGETRE, static_cast<WPARAM>(-1), reinterpret_cast<sptr_t>(replaceTextCp.c_str()));
+
+    // Get the end position after the replacement
+    Sci_Position newTargetEnd = static_cast<Sci_Position>(send(SCI_GETTARGETEND, 0, 0));
+    updateSearchScope(pos, length, newTargetEnd - pos, layoutChanged);
+
+    // Set the cursor to the end of the replaced text
+    setCaretAfterReplace(newTargetEnd);
+
+    return newTargetEnd;
+}
+
+SelectionInfo MultiReplace::getSelectionInfo() {
+    // Get selected text
+    Sci_Position selectionStart = ::SendMessage(_hScintilla, SCI_GETSELECTIONSTART, 0, 0);
+    Sci_Position selectionEnd = ::SendMessage(_hScintilla, SCI_GETSELECTIONEND, 0, 0);
+    std::vector<char> buffer(selectionEnd - selectionStart + 1);
+    ::SendMessage(_hScintilla, SCI_GETSELTEXT, 0, reinterpret_cast<LPARAM>(&buffer[0]));
+    std::string selectedText(&buffer[0]);
+
+    // Calculate the length of the selected text
+    Sci_Position selectionLength = selectionEnd - selectionStart;
+
+    return SelectionInfo{ selectedText, selectionStart, selectionLength };
+}
+
+lua_State* MultiReplace::getLuaState()
+{
+    if (luaState != nullptr) {
+        return luaState;
+    }
+
+    luaState = luaL_newstate();  // Create the Lua environment shared by all evaluations
+    luaL_openlibs(luaState);  // Load standard libraries
 
     // Declare cond statement function
-    luaL_dostring(L,
+    luaL_dostring(luaState,
         "function cond(cond, trueVal, falseVal)\n"
         "  local res = {result = '', skip = false}  -- Initialize result table with defaults\n"
         "  if cond == nil then  -- Check if cond is nil\n"
@@ -1812,7 +2960,7 @@ bool MultiReplace::resolveLuaSyntax(std::string& inputString, const LuaVariables
 
 
     // Declare the set function
-    luaL_dostring(L,
+    luaL_dostring(luaState,
         "function set(strOrCalc)\n"
         "  local res = {result = '', skip = false}  -- Initialize result table with defaults\n"
         "  if strOrCalc == nil then\n"
@@ -1832,7 +2980,7 @@ bool MultiReplace::resolveLuaSyntax(std::string& inputString, const LuaVariables
         "end\n");
 
     // Declare formatNumber function
-    luaL_dostring(L,
+    luaL_dostring(luaState,
         "function fmtN(num, maxDecimals, fixedDecimals)\n"
         "  if num == nil then\n"
         "    error('num cannot be nil')\n"
@@ -1871,26 +3019,120 @@ bool MultiReplace::resolveLuaSyntax(std::string& inputString, const LuaVariables
         "  return output\n"
         "end");
 
-    
-    // Show syntax error
-    if (luaL_dostring(L, inputString.c_str()) != LUA_OK) {
-        const char* cstr = lua_tostring(L, -1);
-        lua_pop(L, 1);
+    return luaState;
+}
+
+void MultiReplace::closeLuaState()
+{
+    // Compiled chunks live in the registry of the state
+    clearCompiledItems();
+    if (luaState != nullptr) {
+        lua_close(luaState);
+        luaState = nullptr;
+    }
+}
+
+bool MultiReplace::resolveLuaSyntax(CompiledReplaceItem& item, std::string& result, const LuaVariables& vars, bool& skip)
+{
+    lua_State* L = getLuaState();
+    result = item.replaceTextUtf8;
+
+    auto showLuaError = [this, L](const wchar_t* title) {
         if (isLuaErrorDialogEnabled) {
-            std::wstring error_message = utf8ToWString(cstr);
-            MessageBoxW(NULL, error_message.c_str(), L"Use Variables: Syntax Error", MB_OK);
+            std::wstring error_message = utf8ToWString(lua_tostring(L, -1));
+            MessageBoxW(NULL, error_message.c_str(), title, MB_OK);
+        }
+        lua_settop(L, 0);
+    };
+
+    // Compile the expression once, it is kept until the entry changes
+    if (item.luaChunkRef == LUA_NOREF) {
+        if (luaL_loadbuffer(L, item.replaceTextUtf8.c_str(), item.replaceTextUtf8.size(), item.replaceTextUtf8.c_str()) != LUA_OK) {
+            showLuaError(L"Use Variables: Syntax Error");
+            return false;
+        }
+        item.luaChunkRef = luaL_ref(L, LUA_REGISTRYINDEX);
+    }
+
+    // Get CAPs from Scintilla using SCI_GETTAG
+    std::vector<std::string> caps;  // Initialize an empty vector to store the captures
+
+    if (item.source.regex) {
+        sptr_t len = 0;
+        for (int i = 1; ; ++i) {
+            char buffer[1024] = { 0 };  // Buffer to hold the capture value
+            len = send(SCI_GETTAG, i, reinterpret_cast<sptr_t>(buffer), true);
+
+            if (len <= 0) {
+                // If len is zero or negative, break the loop
+                break;
+            }
+
+            if (len < sizeof(buffer)) {
+                // If the first character is 0x00, break the loop
+                if (buffer[0] == 0x00) {
+                    break;
+                }
+                buffer[len] = '\0';  // Null-terminate the string
+                std::string cap(buffer);  // Convert to std::string
+                caps.push_back(cap);  // Add the capture to the vector
+            }
+            else {
+                // Buffer overflow detected: This should be rare, but it's good to check
+                return false;
+            }
         }
+    }
+
+    // Each evaluation gets its own globals on top of the shared ones, nothing carries over to the next match
+    lua_newtable(L);
+    lua_newtable(L);
+    lua_pushglobaltable(L);
+    lua_setfield(L, -2, "__index");
+    lua_setmetatable(L, -2);
+
+    // Set variables
+    lua_pushinteger(L, vars.CNT);
+    lua_setfield(L, -2, "CNT");
+    lua_pushinteger(L, vars.LCNT);
+    lua_setfield(L, -2, "LCNT");
+    lua_pushinteger(L, vars.LINE);
+    lua_setfield(L, -2, "LINE");
+    lua_pushinteger(L, vars.LPOS);
+    lua_setfield(L, -2, "LPOS");
+    lua_pushinteger(L, vars.APOS);
+    lua_setfield(L, -2, "APOS");
+    lua_pushinteger(L, vars.COL);
+    lua_setfield(L, -2, "COL");
+
+    setLuaVariable(L, "MATCH", vars.MATCH);
+
+    // Process the captures and set them as variables
+    for (size_t i = 0; i < caps.size(); ++i) {
+        std::string globalVarName = "CAP" + std::to_string(i + 1);
+        setLuaVariable(L, globalVarName, caps[i]);
+    }
+
+    // cond() and set() store their result in the shared globals
+    lua_pushnil(L);
+    lua_setglobal(L, "resultTable");
+
+    lua_rawgeti(L, LUA_REGISTRYINDEX, item.luaChunkRef);
+    lua_pushvalue(L, -2);
+    lua_setupvalue(L, -2, 1);  // Environment of the chunk
 
-        lua_close(L);
+    // Show syntax error
+    if (lua_pcall(L, 0, 0, 0) != LUA_OK) {
+        showLuaError(L"Use Variables: Syntax Error");
         return false;
     }
 
     // Retrieve the result from the table
-    lua_getglobal(L, "resultTable");
+    lua_getfield(L, -1, "resultTable");
     if (lua_istable(L, -1)) {
         lua_getfield(L, -1, "result");
         if (lua_isstring(L, -1) || lua_isnumber(L, -1)) {
-            inputString = lua_tostring(L, -1);  // Update inputString with the result
+            result = lua_tostring(L, -1);  // Update result with the evaluated text
         }
         lua_pop(L, 1);  // Pop the 'result' field from the stack
 
@@ -1907,16 +3149,14 @@ bool MultiReplace::resolveLuaSyntax(std::string& inputString, const LuaVariables
     else {
         // Show Runtime error
         if (isLuaErrorDialogEnabled) {
-            std::string error_message = "Execution halted due to execution failure in:\n" + inputString;
+            std::string error_message = "Execution halted due to execution failure in:\n" + item.replaceTextUtf8;
             std::wstring w_error_message = utf8ToWString(error_message.c_str());
             MessageBoxW(NULL, w_error_message.c_str(), L"Use Variables: Execution Error", MB_OK);
         }
-        lua_close(L);
+        lua_settop(L, 0);
         return false;
     }
-    lua_pop(L, 1);  // Pop the 'result' table from the stack
-
-    lua_close(L);
+    lua_settop(L, 0);  // Pop the 'result' table and the environment from the stack
 
     return true;
 
@@ -1937,7 +3177,7 @@ void MultiReplace::setLuaVariable(lua_State* L, const std::string& varName, std:
     else {
         lua_pushstring(L, value.c_str());
     }
-    lua_setglobal(L, varName.c_str());
+    lua_setfield(L, -2, varName.c_str());  // Into the environment table below the value
 }
 
 #pragma endregion
@@ -1979,7 +3219,7 @@ void MultiReplace::handleFindNextButton() {
         bool matchCase = (IsDlgButtonChecked(_hSelf, IDC_MATCH_CASE_CHECKBOX) == BST_CHECKED);
         bool regex = (IsDlgButtonChecked(_hSelf, IDC_REGEX_RADIO) == BST_CHECKED);
         bool extended = (IsDlgButtonChecked(_hSelf, IDC_EXTENDED_RADIO) == BST_CHECKED);
-        int searchFlags = (wholeWord * SCFIND_WHOLEWORD) | (matchCase * SCFIND_MATCHCASE) | (regex * SCFIND_REGEXP);
+        int searchFlags = (wholeWord * SCFIND_WHOLEWORD) | (matchCase * SCFIND_MATCHCASE) | (regex * SCFIND_REGEXP) | (readFuzzyDistance() << SEARCH_FUZZY_SHIFT);
 
         std::string findTextUtf8 = convertAndExtend(findText, extended);
         SearchResult result = performSearchForward(findTextUtf8, searchFlags, true, searchPos);
@@ -2043,7 +3283,7 @@ void MultiReplace::handleFindPrevButton() {
         bool matchCase = (IsDlgButtonChecked(_hSelf, IDC_MATCH_CASE_CHECKBOX) == BST_CHECKED);
         bool regex = (IsDlgButtonChecked(_hSelf, IDC_REGEX_RADIO) == BST_CHECKED);
         bool extended = (IsDlgButtonChecked(_hSelf, IDC_EXTENDED_RADIO) == BST_CHECKED);
-        int searchFlags = (wholeWord * SCFIND_WHOLEWORD) | (matchCase * SCFIND_MATCHCASE) | (regex * SCFIND_REGEXP);
+        int searchFlags = (wholeWord * SCFIND_WHOLEWORD) | (matchCase * SCFIND_MATCHCASE) | (regex * SCFIND_REGEXP) | (readFuzzyDistance() << SEARCH_FUZZY_SHIFT);
 
         std::string findTextUtf8 = convertAndExtend(findText, extended);
 
@@ -2073,6 +3313,19 @@ void MultiReplace::handleFindPrevButton() {
 
 SearchResult MultiReplace::performSingleSearch(const std::string& findTextUtf8, int searchFlags, bool selectMatch, SelectionRange range) {
 
+    // Fuzzy text is compared in the buffer; target and selection end up on the match as with Scintilla
+    if (searchFlags & SEARCH_FUZZY_MASK) {
+        SearchResult result = findFuzzyInRange(findTextUtf8, searchFlags, range.start, range.end, false);
+        if (result.pos >= 0) {
+            send(SCI_SETTARGETSTART, result.pos, 0);
+            send(SCI_SETTARGETEND, result.pos + result.length, 0);
+            if (selectMatch) {
+                displayResultCentered(result.pos, result.pos + result.length, true);
+            }
+        }
+        return result;
+    }
+
     send(SCI_SETTARGETSTART, range.start, 0);
     send(SCI_SETTARGETEND, range.end, 0);
     send(SCI_SETSEARCHFLAGS, searchFlags, 0);
@@ -2083,25 +3336,9 @@ SearchResult MultiReplace::performSingleSearch(const std::string& findTextUtf8,
     result.pos = pos;
 
     if (pos >= 0) {
-        // If a match is found, set additional result data
+        // If a match is found, set additional result data; the text is only read by those who need it
         result.length = send(SCI_GETTARGETEND, 0, 0) - pos;
 
-        // Consider the worst case for UTF-8, where one character could be up to 4 bytes.
-        char buffer[MAX_TEXT_LENGTH * 4 + 1] = { 0 };  // Assuming UTF-8 encoding in Scintilla
-        Sci_TextRange tr;
-        tr.chrg.cpMin = static_cast<int>(result.pos);
-        tr.chrg.cpMax = static_cast<int>(result.pos + result.length);
-
-        if (tr.chrg.cpMax - tr.chrg.cpMin > sizeof(buffer) - 1) {
-            // Safety check to avoid overflow.
-            tr.chrg.cpMax = tr.chrg.cpMin + sizeof(buffer) - 1;
-        }
-
-        tr.lpstrText = buffer;
-        send(SCI_GETTEXTRANGE, 0, reinterpret_cast<LPARAM>(&tr));
-
-        result.foundText = std::string(buffer);
-
         // If selectMatch is true, highlight the found text
         if (selectMatch) {
             displayResultCentered(result.pos, result.pos + result.length, true);
@@ -2118,39 +3355,19 @@ SearchResult MultiReplace::performSearchForward(const std::string& findTextUtf8,
 
     // Check if IDC_SELECTION_RADIO is enabled and selectMatch is false
     if (!selectMatch && IsDlgButtonChecked(_hSelf, IDC_SELECTION_RADIO) == BST_CHECKED) {
-        LRESULT selectionCount = ::SendMessage(_hScintilla, SCI_GETSELECTIONS, 0, 0);
-        std::vector<SelectionRange> selections(selectionCount);
-
-        for (int i = 0; i < selectionCount; i++) {
-            selections[i].start = ::SendMessage(_hScintilla, SCI_GETSELECTIONNSTART, i, 0);
-            selections[i].end = ::SendMessage(_hScintilla, SCI_GETSELECTIONNEND, i, 0);
-        }
-
-        // Sort selections based on their start position
-        std::sort(selections.begin(), selections.end(), [](const SelectionRange& a, const SelectionRange& b) {
-            return a.start < b.start;
-            });
-
-        // Perform search within each selection
-        for (const auto& selection : selections) {
-            if (start >= selection.start && start < selection.end) {
-                // If the start position is within the current selection
-                targetRange = { start, selection.end };
-                result = performSingleSearch(findTextUtf8, searchFlags, selectMatch, targetRange);
-            }
-            else if (start < selection.start) {
-                // If the start position is lower than the current selection
-                targetRange = selection;
-                result = performSingleSearch(findTextUtf8, searchFlags, selectMatch, targetRange);
-            }
-
-            // Check if a match was found
-            if (result.pos >= 0) {
-                return result;
-            }
+        // Replace All and Mark capture the selections once, a single search reads them here
+        SearchScope singleScope;
+        SearchScope& scope = searchScope.isActive() ? searchScope : singleScope;
+        if (!scope.isActive()) {
+            scope.assign(readSelections());
         }
+        result = performScopeSearch(scope, findTextUtf8, searchFlags, selectMatch, start);
     }
     // Check if IDC_COLUMN_MODE_RADIO is enabled, selectMatch is false, and column delimiter data is set
+    // Cells captured by Replace All or Mark are walked in order from the cell of the previous match
+    else if (IsDlgButtonChecked(_hSelf, IDC_COLUMN_MODE_RADIO) == BST_CHECKED && searchScope.isActive()) {
+        result = performScopeSearch(searchScope, findTextUtf8, searchFlags, selectMatch, start);
+    }
     else if (IsDlgButtonChecked(_hSelf, IDC_COLUMN_MODE_RADIO) == BST_CHECKED && columnDelimiterData.isValid()) {
 
         // Identify Column to Start
@@ -2217,9 +3434,55 @@ SearchResult MultiReplace::performSearchForward(const std::string& findTextUtf8,
         // If neither IDC_SELECTION_RADIO nor IDC_COLUMN_MODE_RADIO, perform search within the whole document
         targetRange.start = start;
         targetRange.end = send(SCI_GETLENGTH, 0, 0);
-        result = performSingleSearch(findTextUtf8, searchFlags, selectMatch, targetRange);
+
+        // Find Next searches literal text in the buffer, caseless UTF-8 included
+        ListMatcher matcher;
+        if (selectMatch && buildSearchMatcher(findTextUtf8, searchFlags, matcher)) {
+            result = performChunkedSearchForward(matcher, targetRange);
+        }
+        else {
+            result = performSingleSearch(findTextUtf8, searchFlags, selectMatch, targetRange);
+        }
+    }
+
+    return result;
+}
+
+SearchResult MultiReplace::performChunkedSearchForward(const ListMatcher& matcher, SelectionRange range)
+{
+    // Scan growing chunks behind the start, so the cost follows the distance to the match and not the
+    // length of the document
+    SearchResult result;
+    ListMatch match;
+    if (matcher.findFirstChunked(documentReader(), static_cast<size_t>(send(SCI_GETLENGTH, 0, 0)), static_cast<size_t>(range.start),
+        static_cast<size_t>(range.end), FORWARD_CHUNK_LENGTH, match)) {
+        result = { static_cast<LRESULT>(match.pos), static_cast<LRESULT>(match.length) };
     }
 
+    // Target and selection end up on the match, as after a single Scintilla search
+    if (result.pos >= 0) {
+        send(SCI_SETTARGETSTART, result.pos, 0);
+        send(SCI_SETTARGETEND, result.pos + result.length, 0);
+        displayResultCentered(result.pos, result.pos + result.length, true);
+    }
+    return result;
+}
+
+SearchResult MultiReplace::performScopeSearch(SearchScope& scope, const std::string& findTextUtf8, int searchFlags, bool selectMatch, LRESULT start)
+{
+    SearchResult result;
+
+    // Perform search within each range from the one the start position lies in or before
+    for (size_t i = scope.findFrom(start); i < scope.size(); ++i) {
+        ScopeRange range = scope.range(i);
+        SelectionRange targetRange = { std::max<LRESULT>(start, range.start), range.end };
+        result = performSingleSearch(findTextUtf8, searchFlags, selectMatch, targetRange);
+
+        // Check if a match was found
+        if (result.pos >= 0) {
+            return result;
+        }
+    }
     return result;
 }
 
@@ -2227,6 +3490,8 @@ SearchResult MultiReplace::performSearchBackward(const std::string& findTextUtf8
 {
     SearchResult result;
     SelectionRange targetRange;
+    ListMatcher matcher;
+    bool literal = buildSearchMatcher(findTextUtf8, searchFlags, matcher);
 
     // Check if IDC_COLUMN_MODE_RADIO is enabled, and column delimiter data is set
     if (IsDlgButtonChecked(_hSelf, IDC_COLUMN_MODE_RADIO) == BST_CHECKED && columnDelimiterData.isValid()) {
@@ -2277,7 +3542,7 @@ SearchResult MultiReplace::performSearchBackward(const std::string& findTextUtf8
                     // Perform search within the column range
                     if (start >= endColumn) {
                         targetRange = { endColumn, startColumn };
-                        result = performSingleSearch(findTextUtf8, searchFlags, true, targetRange);
+                        result = performChunkedSearchBackward(findTextUtf8, searchFlags, literal ? &matcher : nullptr, targetRange);
 
                         // Check if a match was found
                         if (result.pos >= 0) {
@@ -2285,72 +3550,549 @@ SearchResult MultiReplace::performSearchBackward(const std::string& findTextUtf8
                         }
                     }
 
-                }
-            }
-        }
+                }
+            }
+        }
+    }
+    else {
+        // Setting up the range to search backward from 'start' to the beginning
+        SelectionRange searchRange;
+        searchRange.start = start;
+        searchRange.end = 0;
+        result = performChunkedSearchBackward(findTextUtf8, searchFlags, literal ? &matcher : nullptr, searchRange);
+    }
+
+    return result;
+}
+
+SearchResult MultiReplace::performChunkedSearchBackward(const std::string& findTextUtf8, int searchFlags, const ListMatcher* matcher, SelectionRange range)
+{
+    // An empty search text is left to Scintilla, there is nothing to step over
+    if (findTextUtf8.empty()) {
+        return performSingleSearch(findTextUtf8, searchFlags, true, range);
+    }
+
+    // Scan forward over growing chunks in front of the start, so the cost follows the distance to the match
+    // and not the length of the document
+    SearchResult result;
+    if (matcher != nullptr) {
+        // Literal text is searched in the buffer; the occurrence starting last is the one a backward search finds
+        ListMatch match;
+        if (matcher->findLastChunked(documentReader(), static_cast<size_t>(send(SCI_GETLENGTH, 0, 0)), static_cast<size_t>(range.end),
+            static_cast<size_t>(range.start), BACKWARD_CHUNK_LENGTH, match)) {
+            result = { static_cast<LRESULT>(match.pos), static_cast<LRESULT>(match.length) };
+        }
+    }
+    else {
+        LRESULT chunkLength = BACKWARD_CHUNK_LENGTH;
+        LRESULT chunkStart = range.start;
+        do {
+            chunkStart = (range.start - range.end > chunkLength) ? range.start - chunkLength : range.end;
+            result = findLastInChunk(findTextUtf8, searchFlags, chunkStart, range.start);
+            chunkLength *= 2;
+        } while (result.pos < 0 && chunkStart > range.end);
+    }
+
+    // Target and selection end up on the match, as after a single Scintilla search
+    if (result.pos >= 0) {
+        send(SCI_SETTARGETSTART, result.pos, 0);
+        send(SCI_SETTARGETEND, result.pos + result.length, 0);
+        displayResultCentered(result.pos, result.pos + result.length, true);
+    }
+    return result;
+}
+
+SearchResult MultiReplace::findLastInChunk(const std::string& findTextUtf8, int searchFlags, LRESULT chunkStart, LRESULT chunkEnd)
+{
+    SearchResult result;
+
+    if (searchFlags & SEARCH_FUZZY_MASK) {
+        return findFuzzyInRange(findTextUtf8, searchFlags, chunkStart, chunkEnd, true);
+    }
+
+    // Regex continues behind each match like a forward search, other text steps on by one character
+    // so overlapping occurrences are seen
+    bool regex = (searchFlags & SCFIND_REGEXP) != 0;
+    LRESULT lastPos = -1;
+    LRESULT lastEnd = 0;
+    LRESULT from = chunkStart;
+    send(SCI_SETSEARCHFLAGS, searchFlags, 0);
+    while (from <= chunkEnd) {
+        send(SCI_SETTARGETSTART, from, 0);
+        send(SCI_SETTARGETEND, chunkEnd, 0);
+        LRESULT pos = send(SCI_SEARCHINTARGET, findTextUtf8.length(), reinterpret_cast<sptr_t>(findTextUtf8.c_str()));
+        if (pos < 0) {
+            break;
+        }
+        lastPos = pos;
+        lastEnd = send(SCI_GETTARGETEND, 0, 0);
+
+        LRESULT next = (regex && lastEnd > pos) ? lastEnd : send(SCI_POSITIONAFTER, pos, 0);
+        if (next <= pos) {
+            break;
+        }
+        from = next;
+    }
+
+    if (lastPos >= 0) {
+        result.pos = lastPos;
+        result.length = lastEnd - lastPos;
+    }
+    return result;
+}
+
+bool MultiReplace::buildSearchMatcher(const std::string& findTextUtf8, int searchFlags, ListMatcher& matcher)
+{
+    // Literal text the list automaton finds exactly like Scintilla; DBCS documents and regex stay with Scintilla
+    int codepage = static_cast<int>(send(SCI_GETCODEPAGE, 0, 0));
+    if ((searchFlags & (SCFIND_REGEXP | SEARCH_FUZZY_MASK)) || findTextUtf8.empty() || (codepage != 0 && codepage != SC_CP_UTF8)) {
+        return false;
+    }
+
+    ListPattern pattern;
+    pattern.findText = findTextUtf8;
+    pattern.wholeWord = (searchFlags & SCFIND_WHOLEWORD) != 0;
+    pattern.matchCase = (searchFlags & SCFIND_MATCHCASE) != 0;
+    if (!ListMatcher::isSupported(pattern, codepage == SC_CP_UTF8)) {
+        return false;
+    }
+
+    CharClass classes[256];
+    readCharClasses(classes);
+    matcher.setCharClasses(classes, codepage == SC_CP_UTF8);
+    matcher.build({ pattern });
+    return true;
+}
+
+SearchResult MultiReplace::performListSearchBackward(const std::vector<ReplaceItemData>& list, LRESULT cursorPos)
+{
+    SearchResult closestMatch;
+    closestMatch.pos = -1;
+    closestMatch.length = 0;
+
+    // Literal entries are looked up in the position index, the others are searched one by one
+    bool indexed = updateMatchIndex(list);
+    const ListMatch* indexMatch = indexed ? matchIndex.previous(static_cast<size_t>(cursorPos)) : nullptr;
+
+    for (size_t i = 0; i < list.size(); ++i)
+    {
+        const ReplaceItemData& itemData = list[i];
+        if (itemData.isSelected) {
+            SearchResult result;
+            if (indexed && matchIndexPatterns[i] >= 0) {
+                if (indexMatch == nullptr || static_cast<int>(indexMatch->pattern) != matchIndexPatterns[i]) {
+                    continue;
+                }
+                result = { static_cast<LRESULT>(indexMatch->pos), static_cast<LRESULT>(indexMatch->length) };
+            }
+            else {
+                const CompiledReplaceItem& compiled = getCompiledItem(itemData);
+                result = performSearchBackward(compiled.findTextUtf8, compiled.searchFlags, cursorPos);
+            }
+
+            // If a match was found and it's closer to the cursor than the current closest match, update the closest match
+            if (result.pos >= 0 && (closestMatch.pos < 0 || (result.pos + result.length) >(closestMatch.pos + closestMatch.length))) {
+                closestMatch = result;
+            }
+        }
+    }
+    if (closestMatch.pos >= 0) { // Check if a match was found
+        displayResultCentered(closestMatch.pos, closestMatch.pos + closestMatch.length, false);
+    }
+
+    return closestMatch;
+}
+
+SearchResult MultiReplace::performListSearchForward(const std::vector<ReplaceItemData>& list, LRESULT cursorPos)
+{
+    SearchResult closestMatch;
+    closestMatch.pos = -1;
+    closestMatch.length = 0;
+
+    // Literal entries are looked up in the position index, the others are searched one by one
+    bool indexed = updateMatchIndex(list);
+    const ListMatch* indexMatch = indexed ? matchIndex.next(static_cast<size_t>(cursorPos)) : nullptr;
+
+    for (size_t i = 0; i < list.size(); ++i)
+    {
+        const ReplaceItemData& itemData = list[i];
+        if (itemData.isSelected) {
+            SearchResult result;
+            if (indexed && matchIndexPatterns[i] >= 0) {
+                if (indexMatch == nullptr || static_cast<int>(indexMatch->pattern) != matchIndexPatterns[i]) {
+                    continue;
+                }
+                result = { static_cast<LRESULT>(indexMatch->pos), static_cast<LRESULT>(indexMatch->length) };
+            }
+            else {
+                const CompiledReplaceItem& compiled = getCompiledItem(itemData);
+                result = performSearchForward(compiled.findTextUtf8, compiled.searchFlags, false, cursorPos);
+            }
+
+            // If a match was found and it's closer to the cursor than the current closest match, update the closest match
+            if (result.pos >= 0 && (closestMatch.pos < 0 || result.pos < closestMatch.pos)) {
+                closestMatch = result;
+            }
+        }
+    }
+    if (closestMatch.pos >= 0) { // Check if a match was found
+        displayResultCentered(closestMatch.pos, closestMatch.pos + closestMatch.length, true);
+    }
+    return closestMatch;
+}
+
+void MultiReplace::handleFindAllButton()
+{
+    bool useListEnabled = (IsDlgButtonChecked(_hSelf, IDC_USE_LIST_CHECKBOX) == BST_CHECKED);
+    std::vector<ReplaceItemData> fieldItems;
+    std::wstring findText;
+    if (useListEnabled) {
+        if (replaceListData.empty()) {
+            showStatusMessage(L"Add values into the list. Or uncheck 'Use in List' to find directly.", RGB(255, 0, 0));
+            return;
+        }
+    }
+    else {
+        findText = getTextFromDialogItem(_hSelf, IDC_FIND_EDIT);
+        ReplaceItemData itemData;
+        itemData.findText = findText;
+        itemData.wholeWord = (IsDlgButtonChecked(_hSelf, IDC_WHOLE_WORD_CHECKBOX) == BST_CHECKED);
+        itemData.matchCase = (IsDlgButtonChecked(_hSelf, IDC_MATCH_CASE_CHECKBOX) == BST_CHECKED);
+        itemData.regex = (IsDlgButtonChecked(_hSelf, IDC_REGEX_RADIO) == BST_CHECKED);
+        itemData.extended = (IsDlgButtonChecked(_hSelf, IDC_EXTENDED_RADIO) == BST_CHECKED);
+        itemData.fuzzy = readFuzzyDistance();
+        fieldItems.push_back(itemData);
+        addStringToComboBoxHistory(GetDlgItem(_hSelf, IDC_FIND_EDIT), findText);
+    }
+    const std::vector<ReplaceItemData>& items = useListEnabled ? replaceListData : fieldItems;
+
+    size_t docLength = static_cast<size_t>(send(SCI_GETLENGTH, 0, 0));
+    size_t selectedCount = static_cast<size_t>(std::count_if(items.begin(), items.end(),
+        [](const ReplaceItemData& itemData) { return itemData.isSelected; }));
+    beginProgress(L"Find All", docLength * selectedCount);
+    captureSearchScope();
+
+    // Literal and fuzzy entries are found together by the worker threads, regex entries and DBCS documents by Scintilla.
+    // The pattern of every occurrence becomes the row of its entry.
+    std::vector<ListPattern> patterns;
+    std::vector<int> patternOfEntry;
+    collectLiteralPatterns(items, patterns, patternOfEntry);
+    std::vector<ListMatch> hits = findLiteralMatches(patterns);
+    std::vector<FuzzyPattern> fuzzyPatterns;
+    std::vector<int> fuzzyOfEntry;
+    collectFuzzyPatterns(items, fuzzyPatterns, fuzzyOfEntry);
+    std::vector<ListMatch> fuzzyHits = findFuzzyMatches(fuzzyPatterns);
+    std::vector<size_t> rowOfPattern(patterns.size(), 0);
+    std::vector<size_t> rowOfFuzzy(fuzzyPatterns.size(), 0);
+    for (size_t row = 0; row < items.size(); ++row) {
+        if (patternOfEntry[row] >= 0) {
+            rowOfPattern[static_cast<size_t>(patternOfEntry[row])] = row;
+        }
+        if (fuzzyOfEntry[row] >= 0) {
+            rowOfFuzzy[static_cast<size_t>(fuzzyOfEntry[row])] = row;
+        }
+    }
+    for (ListMatch& hit : hits) {
+        hit.pattern = rowOfPattern[hit.pattern];
+    }
+    for (ListMatch& hit : fuzzyHits) {
+        hit.pattern = rowOfFuzzy[hit.pattern];
+        hits.push_back(hit);
+    }
+
+    size_t entryIndex = 0;
+    for (size_t row = 0; row < items.size() && !isProgressCancelled(); ++row) {
+        const ReplaceItemData& itemData = items[row];
+        if (!itemData.isSelected) {
+            continue;
+        }
+        progressOffset = docLength * entryIndex++;
+        progressMatches = hits.size();
+        if (patternOfEntry[row] < 0 && fuzzyOfEntry[row] < 0) {
+            const CompiledReplaceItem& compiled = getCompiledItem(itemData);
+            collectStringMatches(compiled.findTextUtf8, compiled.searchFlags, row, hits);
+        }
+    }
+    releaseSearchScope();
+
+    if (endProgress()) {
+        showStatusMessage(L"Find All cancelled.", RGB(255, 0, 0));
+        return;
+    }
+    if (hits.empty()) {
+        showStatusMessage(useListEnabled ? L"No matches found." : (L"No matches found for '" + findText + L"'.").c_str(), RGB(255, 0, 0));
+        return;
+    }
+
+    // Only read access from here on: the document pointer stays valid while the list is shown
+    int codepage = static_cast<int>(send(SCI_GETCODEPAGE, 0, 0));
+    const char* text = reinterpret_cast<const char*>(send(SCI_GETCHARACTERPOINTER, 0, 0));
+    size_t textLength = static_cast<size_t>(send(SCI_GETLENGTH, 0, 0));
+    FindAllResults results;
+    results.assign(std::move(hits), text, textLength, codepage == SC_CP_UTF8,
+        std::max<size_t>(1, std::thread::hardware_concurrency()), SCAN_CHUNK_LENGTH);
+
+    std::vector<std::wstring> entryNames(items.size());
+    for (size_t row = 0; row < items.size(); ++row) {
+        entryNames[row] = useListEnabled ? L"#" + std::to_wstring(row + 1) + L"  " + items[row].findText : items[row].findText;
+    }
+
+    std::wstring summary = std::to_wstring(results.size()) + L" occurrences";
+    if (useListEnabled) {
+        summary += L" of " + std::to_wstring(results.entryCount()) + L" entries";
+    }
+    summary += L". Select a row to show the occurrence in the document.";
+    showStatusMessage(L"Find All: " + std::to_wstring(results.size()) + L" occurrences.", RGB(0, 128, 0));
+
+    FindAllDialog dialog(nppData._nppHandle, _hSelf, results, text, textLength, codepage, entryNames,
+        [this](size_t pos, size_t length) { displayResultCentered(pos, pos + length, true); });
+    dialog.show(summary);
+}
+
+void MultiReplace::collectStringMatches(const std::string& findTextUtf8, int searchFlags, size_t entry, std::vector<ListMatch>& matches)
+{
+    if (findTextUtf8.empty()) {
+        return;
+    }
+
+    SearchResult searchResult = performSearchForward(findTextUtf8, searchFlags, false, 0);
+    while (searchResult.pos >= 0) {
+        ListMatch match;
+        match.pos = static_cast<size_t>(searchResult.pos);
+        match.length = static_cast<size_t>(searchResult.length);
+        match.pattern = entry;
+        matches.push_back(match);
+
+        size_t done = progressOffset + match.pos + match.length;
+        if (!updateProgress(done, matches.size(), done)) {
+            break;
+        }
+
+        // An empty regex match moves on by one character
+        LRESULT next = (searchResult.length > 0) ? searchResult.pos + searchResult.length : send(SCI_POSITIONAFTER, searchResult.pos, 0);
+        if (next <= searchResult.pos) {
+            break;
+        }
+        searchResult = performSearchForward(findTextUtf8, searchFlags, false, next);
+    }
+}
+
+SearchResult MultiReplace::findFuzzyInRange(const std::string& findTextUtf8, int searchFlags, LRESULT start, LRESULT end, bool last)
+{
+    SearchResult result;
+    if (start >= end) {
+        return result;
+    }
+
+    // Find Next, Replace All and the entries searched one by one ask for the same text again and again
+    int codepage = static_cast<int>(send(SCI_GETCODEPAGE, 0, 0));
+    if (searchFuzzyCodepage != codepage || searchFuzzyFlags != searchFlags || searchFuzzyText != findTextUtf8) {
+        std::vector<FuzzyPattern> patterns(1);
+        if (!makeFuzzyPattern(findTextUtf8, searchFlags, codepage, patterns[0])) {
+            patterns.clear();
+        }
+        searchFuzzyMatcher.build(patterns, codepage == SC_CP_UTF8);
+        searchFuzzyText = findTextUtf8;
+        searchFuzzyFlags = searchFlags;
+        searchFuzzyCodepage = codepage;
+    }
+    if (searchFuzzyMatcher.empty()) {
+        return result;
+    }
+
+    // Only the range is read; like a Scintilla target search an occurrence lies completely inside it
+    size_t length = static_cast<size_t>(end - start);
+    const char* text = reinterpret_cast<const char*>(send(SCI_GETRANGEPOINTER, start, length));
+    ListMatch match;
+    bool found = false;
+    if (last) {
+        std::vector<ListMatch> matches;
+        searchFuzzyMatcher.findAll(text, length, 0, length, matches);
+        found = !matches.empty();
+        if (found) {
+            match = matches.back();
+        }
+    }
+    else {
+        found = searchFuzzyMatcher.findFirst(text, length, 0, length, 0, match);
+    }
+
+    if (found) {
+        result.pos = start + static_cast<LRESULT>(match.pos);
+        result.length = static_cast<LRESULT>(match.length);
+    }
+    return result;
+}
+
+bool MultiReplace::makeFuzzyPattern(const std::string& findTextUtf8, int searchFlags, int codepage, FuzzyPattern& pattern)
+{
+    // Characters are compared one by one, so DBCS documents with their lead bytes are not searched
+    if (findTextUtf8.empty() || (codepage != 0 && codepage != SC_CP_UTF8)) {
+        return false;
+    }
+
+    pattern.findText = (codepage == SC_CP_UTF8) ? findTextUtf8 : utf8ToCodepage(findTextUtf8, codepage);
+    pattern.distance = static_cast<size_t>((searchFlags & SEARCH_FUZZY_MASK) >> SEARCH_FUZZY_SHIFT);
+    pattern.matchCase = (searchFlags & SCFIND_MATCHCASE) != 0;
+    return !pattern.findText.empty();
+}
+
+int MultiReplace::readFuzzyDistance()
+{
+    // Edits of the Find field, 0 unless Fuzzy mode is checked
+    if (IsDlgButtonChecked(_hSelf, IDC_FUZZY_RADIO) != BST_CHECKED) {
+        return 0;
+    }
+    BOOL translated = FALSE;
+    int distance = static_cast<int>(GetDlgItemInt(_hSelf, IDC_FUZZY_DISTANCE_EDIT, &translated, FALSE));
+    return translated ? std::clamp(distance, 1, MAX_FUZZY_DISTANCE) : 1;
+}
+
+void MultiReplace::scheduleLiveSearch()
+{
+    // Restarted by every change, so the search runs once the input pauses
+    SetTimer(_hSelf, LIVE_SEARCH_TIMER, LIVE_SEARCH_DELAY_MS, NULL);
+}
+
+void MultiReplace::runLiveSearch()
+{
+    // Literal text of the Find field in the whole document; regex, Fuzzy, the other scopes and DBCS documents are left to Find and Mark
+    std::wstring findText = getTextFromDialogItem(_hSelf, IDC_FIND_EDIT);
+    bool wholeWord = (IsDlgButtonChecked(_hSelf, IDC_WHOLE_WORD_CHECKBOX) == BST_CHECKED);
+    bool matchCase = (IsDlgButtonChecked(_hSelf, IDC_MATCH_CASE_CHECKBOX) == BST_CHECKED);
+    bool extended = (IsDlgButtonChecked(_hSelf, IDC_EXTENDED_RADIO) == BST_CHECKED);
+    bool literal = (IsDlgButtonChecked(_hSelf, IDC_NORMAL_RADIO) == BST_CHECKED) || extended;
+    bool allText = (IsDlgButtonChecked(_hSelf, IDC_ALL_TEXT_RADIO) == BST_CHECKED);
+    int codepage = static_cast<int>(send(SCI_GETCODEPAGE, 0, 0));
+
+    ListPattern pattern;
+    pattern.findText = findText.empty() ? std::string() : convertAndExtend(findText, extended);
+    pattern.wholeWord = wholeWord;
+    pattern.matchCase = matchCase;
+    if (!literal || !allText || pattern.findText.empty() || (codepage != 0 && codepage != SC_CP_UTF8) ||
+        !ListMatcher::isSupported(pattern, codepage == SC_CP_UTF8)) {
+        clearLiveSearch();
+        return;
     }
-    else {
-        // Setting up the range to search backward from 'start' to the beginning
-        SelectionRange searchRange;
-        searchRange.start = start;
-        searchRange.end = 0;
-        result = performSingleSearch(findTextUtf8, searchFlags, true, searchRange);
+
+    // The kept occurrences belong to one document
+    sptr_t document = send(SCI_GETDOCPOINTER, 0, 0);
+    if (document != liveSearchDocument) {
+        liveSearch.clear();
+        liveSearchDocument = document;
     }
 
-    return result;
+    CharClass classes[256];
+    readCharClasses(classes);
+    size_t docLength = static_cast<size_t>(send(SCI_GETLENGTH, 0, 0));
+    const char* text = reinterpret_cast<const char*>(send(SCI_GETCHARACTERPOINTER, 0, 0));
+    liveSearch.search(pattern, classes, codepage == SC_CP_UTF8, text, docLength,
+        std::max<size_t>(1, std::thread::hardware_concurrency()), SCAN_CHUNK_LENGTH);
+
+    liveSearchEdited = false;
+    highlightLiveViewport();
+    showLiveSearchCount();
 }
 
-SearchResult MultiReplace::performListSearchBackward(const std::vector<ReplaceItemData>& list, LRESULT cursorPos)
+void MultiReplace::showLiveSearchCount()
 {
-    SearchResult closestMatch;
-    closestMatch.pos = -1;
-    closestMatch.length = 0;
-    closestMatch.foundText = "";
+    size_t count = liveSearch.count();
+    showStatusMessage(std::to_wstring(count) + (count == 1 ? L" match" : L" matches"), count > 0 ? RGB(0, 128, 0) : RGB(255, 0, 0));
+}
 
-    for (const ReplaceItemData& itemData : list)
-    {
-        if (itemData.isSelected) {
-            int searchFlags = (itemData.wholeWord * SCFIND_WHOLEWORD) | (itemData.matchCase * SCFIND_MATCHCASE) | (itemData.regex * SCFIND_REGEXP);
-            std::string findTextUtf8 = convertAndExtend(itemData.findText, itemData.extended);
-            SearchResult result = performSearchBackward(findTextUtf8, searchFlags, cursorPos);
+void MultiReplace::highlightLiveViewport()
+{
+    if (liveSearchIndicator < 0) {
+        return;
+    }
 
-            // If a match was found and it's closer to the cursor than the current closest match, update the closest match
-            if (result.pos >= 0 && (closestMatch.pos < 0 || (result.pos + result.length) >(closestMatch.pos + closestMatch.length))) {
-                closestMatch = result;
-            }
-        }
+    send(SCI_SETINDICATORCURRENT, liveSearchIndicator, 0);
+    send(SCI_INDICSETSTYLE, liveSearchIndicator, INDIC_ROUNDBOX);
+    send(SCI_INDICSETFORE, liveSearchIndicator, LIVE_SEARCH_COLOR);
+    send(SCI_INDICSETALPHA, liveSearchIndicator, 100);
+
+    // Only the text highlighted last is cleared, not the whole document on every scroll
+    LRESULT docLength = send(SCI_GETLENGTH, 0, 0);
+    LRESULT clearStart = std::min(liveHighlightStart, docLength);
+    LRESULT clearEnd = std::min(liveHighlightEnd, docLength);
+    if (clearEnd > clearStart) {
+        send(SCI_INDICATORCLEARRANGE, clearStart, clearEnd - clearStart);
     }
-    if (closestMatch.pos >= 0) { // Check if a match was found
-        displayResultCentered(closestMatch.pos, closestMatch.pos + closestMatch.length, false);
+    liveHighlightStart = 0;
+    liveHighlightEnd = 0;
+    if (!liveSearch.isActive() || liveSearchDocument != send(SCI_GETDOCPOINTER, 0, 0)) {
+        return;
     }
 
-    return closestMatch;
+    // Visible lines, read on by the longest occurrence in front so one running into the view is highlighted too
+    LRESULT firstLine = send(SCI_DOCLINEFROMVISIBLE, send(SCI_GETFIRSTVISIBLELINE, 0, 0), 0);
+    LRESULT lastLine = send(SCI_DOCLINEFROMVISIBLE, send(SCI_GETFIRSTVISIBLELINE, 0, 0) + send(SCI_LINESONSCREEN, 0, 0), 0);
+    LRESULT viewStart = send(SCI_POSITIONFROMLINE, firstLine, 0);
+    LRESULT viewEnd = std::min(send(SCI_GETLINEENDPOSITION, lastLine, 0), viewStart + LIVE_VIEW_MAX_LENGTH);
+    LRESULT margin = static_cast<LRESULT>(liveSearch.matchWindow());
+    LRESULT readStart = std::max<LRESULT>(0, viewStart - margin);
+    LRESULT readEnd = std::min(docLength, viewEnd + margin);
+    if (readEnd <= readStart) {
+        return;
+    }
+
+    const char* text = reinterpret_cast<const char*>(send(SCI_GETRANGEPOINTER, readStart, readEnd - readStart));
+    std::vector<ListMatch> found;
+    liveSearch.findInRange(text, static_cast<size_t>(readEnd - readStart), 0, static_cast<size_t>(viewEnd - readStart), found);
+    for (const ListMatch& match : found) {
+        send(SCI_INDICATORFILLRANGE, readStart + static_cast<LRESULT>(match.pos), static_cast<LRESULT>(match.length));
+    }
+    liveHighlightStart = readStart;
+    liveHighlightEnd = viewEnd;
 }
 
-SearchResult MultiReplace::performListSearchForward(const std::vector<ReplaceItemData>& list, LRESULT cursorPos)
+void MultiReplace::repairLiveSearch(const SCNotification* notifyCode)
 {
-    SearchResult closestMatch;
-    closestMatch.pos = -1;
-    closestMatch.length = 0;
-    closestMatch.foundText = "";
-
-    for (const ReplaceItemData& itemData : list)
-    {
-        if (itemData.isSelected) {
-            int searchFlags = (itemData.wholeWord * SCFIND_WHOLEWORD) | (itemData.matchCase * SCFIND_MATCHCASE) | (itemData.regex * SCFIND_REGEXP);
-            std::string findTextUtf8 = convertAndExtend(itemData.findText, itemData.extended);
-            SearchResult result = performSearchForward(findTextUtf8, searchFlags, false, cursorPos);
+    HWND hScintilla = static_cast<HWND>(notifyCode->nmhdr.hwndFrom);
+    if (::SendMessage(hScintilla, SCI_GETDOCPOINTER, 0, 0) != liveSearchDocument) {
+        return;
+    }
 
-            // If a match was found and it's closer to the cursor than the current closest match, update the closest match
-            if (result.pos >= 0 && (closestMatch.pos < 0 || result.pos < closestMatch.pos)) {
-                closestMatch = result;
-            }
-        }
+    // The highlighting moves along with the text
+    LRESULT pos = static_cast<LRESULT>(notifyCode->position);
+    LRESULT length = static_cast<LRESULT>(notifyCode->length);
+    bool inserted = (notifyCode->modificationType & SC_MOD_INSERTTEXT) != 0;
+    LRESULT oldLength = inserted ? 0 : length;
+    LRESULT newLength = inserted ? length : 0;
+    if (liveHighlightStart > pos) {
+        liveHighlightStart = (liveHighlightStart >= pos + oldLength) ? liveHighlightStart - oldLength + newLength : pos;
     }
-    if (closestMatch.pos >= 0) { // Check if a match was found
-        displayResultCentered(closestMatch.pos, closestMatch.pos + closestMatch.length, true);
+    if (liveHighlightEnd > pos) {
+        liveHighlightEnd = (liveHighlightEnd >= pos + oldLength) ? liveHighlightEnd - oldLength + newLength : pos + newLength;
     }
-    return closestMatch;
+
+    // Edits in the other view of a cloned document and Replace All are searched again once the editing pauses
+    size_t textLength = static_cast<size_t>(::SendMessage(hScintilla, SCI_GETLENGTH, 0, 0));
+    if (hScintilla != _hScintilla || isBatchEditActive ||
+        !liveSearch.replaced(documentReader(), textLength, static_cast<size_t>(pos), static_cast<size_t>(oldLength), static_cast<size_t>(newLength))) {
+        liveSearch.clear();
+        liveHighlightStart = 0;
+        liveHighlightEnd = static_cast<LRESULT>(textLength);
+        scheduleLiveSearch();
+        return;
+    }
+    liveSearchEdited = true;
+}
+
+void MultiReplace::clearLiveSearch()
+{
+    KillTimer(_hSelf, LIVE_SEARCH_TIMER);
+    if (liveSearch.isActive()) {
+        liveSearch.clear();
+        showStatusMessage(L"", RGB(0, 0, 0));
+    }
+    if (liveSearchIndicator >= 0) {
+        send(SCI_SETINDICATORCURRENT, liveSearchIndicator, 0);
+        send(SCI_INDICATORCLEARRANGE, 0, send(SCI_GETLENGTH, 0, 0));
+    }
+    liveSearchEdited = false;
+    liveHighlightStart = 0;
+    liveHighlightEnd = 0;
 }
 
 void MultiReplace::displayResultCentered(size_t posStart, size_t posEnd, bool isDownwards)
@@ -2391,6 +4133,7 @@ void MultiReplace::handleMarkMatchesButton() {
     int matchCount = 0;
     bool useListEnabled = (IsDlgButtonChecked(_hSelf, IDC_USE_LIST_CHECKBOX) == BST_CHECKED);
     markedStringsCount = 0;
+    std::vector<ListPattern> literalPatterns;   // Set if everything marked is literal, so the marks can follow edits
 
     if (useListEnabled) {
         if (replaceListData.empty()) {
@@ -2398,15 +4141,29 @@ void MultiReplace::handleMarkMatchesButton() {
             return;
         }
 
-        for (ReplaceItemData& itemData : replaceListData) {
-            if (itemData.isSelected) {
-                std::string findTextUtf8 = convertAndExtend(itemData.findText, itemData.extended);
-                int searchFlags = (itemData.wholeWord * SCFIND_WHOLEWORD)
-                    | (itemData.matchCase * SCFIND_MATCHCASE)
-                    | (itemData.regex * SCFIND_REGEXP);
-                matchCount += markString(findTextUtf8, searchFlags);
+        // A list of literal entries only can be marked lazily and repaired after edits
+        std::vector<ListPattern> patterns;
+        std::vector<int> patternOfEntry;
+        collectLiteralPatterns(replaceListData, patterns, patternOfEntry);
+        bool allLiteral = true;
+        for (size_t i = 0; i < replaceListData.size(); ++i) {
+            if (replaceListData[i].isSelected && !replaceListData[i].findText.empty() && patternOfEntry[i] < 0) {
+                allLiteral = false;
             }
         }
+        if (allLiteral && startLazyMark(patterns)) {
+            return;
+        }
+        if (allLiteral) {
+            literalPatterns = patterns;
+        }
+
+        size_t selectedCount = static_cast<size_t>(std::count_if(replaceListData.begin(), replaceListData.end(),
+            [](const ReplaceItemData& itemData) { return itemData.isSelected; }));
+        beginProgress(L"Mark", static_cast<size_t>(send(SCI_GETLENGTH, 0, 0)) * selectedCount);
+        captureSearchScope();
+        matchCount = markListEntries();
+        releaseSearchScope();
     }
     else {
         std::wstring findText = getTextFromDialogItem(_hSelf, IDC_FIND_EDIT);
@@ -2414,28 +4171,203 @@ void MultiReplace::handleMarkMatchesButton() {
         bool matchCase = (IsDlgButtonChecked(_hSelf, IDC_MATCH_CASE_CHECKBOX) == BST_CHECKED);
         bool regex = (IsDlgButtonChecked(_hSelf, IDC_REGEX_RADIO) == BST_CHECKED);
         bool extended = (IsDlgButtonChecked(_hSelf, IDC_EXTENDED_RADIO) == BST_CHECKED);
+        int fuzzy = readFuzzyDistance();
 
         std::string findTextUtf8 = convertAndExtend(findText, extended);
         int searchFlags = (wholeWord * SCFIND_WHOLEWORD)
             | (matchCase * SCFIND_MATCHCASE)
-            | (regex * SCFIND_REGEXP);
-        matchCount = markString(findTextUtf8, searchFlags);
+            | (regex * SCFIND_REGEXP)
+            | (fuzzy << SEARCH_FUZZY_SHIFT);
+        int codepage = static_cast<int>(send(SCI_GETCODEPAGE, 0, 0));
+        bool scanLiteral = !regex && fuzzy == 0 && !findTextUtf8.empty() && (codepage == 0 || codepage == SC_CP_UTF8) &&
+            ListMatcher::isSupported({ findTextUtf8, wholeWord, matchCase }, codepage == SC_CP_UTF8);
+        if (scanLiteral && startLazyMark({ { findTextUtf8, wholeWord, matchCase } })) {
+            addStringToComboBoxHistory(GetDlgItem(_hSelf, IDC_FIND_EDIT), findText);
+            return;
+        }
+        if (scanLiteral) {
+            literalPatterns = { { findTextUtf8, wholeWord, matchCase } };
+        }
+
+        beginProgress(L"Mark", static_cast<size_t>(send(SCI_GETLENGTH, 0, 0)));
+        captureSearchScope();
+        matchCount = scanLiteral ? markLiteralString(findTextUtf8, wholeWord, matchCase) : markString(findTextUtf8, searchFlags);
+        releaseSearchScope();
 
         addStringToComboBoxHistory(GetDlgItem(_hSelf, IDC_FIND_EDIT), findText);
     }
+
+    // A cancelled run marks nothing, the button cleared the old marks before
+    if (endProgress()) {
+        pendingMarks.clear();
+        pendingEntries.clear();
+        handleClearTextMarksButton();
+        showStatusMessage(L"Mark cancelled.", RGB(255, 0, 0));
+        return;
+    }
+    fillMarks();
+    followMarks(literalPatterns, static_cast<size_t>(matchCount));
     showStatusMessage(std::to_wstring(matchCount) + L" occurrences were marked.", RGB(0, 0, 128));
 }
 
+int MultiReplace::markListEntries() {
+    // Literal entries are found together in one scan and so are fuzzy ones, regex entries and DBCS documents are searched by Scintilla
+    std::vector<ListPattern> patterns;
+    std::vector<int> patternOfEntry;
+    collectLiteralPatterns(replaceListData, patterns, patternOfEntry);
+    std::vector<ListMatch> found = findLiteralMatches(patterns);
+    std::vector<FuzzyPattern> fuzzyPatterns;
+    std::vector<int> fuzzyOfEntry;
+    collectFuzzyPatterns(replaceListData, fuzzyPatterns, fuzzyOfEntry);
+    std::vector<ListMatch> fuzzyFound = findFuzzyMatches(fuzzyPatterns);
+
+    // Mark in list order so each entry keeps its color
+    size_t docLength = static_cast<size_t>(send(SCI_GETLENGTH, 0, 0));
+    size_t entryIndex = 0;
+    int matchCount = 0;
+    size_t next = 0;
+    size_t nextFuzzy = 0;
+    for (size_t i = 0; i < replaceListData.size() && !isProgressCancelled(); ++i) {
+        const ReplaceItemData& itemData = replaceListData[i];
+        if (!itemData.isSelected) {
+            continue;
+        }
+        progressOffset = docLength * entryIndex++;
+        progressMatches = static_cast<size_t>(matchCount);
+
+        const CompiledReplaceItem& compiled = getCompiledItem(itemData);
+        bool fuzzy = (fuzzyOfEntry[i] >= 0);
+        if (patternOfEntry[i] < 0 && !fuzzy) {
+            matchCount += markString(compiled.findTextUtf8, compiled.searchFlags);
+            continue;
+        }
+
+        const std::vector<ListMatch>& hits = fuzzy ? fuzzyFound : found;
+        size_t& cursor = fuzzy ? nextFuzzy : next;
+        size_t pattern = static_cast<size_t>(fuzzy ? fuzzyOfEntry[i] : patternOfEntry[i]);
+        std::vector<SelectionRange>& marks = beginMarks(compiled.findTextUtf8);
+        int markCount = 0;
+        for (; cursor < hits.size() && hits[cursor].pattern == pattern; ++cursor) {
+            marks.push_back({ static_cast<LRESULT>(hits[cursor].pos), static_cast<LRESULT>(hits[cursor].pos + hits[cursor].length) });
+            markCount++;
+
+            size_t done = progressOffset + hits[cursor].pos + hits[cursor].length;
+            if (!updateProgress(done, progressMatches + static_cast<size_t>(markCount), done)) {
+                break;
+            }
+        }
+        if (markCount > 0) {
+            markedStringsCount++;
+        }
+        matchCount += markCount;
+    }
+
+    return matchCount;
+}
+
+void MultiReplace::collectLiteralPatterns(const std::vector<ReplaceItemData>& items, std::vector<ListPattern>& patterns, std::vector<int>& patternOfEntry)
+{
+    int codepage = static_cast<int>(send(SCI_GETCODEPAGE, 0, 0));
+    bool scanLiterals = (codepage == 0 || codepage == SC_CP_UTF8);
+
+    patternOfEntry.assign(items.size(), -1);
+    for (size_t i = 0; i < items.size() && scanLiterals; ++i) {
+        const ReplaceItemData& itemData = items[i];
+        if (!itemData.isSelected || itemData.findText.empty() || itemData.regex || itemData.fuzzy > 0) {
+            continue;
+        }
+        const CompiledReplaceItem& compiled = getCompiledItem(itemData);
+        ListPattern pattern{ compiled.findTextUtf8, itemData.wholeWord, itemData.matchCase };
+        if (!ListMatcher::isSupported(pattern, codepage == SC_CP_UTF8)) {
+            continue;
+        }
+        patternOfEntry[i] = static_cast<int>(patterns.size());
+        patterns.push_back(pattern);
+    }
+}
+
+std::vector<ListMatch> MultiReplace::findLiteralMatches(const std::vector<ListPattern>& patterns)
+{
+    std::vector<ListMatch> found;
+    if (patterns.empty()) {
+        return found;
+    }
+
+    int codepage = static_cast<int>(send(SCI_GETCODEPAGE, 0, 0));
+    ListMatcher matcher;
+    CharClass classes[256];
+    readCharClasses(classes);
+    matcher.setCharClasses(classes, codepage == SC_CP_UTF8);
+    matcher.build(patterns);
+
+    // Each entry steps over its own occurrences like a document search, grouped by entry
+    std::vector<ListMatch> candidates;
+    findListMatches(matcher, candidates);
+    found = ListMatcher::selectPatternMatches(std::move(candidates));
+    return found;
+}
+
+void MultiReplace::collectFuzzyPatterns(const std::vector<ReplaceItemData>& items, std::vector<FuzzyPattern>& patterns, std::vector<int>& patternOfEntry)
+{
+    int codepage = static_cast<int>(send(SCI_GETCODEPAGE, 0, 0));
+
+    patternOfEntry.assign(items.size(), -1);
+    for (size_t i = 0; i < items.size(); ++i) {
+        const ReplaceItemData& itemData = items[i];
+        if (!itemData.isSelected || itemData.fuzzy == 0) {
+            continue;
+        }
+        const CompiledReplaceItem& compiled = getCompiledItem(itemData);
+        FuzzyPattern pattern;
+        if (!makeFuzzyPattern(compiled.findTextUtf8, compiled.searchFlags, codepage, pattern)) {
+            continue;
+        }
+        patternOfEntry[i] = static_cast<int>(patterns.size());
+        patterns.push_back(pattern);
+    }
+}
+
+std::vector<ListMatch> MultiReplace::findFuzzyMatches(const std::vector<FuzzyPattern>& patterns)
+{
+    std::vector<ListMatch> found;
+    if (patterns.empty()) {
+        return found;
+    }
+
+    int codepage = static_cast<int>(send(SCI_GETCODEPAGE, 0, 0));
+    FuzzyMatcher matcher;
+    matcher.build(patterns, codepage == SC_CP_UTF8);
+
+    // The UI thread waits for the workers, so the document cannot change while they read it
+    const char* text = reinterpret_cast<const char*>(send(SCI_GETCHARACTERPOINTER, 0, 0));
+    size_t textLength = static_cast<size_t>(send(SCI_GETLENGTH, 0, 0));
+    size_t threadCount = std::max<size_t>(1, std::thread::hardware_concurrency());
+    for (const SelectionRange& range : getScopeRanges()) {
+        matcher.findAllParallel(text, textLength, static_cast<size_t>(range.start), static_cast<size_t>(range.end),
+            threadCount, SCAN_CHUNK_LENGTH, found);
+    }
+
+    // Every range lists its occurrences by entry; together they are grouped by entry again
+    std::stable_sort(found.begin(), found.end(), [](const ListMatch& a, const ListMatch& b) { return a.pattern < b.pattern; });
+    return found;
+}
+
 int MultiReplace::markString(const std::string& findTextUtf8, int searchFlags) {
     if (findTextUtf8.empty()) {
         return 0;
     }
 
     int markCount = 0;  // Counter for marked matches
+    std::vector<SelectionRange>& marks = beginMarks(findTextUtf8);
     SearchResult searchResult = performSearchForward(findTextUtf8, searchFlags, false, 0);
     while (searchResult.pos >= 0) {
-        highlightTextRange(searchResult.pos, searchResult.length, findTextUtf8);
+        marks.push_back({ searchResult.pos, searchResult.pos + searchResult.length });
         markCount++;
+
+        size_t done = progressOffset + static_cast<size_t>(searchResult.pos + searchResult.length);
+        if (!updateProgress(done, progressMatches + static_cast<size_t>(markCount), done)) {
+            break;
+        }
         searchResult = performSearchForward(findTextUtf8, searchFlags, false, searchResult.pos + searchResult.length);
     }
 
@@ -2446,7 +4378,34 @@ int MultiReplace::markString(const std::string& findTextUtf8, int searchFlags) {
     return markCount;
 }
 
-void MultiReplace::highlightTextRange(LRESULT pos, LRESULT len, const std::string& findTextUtf8)
+int MultiReplace::markLiteralString(const std::string& findTextUtf8, bool wholeWord, bool matchCase) {
+    // Same occurrences as markString() finds, taken from one scan of the document buffer
+    int codepage = static_cast<int>(send(SCI_GETCODEPAGE, 0, 0));
+    ListMatcher matcher;
+    CharClass classes[256];
+    readCharClasses(classes);
+    matcher.setCharClasses(classes, codepage == SC_CP_UTF8);
+    matcher.build({ { findTextUtf8, wholeWord, matchCase } });
+
+    std::vector<ListMatch> candidates;
+    findListMatches(matcher, candidates);
+    std::vector<ListMatch> found = ListMatcher::selectPatternMatches(std::move(candidates));
+
+    int markCount = 0;
+    std::vector<SelectionRange>& marks = beginMarks(findTextUtf8);
+    for (const ListMatch& match : found) {
+        marks.push_back({ static_cast<LRESULT>(match.pos), static_cast<LRESULT>(match.pos + match.length) });
+        markCount++;
+
+        size_t done = progressOffset + match.pos + match.length;
+        if (!updateProgress(done, progressMatches + static_cast<size_t>(markCount), done)) {
+            break;
+        }
+    }
+    return markCount;
+}
+
+std::vector<SelectionRange>& MultiReplace::beginMarks(const std::string& findTextUtf8)
 {
     bool useListEnabled = (IsDlgButtonChecked(_hSelf, IDC_USE_LIST_CHECKBOX) == BST_CHECKED);
     long color = useListEnabled ? generateColorValue(findTextUtf8) : MARKER_COLOR;
@@ -2463,16 +4422,215 @@ void MultiReplace::highlightTextRange(LRESULT pos, LRESULT len, const std::strin
         indicatorStyle = colorToStyleMap[color];
     }
 
-    // Set and apply highlighting style
-    ::SendMessage(_hScintilla, SCI_SETINDICATORCURRENT, indicatorStyle, 0);
-    ::SendMessage(_hScintilla, SCI_INDICSETSTYLE, indicatorStyle, INDIC_STRAIGHTBOX);
+    // Each style is set up once per run, its ranges are filled by fillMarks()
+    auto it = pendingMarks.find(indicatorStyle);
+    if (it == pendingMarks.end()) {
+        send(SCI_INDICSETSTYLE, indicatorStyle, INDIC_STRAIGHTBOX);
+        if (colorToStyleMap.size() < textStyles.size()) {
+            send(SCI_INDICSETFORE, indicatorStyle, color);
+        }
+        send(SCI_INDICSETALPHA, indicatorStyle, 100);
+        it = pendingMarks.emplace(indicatorStyle, std::vector<SelectionRange>()).first;
+    }
+    pendingEntries.push_back({ indicatorStyle, findTextUtf8, it->second.size() });
+    return it->second;
+}
+
+void MultiReplace::fillMarks()
+{
+    // Entries that added ranges are kept by indicator; later entries of an indicator end the ranges of earlier ones
+    std::map<int, size_t> rangesAfter;
+    for (auto entry = pendingEntries.rbegin(); entry != pendingEntries.rend(); ++entry) {
+        auto after = rangesAfter.find(entry->style);
+        size_t end = (after != rangesAfter.end()) ? after->second : pendingMarks[entry->style].size();
+        std::vector<std::string>& names = markEntries[entry->style];
+        if (end > entry->firstRange && std::find(names.begin(), names.end(), entry->findTextUtf8) == names.end()) {
+            names.push_back(entry->findTextUtf8);
+        }
+        rangesAfter[entry->style] = entry->firstRange;
+    }
+    pendingEntries.clear();
+
+    // One fill per run of touching or overlapping ranges of an indicator, in document order
+    for (auto& [indicatorStyle, ranges] : pendingMarks) {
+        std::sort(ranges.begin(), ranges.end(), [](const SelectionRange& a, const SelectionRange& b) { return a.start < b.start; });
+        send(SCI_SETINDICATORCURRENT, indicatorStyle, 0);
+
+        size_t i = 0;
+        while (i < ranges.size()) {
+            LRESULT start = ranges[i].start;
+            LRESULT end = ranges[i].end;
+            for (++i; i < ranges.size() && ranges[i].start <= end; ++i) {
+                end = std::max(end, ranges[i].end);
+            }
+            if (end > start) {
+                send(SCI_INDICATORFILLRANGE, start, end - start);
+            }
+        }
+    }
+    pendingMarks.clear();
+}
+
+bool MultiReplace::canFollowMarks(const std::vector<ListPattern>& patterns)
+{
+    // Literal entries in the 'All Text' scope of single byte and UTF-8 documents; the other marks stay as they are
+    int codepage = static_cast<int>(send(SCI_GETCODEPAGE, 0, 0));
+    return !patterns.empty() && IsDlgButtonChecked(_hSelf, IDC_ALL_TEXT_RADIO) == BST_CHECKED &&
+        (codepage == 0 || codepage == SC_CP_UTF8);
+}
+
+void MultiReplace::startMarkSession(const std::vector<ListPattern>& patterns)
+{
+    CharClass classes[256];
+    readCharClasses(classes);
+    lazyMarker.start(patterns, classes, send(SCI_GETCODEPAGE, 0, 0) == SC_CP_UTF8);
+    lazyMarkDocument = send(SCI_GETDOCPOINTER, 0, 0);
+}
+
+bool MultiReplace::startLazyMark(const std::vector<ListPattern>& patterns)
+{
+    // Very large documents are marked where the view goes; the rest is marked at once
+    if (!canFollowMarks(patterns) || send(SCI_GETLENGTH, 0, 0) < LAZY_MARK_THRESHOLD) {
+        return false;
+    }
+
+    startMarkSession(patterns);
+    paintLazyMarks(false);
+
+    SetTimer(_hSelf, LAZY_COUNT_TIMER, LAZY_COUNT_INTERVAL_MS, NULL);
+    showStatusMessage(L"Marking the visible text, counting occurrences...", RGB(0, 0, 128));
+    return true;
+}
+
+void MultiReplace::followMarks(const std::vector<ListPattern>& patterns, size_t occurrences)
+{
+    // A Mark done at once is followed like a lazy one that has reached every part of the text
+    if (!canFollowMarks(patterns)) {
+        return;
+    }
+    startMarkSession(patterns);
+    lazyMarker.takeAll(static_cast<size_t>(send(SCI_GETLENGTH, 0, 0)), occurrences);
+}
+
+ListMatcher::TextReader MultiReplace::documentReader()
+{
+    // Range pointers leave the gap of the buffer where it is, unless the range reaches over it
+    return [this](size_t start, size_t length) {
+        return reinterpret_cast<const char*>(send(SCI_GETRANGEPOINTER, static_cast<uptr_t>(start), static_cast<sptr_t>(length)));
+        };
+}
+
+void MultiReplace::paintLazyMarks(bool wholeDocument)
+{
+    if (!lazyMarker.isActive() || send(SCI_GETDOCPOINTER, 0, 0) != lazyMarkDocument) {
+        return;
+    }
+
+    // The visible lines and a margin around them, parts marked before are skipped
+    LRESULT docLength = send(SCI_GETLENGTH, 0, 0);
+    LRESULT start = 0;
+    LRESULT end = docLength;
+    if (!wholeDocument) {
+        LRESULT firstVisible = send(SCI_GETFIRSTVISIBLELINE, 0, 0);
+        LRESULT firstLine = send(SCI_DOCLINEFROMVISIBLE, firstVisible, 0);
+        LRESULT lastLine = send(SCI_DOCLINEFROMVISIBLE, firstVisible + send(SCI_LINESONSCREEN, 0, 0), 0);
+        start = std::max<LRESULT>(0, send(SCI_POSITIONFROMLINE, firstLine, 0) - LAZY_MARK_MARGIN);
+        end = std::min(docLength, send(SCI_GETLINEENDPOSITION, lastLine, 0) + LAZY_MARK_MARGIN);
+    }
+
+    std::vector<ListMatch> found;
+    lazyMarker.takeRange(documentReader(), static_cast<size_t>(docLength), static_cast<size_t>(start), static_cast<size_t>(end), found);
+
+    std::vector<std::vector<SelectionRange>*> marks(lazyMarker.patternCount(), nullptr);
+    for (const ListMatch& match : found) {
+        if (marks[match.pattern] == nullptr) {
+            marks[match.pattern] = &beginMarks(lazyMarker.pattern(match.pattern).findText);
+        }
+        marks[match.pattern]->push_back({ static_cast<LRESULT>(match.pos), static_cast<LRESULT>(match.pos + match.length) });
+    }
+    fillMarks();
+}
+
+void MultiReplace::continueLazyCount()
+{
+    // Paused while another document is shown
+    if (!lazyMarker.isActive() || send(SCI_GETDOCPOINTER, 0, 0) != lazyMarkDocument) {
+        KillTimer(_hSelf, LAZY_COUNT_TIMER);
+        return;
+    }
+
+    size_t docLength = static_cast<size_t>(send(SCI_GETLENGTH, 0, 0));
+    if (!lazyMarker.countSlice(documentReader(), docLength, LAZY_COUNT_SLICE, std::max<size_t>(1, std::thread::hardware_concurrency()), SCAN_CHUNK_LENGTH)) {
+        size_t percent = (docLength > 0) ? lazyMarker.countedLength() * 100 / docLength : 100;
+        showStatusMessage(L"Marking the visible text, counting occurrences... " + std::to_wstring(percent) + L"%", RGB(0, 0, 128));
+        return;
+    }
+
+    KillTimer(_hSelf, LAZY_COUNT_TIMER);
+    showStatusMessage(std::to_wstring(lazyMarker.count()) + L" occurrences, marked as they come into view.", RGB(0, 0, 128));
+}
+
+void MultiReplace::remarkEditedText()
+{
+    if (!lazyMarker.isActive() || send(SCI_GETDOCPOINTER, 0, 0) != lazyMarkDocument) {
+        return;
+    }
+
+    // The edited lines and the longest entry on either side are matched again
+    size_t docLength = static_cast<size_t>(send(SCI_GETLENGTH, 0, 0));
+    auto lineBounds = [this](size_t pos, size_t& lineStart, size_t& lineEnd) {
+        LRESULT line = send(SCI_LINEFROMPOSITION, pos, 0);
+        lineStart = static_cast<size_t>(send(SCI_POSITIONFROMLINE, line, 0));
+        lineEnd = static_cast<size_t>(send(SCI_GETLINEENDPOSITION, line, 0));
+    };
+    size_t rangeStart = 0;
+    size_t rangeEnd = 0;
+    if (!lazyMarker.takeEditedLines(lineBounds, docLength, rangeStart, rangeEnd)) {
+        return;
+    }
+
+    // Edits too large for one pass over the text, such as Replace All in a very large document, leave the marks as they are
+    if (rangeEnd - rangeStart > static_cast<size_t>(LAZY_MARK_THRESHOLD)) {
+        endLazyMark();
+        return;
+    }
+
+    std::vector<int> styles;
+    for (const auto& [color, style] : colorToStyleMap) {
+        styles.push_back(style);
+    }
+    auto markRun = [this, &styles](size_t style, size_t pos, size_t& runStart, size_t& runEnd) {
+        if (send(SCI_INDICATORVALUEAT, styles[style], pos) == 0) {
+            return false;
+        }
+        runStart = static_cast<size_t>(send(SCI_INDICATORSTART, styles[style], pos));
+        runEnd = static_cast<size_t>(send(SCI_INDICATOREND, styles[style], pos));
+        return true;
+    };
+    std::vector<ListMatch> found;
+    lazyMarker.remarkRange(documentReader(), docLength, styles.size(), markRun, rangeStart, rangeEnd, found);
+    LRESULT start = static_cast<LRESULT>(rangeStart);
+    LRESULT end = static_cast<LRESULT>(rangeEnd);
 
-    if (colorToStyleMap.size() < textStyles.size()) {
-        ::SendMessage(_hScintilla, SCI_INDICSETFORE, indicatorStyle, color);
+    for (int style : styles) {
+        send(SCI_SETINDICATORCURRENT, style, 0);
+        send(SCI_INDICATORCLEARRANGE, start, end - start);
+    }
+    std::vector<std::vector<SelectionRange>*> marks(lazyMarker.patternCount(), nullptr);
+    for (const ListMatch& match : found) {
+        if (marks[match.pattern] == nullptr) {
+            marks[match.pattern] = &beginMarks(lazyMarker.pattern(match.pattern).findText);
+        }
+        marks[match.pattern]->push_back({ static_cast<LRESULT>(match.pos), static_cast<LRESULT>(match.pos + match.length) });
     }
+    fillMarks();
+}
 
-    ::SendMessage(_hScintilla, SCI_INDICSETALPHA, indicatorStyle, 100);
-    ::SendMessage(_hScintilla, SCI_INDICATORFILLRANGE, pos, len);
+void MultiReplace::endLazyMark()
+{
+    KillTimer(_hSelf, LAZY_COUNT_TIMER);
+    lazyMarker.clear();
+    lazyMarkDocument = 0;
 }
 
 long MultiReplace::generateColorValue(const std::string& str) {
@@ -2495,6 +4653,8 @@ long MultiReplace::generateColorValue(const std::string& str) {
 
 void MultiReplace::handleClearTextMarksButton()
 {
+    endLazyMark();
+
     for (int style : textStyles)
     {
         ::SendMessage(_hScintilla, SCI_SETINDICATORCURRENT, style, 0);
@@ -2502,99 +4662,241 @@ void MultiReplace::handleClearTextMarksButton()
     }
 
     markedStringsCount = 0;
-    colorToStyleMap.clear();    
+    colorToStyleMap.clear();
+    markEntries.clear();
 }
 
 void MultiReplace::handleCopyMarkedTextToClipboardButton()
 {
-    bool wasLastCharMarked = false;
-    size_t markedTextCount = 0;
+    copyMarkedTextToClipboard(MarkedTextFormat::Plain);
+}
 
-    std::string markedText;
-    std::string styleText;
+void MultiReplace::handleExportMarkedTextButton()
+{
+    // Text a lazy Mark has not reached yet is marked first
+    paintLazyMarks(true);
+    if (!hasMarkedText()) {
+        showStatusMessage(L"No marked text to export.", RGB(255, 0, 0));
+        return;
+    }
 
-    for (int style : textStyles)
-    {
-        ::SendMessage(_hScintilla, SCI_SETINDICATORCURRENT, style, 0);
-        LRESULT pos = 0;
-        LRESULT nextPos = ::SendMessage(_hScintilla, SCI_INDICATOREND, style, pos);
+    ExportMarksDialog dialog(nppData._nppHandle, _hSelf);
+    if (!dialog.show(exportFormat, exportToFile)) {
+        return;
+    }
+    if (!exportToFile) {
+        copyMarkedTextToClipboard(exportFormat);
+        return;
+    }
 
-        while (nextPos > pos) // check if nextPos has advanced
-        {
-            bool atEndOfIndic = ::SendMessage(_hScintilla, SCI_INDICATORVALUEAT, style, pos) != 0;
+    std::wstring filePath = (exportFormat == MarkedTextFormat::Csv)
+        ? openFileDialog(true, L"CSV Files (*.csv)\0*.csv\0All Files (*.*)\0*.*\0", L"Export Marked Text", OFN_PATHMUSTEXIST | OFN_OVERWRITEPROMPT, L"csv")
+        : openFileDialog(true, L"Text Files (*.txt)\0*.txt\0All Files (*.*)\0*.*\0", L"Export Marked Text", OFN_PATHMUSTEXIST | OFN_OVERWRITEPROMPT, L"txt");
+    if (!filePath.empty()) {
+        exportMarkedTextToFile(filePath, exportFormat);
+    }
+}
 
-            if (atEndOfIndic)
-            {
-                if (!wasLastCharMarked)
-                {
-                    ++markedTextCount;
-                }
+void MultiReplace::copyMarkedTextToClipboard(MarkedTextFormat format)
+{
+    // Text a lazy Mark has not reached yet is marked first
+    paintLazyMarks(true);
+    size_t docLength = static_cast<size_t>(send(SCI_GETLENGTH, 0, 0));
+
+    // The first pass only measures the text, the second one converts it straight into the Clipboard memory
+    size_t units = 0;
+    MarkedTextWriter measure(format, "\r\n", [&units](const char* data, size_t length) {
+        units += static_cast<size_t>(MultiByteToWideChar(CP_UTF8, 0, data, static_cast<int>(length), NULL, 0));
+        return true;
+        });
+    beginProgress(L"Copy Marked Text", 2 * docLength);
+    bool complete = writeMarkedText(measure, 0);
+    if (!complete || measure.blockCount() == 0) {
+        bool cancelled = endProgress();
+        showStatusMessage(cancelled ? L"Copy cancelled." : L"No marked text to copy.", RGB(255, 0, 0));
+        return;
+    }
 
-                wasLastCharMarked = true;
+    HGLOBAL hClipboardData = GlobalAlloc(GMEM_DDESHARE, sizeof(WCHAR) * (units + 1));
+    WCHAR* pchData = hClipboardData ? reinterpret_cast<WCHAR*>(GlobalLock(hClipboardData)) : NULL;
+    if (!pchData) {
+        endProgress();
+        if (hClipboardData) {
+            GlobalFree(hClipboardData);
+        }
+        showStatusMessage(L"Failed to allocate memory for Clipboard.", RGB(255, 0, 0));
+        return;
+    }
 
-                for (LRESULT i = pos; i < nextPos; ++i)
-                {
-                    char ch = static_cast<char>(::SendMessage(_hScintilla, SCI_GETCHARAT, i, 0));
-                    styleText += ch;
-                }
+    size_t written = 0;
+    MarkedTextWriter convert(format, "\r\n", [pchData, units, &written](const char* data, size_t length) {
+        if (written == units) {
+            return false;
+        }
+        int converted = MultiByteToWideChar(CP_UTF8, 0, data, static_cast<int>(length), pchData + written, static_cast<int>(units - written));
+        written += static_cast<size_t>(converted);
+        return length == 0 || converted > 0;
+        });
+    complete = writeMarkedText(convert, docLength) && written == units;
+    pchData[written] = L'\0';
+    GlobalUnlock(hClipboardData);
+    bool cancelled = endProgress();
+    if (!complete) {
+        GlobalFree(hClipboardData);
+        showStatusMessage(cancelled ? L"Copy cancelled." : L"Failed to copy marked text to Clipboard.", RGB(255, 0, 0));
+        return;
+    }
 
-                markedText += styleText;
-                styleText.clear();
-            }
-            else
-            {
-                wasLastCharMarked = false;
-            }
+    OpenClipboard(0);
+    EmptyClipboard();
+    if (SetClipboardData(CF_UNICODETEXT, hClipboardData) != NULL) {
+        showStatusMessage(std::to_wstring(convert.blockCount()) + L" marked blocks copied into Clipboard.", RGB(0, 128, 0));
+    }
+    else {
+        GlobalFree(hClipboardData);
+        showStatusMessage(L"Failed to copy marked text to Clipboard.", RGB(255, 0, 0));
+    }
+    CloseClipboard();
+}
 
-            pos = nextPos;
-            nextPos = ::SendMessage(_hScintilla, SCI_INDICATOREND, style, pos);
-        }
+void MultiReplace::exportMarkedTextToFile(const std::wstring& filePath, MarkedTextFormat format)
+{
+    std::ofstream outFile(filePath, std::ios::binary);
+    if (!outFile.is_open()) {
+        showStatusMessage(L"Error: Unable to open file for writing.", RGB(255, 0, 0));
+        return;
     }
 
-    // Convert encoding to wide string
-    std::wstring wstr = stringToWString(markedText);
+    // Lines end like the document's
+    LRESULT eolMode = send(SCI_GETEOLMODE, 0, 0);
+    std::string eol = (eolMode == SC_EOL_LF) ? "\n" : (eolMode == SC_EOL_CR) ? "\r" : "\r\n";
+    MarkedTextWriter writer(format, eol, [&outFile](const char* data, size_t length) {
+        outFile.write(data, static_cast<std::streamsize>(length));
+        return outFile.good();
+        });
 
-    if (markedTextCount > 0)
-    {
-        // Open Clipboard
-        OpenClipboard(0);
-        EmptyClipboard();
+    beginProgress(L"Export Marked Text", static_cast<size_t>(send(SCI_GETLENGTH, 0, 0)));
+    bool complete = writeMarkedText(writer, 0);
+    bool cancelled = endProgress();
+    outFile.close();
+
+    if (cancelled) {
+        showStatusMessage(L"Export cancelled. The file holds the blocks written so far.", RGB(255, 0, 0));
+    }
+    else if (!complete || outFile.fail()) {
+        showStatusMessage(L"Error: Unable to write the file.", RGB(255, 0, 0));
+    }
+    else {
+        showStatusMessage(std::to_wstring(writer.blockCount()) + L" marked blocks exported.", RGB(0, 128, 0));
+    }
+}
+
+bool MultiReplace::writeMarkedText(MarkedTextWriter& writer, size_t progressBase)
+{
+    struct MarkRun {
+        int style;
+        LRESULT start;
+        LRESULT end;
+    };
 
-        // Copy data to clipboard
-        HGLOBAL hClipboardData = GlobalAlloc(GMEM_DDESHARE, sizeof(WCHAR) * (wstr.length() + 1));
-        if (hClipboardData)
-        {
-            WCHAR* pchData;
-            pchData = reinterpret_cast<WCHAR*>(GlobalLock(hClipboardData));
-            if (pchData)
-            {
-                wcscpy(pchData, wstr.c_str());
-                GlobalUnlock(hClipboardData);
+    // The next run of every indicator; the runs are written in document order
+    std::vector<MarkRun> runs;
+    std::map<int, std::string> entryNames;
+    for (int style : textStyles) {
+        MarkRun run = { style, 0, 0 };
+        if (findMarkedRun(style, 0, run.start, run.end)) {
+            runs.push_back(run);
+        }
+
+        // Entries sharing the color of an indicator are listed together
+        std::string& names = entryNames[style];
+        for (const std::string& name : markEntries[style]) {
+            names += (names.empty() ? "" : " | ") + name;
+        }
+    }
+
+    int codepage = static_cast<int>(send(SCI_GETCODEPAGE, 0, 0));
+    LRESULT lineStart = 0;
+    LRESULT columnPos = 0;
+    size_t column = 0;
+    std::wstring wide;
+    std::string utf8;
+    while (!runs.empty()) {
+        auto next = std::min_element(runs.begin(), runs.end(), [](const MarkRun& a, const MarkRun& b) { return a.start < b.start; });
+        MarkRun run = *next;
+
+        // Columns are counted on from the last block of the same line
+        LRESULT line = 0;
+        if (writer.writesPositions()) {
+            line = send(SCI_LINEFROMPOSITION, run.start, 0);
+            LRESULT start = send(SCI_POSITIONFROMLINE, line, 0);
+            if (start != lineStart || run.start < columnPos) {
+                lineStart = start;
+                columnPos = start;
+                column = 0;
+            }
+            column += static_cast<size_t>(send(SCI_COUNTCHARACTERS, columnPos, run.start));
+            columnPos = run.start;
+        }
+        writer.beginBlock(static_cast<size_t>(line), column, entryNames[run.style]);
 
-                // Checking SetClipboardData return
-                if (SetClipboardData(CF_UNICODETEXT, hClipboardData) != NULL)
-                {
-                    int markedTextCountInt = static_cast<int>(markedTextCount);
-                    showStatusMessage(std::to_wstring(markedTextCountInt) + L" marked blocks copied into Clipboard.", RGB(0, 128, 0));
-                }
-                else
-                {
-                    showStatusMessage(L"Failed to copy marked text to Clipboard.", RGB(255, 0, 0));
-                }
+        // Long blocks are read in pieces ending behind a whole character
+        for (LRESULT pieceStart = run.start; pieceStart < run.end; ) {
+            LRESULT pieceEnd = run.end;
+            if (pieceEnd - pieceStart > EXPORT_PIECE_LENGTH) {
+                pieceEnd = send(SCI_POSITIONBEFORE, pieceStart + EXPORT_PIECE_LENGTH + 1, 0);
             }
-            else
-            {
-                showStatusMessage(L"Failed to allocate memory for Clipboard.", RGB(255, 0, 0));
-                GlobalFree(hClipboardData);
+            const char* text = reinterpret_cast<const char*>(send(SCI_GETRANGEPOINTER, pieceStart, pieceEnd - pieceStart));
+            int length = static_cast<int>(pieceEnd - pieceStart);
+            if (codepage == SC_CP_UTF8) {
+                writer.appendText(text, static_cast<size_t>(length));
             }
+            else {
+                UINT sourceCodepage = (codepage == 0) ? CP_ACP : static_cast<UINT>(codepage);
+                wide.resize(static_cast<size_t>(MultiByteToWideChar(sourceCodepage, 0, text, length, NULL, 0)));
+                MultiByteToWideChar(sourceCodepage, 0, text, length, &wide[0], static_cast<int>(wide.size()));
+                utf8.resize(static_cast<size_t>(WideCharToMultiByte(CP_UTF8, 0, wide.data(), static_cast<int>(wide.size()), NULL, 0, NULL, NULL)));
+                WideCharToMultiByte(CP_UTF8, 0, wide.data(), static_cast<int>(wide.size()), &utf8[0], static_cast<int>(utf8.size()), NULL, NULL);
+                writer.appendText(utf8.data(), utf8.size());
+            }
+            pieceStart = pieceEnd;
+        }
+        if (!writer.endBlock()) {
+            return false;
         }
 
-        CloseClipboard();
-    }
-    else
-    {
-        showStatusMessage(L"No marked text to copy.", RGB(255, 0, 0));
+        size_t done = progressBase + static_cast<size_t>(run.end);
+        if (!updateProgress(done, writer.blockCount(), static_cast<size_t>(run.end))) {
+            return false;
+        }
+        if (!findMarkedRun(run.style, run.end, next->start, next->end)) {
+            runs.erase(next);
+        }
     }
+    return writer.finish();
+}
+
+bool MultiReplace::findMarkedRun(int style, LRESULT pos, LRESULT& start, LRESULT& end)
+{
+    // Runs end where the value of the indicator changes
+    LRESULT nextPos = send(SCI_INDICATOREND, style, pos);
+    while (nextPos > pos) {
+        if (send(SCI_INDICATORVALUEAT, style, pos) != 0) {
+            start = pos;
+            end = nextPos;
+            return true;
+        }
+        pos = nextPos;
+        nextPos = send(SCI_INDICATOREND, style, pos);
+    }
+    return false;
+}
+
+bool MultiReplace::hasMarkedText()
+{
+    LRESULT start = 0;
+    LRESULT end = 0;
+    return std::any_of(textStyles.begin(), textStyles.end(), [&](int style) { return findMarkedRun(style, 0, start, end); });
 }
 
 #pragma endregion
@@ -2754,7 +5056,7 @@ bool MultiReplace::parseColumnAndDelimiterData() {
     return true;
 }
 
-void MultiReplace::findAllDelimitersInDocument() {
+bool MultiReplace::findAllDelimitersInDocument() {
 
     // Clear list for new data
     lineDelimiterPositions.clear();
@@ -2773,19 +5075,47 @@ void MultiReplace::findAllDelimitersInDocument() {
     lineDelimiterPositions.resize(totalLines);
 
     // Find and store delimiter positions for each line
+    beginProgress(L"Scanning columns", static_cast<size_t>(totalLines));
     for (LRESULT line = 0; line < totalLines; ++line) {
 
         // Find delimiters in line
         findDelimitersInLine(line);
 
+        if (!updateProgress(static_cast<size_t>(line) + 1, 0, static_cast<size_t>(lineDelimiterPositions[line].endPosition))) {
+            break;
+        }
     }
 
     // Clear log queue
     logChanges.clear();
 
+    // A partial index is of no use, start over with the next operation
+    if (endProgress()) {
+        handleClearDelimiterState();
+        return false;
+    }
+    return true;
 }
 
 void MultiReplace::findDelimitersInLine(LRESULT line) {
+    LineInfo lineInfo = scanDelimitersInLine(line);
+
+    // Convert size of lineDelimiterPositions to signed integer
+    LRESULT listSize = static_cast<LRESULT>(lineDelimiterPositions.size());
+
+    // Update lineDelimiterPositions with the LineInfo for this line
+    if (line < listSize) {
+        lineDelimiterPositions[line] = lineInfo;
+    }
+    else {
+        // If the line index is greater than the current size of the list,
+        // append new elements to the list
+        lineDelimiterPositions.resize(line + 1);
+        lineDelimiterPositions[line] = lineInfo;
+    }
+}
+
+LineInfo MultiReplace::scanDelimitersInLine(LRESULT line) {
     // Initialize LineInfo for this line
     LineInfo lineInfo;
 
@@ -2828,19 +5158,7 @@ void MultiReplace::findDelimitersInLine(LRESULT line) {
         ++pos;
     }
 
-    // Convert size of lineDelimiterPositions to signed integer
-    LRESULT listSize = static_cast<LRESULT>(lineDelimiterPositions.size());
-
-    // Update lineDelimiterPositions with the LineInfo for this line
-    if (line < listSize) {
-        lineDelimiterPositions[line] = lineInfo;
-    }
-    else {
-        // If the line index is greater than the current size of the list,
-        // append new elements to the list
-        lineDelimiterPositions.resize(line + 1);
-        lineDelimiterPositions[line] = lineInfo;
-    }
+    return lineInfo;
 }
 
 ColumnInfo MultiReplace::getColumnInfo(LRESULT startPosition) {
@@ -3056,7 +5374,7 @@ void MultiReplace::processLogForDelimiters()
     for (const auto& modifyLogEntry : modifyLogEntries) {
         if (modifyLogEntry.lineNumber != -1) {
             updateDelimitersInDocument(static_cast<int>(modifyLogEntry.lineNumber), ChangeType::Modify);
-            if (isColumnHighlighted) {
+            if (isColumnHighlighted && !isBatchEditActive) {
                 //clearMarksInLine(modifyLogEntry.lineNumber);
                 highlightColumnsInLine(modifyLogEntry.lineNumber);
             }
@@ -3117,10 +5435,13 @@ void MultiReplace::updateDelimitersInDocument(SIZE_T lineNumber, ChangeType chan
             // Re-analyze the line to find delimiters
             findDelimitersInLine(lineNumber);
 
-            // Update the highlight if necessary
-            if (isColumnHighlighted) {
+            // Update the highlight if necessary, a batch edit refreshes it once at the end
+            if (isColumnHighlighted && !isBatchEditActive) {
                 highlightColumnsInLine(lineNumber);
             }
+            else if (isColumnHighlighted && (batchFirstDirtyLine < 0 || static_cast<LRESULT>(lineNumber) < batchFirstDirtyLine)) {
+                batchFirstDirtyLine = static_cast<LRESULT>(lineNumber);
+            }
 
             // Only adjust following lines if not at the last line
             if (lineNumber < lineDelimiterPositions.size() - 1) {
@@ -3153,10 +5474,10 @@ void MultiReplace::updateDelimitersInDocument(SIZE_T lineNumber, ChangeType chan
     }
 }
 
-void MultiReplace::handleDelimiterPositions(DelimiterOperation operation) {
+bool MultiReplace::handleDelimiterPositions(DelimiterOperation operation) {
     // Check if IDC_COLUMN_MODE_RADIO checkbox is not checked, and if so, return early
     if (IsDlgButtonChecked(_hSelf, IDC_COLUMN_MODE_RADIO) != BST_CHECKED) {
-        return;
+        return true;
     }
     //int currentBufferID = (int)::SendMessage(nppData._nppHandle, NPPM_GETCURRENTBUFFERID, 0, 0);
     LRESULT updatedEolLength = updateEOLLength();
@@ -3173,12 +5494,13 @@ void MultiReplace::handleDelimiterPositions(DelimiterOperation operation) {
     if (operation == DelimiterOperation::LoadAll) {
         // Parse column and delimiter data; exit if parsing fails or if delimiter is empty
         if (!parseColumnAndDelimiterData()) {
-            return;
+            return true;
         }
 
         // If any conditions that warrant a refresh of delimiters are met, proceed
-        if (columnDelimiterData.isValid()) {
-            findAllDelimitersInDocument();
+        if (columnDelimiterData.isValid() && !findAllDelimitersInDocument()) {
+            showStatusMessage(L"Column scan cancelled.", RGB(255, 0, 0));
+            return false;
         }
     }
     else if (operation == DelimiterOperation::Update) {
@@ -3187,6 +5509,7 @@ void MultiReplace::handleDelimiterPositions(DelimiterOperation operation) {
             processLogForDelimiters();
         }
     }
+    return true;
 }
 
 void MultiReplace::handleClearDelimiterState() {
@@ -3198,6 +5521,127 @@ void MultiReplace::handleClearDelimiterState() {
     isCaretPositionEnabled = false;
 }
 
+std::vector<SelectionRange> MultiReplace::getScopeRanges() {
+    std::vector<SelectionRange> ranges;
+
+    // A running Replace All or Mark keeps the ranges up to date itself
+    if (searchScope.isActive()) {
+        for (const ScopeRange& range : searchScope.allRanges()) {
+            ranges.push_back({ range.start, range.end });
+        }
+    }
+    else if (IsDlgButtonChecked(_hSelf, IDC_SELECTION_RADIO) == BST_CHECKED) {
+        SearchScope singleScope;
+        singleScope.assign(readSelections());
+        for (const ScopeRange& selection : singleScope.allRanges()) {
+            ranges.push_back({ selection.start, selection.end });
+        }
+    }
+    else if (IsDlgButtonChecked(_hSelf, IDC_COLUMN_MODE_RADIO) == BST_CHECKED && columnDelimiterData.isValid()) {
+        LRESULT totalLines = ::SendMessage(_hScintilla, SCI_GETLINECOUNT, 0, 0);
+        LRESULT listSize = static_cast<LRESULT>(lineDelimiterPositions.size());
+
+        std::vector<ScopeRange> cells;
+        for (LRESULT line = 0; line < totalLines && line < listSize; ++line) {
+            appendColumnCells(lineDelimiterPositions[line], cells);
+        }
+        for (const ScopeRange& cell : cells) {
+            ranges.push_back({ cell.start, cell.end });
+        }
+    }
+    else {
+        ranges.push_back({ 0, send(SCI_GETLENGTH, 0, 0) });
+    }
+
+    return ranges;
+}
+
+void MultiReplace::appendColumnCells(const LineInfo& lineInfo, std::vector<ScopeRange>& cells) {
+    SIZE_T totalColumns = lineInfo.positions.size() + 1;
+
+    // Cells of the selected columns, in document order
+    for (int column : columnDelimiterData.columns) {
+        if (column < 1 || static_cast<SIZE_T>(column) > totalColumns) {
+            continue;
+        }
+        ScopeRange cell;
+        cell.start = (column == 1) ? lineInfo.startPosition : lineInfo.positions[column - 2].position + columnDelimiterData.delimiterLength;
+        cell.end = (static_cast<SIZE_T>(column) == totalColumns) ? lineInfo.endPosition : lineInfo.positions[column - 1].position;
+        cell.column = column;
+        cells.push_back(cell);
+    }
+}
+
+std::vector<ScopeRange> MultiReplace::readSelections() {
+    LRESULT selectionCount = ::SendMessage(_hScintilla, SCI_GETSELECTIONS, 0, 0);
+    std::vector<ScopeRange> selections(static_cast<size_t>(selectionCount));
+
+    for (int i = 0; i < selectionCount; i++) {
+        selections[i].start = ::SendMessage(_hScintilla, SCI_GETSELECTIONNSTART, i, 0);
+        selections[i].end = ::SendMessage(_hScintilla, SCI_GETSELECTIONNEND, i, 0);
+    }
+    return selections;
+}
+
+void MultiReplace::captureSearchScope() {
+    // Read once per operation, the replacements move the ranges instead of querying the editor or the delimiter index per match
+    if (IsDlgButtonChecked(_hSelf, IDC_SELECTION_RADIO) == BST_CHECKED) {
+        searchScope.assign(readSelections());
+    }
+    else if (IsDlgButtonChecked(_hSelf, IDC_COLUMN_MODE_RADIO) == BST_CHECKED && columnDelimiterData.isValid() && !lineDelimiterPositions.empty()) {
+        LRESULT totalLines = ::SendMessage(_hScintilla, SCI_GETLINECOUNT, 0, 0);
+        LRESULT listSize = static_cast<LRESULT>(lineDelimiterPositions.size());
+
+        std::vector<ScopeRange> cells;
+        for (LRESULT line = 0; line < totalLines && line < listSize; ++line) {
+            appendColumnCells(lineDelimiterPositions[line], cells);
+        }
+        searchScope.assignCells(std::move(cells));
+    }
+}
+
+void MultiReplace::releaseSearchScope() {
+    searchScope.clear();
+}
+
+void MultiReplace::updateSearchScope(Sci_Position pos, Sci_Position length, Sci_Position newLength, bool layoutChanged) {
+    if (!searchScope.isActive()) {
+        return;
+    }
+    searchScope.replaced(pos, length, newLength);
+
+    // A delimiter, quote or line break that came or went moves the cells of its lines, only those lines are scanned again
+    if (searchScope.hasCells() && (layoutChanged || changesColumnLayout(pos, newLength))) {
+        LRESULT firstLine = send(SCI_LINEFROMPOSITION, pos, 0);
+        LRESULT lastLine = send(SCI_LINEFROMPOSITION, pos + newLength, 0);
+
+        std::vector<ScopeRange> cells;
+        for (LRESULT line = firstLine; line <= lastLine; ++line) {
+            appendColumnCells(scanDelimitersInLine(line), cells);
+        }
+        searchScope.reload(send(SCI_POSITIONFROMLINE, firstLine, 0), send(SCI_GETLINEENDPOSITION, lastLine, 0), cells);
+    }
+}
+
+bool MultiReplace::changesColumnLayout(Sci_Position pos, Sci_Position length) {
+    // Widened by the delimiter length, a delimiter may begin in front of the text or end behind it
+    Sci_Position margin = static_cast<Sci_Position>(columnDelimiterData.delimiterLength) - 1;
+    Sci_Position start = std::max<Sci_Position>(0, pos - margin);
+    Sci_Position end = std::min<Sci_Position>(static_cast<Sci_Position>(send(SCI_GETLENGTH, 0, 0)), pos + length + margin);
+    if (end <= start) {
+        return false;
+    }
+
+    const char* pointer = reinterpret_cast<const char*>(send(SCI_GETRANGEPOINTER, start, end - start));
+    if (pointer == nullptr) {
+        return true;
+    }
+    std::string text(pointer, static_cast<size_t>(end - start));
+    return text.find(columnDelimiterData.extendedDelimiter) != std::string::npos ||
+        (!columnDelimiterData.quoteChar.empty() && text.find(columnDelimiterData.quoteChar) != std::string::npos) ||
+        text.find_first_of("\r\n") != std::string::npos;
+}
+
 /* For testing purposes only
 void MultiReplace::displayLogChangesInMessageBox() {
 
@@ -3267,136 +5711,6 @@ void MultiReplace::displayLogChangesInMessageBox() {
 
 #pragma region Utilities
 
-int MultiReplace::convertExtendedToString(const std::string& query, std::string& result)
-{
-    auto readBase = [](const char* str, int* value, int base, int size) -> bool
-    {
-        int i = 0, temp = 0;
-        *value = 0;
-        char max = '0' + static_cast<char>(base) - 1;
-        char current;
-        while (i < size)
-        {
-            current = str[i];
-            if (current >= 'A')
-            {
-                current &= 0xdf;
-                current -= ('A' - '0' - 10);
-            }
-            else if (current > '9')
-                return false;
-
-            if (current >= '0' && current <= max)
-            {
-                temp *= base;
-                temp += (current - '0');
-            }
-            else
-            {
-                return false;
-            }
-            ++i;
-        }
-        *value = temp;
-        return true;
-    };
-
-    int i = 0, j = 0;
-    int charLeft = static_cast<int>(query.length());
-    char current;
-    result.clear();
-    result.resize(query.length()); // Preallocate memory for optimal performance
-
-    while (i < static_cast<int>(query.length()))
-    {
-        current = query[i];
-        --charLeft;
-        if (current == '\\' && charLeft)
-        {
-            ++i;
-            --charLeft;
-            current = query[i];
-            switch (current)
-            {
-            case 'r':
-                result[j] = '\r';
-                break;
-            case 'n':
-                result[j] = '\n';
-                break;
-            case '0':
-                result[j] = '\0';
-                break;
-            case 't':
-                result[j] = '\t';
-                break;
-            case '\\':
-                result[j] = '\\';
-                break;
-            case 'b':
-            case 'd':
-            case 'o':
-            case 'x':
-            case 'u':
-            {
-                int size = 0, base = 0;
-                if (current == 'b')
-                {
-                    size = 8, base = 2;
-                }
-                else if (current == 'o')
-                {
-                    size = 3, base = 8;
-                }
-                else if (current == 'd')
-                {
-                    size = 3, base = 10;
-                }
-                else if (current == 'x')
-                {
-                    size = 2, base = 16;
-                }
-                else if (current == 'u')
-                {
-                    size = 4, base = 16;
-                }
-
-                if (charLeft >= size)
-                {
-                    int res = 0;
-                    if (readBase(query.c_str() + (i + 1), &res, base, size))
-                    {
-                        result[j] = static_cast<char>(res);
-                        i += size;
-                        break;
-                    }
-                }
-                // not enough chars to make parameter, use default method as fallback
-            }
-            [[fallthrough]];
-            default:
-                // unknown sequence, treat as regular text
-                result[j] = '\\';
-                ++j;
-                result[j] = current;
-                break;
-            }
-        }
-        else
-        {
-            result[j] = query[i];
-        }
-        ++i;
-        ++j;
-    }
-
-    // Nullterminate the result-String
-    result.resize(j);
-
-    // Return length of result-Strings
-    return j;
-}
-
 std::string MultiReplace::convertAndExtend(const std::wstring& input, bool extended)
 {
     std::string output = wstringToString(input);
@@ -3579,6 +5893,9 @@ void MultiReplace::setElementsState(const std::vector<int>& elements, bool enabl
 }
 
 sptr_t MultiReplace::send(unsigned int iMessage, uptr_t wParam, sptr_t lParam, bool useDirect) {
+#ifdef _DEBUG
+    ++sciMessageCount;
+#endif
     if (useDirect && pSciMsg) {
         return pSciMsg(pSciWndData, iMessage, wParam, lParam);
     }
@@ -3639,6 +5956,50 @@ sptr_t MultiReplace::send(unsigned int iMessage, uptr_t wParam, sptr_t lParam, b
 } 
 */
 
+void MultiReplace::beginProgress(const std::wstring& title, size_t total)
+{
+    // Runs started inside another one (e.g. a column scan) report through the outer run
+    if (progressScheduler) {
+        ++progressNesting;
+        return;
+    }
+
+    progressOffset = 0;
+    progressMatches = 0;
+    progressScheduler = std::make_unique<ProgressScheduler>(total, static_cast<size_t>(PROGRESS_THRESHOLD),
+        std::chrono::milliseconds(PROGRESS_SLICE_MS), [this](const ProgressInfo& info) { progressDialog->report(info); });
+    progressDialog = std::make_unique<ProgressDialog>(nppData._nppHandle, _hSelf, title, *progressScheduler);
+}
+
+bool MultiReplace::updateProgress(size_t done, size_t matches, size_t bytes)
+{
+    if (!progressScheduler) {
+        return true;
+    }
+    if (progressNesting > 0) {
+        return !progressScheduler->isCancelled();
+    }
+    return progressScheduler->update(done, matches, bytes);
+}
+
+bool MultiReplace::isProgressCancelled() const
+{
+    return progressScheduler && progressScheduler->isCancelled();
+}
+
+bool MultiReplace::endProgress()
+{
+    bool cancelled = isProgressCancelled();
+    if (progressNesting > 0) {
+        --progressNesting;
+        return cancelled;
+    }
+
+    progressDialog.reset();
+    progressScheduler.reset();
+    return cancelled;
+}
+
 bool MultiReplace::normalizeAndValidateNumber(std::string& str) {
     if (str == "." || str == ",") {
         return false;
@@ -3780,7 +6141,7 @@ bool MultiReplace::saveListToCsvSilent(const std::wstring& filePath, const std::
     }
 
     // Convert and Write CSV header
-    std::string utf8Header = wstringToString(L"Selected,Find,Replace,WholeWord,MatchCase,UseVariables,Regex,Extended\n");
+    std::string utf8Header = wstringToString(L"Selected,Find,Replace,WholeWord,MatchCase,UseVariables,Regex,Extended,Fuzzy\n");
     outFile << utf8Header;
 
     // Write list items to CSV file
@@ -3792,7 +6153,8 @@ bool MultiReplace::saveListToCsvSilent(const std::wstring& filePath, const std::
             std::to_wstring(item.matchCase) + L"," +
             std::to_wstring(item.useVariables) + L"," +
             std::to_wstring(item.extended) + L"," +
-            std::to_wstring(item.regex) + L"\n";
+            std::to_wstring(item.regex) + L"," +
+            std::to_wstring(item.fuzzy) + L"\n";
         std::string utf8Line = wstringToString(line);
         outFile << utf8Line;
     }
@@ -3857,8 +6219,8 @@ void MultiReplace::loadListFromCsvSilent(const std::wstring& filePath, std::vect
 
         columns.push_back(unescapeCsvValue(currentValue));
 
-        // Check if the row has the correct number of columns
-        if (columns.size() != 8) {
+        // Check if the row has the correct number of columns; lists saved before the Fuzzy column have one less
+        if (columns.size() != 8 && columns.size() != 9) {
             throw CsvLoadException("Invalid number of columns in CSV file '" + wstringToString(fileName) + "'.");
         }
 
@@ -3873,6 +6235,7 @@ void MultiReplace::loadListFromCsvSilent(const std::wstring& filePath, std::vect
             item.useVariables = std::stoi(columns[5]) != 0;
             item.extended = std::stoi(columns[6]) != 0;
             item.regex = std::stoi(columns[7]) != 0;
+            item.fuzzy = (columns.size() > 8) ? std::clamp(std::stoi(columns[8]), 0, MAX_FUZZY_DISTANCE) : 0;
 
             tempList.push_back(item);
         }
@@ -3911,6 +6274,7 @@ void MultiReplace::loadListFromCsv(const std::wstring& filePath) {
 
     ListView_SetItemCountEx(_replaceListView, replaceListData.size(), LVSICF_NOINVALIDATEALL);
     InvalidateRect(_replaceListView, NULL, TRUE);
+    scheduleHitCountOfNewEntries();
 }
 
 std::wstring MultiReplace::escapeCsvValue(const std::wstring& value) {
@@ -4022,9 +6386,16 @@ void MultiReplace::exportToBashScript(const std::wstring& fileName) {
     file << "cp $inputFile $outputFile\n\n";
 
     file << "# processLine arguments: \"findString\" \"replaceString\" wholeWord matchCase normal extended regex\n";
+    int skippedFuzzy = 0;
     for (const auto& itemData : replaceListData) {
         if (!itemData.isSelected) continue; // Skip if this item is not selected
 
+        // sed has no approximate matching
+        if (itemData.fuzzy > 0) {
+            skippedFuzzy++;
+            continue;
+        }
+
         std::string find;
         std::string replace;
         if (itemData.extended) {
@@ -4051,7 +6422,12 @@ void MultiReplace::exportToBashScript(const std::wstring& fileName) {
 
     file.close();
 
-    showStatusMessage(L"List exported to BASH script.", RGB(0, 128, 0));
+    if (skippedFuzzy > 0) {
+        showStatusMessage(L"List exported to BASH script. " + std::to_wstring(skippedFuzzy) + L" Fuzzy entries were left out.", RGB(0, 128, 0));
+    }
+    else {
+        showStatusMessage(L"List exported to BASH script.", RGB(0, 128, 0));
+    }
 
     // Enable the ListView accordingly
     SendMessage(GetDlgItem(_hSelf, IDC_USE_LIST_CHECKBOX), BM_SETCHECK, BST_CHECKED, 0);
@@ -4179,6 +6555,8 @@ void MultiReplace::saveSettingsToIni(const std::wstring& iniFilePath) {
     int matchCase = IsDlgButtonChecked(_hSelf, IDC_MATCH_CASE_CHECKBOX) == BST_CHECKED ? 1 : 0;
     int extended = IsDlgButtonChecked(_hSelf, IDC_EXTENDED_RADIO) == BST_CHECKED ? 1 : 0;
     int regex = IsDlgButtonChecked(_hSelf, IDC_REGEX_RADIO) == BST_CHECKED ? 1 : 0;
+    int fuzzy = IsDlgButtonChecked(_hSelf, IDC_FUZZY_RADIO) == BST_CHECKED ? 1 : 0;
+    std::wstring fuzzyDistance = getTextFromDialogItem(_hSelf, IDC_FUZZY_DISTANCE_EDIT);
     int wrapAround = IsDlgButtonChecked(_hSelf, IDC_WRAP_AROUND_CHECKBOX) == BST_CHECKED ? 1 : 0;
     int useVariables = IsDlgButtonChecked(_hSelf, IDC_USE_VARIABLES_CHECKBOX) == BST_CHECKED ? 1 : 0;
     int ButtonsMode = IsDlgButtonChecked(_hSelf, IDC_2_BUTTONS_MODE) == BST_CHECKED ? 1 : 0;
@@ -4189,10 +6567,14 @@ void MultiReplace::saveSettingsToIni(const std::wstring& iniFilePath) {
     outFile << wstringToString(L"MatchCase=" + std::to_wstring(matchCase) + L"\n");
     outFile << wstringToString(L"Extended=" + std::to_wstring(extended) + L"\n");
     outFile << wstringToString(L"Regex=" + std::to_wstring(regex) + L"\n");
+    outFile << wstringToString(L"Fuzzy=" + std::to_wstring(fuzzy) + L"\n");
+    outFile << wstringToString(L"FuzzyDistance=" + fuzzyDistance + L"\n");
     outFile << wstringToString(L"WrapAround=" + std::to_wstring(wrapAround) + L"\n");
     outFile << wstringToString(L"UseVariables=" + std::to_wstring(useVariables) + L"\n");
     outFile << wstringToString(L"ButtonsMode=" + std::to_wstring(ButtonsMode) + L"\n");
     outFile << wstringToString(L"UseList=" + std::to_wstring(useList) + L"\n");
+    outFile << wstringToString(L"SinglePassList=" + std::to_wstring(useSinglePassList ? 1 : 0) + L"\n");
+    outFile << wstringToString(L"ListReplaceMode=" + std::to_wstring(static_cast<int>(listReplaceMode)) + L"\n");
 
     // Convert and Store the scope options
     int selection = IsDlgButtonChecked(_hSelf, IDC_SELECTION_RADIO) == BST_CHECKED ? 1 : 0;
@@ -4296,17 +6678,24 @@ void MultiReplace::loadSettingsFromIni(const std::wstring& iniFilePath) {
 
     bool extended = readBoolFromIniFile(iniFilePath, L"Options", L"Extended", false);
     bool regex = readBoolFromIniFile(iniFilePath, L"Options", L"Regex", false);
+    bool fuzzy = readBoolFromIniFile(iniFilePath, L"Options", L"Fuzzy", false);
+    int fuzzyDistance = std::clamp(readIntFromIniFile(iniFilePath, L"Options", L"FuzzyDistance", 1), 1, MAX_FUZZY_DISTANCE);
+    SetDlgItemTextW(_hSelf, IDC_FUZZY_DISTANCE_EDIT, std::to_wstring(fuzzyDistance).c_str());
 
     // Select the appropriate radio button based on the settings
     if (regex) {
-        CheckRadioButton(_hSelf, IDC_NORMAL_RADIO, IDC_REGEX_RADIO, IDC_REGEX_RADIO);
-        EnableWindow(GetDlgItem(_hSelf, IDC_WHOLE_WORD_CHECKBOX), SW_HIDE);
+        CheckRadioButton(_hSelf, IDC_NORMAL_RADIO, IDC_FUZZY_RADIO, IDC_REGEX_RADIO);
+        EnableWindow(GetDlgItem(_hSelf, IDC_WHOLE_WORD_CHECKBOX), FALSE);
+    }
+    else if (fuzzy) {
+        CheckRadioButton(_hSelf, IDC_NORMAL_RADIO, IDC_FUZZY_RADIO, IDC_FUZZY_RADIO);
+        EnableWindow(GetDlgItem(_hSelf, IDC_WHOLE_WORD_CHECKBOX), FALSE);
     }
     else if (extended) {
-        CheckRadioButton(_hSelf, IDC_NORMAL_RADIO, IDC_REGEX_RADIO, IDC_EXTENDED_RADIO);
+        CheckRadioButton(_hSelf, IDC_NORMAL_RADIO, IDC_FUZZY_RADIO, IDC_EXTENDED_RADIO);
     }
     else {
-        CheckRadioButton(_hSelf, IDC_NORMAL_RADIO, IDC_REGEX_RADIO, IDC_NORMAL_RADIO);
+        CheckRadioButton(_hSelf, IDC_NORMAL_RADIO, IDC_FUZZY_RADIO, IDC_NORMAL_RADIO);
     }
 
     bool wrapAround = readBoolFromIniFile(iniFilePath, L"Options", L"WrapAround", false);
@@ -4319,6 +6708,11 @@ void MultiReplace::loadSettingsFromIni(const std::wstring& iniFilePath) {
     SendMessage(GetDlgItem(_hSelf, IDC_USE_LIST_CHECKBOX), BM_SETCHECK, useList ? BST_CHECKED : BST_UNCHECKED, 0);
     EnableWindow(_replaceListView, useList);
 
+    useSinglePassList = readBoolFromIniFile(iniFilePath, L"Options", L"SinglePassList", true);
+    int replaceMode = readIntFromIniFile(iniFilePath, L"Options", L"ListReplaceMode", 0);
+    listReplaceMode = (replaceMode == 1) ? ListReplaceMode::Simultaneous
+        : (replaceMode == 2) ? ListReplaceMode::LeftmostLongest : ListReplaceMode::Sequential;
+
     // Load Scope
     int selection = readIntFromIniFile(iniFilePath, L"Scope", L"Selection", 0);
     int columnMode = readIntFromIniFile(iniFilePath, L"Scope", L"ColumnMode", 0);
@@ -4392,7 +6786,7 @@ void MultiReplace::loadSettings() {
 
     ListView_SetItemCountEx(_replaceListView, replaceListData.size(), LVSICF_NOINVALIDATEALL);
     InvalidateRect(_replaceListView, NULL, TRUE);
-
+    scheduleHitCountOfNewEntries();
 }
 
 std::wstring MultiReplace::readStringFromIniFile(const std::wstring& iniFilePath, const std::wstring& section, const std::wstring& key, const std::wstring& defaultValue) {
@@ -4498,6 +6892,65 @@ void MultiReplace::processTextChange(SCNotification* notifyCode) {
     }
 }
 
+void MultiReplace::processMatchIndexChange(SCNotification* notifyCode) {
+    if (instance == nullptr || !instance->matchIndex.isActive()) {
+        return;
+    }
+
+    instance->repairMatchIndex(notifyCode);
+}
+
+void MultiReplace::processHitChange(SCNotification* notifyCode) {
+    if (instance == nullptr) {
+        return;
+    }
+
+    instance->repairHitIndex(notifyCode);
+}
+
+void MultiReplace::processLiveSearchChange(SCNotification* notifyCode) {
+    if (instance == nullptr || !instance->liveSearch.isActive()) {
+        return;
+    }
+
+    instance->repairLiveSearch(notifyCode);
+}
+
+void MultiReplace::processMarkChange(SCNotification* notifyCode) {
+    if (instance == nullptr || !instance->lazyMarker.isActive()) {
+        return;
+    }
+
+    // Marks move along with the text, so the regions marked before do too
+    HWND hScintilla = static_cast<HWND>(notifyCode->nmhdr.hwndFrom);
+    if (::SendMessage(hScintilla, SCI_GETDOCPOINTER, 0, 0) != instance->lazyMarkDocument) {
+        return;
+    }
+    // Both views report an edit of a cloned document, only the panel's view is followed; edits it does not see end the Mark
+    if (hScintilla != instance->_hScintilla) {
+        if (instance->send(SCI_GETDOCPOINTER, 0, 0) != instance->lazyMarkDocument) {
+            instance->endLazyMark();
+        }
+        return;
+    }
+    size_t pos = static_cast<size_t>(notifyCode->position);
+    size_t length = static_cast<size_t>(notifyCode->length);
+    bool inserted = (notifyCode->modificationType & SC_MOD_INSERTTEXT) != 0;
+    instance->lazyMarker.replaced(pos, inserted ? 0 : length, inserted ? length : 0);
+}
+
+void MultiReplace::onDocumentClosed() {
+    // The document pointer of a closed file can come back for the next one opened
+    if (instance != nullptr) {
+        instance->matchIndex.clear();
+        instance->liveSearch.clear();
+        instance->liveSearchDocument = 0;
+        instance->dropHits();
+        instance->scheduleHitCount();
+        instance->endLazyMark();
+    }
+}
+
 void MultiReplace::processLog() {
     if (!isWindowOpen) {
         return;
@@ -4524,6 +6977,27 @@ void MultiReplace::onDocumentSwitched() {
             instance->showStatusMessage(L"", RGB(0, 0, 0));
         }
     }
+
+    // A lazy Mark goes on when its document comes back
+    if (instance != nullptr && instance->lazyMarker.isActive() && instance->lazyMarkDocument == instance->send(SCI_GETDOCPOINTER, 0, 0)) {
+        instance->remarkEditedText();
+        instance->paintLazyMarks(false);
+        if (!instance->lazyMarker.isCounted()) {
+            SetTimer(instance->_hSelf, LAZY_COUNT_TIMER, LAZY_COUNT_INTERVAL_MS, NULL);
+        }
+    }
+
+    // The live search and the Hits column follow into the other document
+    if (instance != nullptr && instance->liveSearch.isActive()) {
+        instance->scheduleLiveSearch();
+    }
+    if (instance != nullptr && (!instance->hitsCurrent || instance->hitDocument != instance->send(SCI_GETDOCPOINTER, 0, 0))) {
+        instance->hitsCurrent = false;
+        instance->scheduleHitCount();
+    }
+    if (instance != nullptr) {
+        instance->repaintHits();
+    }
 }
 
 void MultiReplace::onSelectionChanged() {
@@ -4564,6 +7038,41 @@ void MultiReplace::onTextChanged() {
     textModified = true;
 }
 
+void MultiReplace::onViewportChanged() {
+    if (!isWindowOpen || instance == nullptr) {
+        return;
+    }
+
+    if (instance->liveSearch.isActive()) {
+        instance->highlightLiveViewport();
+    }
+    if (instance->lazyMarker.isActive()) {
+        instance->paintLazyMarks(false);
+    }
+
+    // The density strip shows where the view is
+    InvalidateRect(GetDlgItem(instance->_hSelf, IDC_DENSITY_STRIP), NULL, FALSE);
+}
+
+void MultiReplace::onContentChanged() {
+    if (!isWindowOpen || instance == nullptr) {
+        return;
+    }
+
+    // Marks are repaired once per update, after all edits of a keystroke or an undo step
+    if (instance->lazyMarker.isActive()) {
+        instance->remarkEditedText();
+    }
+    instance->recountEditedHits();
+
+    // The live search shows its repaired occurrences once per update as well
+    if (instance->liveSearchEdited) {
+        instance->liveSearchEdited = false;
+        instance->highlightLiveViewport();
+        instance->showLiveSearchCount();
+    }
+}
+
 void MultiReplace::onCaretPositionChanged()
 {
     if (!isWindowOpen || !isCaretPositionEnabled) {
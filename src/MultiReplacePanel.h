@@ -1,4 +1,4 @@
-// This file is part of Notepad++ project
+﻿// This file is part of Notepad++ project
 // Copyright (C)2023 Thomas Knoefel
 // This program is free software: you can redistribute it and/or modify
 // it under the terms of the GNU General Public License as published by
@@ -19,6 +19,21 @@
 #include "StaticDialog/StaticDialog.h"
 #include "StaticDialog/resource.h"
 #include "PluginInterface.h"
+#include "DensityMap.h"
+#include "FuzzyMatcher.h"
+#include "HitCounter.h"
+#include "IncrementalSearch.h"
+#include "LazyMarker.h"
+#include "ListMatcher.h"
+#include "MatchIndex.h"
+#include "ReplaceList.h"
+#include "ProgressDialog.h"
+#include "ProgressScheduler.h"
+#include "PreviewDialog.h"
+#include "FindAllDialog.h"
+#include "ExportMarksDialog.h"
+#include "ReplacePreview.h"
+#include "SearchScope.h"
 
 #include <string>
 #include <vector>
@@ -28,6 +43,7 @@
 #include <algorithm>
 #include <unordered_map>
 #include <set>
+#include <memory>
 #include <commctrl.h>
 #include <lua.hpp>
 
@@ -35,6 +51,7 @@ extern NppData nppData;
 
 enum class DelimiterOperation { LoadAll, Update };
 enum class Direction { Up, Down };
+enum class ListReplaceMode { Sequential, Simultaneous, LeftmostLongest };
 
 struct ReplaceItemData
 {
@@ -46,6 +63,7 @@ struct ReplaceItemData
     bool useVariables = false;
     bool extended = false;
     bool regex = false;
+    int fuzzy = 0;              // Edits an occurrence may differ by in Fuzzy mode, 0 in the other modes
 
     bool operator==(const ReplaceItemData& rhs) const {
         return
@@ -55,12 +73,26 @@ struct ReplaceItemData
             wholeWord == rhs.wholeWord &&
             matchCase == rhs.matchCase &&
             extended == rhs.extended &&
-            regex == rhs.regex;
+            regex == rhs.regex &&
+            fuzzy == rhs.fuzzy;
     }
 
     bool operator!=(const ReplaceItemData& rhs) const {
         return !(*this == rhs);
     }
+
+    // Same search and replace settings, the selection state is ignored
+    bool hasSameContent(const ReplaceItemData& rhs) const {
+        return
+            findText == rhs.findText &&
+            replaceText == rhs.replaceText &&
+            wholeWord == rhs.wholeWord &&
+            matchCase == rhs.matchCase &&
+            useVariables == rhs.useVariables &&
+            extended == rhs.extended &&
+            regex == rhs.regex &&
+            fuzzy == rhs.fuzzy;
+    }
 };
 
 struct ControlInfo
@@ -72,10 +104,10 @@ struct ControlInfo
     LPCWSTR tooltipText;
 };
 
+// Position of a match in the document; its text is read with getMatchText() where it is needed
 struct SearchResult {
     LRESULT pos = -1;
     LRESULT length = 0;
-    std::string foundText = "";
 };
 
 struct SelectionInfo {
@@ -89,6 +121,13 @@ struct SelectionRange {
     LRESULT end = 0;
 };
 
+// A list entry of a running Mark and the ranges its indicator had before the entry added its own
+struct PendingEntry {
+    int style = 0;
+    std::string findTextUtf8;
+    size_t firstRange = 0;
+};
+
 struct ColumnDelimiterData {
     std::set<int> columns;
     std::string extendedDelimiter;
@@ -131,17 +170,17 @@ struct LuaVariables {
     std::string MATCH;
 };
 
-// Exceptions
-class CsvLoadException : public std::exception {
-public:
-    explicit CsvLoadException(const std::string& message) : message_(message) {}
-    const char* what() const noexcept override {
-        return message_.c_str();
-    }
-private:
-    std::string message_;
+struct CompiledReplaceItem {
+    ReplaceItemData source;         // Entry the plan was built from
+    int codepage = -1;              // Document codepage the texts were converted for
+    std::string findTextUtf8;       // Find text as passed to Scintilla
+    std::string replaceTextUtf8;    // Replace text, Lua source if variables are used
+    std::string replaceTextCp;      // Replace text as passed to SCI_REPLACETARGET
+    int searchFlags = 0;
+    int luaChunkRef = LUA_NOREF;    // Precompiled Lua chunk in the registry of luaState
 };
 
+// Exceptions
 class LuaSyntaxException : public std::exception {   
 };
 
@@ -193,6 +232,7 @@ public:
     static bool isLoggingEnabled;
     static bool isCaretPositionEnabled;
     static bool isLuaErrorDialogEnabled;
+    static bool isBatchEditActive;
 
     // Static methods for Event Handling
     static void onSelectionChanged();
@@ -200,7 +240,14 @@ public:
     static void onDocumentSwitched();
     static void processLog();
     static void processTextChange(SCNotification* notifyCode);
+    static void processMatchIndexChange(SCNotification* notifyCode);
+    static void processHitChange(SCNotification* notifyCode);
+    static void processLiveSearchChange(SCNotification* notifyCode);
+    static void processMarkChange(SCNotification* notifyCode);
+    static void onDocumentClosed();
     static void onCaretPositionChanged();
+    static void onViewportChanged();
+    static void onContentChanged();
 
     enum class ChangeType { Insert, Delete, Modify };
 
@@ -220,8 +267,35 @@ private:
     static constexpr const TCHAR* FONT_NAME = TEXT("MS Shell Dlg");
     static constexpr int FONT_SIZE = 16;
     static constexpr long MARKER_COLOR = 0x007F00; // Color for non-list Marker
-    static constexpr LRESULT PROGRESS_THRESHOLD = 50000; // Will show progress bar if total exceeds defined threshold
+    static constexpr LRESULT PROGRESS_THRESHOLD = 50000; // Will show progress bar if total exceeds defined threshold (bytes to search or lines to scan)
+    static constexpr int PROGRESS_SLICE_MS = 100; // Progress is reported, and Cancel checked, once per slice; shorter runs never show the bar
+    static constexpr size_t EDIT_COALESCE_GAP = 4096; // Matches closer than this are rewritten with one range replacement
+    static constexpr size_t EDIT_MAX_SPAN = 1 << 20; // Upper limit for the text covered by one range replacement
+    static constexpr size_t SCAN_CHUNK_LENGTH = 1 << 22; // Minimum text per thread when the list entries are searched in parallel
+    static constexpr LRESULT BACKWARD_CHUNK_LENGTH = 4096; // Text in front of the start a backward search scans first, doubled until a match is found
+    static constexpr LRESULT FORWARD_CHUNK_LENGTH = 65536; // Text behind the start a literal Find Next scans first, doubled until a match is found
+    static constexpr int SEARCH_FUZZY_SHIFT = 24; // Edits of a Fuzzy search are passed in the search flags above the Scintilla ones
+    static constexpr int SEARCH_FUZZY_MASK = 0xF << SEARCH_FUZZY_SHIFT;
+    static constexpr int MAX_FUZZY_DISTANCE = 9; // Upper limit for the edits of a Fuzzy entry
+    static constexpr size_t MATCH_INDEX_REPAIR_LIMIT = 1 << 26; // Index entries moved by edits between two list searches before the index is dropped and rebuilt
+    static constexpr UINT_PTR LIVE_SEARCH_TIMER = 1; // Timer of the search that follows typing in the Find field
+    static constexpr UINT LIVE_SEARCH_DELAY_MS = 250; // Pause in typing before the live search runs
+    static constexpr LRESULT LIVE_VIEW_MAX_LENGTH = 1 << 20; // Upper limit for the visible text the live search highlights
+    static constexpr long LIVE_SEARCH_COLOR = 0x00A5FF; // Color of the live search highlighting
+    static constexpr UINT_PTR HIT_COUNT_TIMER = 2; // Timer of the background count for the Hits column
+    static constexpr UINT HIT_COUNT_DELAY_MS = 500; // Pause after list or document changes before the hits are counted again
+    static constexpr UINT WM_HITS_COUNTED = WM_APP + 1; // Posted by the hit count worker, wParam is the count generation
+    static constexpr int HITS_COLUMN_WIDTH = 55;
+    static constexpr int DENSITY_STRIP_WIDTH = 12; // Match density strip beside the list
+    static constexpr LRESULT LAZY_MARK_THRESHOLD = 1 << 26; // Larger documents are marked as the view reaches the text
+    static constexpr LRESULT LAZY_MARK_MARGIN = 1 << 16; // Text above and below the view marked in advance
+    static constexpr UINT_PTR LAZY_COUNT_TIMER = 3; // Timer of the count behind a lazy Mark
+    static constexpr UINT LAZY_COUNT_INTERVAL_MS = 10;
+    static constexpr size_t LAZY_COUNT_SLICE = 1 << 25; // Text counted per timer tick
+    static constexpr LRESULT EXPORT_PIECE_LENGTH = 1 << 20; // Text of a marked block read at once by an export
     bool isReplaceOnceInList = false;            // When set, replacement stops after the first match in list and the next list entry gets activated.
+    bool useSinglePassList = true;               // Replace All applies literal entries in one pass over the buffer; off forces one Scintilla sweep per entry.
+    ListReplaceMode listReplaceMode = ListReplaceMode::Sequential; // Simultaneous modes match all entries against the original text only.
 
     // Static variables related to GUI 
     static HWND s_hScintilla;
@@ -258,6 +332,13 @@ private:
     size_t markedStringsCount = 0;
     bool allSelected = true;
     std::unordered_map<long, int> colorToStyleMap;
+    std::map<int, std::vector<SelectionRange>> pendingMarks; // Ranges of the running Mark per indicator, filled when it ends
+    std::vector<PendingEntry> pendingEntries;                 // Entries of the running Mark in the order their ranges were added
+    std::map<int, std::vector<std::string>> markEntries;      // Entries with marks per indicator, for the Entry column of an export
+    MarkedTextFormat exportFormat = MarkedTextFormat::Lines;
+    bool exportToFile = true;
+    LazyMarker lazyMarker;                                    // Mark of literal entries, repaired after edits and in very large documents filled where the view goes
+    sptr_t lazyMarkDocument = 0;
     int lastColumn = -1;
     bool ascending = true;
     ColumnDelimiterData columnDelimiterData;
@@ -267,12 +348,79 @@ private:
     bool isColumnHighlighted = false;
     std::map<int, bool> stateSnapshot; // stores the state of the Elements
 
+    // Compiled replace plans, rebuilt only if an entry or the document codepage changes
+    std::vector<CompiledReplaceItem> compiledListData; // Parallel to replaceListData
+    CompiledReplaceItem compiledFieldItem;             // Find and Replace fields
+    ListMatcher listMatcher;                           // Automaton of the literal list entries
+    std::vector<ReplaceItemData> listMatcherSource;    // Entries the automaton was built from
+    std::vector<std::string> listMatcherReplacements;
+    int listMatcherCodepage = -1;
+
+    // Positions of the literal list entries for list Find Next and Find Previous, repaired on every edit
+    MatchIndex matchIndex;
+    ListMatcher matchIndexMatcher;
+    std::vector<ReplaceItemData> matchIndexSource;  // List the index was built for, with selection state
+    std::vector<int> matchIndexPatterns;            // Parallel to matchIndexSource, matcher pattern or -1 for entries searched one by one
+    CharClass matchIndexClasses[256] = {};
+    HWND matchIndexScintilla = nullptr;
+    sptr_t matchIndexDocument = 0;
+    int matchIndexCodepage = -1;
+    size_t matchIndexLength = 0;                    // Document length after the repaired edits
+    size_t matchIndexMoved = 0;                     // Entries moved by edits since the last list search
+    lua_State* luaState = nullptr;                     // Shared by all 'Use Variables' evaluations
+
+    // Matcher of the last single Fuzzy search, kept for Find Next and Replace All asking for the same text again
+    FuzzyMatcher searchFuzzyMatcher;
+    std::string searchFuzzyText;
+    int searchFuzzyFlags = 0;
+    int searchFuzzyCodepage = -1;
+
+    // Hits column: occurrences of the literal entries in the whole document, counted in the background
+    HitCounter hitCounter;
+    MatchIndex hitIndex;                                        // Positions of the counted occurrences if not too many, repaired on edits
+    ListMatcher hitMatcher;
+    std::unordered_map<std::wstring, size_t> hitPatternOfKey;   // Search settings of an entry to its pattern, SIZE_MAX if not counted
+    DensityMap hitDensity;                                      // Occurrences per pattern and stretch of the document, repaired on edits
+    HWND hitScintilla = nullptr;
+    sptr_t hitDocument = 0;
+    bool hitsCurrent = false;                                   // Counts belong to the current text of hitDocument
+    size_t hitIndexMoved = 0;
+    WPARAM hitGeneration = 0;                                   // Count whose result is awaited
+    ListMatcher hitPendingMatcher;                              // Running count
+    std::unordered_map<std::wstring, size_t> hitPendingKeys;
+    sptr_t hitPendingDocument = 0;
+    bool hitEditedWhileCounting = false;
+
+    // Search as you type: occurrences of the Find field, highlighted in the visible text only
+    IncrementalSearch liveSearch;
+    int liveSearchIndicator = -1;   // Allocated from Notepad++, -1 if it has none to give
+    sptr_t liveSearchDocument = 0;
+    bool liveSearchEdited = false;  // Occurrences repaired since the last update of the view
+    LRESULT liveHighlightStart = 0; // Text highlighted last, moved along with edits
+    LRESULT liveHighlightEnd = 0;
+
+    // Batch edit session around Replace All
+    bool batchLoggingSuspended = false;   // Change log is off, the delimiter index is rebuilt at the end
+    LRESULT batchFirstDirtyLine = -1;     // First line whose column highlighting was deferred
+    Sci_Position batchCaretPos = -1;      // Caret position after the last replacement
+    SearchScope searchScope;              // Selections or cells of the running Replace All or Mark, moved along with the replacements
+
+    // Progress of long running operations
+    std::unique_ptr<ProgressScheduler> progressScheduler;
+    std::unique_ptr<ProgressDialog> progressDialog;
+    int progressNesting = 0;              // Operations started while another one reports progress
+    size_t progressOffset = 0;            // Units finished by earlier list entries
+    size_t progressMatches = 0;           // Matches of earlier list entries
+
     // Debugging and logging related 
     std::string messageBoxContent;  // just for temporary debugging usage
 
     // Scintilla related 
     SciFnDirect pSciMsg = nullptr;
     sptr_t pSciWndData = 0;
+#ifdef _DEBUG
+    size_t sciMessageCount = 0; // Messages sent through send(), reported per Replace All
+#endif
 
     // GUI control-related constants
     const std::vector<int> selectionRadioDisabledButtons = {
@@ -311,36 +459,109 @@ private:
 
     //Replace
     void handleReplaceAllButton();
+    void handlePreviewReplaceAllButton();
     void handleReplaceButton();
     int replaceAll(const ReplaceItemData& itemData);
+    // Entries are passed in place: list entries keep their compiled slot, the whole list its cached automaton
+    bool replaceAllSinglePass(const ReplaceItemData* items, size_t itemCount, int& replaceCount);
+    bool isWholeList(const ReplaceItemData* items, size_t itemCount) const;
+    bool buildListMatcher(const ReplaceItemData* items, size_t itemCount, ListMatcher& matcher, std::vector<std::string>& replacements, int codepage, bool cached);
+    CompiledReplaceItem& getCompiledItem(const ReplaceItemData& itemData);
+    void releaseCompiledItem(CompiledReplaceItem& item);
+    void clearCompiledItems();
+    std::vector<ListMatch> selectSimultaneousMatches(const ListMatcher& matcher, std::vector<ListMatch> candidates);
+    void readCharClasses(CharClass classes[256]);
+    void findListMatches(const ListMatcher& matcher, std::vector<ListMatch>& matches);
+    bool updateMatchIndex(const std::vector<ReplaceItemData>& list);
+    void repairMatchIndex(const SCNotification* notifyCode);
+    void scheduleHitCount();
+    void scheduleHitCountOfNewEntries();
+    void startHitCount();
+    void finishHitCount(WPARAM generation);
+    void repairHitIndex(const SCNotification* notifyCode);
+    void recountEditedHits();
+    void recountHits();
+    void dropHits();
+    void repaintHits();
+    bool readHits(const ReplaceItemData& itemData, size_t& hits);
+    bool isDensityShown();
+    size_t densityEntry();
+    void drawDensityStrip(const DRAWITEMSTRUCT* drawItem);
+    void handleDensityStripClick();
+    bool findDensityOccurrence(size_t bucket, size_t entry, size_t pos, bool before, ListMatch& match);
+    void beginBatchEdit();
+    void endBatchEdit(bool rollback);
+    void setCaretAfterReplace(Sci_Position pos);
     bool replaceOne(const ReplaceItemData& itemData, const SelectionInfo& selection, SearchResult& searchResult, Sci_Position& newPos);
-    Sci_Position performReplace(const std::string& replaceTextUtf8, Sci_Position pos, Sci_Position length);
-    Sci_Position performRegexReplace(const std::string& replaceTextUtf8, Sci_Position pos, Sci_Position length);
+    Sci_Position performReplace(const std::string& replaceTextCp, Sci_Position pos, Sci_Position length);
+    Sci_Position performRegexReplace(const std::string& replaceTextCp, Sci_Position pos, Sci_Position length);
     SelectionInfo getSelectionInfo();
-    bool resolveLuaSyntax(std::string& inputString, const LuaVariables& vars, bool& skip, bool regex);
+    lua_State* getLuaState();
+    void closeLuaState();
+    bool resolveLuaSyntax(CompiledReplaceItem& item, std::string& result, const LuaVariables& vars, bool& skip);
     void setLuaVariable(lua_State* L, const std::string& varName, std::string value);
 
     //Find
     void handleFindNextButton();
     void handleFindPrevButton();
+    std::string getMatchText(const SearchResult& result);
     SearchResult performSingleSearch(const std::string& findTextUtf8, int searchFlags, bool selectMatch, SelectionRange range);
     SearchResult performSearchForward(const std::string& findTextUtf8, int searchFlags, bool selectMatch, LRESULT start);
+    SearchResult performScopeSearch(SearchScope& scope, const std::string& findTextUtf8, int searchFlags, bool selectMatch, LRESULT start);
     SearchResult performSearchBackward(const std::string& findTextUtf8, int searchFlags, LRESULT start);
+    SearchResult performChunkedSearchForward(const ListMatcher& matcher, SelectionRange range);
+    SearchResult performChunkedSearchBackward(const std::string& findTextUtf8, int searchFlags, const ListMatcher* matcher, SelectionRange range);
+    SearchResult findLastInChunk(const std::string& findTextUtf8, int searchFlags, LRESULT chunkStart, LRESULT chunkEnd);
+    bool buildSearchMatcher(const std::string& findTextUtf8, int searchFlags, ListMatcher& matcher);
     SearchResult performListSearchForward(const std::vector<ReplaceItemData>& list, LRESULT cursorPos);
     SearchResult performListSearchBackward(const std::vector<ReplaceItemData>& list, LRESULT cursorPos);
+    void handleFindAllButton();
+    void collectStringMatches(const std::string& findTextUtf8, int searchFlags, size_t entry, std::vector<ListMatch>& matches);
+    SearchResult findFuzzyInRange(const std::string& findTextUtf8, int searchFlags, LRESULT start, LRESULT end, bool last);
+    bool makeFuzzyPattern(const std::string& findTextUtf8, int searchFlags, int codepage, FuzzyPattern& pattern);
+    int readFuzzyDistance();
+    void scheduleLiveSearch();
+    void runLiveSearch();
+    void highlightLiveViewport();
+    void showLiveSearchCount();
+    void repairLiveSearch(const SCNotification* notifyCode);
+    void clearLiveSearch();
 
     //Mark
     void handleMarkMatchesButton();
+    int markListEntries();
+    void collectLiteralPatterns(const std::vector<ReplaceItemData>& items, std::vector<ListPattern>& patterns, std::vector<int>& patternOfEntry);
+    std::vector<ListMatch> findLiteralMatches(const std::vector<ListPattern>& patterns);
+    void collectFuzzyPatterns(const std::vector<ReplaceItemData>& items, std::vector<FuzzyPattern>& patterns, std::vector<int>& patternOfEntry);
+    std::vector<ListMatch> findFuzzyMatches(const std::vector<FuzzyPattern>& patterns);
     int markString(const std::string& findTextUtf8, int searchFlags);
-    void highlightTextRange(LRESULT pos, LRESULT len, const std::string& findTextUtf8);
+    int markLiteralString(const std::string& findTextUtf8, bool wholeWord, bool matchCase);
+    std::vector<SelectionRange>& beginMarks(const std::string& findTextUtf8);
+    void fillMarks();
+    bool canFollowMarks(const std::vector<ListPattern>& patterns);
+    void startMarkSession(const std::vector<ListPattern>& patterns);
+    bool startLazyMark(const std::vector<ListPattern>& patterns);
+    void followMarks(const std::vector<ListPattern>& patterns, size_t occurrences);
+    ListMatcher::TextReader documentReader();
+    void paintLazyMarks(bool wholeDocument);
+    void remarkEditedText();
+    void continueLazyCount();
+    void endLazyMark();
     long generateColorValue(const std::string& str);
     void handleClearTextMarksButton();
     void handleCopyMarkedTextToClipboardButton();
+    void handleExportMarkedTextButton();
+    void copyMarkedTextToClipboard(MarkedTextFormat format);
+    void exportMarkedTextToFile(const std::wstring& filePath, MarkedTextFormat format);
+    bool writeMarkedText(MarkedTextWriter& writer, size_t progressBase);
+    bool findMarkedRun(int style, LRESULT pos, LRESULT& start, LRESULT& end);
+    bool hasMarkedText();
 
     //Scope
     bool parseColumnAndDelimiterData();
-    void findAllDelimitersInDocument();
+    bool findAllDelimitersInDocument();
     void findDelimitersInLine(LRESULT line);
+    LineInfo scanDelimitersInLine(LRESULT line);
     ColumnInfo getColumnInfo(LRESULT startPosition);
     void initializeColumnStyles();
     void handleHighlightColumnsInDocument();
@@ -349,12 +570,18 @@ private:
     std::wstring addLineAndColumnMessage(LRESULT pos);
     void updateDelimitersInDocument(SIZE_T lineNumber, ChangeType changeType);
     void processLogForDelimiters();
-    void handleDelimiterPositions(DelimiterOperation operation);
+    bool handleDelimiterPositions(DelimiterOperation operation);
     void handleClearDelimiterState();
+    std::vector<SelectionRange> getScopeRanges();
+    std::vector<ScopeRange> readSelections();
+    void appendColumnCells(const LineInfo& lineInfo, std::vector<ScopeRange>& cells);
+    void captureSearchScope();
+    void releaseSearchScope();
+    void updateSearchScope(Sci_Position pos, Sci_Position length, Sci_Position newLength, bool layoutChanged);
+    bool changesColumnLayout(Sci_Position pos, Sci_Position length);
     //void displayLogChangesInMessageBox();
 
     //Utilities
-    int convertExtendedToString(const std::string& query, std::string& result);
     std::string convertAndExtend(const std::wstring& input, bool extended);
     static void addStringToComboBoxHistory(HWND hComboBox, const std::wstring& str, int maxItems = 10);
     std::wstring getTextFromDialogItem(HWND hwnd, int itemID);
@@ -366,6 +593,10 @@ private:
     LRESULT updateEOLLength();
     void setElementsState(const std::vector<int>& elements, bool enable);
     sptr_t send(unsigned int iMessage, uptr_t wParam = 0, sptr_t lParam = 0, bool useDirect = true);
+    void beginProgress(const std::wstring& title, size_t total);
+    bool updateProgress(size_t done, size_t matches, size_t bytes);
+    bool isProgressCancelled() const;
+    bool endProgress();
     bool MultiReplace::normalizeAndValidateNumber(std::string& str);
 
     //StringHandling
@@ -0,0 +1,163 @@
+//this file is part of notepad++
+//Copyright (C)2023 Thomas Knoefel
+//
+//This program is free software; you can redistribute it and/or
+//modify it under the terms of the GNU General Public License
+//as published by the Free Software Foundation; either
+//version 2 of the License, or (at your option) any later version.
+//
+//This program is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//GNU General Public License for more details.
+//
+//You should have received a copy of the GNU General Public License
+//along with this program; if not, write to the Free Software
+//Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+#include <windows.h>
+#include <cstdio>
+#include "StaticDialog/resource.h"
+#include "PreviewDialog.h"
+#include "ProgressDialog.h"
+
+static const size_t PREVIEW_LINES_PER_PAGE = 50;
+static const size_t PREVIEW_MAX_LINE_LENGTH = 500;  // Longer lines are cut in the display
+
+PreviewDialog::PreviewDialog(HWND owner, HWND panel, ReplacePreview& preview, const char* text, size_t textLength, int codepage)
+    : _hOwner(owner), _hPanel(panel), _preview(preview), _text(text), _textLength(textLength), _codepage(codepage)
+{
+}
+
+void PreviewDialog::show(const std::wstring& summary, const std::wstring& entryCounts)
+{
+    _summary = summary;
+    _entryCounts = entryCounts;
+    _pageIndex = 0;
+
+    runModalDialog(_hOwner, _hPanel, IDD_PREVIEW_DIALOG, dlgProc, reinterpret_cast<LPARAM>(this));
+}
+
+INT_PTR CALLBACK PreviewDialog::dlgProc(HWND hwnd, UINT message, WPARAM wParam, LPARAM lParam)
+{
+    PreviewDialog* dialog = reinterpret_cast<PreviewDialog*>(GetWindowLongPtr(hwnd, GWLP_USERDATA));
+
+    switch (message)
+    {
+    case WM_INITDIALOG:
+    {
+        SetWindowLongPtr(hwnd, GWLP_USERDATA, lParam);
+        dialog = reinterpret_cast<PreviewDialog*>(lParam);
+        dialog->_hDiffFont = CreateFont(14, 0, 0, 0, FW_NORMAL, FALSE, FALSE, FALSE, DEFAULT_CHARSET, 0, 0, 0, 0, TEXT("Courier New"));
+        SendDlgItemMessage(hwnd, IDC_PREVIEW_DIFF_EDIT, WM_SETFONT, (WPARAM)dialog->_hDiffFont, TRUE);
+        SetDlgItemText(hwnd, IDC_PREVIEW_SUMMARY_STATIC, dialog->_summary.c_str());
+        SetDlgItemText(hwnd, IDC_PREVIEW_COUNTS_EDIT, dialog->_entryCounts.c_str());
+        dialog->showPage(hwnd, 0);
+        return TRUE;
+    }
+
+    case WM_COMMAND:
+        switch (LOWORD(wParam))
+        {
+        case IDC_PREVIEW_PREV_BUTTON:
+            if (dialog->_pageIndex > 0) {
+                dialog->showPage(hwnd, dialog->_pageIndex - 1);
+            }
+            return TRUE;
+
+        case IDC_PREVIEW_NEXT_BUTTON:
+            dialog->showPage(hwnd, dialog->_pageIndex + 1);
+            return TRUE;
+
+        case IDOK:
+        case IDCANCEL:
+            EndDialog(hwnd, LOWORD(wParam));
+            return TRUE;
+        }
+        break;
+
+    case WM_DESTROY:
+        if (dialog != nullptr && dialog->_hDiffFont != nullptr) {
+            DeleteObject(dialog->_hDiffFont);
+            dialog->_hDiffFont = nullptr;
+        }
+        break;
+    }
+
+    return FALSE;
+}
+
+void PreviewDialog::showPage(HWND hwnd, size_t pageIndex)
+{
+    std::vector<PreviewLine> lines;
+    bool found = _preview.page(_text, _textLength, pageIndex, PREVIEW_LINES_PER_PAGE, lines);
+    if (!found && pageIndex > 0) {
+        return;
+    }
+    _pageIndex = pageIndex;
+
+    std::wstring diff;
+    if (!_preview.hasDiff()) {
+        diff = L"No line view available: a chained entry adds or removes line breaks.";
+    }
+    else if (lines.empty()) {
+        diff = L"No lines would change.";
+    }
+    for (const PreviewLine& line : lines) {
+        wchar_t header[64];
+        if (line.lineCount > 1) {
+            swprintf(header, 64, L"Lines %zu-%zu\r\n", line.lineNumber + 1, line.lineNumber + line.lineCount);
+        }
+        else {
+            swprintf(header, 64, L"Line %zu\r\n", line.lineNumber + 1);
+        }
+        diff += header;
+        diff += L"- " + toDisplayText(line.before) + L"\r\n";
+        diff += L"+ " + toDisplayText(line.after) + L"\r\n\r\n";
+    }
+    SetDlgItemText(hwnd, IDC_PREVIEW_DIFF_EDIT, diff.c_str());
+
+    // Asking for the following page computes it now, so Next is only offered when there is one
+    std::vector<PreviewLine> nextLines;
+    bool hasNext = found && _preview.page(_text, _textLength, pageIndex + 1, PREVIEW_LINES_PER_PAGE, nextLines);
+    EnableWindow(GetDlgItem(hwnd, IDC_PREVIEW_PREV_BUTTON), pageIndex > 0);
+    EnableWindow(GetDlgItem(hwnd, IDC_PREVIEW_NEXT_BUTTON), hasNext);
+
+    wchar_t pageText[64];
+    swprintf(pageText, 64, L"Page %zu%s", pageIndex + 1, hasNext ? L"" : L" (last)");
+    SetDlgItemText(hwnd, IDC_PREVIEW_PAGE_STATIC, found ? pageText : L"");
+}
+
+std::wstring PreviewDialog::toDisplayText(const std::string& line) const
+{
+    std::string text = line;
+    if (!text.empty() && text.back() == '\r') {
+        text.pop_back();
+    }
+    bool cut = text.size() > PREVIEW_MAX_LINE_LENGTH;
+    if (cut) {
+        text.resize(PREVIEW_MAX_LINE_LENGTH);
+    }
+
+    int codepage = (_codepage == 0) ? CP_ACP : _codepage;
+    std::wstring result;
+    int length = MultiByteToWideChar(codepage, 0, text.data(), static_cast<int>(text.size()), NULL, 0);
+    if (length > 0) {
+        result.resize(static_cast<size_t>(length));
+        MultiByteToWideChar(codepage, 0, text.data(), static_cast<int>(text.size()), &result[0], length);
+    }
+
+    // Line breaks inside an occurrence are shown as a symbol, the edit control would start a new line
+    for (wchar_t& ch : result) {
+        if (ch == L'\n') {
+            ch = L'\u21B5';
+        }
+        else if (ch == L'\r') {
+            ch = L' ';
+        }
+    }
+    if (cut) {
+        result += L"...";
+    }
+    return result;
+}
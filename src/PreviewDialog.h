@@ -0,0 +1,51 @@
+//this file is part of notepad++
+//Copyright (C)2023 Thomas Knoefel
+//
+//This program is free software; you can redistribute it and/or
+//modify it under the terms of the GNU General Public License
+//as published by the Free Software Foundation; either
+//version 2 of the License, or (at your option) any later version.
+//
+//This program is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//GNU General Public License for more details.
+//
+//You should have received a copy of the GNU General Public License
+//along with this program; if not, write to the Free Software
+//Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+#pragma once
+
+#include <windows.h>
+#include <string>
+#include <vector>
+#include "ReplacePreview.h"
+extern HINSTANCE hInst;
+
+// Modal result window of a dry run: hit counts per entry and the affected lines page by page.
+// Pages are built when they are first shown; Notepad++ and the panel are disabled meanwhile, so the document stays as it was.
+class PreviewDialog
+{
+public:
+    PreviewDialog(HWND owner, HWND panel, ReplacePreview& preview, const char* text, size_t textLength, int codepage);
+
+    void show(const std::wstring& summary, const std::wstring& entryCounts);
+
+private:
+    HWND _hOwner;
+    HWND _hPanel;
+    ReplacePreview& _preview;
+    const char* _text;
+    size_t _textLength;
+    int _codepage;
+    std::wstring _summary;
+    std::wstring _entryCounts;
+    size_t _pageIndex = 0;
+    HFONT _hDiffFont = nullptr;
+
+    void showPage(HWND hwnd, size_t pageIndex);
+    std::wstring toDisplayText(const std::string& line) const;
+
+    static INT_PTR CALLBACK dlgProc(HWND hwnd, UINT message, WPARAM wParam, LPARAM lParam);
+};
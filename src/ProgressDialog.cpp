@@ -0,0 +1,125 @@
+//this file is part of notepad++
+//Copyright (C)2023 Thomas Knoefel
+//
+//This program is free software; you can redistribute it and/or
+//modify it under the terms of the GNU General Public License
+//as published by the Free Software Foundation; either
+//version 2 of the License, or (at your option) any later version.
+//
+//This program is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//GNU General Public License for more details.
+//
+//You should have received a copy of the GNU General Public License
+//along with this program; if not, write to the Free Software
+//Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+#include <windows.h>
+#include <commctrl.h>
+#include <cstdio>
+#include "StaticDialog/resource.h"
+#include "ProgressDialog.h"
+
+ProgressDialog::ProgressDialog(HWND owner, HWND panel, const std::wstring& title, ProgressScheduler& scheduler)
+    : _hOwner(owner), _hPanel(panel), _title(title), _scheduler(scheduler)
+{
+}
+
+ProgressDialog::~ProgressDialog()
+{
+    close();
+}
+
+INT_PTR CALLBACK ProgressDialog::dlgProc(HWND hwnd, UINT message, WPARAM wParam, LPARAM lParam)
+{
+    switch (message)
+    {
+    case WM_INITDIALOG:
+    {
+        SetWindowLongPtr(hwnd, GWLP_USERDATA, lParam);
+        SendDlgItemMessage(hwnd, IDC_PROGRESS_BAR, PBM_SETRANGE32, 0, 1000);
+        return TRUE;
+    }
+
+    case WM_COMMAND:
+        if (LOWORD(wParam) != IDCANCEL) {
+            break;
+        }
+        // fall through
+    case WM_CLOSE:
+    {
+        ProgressScheduler* scheduler = reinterpret_cast<ProgressScheduler*>(GetWindowLongPtr(hwnd, GWLP_USERDATA));
+        if (scheduler != nullptr) {
+            scheduler->cancel();
+        }
+        EnableWindow(GetDlgItem(hwnd, IDCANCEL), FALSE);
+        SetDlgItemText(hwnd, IDC_PROGRESS_STATIC, L"Cancelling...");
+        return TRUE;
+    }
+    }
+
+    return FALSE;
+}
+
+void ProgressDialog::report(const ProgressInfo& info)
+{
+    if (_hSelf == nullptr) {
+        _hSelf = CreateDialogParam(hInst, MAKEINTRESOURCE(IDD_PROGRESS_DIALOG), _hOwner, dlgProc, reinterpret_cast<LPARAM>(&_scheduler));
+        if (_hSelf == nullptr) {
+            return;
+        }
+        SetWindowText(_hSelf, _title.c_str());
+        EnableWindow(_hOwner, FALSE);
+        EnableWindow(_hPanel, FALSE);
+        ShowWindow(_hSelf, SW_SHOW);
+    }
+
+    if (!_scheduler.isCancelled()) {
+        size_t total = (info.total > 0) ? info.total : 1;
+        WPARAM permille = static_cast<WPARAM>((info.done >= total) ? 1000 : info.done * 1000 / total);
+        SendDlgItemMessage(_hSelf, IDC_PROGRESS_BAR, PBM_SETPOS, permille, 0);
+
+        wchar_t text[128];
+        swprintf(text, 128, L"%zu matches, %.1f MB  (%.0f matches/s, %.1f MB/s)",
+            info.matches, info.bytes / (1024.0 * 1024.0), info.matchesPerSecond(), info.megabytesPerSecond());
+        SetDlgItemText(_hSelf, IDC_PROGRESS_STATIC, text);
+    }
+
+    // Owner windows are disabled, so user input only reaches this dialog
+    MSG msg;
+    while (PeekMessage(&msg, NULL, 0, 0, PM_REMOVE)) {
+        if (msg.message == WM_QUIT) {
+            _scheduler.cancel();
+            PostQuitMessage(static_cast<int>(msg.wParam));
+            break;
+        }
+        if (!IsDialogMessage(_hSelf, &msg)) {
+            TranslateMessage(&msg);
+            DispatchMessage(&msg);
+        }
+    }
+}
+
+void ProgressDialog::close()
+{
+    if (_hSelf == nullptr) {
+        return;
+    }
+
+    // Re-enable the owners first, otherwise Windows activates some other application
+    EnableWindow(_hOwner, TRUE);
+    EnableWindow(_hPanel, TRUE);
+    DestroyWindow(_hSelf);
+    _hSelf = nullptr;
+    SetActiveWindow(_hPanel);
+}
+
+INT_PTR runModalDialog(HWND owner, HWND panel, int templateId, DLGPROC dlgProc, LPARAM param)
+{
+    EnableWindow(panel, FALSE);
+    INT_PTR result = DialogBoxParam(hInst, MAKEINTRESOURCE(templateId), owner, dlgProc, param);
+    EnableWindow(panel, TRUE);
+    SetActiveWindow(panel);
+    return result;
+}
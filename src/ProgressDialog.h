@@ -0,0 +1,49 @@
+//this file is part of notepad++
+//Copyright (C)2023 Thomas Knoefel
+//
+//This program is free software; you can redistribute it and/or
+//modify it under the terms of the GNU General Public License
+//as published by the Free Software Foundation; either
+//version 2 of the License, or (at your option) any later version.
+//
+//This program is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//GNU General Public License for more details.
+//
+//You should have received a copy of the GNU General Public License
+//along with this program; if not, write to the Free Software
+//Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+#pragma once
+
+#include <windows.h>
+#include <string>
+#include "ProgressScheduler.h"
+extern HINSTANCE hInst;
+
+// Modeless progress window with a Cancel button, shown on the first report of a long run.
+// Notepad++ and the panel are disabled while it is open, so only the running operation changes the document.
+class ProgressDialog
+{
+public:
+    ProgressDialog(HWND owner, HWND panel, const std::wstring& title, ProgressScheduler& scheduler);
+    ~ProgressDialog();
+
+    // Updates bar and throughput, then processes pending messages (repaint, Cancel click)
+    void report(const ProgressInfo& info);
+    void close();
+
+private:
+    HWND _hOwner;
+    HWND _hPanel;
+    HWND _hSelf = nullptr;
+    std::wstring _title;
+    ProgressScheduler& _scheduler;
+
+    static INT_PTR CALLBACK dlgProc(HWND hwnd, UINT message, WPARAM wParam, LPARAM lParam);
+};
+
+// Shows a modal dialog over Notepad++ and the panel and returns its result. The dialog box disables its owner,
+// the panel is disabled separately and active again once the dialog is closed.
+INT_PTR runModalDialog(HWND owner, HWND panel, int templateId, DLGPROC dlgProc, LPARAM param);
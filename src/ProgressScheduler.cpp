@@ -0,0 +1,42 @@
+// This file is part of Notepad++ project
+// Copyright (C)2023 Thomas Knoefel
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "ProgressScheduler.h"
+
+ProgressScheduler::ProgressScheduler(size_t total, size_t threshold, std::chrono::milliseconds slice, ReportFunction report)
+    : slice(slice), report(std::move(report)) {
+    info.total = total;
+    reporting = (total > threshold) && static_cast<bool>(this->report);
+    startTime = std::chrono::steady_clock::now();
+    nextReport = startTime + slice;
+}
+
+bool ProgressScheduler::update(size_t done, size_t matches, size_t bytes) {
+    info.done = done;
+    info.matches = matches;
+    info.bytes = bytes;
+
+    if (reporting && !cancelled) {
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        if (now >= nextReport) {
+            info.seconds = std::chrono::duration<double>(now - startTime).count();
+            report(info);
+            nextReport = std::chrono::steady_clock::now() + slice;
+        }
+    }
+
+    return !cancelled;
+}
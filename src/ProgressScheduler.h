@@ -0,0 +1,68 @@
+// This file is part of Notepad++ project
+// Copyright (C)2023 Thomas Knoefel
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef PROGRESS_SCHEDULER_H
+#define PROGRESS_SCHEDULER_H
+
+// Splits a long running loop into time slices. After each slice the host gets a
+// progress report (to repaint and to process a Cancel click) and the loop learns
+// whether it has to stop. No Win32 in here, the host side lives in ProgressDialog.
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+
+struct ProgressInfo {
+    size_t done = 0;        // Units of work finished (lines, matches, ...)
+    size_t total = 0;
+    size_t matches = 0;
+    size_t bytes = 0;       // Text processed so far
+    double seconds = 0.0;
+
+    double matchesPerSecond() const { return seconds > 0.0 ? matches / seconds : 0.0; }
+    double megabytesPerSecond() const { return seconds > 0.0 ? bytes / (seconds * 1024.0 * 1024.0) : 0.0; }
+};
+
+class ProgressScheduler
+{
+public:
+    using ReportFunction = std::function<void(const ProgressInfo&)>;
+
+    // Runs with no more than threshold units are never reported, they just run through.
+    // Otherwise report is called at most once per slice, from the thread calling update().
+    ProgressScheduler(size_t total, size_t threshold, std::chrono::milliseconds slice, ReportFunction report);
+
+    // Called by the loop after every step. Returns false once cancel() was requested.
+    bool update(size_t done, size_t matches, size_t bytes);
+
+    // Safe to call from any thread and from within the report function
+    void cancel() { cancelled = true; }
+    bool isCancelled() const { return cancelled; }
+
+    bool isReporting() const { return reporting; }
+    const ProgressInfo& progress() const { return info; }
+
+private:
+    ProgressInfo info;
+    bool reporting = false;
+    std::chrono::steady_clock::duration slice;
+    std::chrono::steady_clock::time_point startTime;
+    std::chrono::steady_clock::time_point nextReport;
+    ReportFunction report;
+    std::atomic<bool> cancelled{ false };
+};
+
+#endif // PROGRESS_SCHEDULER_H
@@ -0,0 +1,253 @@
+// This file is part of Notepad++ project
+// Copyright (C)2023 Thomas Knoefel
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "ReplaceList.h"
+
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+static std::string unescapeCsvField(const std::string& value) {
+    std::string unescapedValue;
+
+    // If the value starts and ends with double quotes, remove them.
+    size_t start = (value.size() > 1 && value[0] == '"' && value[value.size() - 1] == '"') ? 1 : 0;
+    size_t end = (start == 1) ? value.size() - 1 : value.size();
+
+    bool wasPreviousCharQuote = false;
+    for (size_t i = start; i < end; ++i) {
+        if (value[i] == '"') {
+            if (wasPreviousCharQuote) {
+                wasPreviousCharQuote = false;
+                continue;
+            }
+            wasPreviousCharQuote = true;
+        }
+        else {
+            wasPreviousCharQuote = false;
+        }
+
+        unescapedValue += value[i];
+    }
+
+    return unescapedValue;
+}
+
+void parseReplaceListCsv(const std::string& content, const std::string& fileName, std::vector<ReplaceListEntry>& list) {
+    std::vector<ReplaceListEntry> tempList;
+
+    // Quotes and separators are ASCII, so the UTF-8 bytes can be split directly. A line break inside quotes
+    // belongs to the field.
+    std::vector<std::string> columns;
+    std::string currentValue;
+    bool insideQuotes = false;
+    size_t pos = content.find('\n');  // Skip the CSV header
+    if (pos == std::string::npos) {
+        pos = content.size();
+    }
+    for (++pos; pos <= content.size(); ++pos) {
+        char ch = (pos < content.size()) ? content[pos] : '\n';
+        if (ch == '"') {
+            insideQuotes = !insideQuotes;
+        }
+        if (ch == ',' && !insideQuotes) {
+            columns.push_back(unescapeCsvField(currentValue));
+            currentValue.clear();
+            continue;
+        }
+        if (ch != '\n' || (insideQuotes && pos < content.size())) {
+            currentValue += ch;
+            continue;
+        }
+
+        // End of a row; a final line break does not start another one
+        if (!currentValue.empty() && currentValue.back() == '\r') {
+            currentValue.pop_back();
+        }
+        if (pos == content.size() && columns.empty() && currentValue.empty()) {
+            break;
+        }
+        columns.push_back(unescapeCsvField(currentValue));
+        currentValue.clear();
+        insideQuotes = false;
+
+        if (columns.size() != 8 && columns.size() != 9) {
+            throw CsvLoadException("Invalid number of columns in CSV file '" + fileName + "'.");
+        }
+
+        ReplaceListEntry item;
+        try {
+            item.isSelected = std::stoi(columns[0]) != 0;
+            item.findText = columns[1];
+            item.replaceText = columns[2];
+            item.wholeWord = std::stoi(columns[3]) != 0;
+            item.matchCase = std::stoi(columns[4]) != 0;
+            item.useVariables = std::stoi(columns[5]) != 0;
+            item.extended = std::stoi(columns[6]) != 0;
+            item.regex = std::stoi(columns[7]) != 0;
+            item.fuzzy = (columns.size() > 8) ? std::stoi(columns[8]) : 0;
+            tempList.push_back(item);
+        }
+        catch (const std::logic_error&) {
+            // std::invalid_argument and std::out_of_range
+            throw CsvLoadException("Invalid data in columns.");
+        }
+        columns.clear();
+    }
+
+    list = tempList;
+}
+
+void loadReplaceListCsv(const std::string& filePath, std::vector<ReplaceListEntry>& list) {
+    std::ifstream inFile(filePath, std::ios::binary);
+    std::string fileName = filePath.substr(filePath.find_last_of("/\\") + 1);
+    if (!inFile.is_open()) {
+        throw CsvLoadException("Failed to open '" + fileName + "'.");
+    }
+
+    std::string content((std::istreambuf_iterator<char>(inFile)), std::istreambuf_iterator<char>());
+    parseReplaceListCsv(content, fileName, list);
+}
+
+int convertExtendedToString(const std::string& query, std::string& result)
+{
+    auto readBase = [](const char* str, int* value, int base, int size) -> bool
+    {
+        int i = 0, temp = 0;
+        *value = 0;
+        char max = '0' + static_cast<char>(base) - 1;
+        char current;
+        while (i < size)
+        {
+            current = str[i];
+            if (current >= 'A')
+            {
+                current &= 0xdf;
+                current -= ('A' - '0' - 10);
+            }
+            else if (current > '9')
+                return false;
+
+            if (current >= '0' && current <= max)
+            {
+                temp *= base;
+                temp += (current - '0');
+            }
+            else
+            {
+                return false;
+            }
+            ++i;
+        }
+        *value = temp;
+        return true;
+    };
+
+    int i = 0, j = 0;
+    int charLeft = static_cast<int>(query.length());
+    char current;
+    result.clear();
+    result.resize(query.length()); // Preallocate memory for optimal performance
+
+    while (i < static_cast<int>(query.length()))
+    {
+        current = query[i];
+        --charLeft;
+        if (current == '\\' && charLeft)
+        {
+            ++i;
+            --charLeft;
+            current = query[i];
+            switch (current)
+            {
+            case 'r':
+                result[j] = '\r';
+                break;
+            case 'n':
+                result[j] = '\n';
+                break;
+            case '0':
+                result[j] = '\0';
+                break;
+            case 't':
+                result[j] = '\t';
+                break;
+            case '\\':
+                result[j] = '\\';
+                break;
+            case 'b':
+            case 'd':
+            case 'o':
+            case 'x':
+            case 'u':
+            {
+                int size = 0, base = 0;
+                if (current == 'b')
+                {
+                    size = 8, base = 2;
+                }
+                else if (current == 'o')
+                {
+                    size = 3, base = 8;
+                }
+                else if (current == 'd')
+                {
+                    size = 3, base = 10;
+                }
+                else if (current == 'x')
+                {
+                    size = 2, base = 16;
+                }
+                else if (current == 'u')
+                {
+                    size = 4, base = 16;
+                }
+
+                if (charLeft >= size)
+                {
+                    int res = 0;
+                    if (readBase(query.c_str() + (i + 1), &res, base, size))
+                    {
+                        result[j] = static_cast<char>(res);
+                        i += size;
+                        break;
+                    }
+                }
+                // not enough chars to make parameter, use default method as fallback
+            }
+            [[fallthrough]];
+            default:
+                // unknown sequence, treat as regular text
+                result[j] = '\\';
+                ++j;
+                result[j] = current;
+                break;
+            }
+        }
+        else
+        {
+            result[j] = query[i];
+        }
+        ++i;
+        ++j;
+    }
+
+    // Nullterminate the result-String
+    result.resize(j);
+
+    // Return length of result-Strings
+    return j;
+}
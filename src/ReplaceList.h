@@ -0,0 +1,58 @@
+// This file is part of Notepad++ project
+// Copyright (C)2023 Thomas Knoefel
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#ifndef REPLACE_LIST_H
+#define REPLACE_LIST_H
+
+// Replace lists as saved by the panel, readable without Notepad++ (UTF-8 texts, no Win32).
+
+#include <exception>
+#include <string>
+#include <vector>
+
+class CsvLoadException : public std::exception {
+public:
+    explicit CsvLoadException(const std::string& message) : message_(message) {}
+    const char* what() const noexcept override {
+        return message_.c_str();
+    }
+private:
+    std::string message_;
+};
+
+struct ReplaceListEntry {
+    bool isSelected = true;
+    std::string findText;       // UTF-8
+    std::string replaceText;    // UTF-8
+    bool wholeWord = false;
+    bool matchCase = false;
+    bool useVariables = false;
+    bool extended = false;
+    bool regex = false;
+    int fuzzy = 0;              // Edits allowed in Fuzzy mode, 0 in the other modes
+};
+
+// Same format and checks as MultiReplace::loadListFromCsvSilent(); throws CsvLoadException
+void loadReplaceListCsv(const std::string& filePath, std::vector<ReplaceListEntry>& list);
+
+// The rows of a list file read into content, header line first; fileName is used in the error messages.
+// Quoted fields may hold commas, doubled quotes and line breaks.
+void parseReplaceListCsv(const std::string& content, const std::string& fileName, std::vector<ReplaceListEntry>& list);
+
+// Resolves the escape sequences of the Extended search mode (\n, \r, \t, \0, \\, \b, \o, \d, \x, \u)
+int convertExtendedToString(const std::string& query, std::string& result);
+
+#endif // REPLACE_LIST_H
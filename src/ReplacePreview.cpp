@@ -0,0 +1,171 @@
+// This file is part of Notepad++ project
+// Copyright (C)2023 Thomas Knoefel
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "ReplacePreview.h"
+
+#include <algorithm>
+#include <cstring>
+
+static size_t lineEndFrom(const char* text, size_t textLength, size_t pos) {
+    const void* found = (pos < textLength) ? std::memchr(text + pos, '\n', textLength - pos) : nullptr;
+    return found ? static_cast<size_t>(static_cast<const char*>(found) - text) : textLength;
+}
+
+void ReplacePreview::setMatches(std::vector<ListMatch> selected, const std::vector<std::string>& replacements, size_t entryCount) {
+    matches = std::move(selected);
+    replaceTexts = replacements;
+    output.clear();
+    chained = false;
+    diffAvailable = true;
+    pages.clear();
+
+    hits.assign(entryCount, 0);
+    for (const ListMatch& match : matches) {
+        ++hits[match.pattern];
+    }
+}
+
+void ReplacePreview::runSequential(const char* text, size_t textLength, const ListMatcher& matcher,
+    const std::vector<std::string>& replacements, const CharClass classes[256], bool utf8, bool firstOnly) {
+
+    matches.clear();
+    replaceTexts = replacements;
+    output.assign(text, textLength);
+    chained = true;
+    diffAvailable = true;
+    pages.clear();
+    hits.assign(matcher.patternCount(), 0);
+
+    // Each entry gets its own automaton and sees the text the entries before it produced
+    for (size_t entry = 0; entry < matcher.patternCount(); ++entry) {
+        const ListPattern& pattern = matcher.pattern(entry);
+        if (pattern.findText.find_first_of("\r\n") != std::string::npos ||
+            replacements[entry].find_first_of("\r\n") != std::string::npos) {
+            diffAvailable = false;
+        }
+
+        ListMatcher single;
+        single.setCharClasses(classes, utf8);
+        single.build({ pattern });
+        hits[entry] = single.replaceSequentially(output, replacements[entry], firstOnly);
+    }
+}
+
+size_t ReplacePreview::totalHits() const {
+    size_t total = 0;
+    for (size_t count : hits) {
+        total += count;
+    }
+    return total;
+}
+
+bool ReplacePreview::page(const char* text, size_t textLength, size_t pageIndex, size_t linesPerPage, std::vector<PreviewLine>& lines) {
+    lines.clear();
+    if (linesPerPage == 0 || (chained && !diffAvailable)) {
+        return false;
+    }
+
+    if (linesPerPage != linesPerPageUsed) {
+        pages.clear();
+        linesPerPageUsed = linesPerPage;
+    }
+    if (pages.empty()) {
+        pages.push_back(PageCursor());
+    }
+
+    // Pages before the requested one are walked once to find where it starts, their lines are not kept
+    while (pages.size() <= pageIndex) {
+        PageCursor cursor = pages.back();
+        bool found = chained ? nextChangedLines(text, textLength, cursor, linesPerPage, nullptr)
+            : nextMatchLines(text, textLength, cursor, linesPerPage, nullptr);
+        if (!found) {
+            return false;
+        }
+        pages.push_back(cursor);
+    }
+
+    PageCursor cursor = pages[pageIndex];
+    return chained ? nextChangedLines(text, textLength, cursor, linesPerPage, &lines)
+        : nextMatchLines(text, textLength, cursor, linesPerPage, &lines);
+}
+
+bool ReplacePreview::nextMatchLines(const char* text, size_t textLength, PageCursor& cursor, size_t count, std::vector<PreviewLine>* lines) const {
+    size_t produced = 0;
+    while (produced < count && cursor.match < matches.size()) {
+        const ListMatch& first = matches[cursor.match];
+        size_t start = first.pos;
+        while (start > 0 && text[start - 1] != '\n') {
+            --start;
+        }
+
+        // Occurrences on the same line, or on lines joined by an occurrence, form one diff line
+        size_t end = lineEndFrom(text, textLength, first.pos + first.length);
+        size_t last = cursor.match + 1;
+        while (last < matches.size() && matches[last].pos <= end) {
+            end = std::max(end, lineEndFrom(text, textLength, matches[last].pos + matches[last].length));
+            ++last;
+        }
+
+        cursor.lineNumber += static_cast<size_t>(std::count(text + cursor.textPos, text + start, '\n'));
+        cursor.textPos = start;
+
+        if (lines != nullptr) {
+            PreviewLine line;
+            line.lineNumber = cursor.lineNumber;
+            line.before.assign(text + start, end - start);
+            line.lineCount = 1 + static_cast<size_t>(std::count(line.before.begin(), line.before.end(), '\n'));
+
+            size_t copied = start;
+            for (size_t i = cursor.match; i < last; ++i) {
+                line.after.append(text + copied, matches[i].pos - copied);
+                line.after.append(replaceTexts[matches[i].pattern]);
+                copied = matches[i].pos + matches[i].length;
+            }
+            line.after.append(text + copied, end - copied);
+            lines->push_back(std::move(line));
+        }
+
+        cursor.match = last;
+        ++produced;
+    }
+    return produced > 0;
+}
+
+bool ReplacePreview::nextChangedLines(const char* text, size_t textLength, PageCursor& cursor, size_t count, std::vector<PreviewLine>* lines) const {
+    size_t produced = 0;
+    while (produced < count && (cursor.textPos < textLength || cursor.outputPos < output.size())) {
+        size_t lineEnd = lineEndFrom(text, textLength, cursor.textPos);
+        size_t outputEnd = lineEndFrom(output.data(), output.size(), cursor.outputPos);
+        size_t lineLength = lineEnd - cursor.textPos;
+        size_t outputLength = outputEnd - cursor.outputPos;
+
+        if (lineLength != outputLength || std::memcmp(text + cursor.textPos, output.data() + cursor.outputPos, lineLength) != 0) {
+            if (lines != nullptr) {
+                PreviewLine line;
+                line.lineNumber = cursor.lineNumber;
+                line.before.assign(text + cursor.textPos, lineLength);
+                line.after.assign(output, cursor.outputPos, outputLength);
+                lines->push_back(std::move(line));
+            }
+            ++produced;
+        }
+
+        cursor.textPos = std::min(lineEnd + 1, textLength);
+        cursor.outputPos = std::min(outputEnd + 1, output.size());
+        ++cursor.lineNumber;
+    }
+    return produced > 0;
+}
@@ -0,0 +1,76 @@
+// This file is part of Notepad++ project
+// Copyright (C)2023 Thomas Knoefel
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef REPLACE_PREVIEW_H
+#define REPLACE_PREVIEW_H
+
+// Dry run of a literal replace plan: hit counts per entry and a paged diff of the affected lines.
+// Works on a read-only copy or pointer of the text, the document itself is never modified.
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "ListMatcher.h"
+
+struct PreviewLine {
+    size_t lineNumber = 0;  // Zero based line of the original text
+    size_t lineCount = 1;   // Original lines covered, more than one if an occurrence spans a line break
+    std::string before;
+    std::string after;
+};
+
+class ReplacePreview
+{
+public:
+    // Plan of entries that do not interact: the occurrences one pass over the text replaces, ordered by position
+    void setMatches(std::vector<ListMatch> selected, const std::vector<std::string>& replacements, size_t entryCount);
+
+    // Plan of chained entries: applies them one after another to a private copy of the whole text.
+    // With firstOnly set every entry replaces its first occurrence only.
+    void runSequential(const char* text, size_t textLength, const ListMatcher& matcher,
+        const std::vector<std::string>& replacements, const CharClass classes[256], bool utf8, bool firstOnly);
+
+    const std::vector<size_t>& entryHits() const { return hits; }
+    size_t totalHits() const;
+
+    // Chained plans can only be compared line by line while no entry adds or removes line breaks
+    bool hasDiff() const { return diffAvailable; }
+
+    // Affected lines of page pageIndex; pages are computed on first request and the text must be unchanged since the run.
+    // Returns false if the page lies behind the last affected line.
+    bool page(const char* text, size_t textLength, size_t pageIndex, size_t linesPerPage, std::vector<PreviewLine>& lines);
+
+private:
+    struct PageCursor {
+        size_t match = 0;       // Next occurrence (single pass)
+        size_t textPos = 0;     // Start of the next line to compare (chained) or first uncounted byte (single pass)
+        size_t outputPos = 0;   // Start of the same line in the replaced copy (chained)
+        size_t lineNumber = 0;
+    };
+
+    std::vector<ListMatch> matches;
+    std::vector<std::string> replaceTexts;
+    std::vector<size_t> hits;
+    std::string output;         // Replaced copy, chained plans only
+    bool chained = false;
+    bool diffAvailable = true;
+    std::vector<PageCursor> pages;
+    size_t linesPerPageUsed = 0;
+
+    bool nextMatchLines(const char* text, size_t textLength, PageCursor& cursor, size_t count, std::vector<PreviewLine>* lines) const;
+    bool nextChangedLines(const char* text, size_t textLength, PageCursor& cursor, size_t count, std::vector<PreviewLine>* lines) const;
+};
+
+#endif // REPLACE_PREVIEW_H
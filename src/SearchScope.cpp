@@ -0,0 +1,183 @@
+// This file is part of Notepad++ project
+// Copyright (C)2023 Thomas Knoefel
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "SearchScope.h"
+
+#include <algorithm>
+#include <utility>
+
+void SearchScope::assign(std::vector<ScopeRange> selections) {
+    std::sort(selections.begin(), selections.end(), [](const ScopeRange& a, const ScopeRange& b) {
+        return a.start < b.start;
+        });
+    assignCells(std::move(selections));
+    cellScope = false;
+}
+
+void SearchScope::assignCells(std::vector<ScopeRange> cells) {
+    ranges = std::move(cells);
+    pendingFrom = 0;
+    pendingShift = 0;
+    cursor = 0;
+    active = true;
+    cellScope = true;
+}
+
+void SearchScope::clear() {
+    ranges.clear();
+    pendingFrom = 0;
+    pendingShift = 0;
+    cursor = 0;
+    active = false;
+    cellScope = false;
+}
+
+ScopeRange SearchScope::range(size_t index) const {
+    ScopeRange result = ranges[index];
+    if (index >= pendingFrom) {
+        result.start += pendingShift;
+        result.end += pendingShift;
+    }
+    return result;
+}
+
+std::vector<ScopeRange> SearchScope::allRanges() const {
+    std::vector<ScopeRange> result;
+    result.reserve(ranges.size());
+    for (size_t i = 0; i < ranges.size(); ++i) {
+        result.push_back(range(i));
+    }
+    return result;
+}
+
+bool SearchScope::isBefore(const ScopeRange& range, Sci_Position pos) const {
+    // A search starting at the end of a cell still looks at it, a selection there is left out
+    return cellScope ? range.end < pos : range.end <= pos;
+}
+
+size_t SearchScope::findFrom(Sci_Position pos) {
+    if (cursor > ranges.size() || (cursor > 0 && !isBefore(range(cursor - 1), pos))) {
+        size_t low = 0;
+        size_t high = ranges.size();
+        while (low < high) {
+            size_t middle = low + (high - low) / 2;
+            if (isBefore(range(middle), pos)) {
+                low = middle + 1;
+            }
+            else {
+                high = middle;
+            }
+        }
+        cursor = low;
+    }
+
+    while (cursor < ranges.size() && isBefore(range(cursor), pos)) {
+        ++cursor;
+    }
+    return cursor;
+}
+
+void SearchScope::replaced(Sci_Position pos, Sci_Position length, Sci_Position newLength) {
+    if (ranges.empty() || (length == 0 && newLength == 0)) {
+        return;
+    }
+
+    // Scintilla deletes the old text, then inserts the new one. A selection start at the insert position
+    // moves behind the new text, a selection end there stays in front of it unless the selection became empty.
+    // Cells keep their start and take the text inserted at their end.
+    auto deleted = [&](Sci_Position p) {
+        return (p > pos + length) ? p - length : std::min(p, pos);
+    };
+    auto inserted = [&](Sci_Position p, bool moveForEqual) {
+        return (p > pos || (p == pos && moveForEqual)) ? p + newLength : p;
+    };
+
+    // Ranges ending before pos keep their place; the ones reaching into the replaced text are moved one by one
+    size_t first = findFrom(pos);
+    while (!cellScope && first > 0 && range(first - 1).start == pos) {
+        --first;  // Empty selection at pos
+    }
+
+    size_t last = first;
+    while (last < ranges.size() && range(last).start <= pos + length) {
+        ScopeRange moved = range(last);
+        moved.start = deleted(moved.start);
+        moved.end = deleted(moved.end);
+        if (cellScope) {
+            moved.start = inserted(moved.start, false);
+            moved.end = inserted(moved.end, true);
+        }
+        else {
+            bool empty = (moved.start == moved.end);
+            moved.start = inserted(moved.start, true);
+            moved.end = inserted(moved.end, empty);
+        }
+        store(last, moved);
+        ++last;
+    }
+
+    shiftFrom(last, newLength - length);
+}
+
+void SearchScope::reload(Sci_Position from, Sci_Position to, const std::vector<ScopeRange>& fresh) {
+    for (size_t i = pendingFrom; i < ranges.size(); ++i) {
+        ranges[i].start += pendingShift;
+        ranges[i].end += pendingShift;
+    }
+    pendingFrom = 0;
+    pendingShift = 0;
+
+    auto first = std::lower_bound(ranges.begin(), ranges.end(), from,
+        [](const ScopeRange& range, Sci_Position pos) { return range.start < pos; });
+    auto last = first;
+    while (last != ranges.end() && last->start <= to) {
+        ++last;
+    }
+
+    size_t index = static_cast<size_t>(first - ranges.begin());
+    ranges.insert(ranges.erase(first, last), fresh.begin(), fresh.end());
+    cursor = index;
+}
+
+void SearchScope::store(size_t index, const ScopeRange& range) {
+    ranges[index] = range;
+    if (index >= pendingFrom) {
+        ranges[index].start -= pendingShift;
+        ranges[index].end -= pendingShift;
+    }
+}
+
+void SearchScope::shiftFrom(size_t index, Sci_Position delta) {
+    if (delta == 0) {
+        return;
+    }
+
+    if (index >= pendingFrom) {
+        // Ranges in front of index get the pending shift for good, the rest share the new one
+        for (size_t i = pendingFrom; i < index && i < ranges.size(); ++i) {
+            ranges[i].start += pendingShift;
+            ranges[i].end += pendingShift;
+        }
+        pendingFrom = index;
+    }
+    else {
+        for (size_t i = index; i < pendingFrom; ++i) {
+            ranges[i].start += delta;
+            ranges[i].end += delta;
+        }
+    }
+    pendingShift += delta;
+}
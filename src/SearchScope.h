@@ -0,0 +1,75 @@
+// This file is part of Notepad++ project
+// Copyright (C)2023 Thomas Knoefel
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef SEARCH_SCOPE_H
+#define SEARCH_SCOPE_H
+
+// Ranges of a 'Selection' or 'CSV' scope operation, captured once and kept in sync with the replacements.
+// Selections move the way Scintilla moves its own selections and cells grow or shrink with the text
+// replaced in them, so searching them gives the same result as reading the editor or the delimiter
+// index before every search.
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Sci_Position.h"
+
+struct ScopeRange {
+    Sci_Position start = 0;
+    Sci_Position end = 0;
+    int column = 0;  // One based column of a cell, 0 for a selection
+};
+
+class SearchScope
+{
+public:
+    // Selections are sorted by position, cells have to be passed in document order
+    void assign(std::vector<ScopeRange> selections);
+    void assignCells(std::vector<ScopeRange> cells);
+    void clear();
+
+    bool isActive() const { return active; }
+    bool hasCells() const { return cellScope; }
+    size_t size() const { return ranges.size(); }
+    ScopeRange range(size_t index) const;
+    std::vector<ScopeRange> allRanges() const;
+
+    // Index of the first range a search from pos has to look at: the first selection ending behind pos,
+    // or the first cell ending at or behind it. Searches mostly move forward, so the scan continues
+    // from the previous call and only falls back to a binary search if pos went back.
+    size_t findFrom(Sci_Position pos);
+
+    // Text of length bytes at pos was replaced by newLength bytes
+    void replaced(Sci_Position pos, Sci_Position length, Sci_Position newLength);
+
+    // Replaces the ranges starting within [from, to] by the ones of a new scan of that text
+    void reload(Sci_Position from, Sci_Position to, const std::vector<ScopeRange>& fresh);
+
+private:
+    // Ranges from index pendingFrom on still have to be moved by pendingShift; a replacement
+    // only updates the ranges it touches, the ones behind it get their shift here.
+    std::vector<ScopeRange> ranges;
+    size_t pendingFrom = 0;
+    Sci_Position pendingShift = 0;
+    size_t cursor = 0;
+    bool active = false;
+    bool cellScope = false;
+
+    bool isBefore(const ScopeRange& range, Sci_Position pos) const;
+    void store(size_t index, const ScopeRange& range);
+    void shiftFrom(size_t index, Sci_Position delta);
+};
+
+#endif // SEARCH_SCOPE_H
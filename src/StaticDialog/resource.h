@@ -62,6 +62,8 @@
 #define IDC_NORMAL_RADIO                5301
 #define IDC_EXTENDED_RADIO              5302
 #define IDC_REGEX_RADIO                 5303
+#define IDC_FUZZY_RADIO                 5304
+#define IDC_FUZZY_DISTANCE_EDIT         5305
 
 #define IDC_SCOPE_GROUP                 5451
 #define IDC_ALL_TEXT_RADIO              5452
@@ -78,6 +80,7 @@
 #define IDC_STATIC_FRAME                5501
 #define IDC_USE_LIST_CHECKBOX			5502
 #define IDC_REPLACE_LIST                5503
+#define IDC_DENSITY_STRIP               5504
 
 #define IDD_ABOUT_DIALOG                5600
 #define IDC_NAME_STATIC	                5601
@@ -86,6 +89,29 @@
 #define IDC_LICENSE_STATIC              5604
 #define IDC_AUTHOR_STATIC               5605
 
+#define IDD_PROGRESS_DIALOG             5700
+#define IDC_PROGRESS_BAR                5701
+#define IDC_PROGRESS_STATIC             5702
+
+#define IDD_PREVIEW_DIALOG              5710
+#define IDC_PREVIEW_SUMMARY_STATIC      5711
+#define IDC_PREVIEW_COUNTS_EDIT         5712
+#define IDC_PREVIEW_DIFF_EDIT           5713
+#define IDC_PREVIEW_PREV_BUTTON         5714
+#define IDC_PREVIEW_NEXT_BUTTON         5715
+#define IDC_PREVIEW_PAGE_STATIC         5716
+
+#define IDD_FINDALL_DIALOG              5720
+#define IDC_FINDALL_SUMMARY_STATIC      5721
+#define IDC_FINDALL_LIST                5722
+
+#define IDD_EXPORT_MARKS_DIALOG         5730
+#define IDC_EXPORT_LINES_RADIO          5731
+#define IDC_EXPORT_POSITIONS_RADIO      5732
+#define IDC_EXPORT_CSV_RADIO            5733
+#define IDC_EXPORT_FILE_RADIO           5734
+#define IDC_EXPORT_CLIPBOARD_RADIO      5735
+
 #define STYLE1							60
 #define STYLE2							61
 #define STYLE3							62
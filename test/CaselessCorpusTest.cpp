@@ -0,0 +1,123 @@
+// This file is part of Notepad++ project
+// Copyright (C)2023 Thomas Knoefel
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+// Caseless UTF-8 search against CaselessCorpus.txt, the results of a model of Scintilla's search without
+// SCFIND_MATCHCASE (see make_caseless_corpus.py). Run from the test directory.
+
+#include "Test.h"
+#include "ListMatcher.h"
+#include "LiteralScanner.h"
+
+#include <fstream>
+#include <sstream>
+#include <utility>
+
+typedef std::vector<std::pair<size_t, size_t>> Hits;
+
+struct CorpusCase {
+    std::string text;
+    std::vector<std::string> needles;
+    std::vector<Hits> expected;
+};
+
+static std::string fromHex(const std::string& hex) {
+    std::string bytes;
+    for (size_t i = 0; i + 1 < hex.size(); i += 2) {
+        bytes += static_cast<char>(std::stoi(hex.substr(i, 2), nullptr, 16));
+    }
+    return bytes;
+}
+
+static std::vector<CorpusCase> readCorpus(const char* path) {
+    std::vector<CorpusCase> cases;
+    std::ifstream file(path);
+    std::string line;
+    while (std::getline(file, line)) {
+        std::istringstream fields(line);
+        std::string kind, hex;
+        fields >> kind >> hex;
+        if (kind == "doc") {
+            cases.push_back({ fromHex(hex), {}, {} });
+        }
+        else if (kind == "find" && !cases.empty()) {
+            size_t count = 0;
+            fields >> count;
+            Hits hits;
+            for (std::string hit; fields >> hit; ) {
+                size_t colon = hit.find(':');
+                hits.push_back({ std::stoul(hit.substr(0, colon)), std::stoul(hit.substr(colon + 1)) });
+            }
+            CHECK(hits.size() == count);
+            cases.back().needles.push_back(fromHex(hex));
+            cases.back().expected.push_back(hits);
+        }
+    }
+    return cases;
+}
+
+static Hits patternHits(const std::vector<ListMatch>& candidates, size_t pattern) {
+    Hits hits;
+    for (const ListMatch& match : ListMatcher::selectPatternMatches(candidates)) {
+        if (match.pattern == pattern) {
+            hits.push_back({ match.pos, match.length });
+        }
+    }
+    return hits;
+}
+
+TEST(caselessSearchMatchesCorpus) {
+    std::vector<CorpusCase> cases = readCorpus("CaselessCorpus.txt");
+    CHECK(cases.size() > 1000);
+
+    for (const CorpusCase& corpusCase : cases) {
+        const std::string& text = corpusCase.text;
+        std::vector<ListPattern> patterns;
+
+        for (size_t i = 0; i < corpusCase.needles.size(); ++i) {
+            // The single entry scanner, on its own and behind the matcher
+            LiteralScanner scanner;
+            scanner.setPattern(corpusCase.needles[i], false, true);
+            Hits scanned;
+            size_t matchLength;
+            for (size_t pos = scanner.find(text.data(), 0, text.size(), matchLength); pos < text.size();
+                pos = scanner.find(text.data(), pos + matchLength, text.size(), matchLength)) {
+                scanned.push_back({ pos, matchLength });
+            }
+            CHECK(scanned == corpusCase.expected[i]);
+
+            ListMatcher single;
+            single.build({ { corpusCase.needles[i], false, false } });
+            std::vector<ListMatch> found;
+            single.findAll(text.data(), text.size(), 0, text.size(), found);
+            CHECK(patternHits(found, 0) == corpusCase.expected[i]);
+
+            patterns.push_back({ corpusCase.needles[i], false, false });
+        }
+
+        // All needles in one automaton, with an entry that never occurs so it is used even for one needle
+        patterns.push_back({ "\x01\x02", false, true });
+        ListMatcher matcher;
+        matcher.build(patterns);
+        std::vector<ListMatch> found;
+        matcher.findAll(text.data(), text.size(), 0, text.size(), found);
+        std::vector<ListMatch> parallel;
+        matcher.findAllParallel(text.data(), text.size(), 0, text.size(), 4, 4, parallel);
+        for (size_t i = 0; i < corpusCase.needles.size(); ++i) {
+            CHECK(patternHits(found, i) == corpusCase.expected[i]);
+            CHECK(patternHits(parallel, i) == corpusCase.expected[i]);
+        }
+    }
+}
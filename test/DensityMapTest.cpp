@@ -0,0 +1,99 @@
+// This file is part of Notepad++ project
+// Copyright (C)2023 Thomas Knoefel
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "Test.h"
+#include "DensityMap.h"
+#include "HitCounter.h"
+#include "ListMatcher.h"
+
+#include <algorithm>
+
+// All occurrences in the text, the count the repaired map is compared with
+static std::vector<ListMatch> allMatches(const ListMatcher& matcher, const std::string& text) {
+    std::vector<ListMatch> found;
+    matcher.findAll(text.data(), text.size(), 0, text.size(), found);
+    return found;
+}
+
+// Mostly short edits, now and then one over several buckets
+static size_t editLength(std::mt19937& random, size_t shortLength) {
+    return random() % ((random() % 5 == 0) ? 3000 : shortLength);
+}
+
+TEST(densityMapRepairCountsLikeFullCount) {
+    std::mt19937 random(25);
+    const std::string alphabet = "ab c\n";
+    CharClass classes[256];
+    wordClasses(classes);
+    for (int round = 0; round < 300; ++round) {
+        std::vector<ListPattern> patterns;
+        for (const char* findText : { "a", "ab", "aaa", "b c", "ba" }) {
+            patterns.push_back({ findText, random() % 3 == 0, true });
+        }
+        ListMatcher matcher;
+        matcher.setCharClasses(classes, true);
+        matcher.build(patterns);
+
+        std::string text = randomText(random, alphabet, random() % 20000);
+        DensityMap density;
+        density.reset(text.size(), patterns.size(), matcher.maxPatternLength());
+        for (const ListMatch& match : allMatches(matcher, text)) {
+            density.add(match.pos, match.pattern);
+        }
+
+        // Updates of a few edits each, the edited buckets counted again after every update
+        for (int update = random() % 30; update > 0; --update) {
+            for (int edit = 1 + random() % 4; edit > 0; --edit) {
+                size_t pos = random() % (text.size() + 1);
+                size_t length = (random() % 2 == 0) ? std::min(editLength(random, 10), text.size() - pos) : 0;
+                text.erase(pos, length);
+                density.replaced(pos, length, 0);
+                std::string newText = (random() % 2 == 0) ? randomText(random, alphabet, editLength(random, 8)) : std::string();
+                text.insert(pos, newText);
+                if (!newText.empty()) {
+                    density.replaced(pos, 0, newText.size());
+                }
+            }
+            size_t start = 0;
+            size_t end = 0;
+            if (density.takeEdited(start, end)) {
+                auto read = [&text](size_t pos, size_t) { return text.data() + pos; };
+                HitCounter::countEdited(matcher, read, text.size(), start, end, density);
+            }
+
+            CHECK(density.length() == text.size());
+            std::vector<size_t> entryTotals(patterns.size(), 0);
+            std::vector<size_t> totals(density.bucketCount(), 0);
+            std::vector<size_t> counts(density.bucketCount() * patterns.size(), 0);
+            for (const ListMatch& match : allMatches(matcher, text)) {
+                size_t bucket = density.bucketAt(match.pos);
+                entryTotals[match.pattern]++;
+                totals[bucket]++;
+                counts[bucket * patterns.size() + match.pattern]++;
+            }
+            for (size_t entry = 0; entry < patterns.size(); ++entry) {
+                CHECK(density.entryTotal(entry) == entryTotals[entry]);
+            }
+            for (size_t bucket = 0; bucket < density.bucketCount(); ++bucket) {
+                CHECK(density.bucketStart(bucket) <= density.bucketEnd(bucket));
+                CHECK(density.total(bucket) == totals[bucket]);
+                for (size_t entry = 0; entry < patterns.size(); ++entry) {
+                    CHECK(density.count(bucket, entry) == counts[bucket * patterns.size() + entry]);
+                }
+            }
+        }
+    }
+}
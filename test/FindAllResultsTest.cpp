@@ -0,0 +1,136 @@
+// This file is part of Notepad++ project
+// Copyright (C)2023 Thomas Knoefel
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "Test.h"
+#include "FindAllResults.h"
+
+#include <algorithm>
+
+// Lines ending in LF, CR and CRLF, and a two byte UTF-8 character
+static const std::vector<std::string> PIECES = { "a", "b", "\n", "\r", "\r\n", "\xC3\xA4" };
+
+static bool isBreak(char ch) {
+    return ch == '\n' || ch == '\r';
+}
+
+static bool isCharacterStart(const std::string& text, size_t pos, bool utf8) {
+    return !utf8 || pos >= text.size() || (static_cast<unsigned char>(text[pos]) & 0xC0) != 0x80;
+}
+
+TEST(findAllLinesAndColumns) {
+    std::mt19937 random(17);
+    for (int round = 0; round < 2000; ++round) {
+        std::string text;
+        size_t length = random() % 300;
+        while (text.size() < length) {
+            text += PIECES[random() % PIECES.size()];
+        }
+        bool utf8 = (random() % 4 != 0);
+
+        std::vector<ListMatch> matches(random() % 30);
+        for (ListMatch& match : matches) {
+            match.pos = random() % (text.size() + 1);
+            match.length = std::min<size_t>(1 + random() % 4, text.size() - match.pos);
+            match.pattern = random() % 5;
+        }
+        FindAllResults results;
+        results.assign(matches, text.data(), text.size(), utf8, 1 + random() % 8, 1 + random() % 16);
+
+        CHECK(results.size() == matches.size());
+        std::vector<bool> entrySeen(5, false);
+        for (const ListMatch& match : matches) {
+            entrySeen[match.pattern] = true;
+        }
+        CHECK(results.entryCount() == static_cast<size_t>(std::count(entrySeen.begin(), entrySeen.end(), true)));
+
+        for (size_t i = 0; i < results.size(); ++i) {
+            const FindAllHit& hit = results.hit(i);
+            CHECK(i == 0 || results.hit(i - 1).pos <= hit.pos);
+
+            // A CR followed by LF is one line break
+            size_t line = 0;
+            size_t column = 0;
+            for (size_t pos = 0; pos < hit.pos; ++pos) {
+                if (text[pos] == '\n' || (text[pos] == '\r' && (pos + 1 == text.size() || text[pos + 1] != '\n'))) {
+                    ++line;
+                    column = 0;
+                }
+                else if (isCharacterStart(text, pos, utf8)) {
+                    ++column;
+                }
+            }
+            CHECK(hit.line == line);
+            CHECK(hit.column == column);
+        }
+    }
+}
+
+TEST(findAllContextIsCutAtLineAndCharacter) {
+    std::mt19937 random(18);
+    for (int round = 0; round < 2000; ++round) {
+        std::string text;
+        size_t length = random() % 120;
+        while (text.size() < length) {
+            text += PIECES[random() % PIECES.size()];
+        }
+        if (text.empty()) {
+            continue;
+        }
+        bool utf8 = (random() % 4 != 0);
+        ListMatch match;
+        match.pos = random() % text.size();
+        match.length = std::min<size_t>(1 + random() % 3, text.size() - match.pos);
+        FindAllResults results;
+        results.assign({ match }, text.data(), text.size(), utf8, 1, 1);
+
+        size_t maxBefore = random() % 12;
+        size_t maxAfter = 1 + random() % 12;
+        bool cutBefore;
+        bool cutAfter;
+        std::string context = results.context(text.data(), text.size(), 0, maxBefore, maxAfter, cutBefore, cutAfter);
+
+        // Expected: the line around the occurrence, cut to the limits at character starts
+        size_t lineStart = match.pos;
+        while (lineStart > 0 && !isBreak(text[lineStart - 1])) {
+            --lineStart;
+        }
+        size_t start = lineStart;
+        bool expectCutBefore = (match.pos - lineStart > maxBefore);
+        if (expectCutBefore) {
+            start = match.pos - maxBefore;
+            while (start < match.pos && !isCharacterStart(text, start, utf8)) {
+                ++start;
+            }
+        }
+        size_t limit = std::min(match.pos + maxAfter, text.size());
+        size_t lineEnd = std::min(match.pos + match.length, limit);
+        while (lineEnd < text.size() && !isBreak(text[lineEnd])) {
+            ++lineEnd;
+        }
+        size_t end = lineEnd;
+        bool expectCutAfter = (lineEnd > limit);
+        if (expectCutAfter) {
+            end = limit;
+            while (end > match.pos && !isCharacterStart(text, end, utf8)) {
+                --end;
+            }
+        }
+
+        CHECK(cutBefore == expectCutBefore);
+        CHECK(cutAfter == expectCutAfter);
+        CHECK(context == text.substr(start, end - start));
+    }
+}
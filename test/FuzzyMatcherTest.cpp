@@ -0,0 +1,218 @@
+// This file is part of Notepad++ project
+// Copyright (C)2023 Thomas Knoefel
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "Test.h"
+#include "CaseFolding.h"
+#include "FuzzyMatcher.h"
+
+#include <algorithm>
+
+// ASCII, a two byte letter in both cases and the Kelvin sign, which folds to k
+static const std::vector<std::string> PIECES = { "a", "b", "c", "A", "B", "x", " ", "\xC3\xA4", "\xC3\x84", "\xE2\x84\xAA", "k", "K" };
+static const std::vector<std::string> ASCII_PIECES(PIECES.begin(), PIECES.begin() + 7);
+
+struct Character {
+    size_t pos;
+    std::string key;    // What the character is compared by
+};
+
+static std::vector<Character> characters(const std::string& text, bool utf8, bool matchCase) {
+    std::vector<Character> result;
+    for (size_t pos = 0; pos < text.size(); ) {
+        unsigned char ch = static_cast<unsigned char>(text[pos]);
+        size_t width = 1;
+        std::string key;
+        if (ch < 0x80 || !utf8) {
+            key.assign(1, static_cast<char>((!matchCase && ch >= 'A' && ch <= 'Z') ? ch + 32 : ch));
+        }
+        else if (matchCase) {
+            unsigned int codePoint;
+            width = CaseFolding::decode(text.data(), text.size(), pos, codePoint);
+            key = text.substr(pos, width);
+        }
+        else {
+            const char* folded;
+            size_t foldedLength;
+            width = CaseFolding::foldCharacter(text.data(), text.size(), pos, folded, foldedLength);
+            key.assign(folded, foldedLength);
+        }
+        result.push_back({ pos, key });
+        pos += width;
+    }
+    return result;
+}
+
+// Fewest edits between the pattern and any text [start, end) with start in [from, end), for every end from
+// from to the end of the text (semi-global edit distance, Sellers' algorithm)
+static std::vector<size_t> fewestEditsPerEnd(const std::vector<Character>& pattern, const std::vector<Character>& text, size_t from) {
+    std::vector<size_t> column(pattern.size() + 1);
+    for (size_t i = 0; i < column.size(); ++i) {
+        column[i] = i;
+    }
+    std::vector<size_t> result(1, pattern.size());
+    for (size_t j = from; j < text.size(); ++j) {
+        size_t diagonal = column[0];
+        column[0] = 0;
+        for (size_t i = 1; i < column.size(); ++i) {
+            size_t above = column[i];
+            column[i] = std::min({ above + 1, column[i - 1] + 1, diagonal + (pattern[i - 1].key == text[j].key ? 0 : 1) });
+            diagonal = above;
+        }
+        result.push_back(column.back());
+    }
+    return result;
+}
+
+// Edit distance between the pattern and the text [end - k, end) for every k up to end - from
+static std::vector<size_t> editsPerStart(const std::vector<Character>& pattern, const std::vector<Character>& text, size_t from, size_t end) {
+    std::vector<size_t> column(pattern.size() + 1);
+    for (size_t i = 0; i < column.size(); ++i) {
+        column[i] = i;
+    }
+    std::vector<size_t> result(1, pattern.size());
+    for (size_t j = end; j > from; --j) {
+        size_t diagonal = column[0];
+        column[0] = end - j + 1;
+        for (size_t i = 1; i < column.size(); ++i) {
+            size_t above = column[i];
+            size_t patternIndex = pattern.size() - i;
+            column[i] = std::min({ above + 1, column[i - 1] + 1, diagonal + (pattern[patternIndex].key == text[j - 1].key ? 0 : 1) });
+            diagonal = above;
+        }
+        result.push_back(column.back());
+    }
+    return result;
+}
+
+// What FuzzyMatcher promises: from the search position, the first end where some text is close enough; of the ends
+// that follow while the text stays close enough, the one with the fewest edits, and the longest text with those
+// edits. The search goes on behind the occurrence.
+static std::vector<ListMatch> expectedMatches(const FuzzyPattern& pattern, const std::string& text, bool utf8) {
+    std::vector<Character> needle = characters(pattern.findText, utf8, pattern.matchCase);
+    std::vector<Character> chars = characters(text, utf8, pattern.matchCase);
+    size_t length = needle.size();
+    size_t distance = std::min(pattern.distance, length - 1);
+
+    std::vector<ListMatch> result;
+    size_t from = 0;
+    while (from < chars.size()) {
+        std::vector<size_t> fewest = fewestEditsPerEnd(needle, chars, from);
+        size_t firstEnd = from + 1;
+        while (firstEnd <= chars.size() && fewest[firstEnd - from] > distance) {
+            ++firstEnd;
+        }
+        if (firstEnd > chars.size()) {
+            break;
+        }
+
+        size_t chosenStart = 0;
+        size_t chosenEnd = 0;
+        size_t chosenEdits = length + 1;
+        for (size_t end = firstEnd; end <= chars.size() && end <= firstEnd + length; ++end) {
+            size_t edits = fewest[end - from];
+            if (edits > distance) {
+                break;
+            }
+            // The first start with the fewest edits, counted from the search position
+            std::vector<size_t> perStart = editsPerStart(needle, chars, from, end);
+            size_t start = from;
+            while (perStart[end - start] != edits) {
+                ++start;
+            }
+            if (edits < chosenEdits || (edits == chosenEdits && start <= chosenStart)) {
+                chosenStart = start;
+                chosenEnd = end;
+                chosenEdits = edits;
+            }
+        }
+        size_t startPos = chars[chosenStart].pos;
+        size_t endPos = (chosenEnd < chars.size()) ? chars[chosenEnd].pos : text.size();
+        result.push_back({ startPos, endPos - startPos, 0 });
+        from = chosenEnd;
+    }
+    return result;
+}
+
+TEST(fuzzyMatchesEditDistanceReference) {
+    std::mt19937 random(18);
+    for (int round = 0; round < 2000; ++round) {
+        bool utf8 = (round % 2 == 1);
+        const std::vector<std::string>& pieces = utf8 ? PIECES : ASCII_PIECES;
+        std::string text = randomPieces(random, pieces, random() % 50);
+
+        std::vector<FuzzyPattern> patterns(1 + random() % 3);
+        for (FuzzyPattern& pattern : patterns) {
+            pattern = { randomPieces(random, pieces, 1 + random() % 9), random() % 4, random() % 2 == 0 };
+        }
+        FuzzyMatcher matcher;
+        matcher.build(patterns, utf8);
+
+        std::vector<ListMatch> expected;
+        for (size_t i = 0; i < patterns.size(); ++i) {
+            for (ListMatch match : expectedMatches(patterns[i], text, utf8)) {
+                match.pattern = i;
+                expected.push_back(match);
+            }
+        }
+        std::vector<ListMatch> found;
+        matcher.findAll(text.data(), text.size(), 0, text.size(), found);
+        CHECK(sameMatches(found, expected));
+
+        std::vector<ListMatch> parallel;
+        matcher.findAllParallel(text.data(), text.size(), 0, text.size(), 4, 8, parallel);
+        CHECK(sameMatches(parallel, expected));
+
+        for (size_t i = 0; i < patterns.size(); ++i) {
+            auto first = std::find_if(expected.begin(), expected.end(), [i](const ListMatch& match) { return match.pattern == i; });
+            ListMatch match;
+            bool foundFirst = matcher.findFirst(text.data(), text.size(), 0, text.size(), i, match);
+            CHECK(foundFirst == (first != expected.end()));
+            CHECK(!foundFirst || (match.pos == first->pos && match.length == first->length));
+        }
+    }
+}
+
+TEST(fuzzyFindsDamagedCopies) {
+    // Longer entries are searched through their pieces; plant copies with a few characters removed
+    std::mt19937 random(19);
+    for (int round = 0; round < 300; ++round) {
+        bool utf8 = (round % 2 == 1);
+        const std::vector<std::string>& pieces = utf8 ? PIECES : ASCII_PIECES;
+        bool longEntry = (round % 10 == 0);
+        FuzzyPattern pattern = { randomPieces(random, pieces, longEntry ? 70 + random() % 60 : 8 + random() % 14),
+            1 + random() % 3, random() % 2 == 0 };
+
+        std::string text;
+        while (text.size() < (longEntry ? 150u : 250u)) {
+            if (random() % 3 == 0) {
+                std::string copy = pattern.findText;
+                for (size_t edits = random() % 4; edits > 0; --edits) {
+                    copy.erase(random() % copy.size(), 1);
+                }
+                text += copy;
+            }
+            else {
+                text += randomPieces(random, pieces, 5);
+            }
+        }
+
+        FuzzyMatcher matcher;
+        matcher.build({ pattern }, utf8);
+        std::vector<ListMatch> found;
+        matcher.findAll(text.data(), text.size(), 0, text.size(), found);
+        CHECK(sameMatches(found, expectedMatches(pattern, text, utf8)));
+    }
+}
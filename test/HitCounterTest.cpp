@@ -0,0 +1,87 @@
+// This file is part of Notepad++ project
+// Copyright (C)2023 Thomas Knoefel
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "Test.h"
+#include "HitCounter.h"
+
+#include <algorithm>
+#include <atomic>
+
+TEST(hitCounterCountsLikeFindAll) {
+    std::mt19937 random(20);
+    for (int round = 0; round < 300; ++round) {
+        std::vector<ListPattern> patterns(1 + random() % 4);
+        for (ListPattern& pattern : patterns) {
+            pattern = { randomText(random, "abAB _", 1 + random() % 3), random() % 2 == 0, random() % 2 == 0 };
+        }
+        ListMatcher matcher;
+        matcher.build(patterns);
+        std::string text = randomText(random, "abAB _\n", random() % 20000);
+
+        // Small chunks so the threads split the text
+        std::atomic<bool> finished{ false };
+        HitCounter counter;
+        counter.start(matcher, text, 1 + random() % 4, 64, [&finished]() { finished = true; });
+        DensityMap density;
+        std::vector<ListMatch> positions;
+        bool kept = false;
+        CHECK(counter.take(density, positions, kept));
+        CHECK(finished);
+        CHECK(!counter.isRunning());
+
+        std::vector<ListMatch> found;
+        matcher.findAll(text.data(), text.size(), 0, text.size(), found);
+        CHECK(kept);
+        sortMatches(positions);
+        sortMatches(found);
+        CHECK(sameMatches(positions, found));
+        CHECK(density.length() == text.size());
+        for (size_t entry = 0; entry < patterns.size(); ++entry) {
+            CHECK(density.entryTotal(entry) == static_cast<size_t>(std::count_if(found.begin(), found.end(),
+                [entry](const ListMatch& match) { return match.pattern == entry; })));
+        }
+        for (size_t bucket = 0; bucket < density.bucketCount(); ++bucket) {
+            size_t start = density.bucketStart(bucket);
+            size_t end = density.bucketEnd(bucket);
+            CHECK(density.total(bucket) == static_cast<size_t>(std::count_if(found.begin(), found.end(),
+                [start, end](const ListMatch& match) { return match.pos >= start && match.pos < end; })));
+        }
+    }
+}
+
+TEST(hitCounterCancelDropsTheResult) {
+    std::mt19937 random(120);
+    ListMatcher matcher;
+    matcher.build({ { "ab", false, true } });
+    std::string text = randomText(random, "ab ", 1 << 20);
+
+    HitCounter counter;
+    counter.start(matcher, text, 2, 1 << 16, []() {});
+    counter.cancel();
+    CHECK(!counter.isRunning());
+    DensityMap density;
+    std::vector<ListMatch> positions;
+    bool kept = false;
+    CHECK(!counter.take(density, positions, kept));
+    CHECK(!density.isActive());
+
+    // A new count replaces one still running
+    counter.start(matcher, text, 2, 1 << 16, []() {});
+    counter.start(matcher, "ab ab", 2, 1 << 16, []() {});
+    CHECK(counter.take(density, positions, kept));
+    CHECK(positions.size() == 2);
+    CHECK(density.entryTotal(0) == 2);
+}
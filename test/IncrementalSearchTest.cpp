@@ -0,0 +1,93 @@
+// This file is part of Notepad++ project
+// Copyright (C)2023 Thomas Knoefel
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "Test.h"
+#include "IncrementalSearch.h"
+
+// ASCII in both cases, sharp s, the Kelvin sign, the ff ligature and a two byte letter in both cases
+static const std::vector<std::string> PIECES = { "a", "b", "s", "S", "k", "K", "\xC3\x9F", "\xE2\x84\xAA", "\xEF\xAC\x80",
+    "f", " ", "x", "\xC3\xA4", "\xC3\x84" };
+
+// Occurrences Find Next steps over, from a search of the whole text
+static size_t expectedCount(const ListPattern& pattern, const CharClass classes[256], const std::string& text) {
+    ListMatcher matcher;
+    matcher.setCharClasses(classes, true);
+    matcher.build({ pattern });
+    std::vector<ListMatch> found;
+    matcher.findAll(text.data(), text.size(), 0, text.size(), found);
+    return ListMatcher::selectPatternMatches(std::move(found)).size();
+}
+
+TEST(incrementalSearchNarrowsLikeFullSearch) {
+    std::mt19937 random(19);
+    CharClass classes[256];
+    wordClasses(classes);
+    for (int round = 0; round < 1500; ++round) {
+        std::string text = randomPieces(random, PIECES, random() % 300);
+        bool matchCase = random() % 2 == 0;
+        bool wholeWord = random() % 3 == 0;
+        IncrementalSearch search;
+        std::string findText;
+        for (int typed = 0; typed < 4; ++typed) {
+            findText += PIECES[random() % PIECES.size()];
+            ListPattern pattern = { findText, wholeWord, matchCase };
+            if (!ListMatcher::isSupported(pattern, true)) {
+                break;
+            }
+            search.search(pattern, classes, true, text.data(), text.size(), 1, 1 << 20);
+            CHECK(search.count() == expectedCount(pattern, classes, text));
+        }
+    }
+}
+
+TEST(incrementalSearchRepairMatchesFullSearch) {
+    std::mt19937 random(119);
+    CharClass classes[256];
+    wordClasses(classes);
+    for (int round = 0; round < 1500; ++round) {
+        std::string text = randomPieces(random, PIECES, random() % 120);
+        ListPattern pattern = { randomPieces(random, PIECES, 1 + random() % 3), random() % 3 == 0, random() % 2 == 0 };
+        if (!ListMatcher::isSupported(pattern, true)) {
+            continue;
+        }
+        IncrementalSearch search;
+        search.search(pattern, classes, true, text.data(), text.size(), 1, 1 << 20);
+        auto read = [&text](size_t start, size_t) { return text.data() + start; };
+
+        for (int edit = 0; edit < 10; ++edit) {
+            // Scintilla reports a replacement as a deletion and an insertion
+            size_t pos = random() % (text.size() + 1);
+            size_t length = std::min<size_t>(random() % 4, text.size() - pos);
+            std::string newText = randomPieces(random, PIECES, random() % 3);
+            if (length > 0) {
+                text.erase(pos, length);
+                CHECK(search.replaced(read, text.size(), pos, length, 0));
+            }
+            if (!newText.empty()) {
+                text.insert(pos, newText);
+                CHECK(search.replaced(read, text.size(), pos, 0, newText.size()));
+            }
+            CHECK(search.count() == expectedCount(pattern, classes, text));
+        }
+
+        // Typing on narrows the repaired occurrences
+        pattern.findText += PIECES[random() % PIECES.size()];
+        if (ListMatcher::isSupported(pattern, true)) {
+            search.search(pattern, classes, true, text.data(), text.size(), 1, 1 << 20);
+            CHECK(search.count() == expectedCount(pattern, classes, text));
+        }
+    }
+}
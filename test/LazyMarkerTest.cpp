@@ -0,0 +1,208 @@
+// This file is part of Notepad++ project
+// Copyright (C)2023 Thomas Knoefel
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "Test.h"
+#include "LazyMarker.h"
+
+#include <algorithm>
+#include <set>
+#include <tuple>
+
+// Short text with now and then a long run of one letter, so occurrences step over each other across regions
+static std::string randomRuns(std::mt19937& random, size_t length, size_t longestRun) {
+    std::string text;
+    while (text.size() < length) {
+        text += (random() % 50 == 0) ? std::string(random() % longestRun, 'a') : randomText(random, "abA .\n", 1);
+    }
+    return text;
+}
+
+// What marking the whole document at once finds
+static std::vector<ListMatch> markAll(const std::vector<ListPattern>& patterns, const CharClass classes[256], const std::string& text) {
+    ListMatcher matcher;
+    matcher.setCharClasses(classes, true);
+    matcher.build(patterns);
+    std::vector<ListMatch> found;
+    matcher.findAll(text.data(), text.size(), 0, text.size(), found);
+    return ListMatcher::selectPatternMatches(std::move(found));
+}
+
+// Reads only the requested window, so reading outside of it is noticed
+static LazyMarker::TextReader windowReader(const std::string& text, std::string& window) {
+    return [&text, &window](size_t start, size_t length) {
+        window = text.substr(start, length);
+        return window.data();
+    };
+}
+
+TEST(lazyMarkerRegionsMarkLikeWholeDocument) {
+    std::mt19937 random(22);
+    CharClass classes[256];
+    wordClasses(classes);
+    for (int round = 0; round < 200; ++round) {
+        std::string text = randomRuns(random, 1000 + random() % 20000, 3000);
+        std::vector<ListPattern> patterns = randomPatterns(random, "abA ", 5, 4);
+        std::set<std::tuple<size_t, size_t, size_t>> expected;
+        for (const ListMatch& match : markAll(patterns, classes, text)) {
+            expected.insert({ match.pattern, match.pos, match.length });
+        }
+
+        // Regions as the view reaches them, then the rest; no occurrence may be handed out twice
+        std::string window;
+        LazyMarker::TextReader read = windowReader(text, window);
+        LazyMarker marker;
+        marker.start(patterns, classes, true);
+        std::vector<ListMatch> found;
+        for (int view = 0; view < 40; ++view) {
+            size_t start = random() % text.size();
+            marker.takeRange(read, text.size(), start, std::min(start + random() % 5000, text.size()), found);
+        }
+        marker.takeRange(read, text.size(), 0, text.size(), found);
+        std::set<std::tuple<size_t, size_t, size_t>> marked;
+        for (const ListMatch& match : found) {
+            CHECK(marked.insert({ match.pattern, match.pos, match.length }).second);
+        }
+        CHECK(marked == expected);
+
+        // Counting slice by slice ends with the same total
+        size_t sliceLength = 1 + random() % 20000;
+        while (!marker.countSlice(read, text.size(), sliceLength, 2, 1024)) {
+        }
+        CHECK(marker.count() == expected.size());
+    }
+}
+
+// Indicator values per style and byte, as Scintilla keeps them; entries share the styles like list colors do
+static const size_t STYLES = 3;
+using Indicators = std::vector<std::vector<char>>;
+
+static void fill(Indicators& indicators, const std::vector<ListMatch>& matches) {
+    for (const ListMatch& match : matches) {
+        std::fill_n(indicators[match.pattern % STYLES].begin() + match.pos, match.length, 1);
+    }
+}
+
+static Indicators indicatorsOf(const std::vector<ListMatch>& matches, size_t textLength) {
+    Indicators indicators(STYLES, std::vector<char>(textLength, 0));
+    fill(indicators, matches);
+    return indicators;
+}
+
+// Text inserted into or right behind an indicator run takes its value, as in Scintilla
+static void replaceText(std::string& text, Indicators& indicators, size_t pos, size_t length, const std::string& newText) {
+    text.replace(pos, length, newText);
+    for (std::vector<char>& values : indicators) {
+        values.erase(values.begin() + pos, values.begin() + pos + length);
+        values.insert(values.begin() + pos, newText.size(), (pos > 0) ? values[pos - 1] : 0);
+    }
+}
+
+// Repairs the marks after an update as MultiReplace::remarkEditedText() does, through LazyMarker; Scintilla's
+// part, reading lines and indicator runs and setting the indicators, is played by the text and the model
+static void remarkEdited(LazyMarker& marker, const LazyMarker::TextReader& read, const std::string& text, Indicators& indicators) {
+    auto lineBounds = [&text](size_t pos, size_t& lineStart, size_t& lineEnd) {
+        lineStart = pos;
+        while (lineStart > 0 && text[lineStart - 1] != '\n') {
+            --lineStart;
+        }
+        lineEnd = pos;
+        while (lineEnd < text.size() && text[lineEnd] != '\n') {
+            ++lineEnd;
+        }
+    };
+    auto markRun = [&indicators](size_t style, size_t pos, size_t& runStart, size_t& runEnd) {
+        const std::vector<char>& values = indicators[style];
+        if (!values[pos]) {
+            return false;
+        }
+        runStart = pos;
+        while (runStart > 0 && values[runStart - 1]) {
+            --runStart;
+        }
+        runEnd = pos;
+        while (runEnd < values.size() && values[runEnd]) {
+            ++runEnd;
+        }
+        return true;
+    };
+
+    size_t start = 0;
+    size_t end = 0;
+    if (!marker.takeEditedLines(lineBounds, text.size(), start, end)) {
+        return;
+    }
+    std::vector<ListMatch> found;
+    marker.remarkRange(read, text.size(), STYLES, markRun, start, end, found);
+    for (std::vector<char>& values : indicators) {
+        std::fill(values.begin() + start, values.begin() + end, 0);
+    }
+    fill(indicators, found);
+}
+
+TEST(lazyMarkerRepairMarksLikeWholeDocument) {
+    std::mt19937 random(24);
+    CharClass classes[256];
+    wordClasses(classes);
+    for (int round = 0; round < 300; ++round) {
+        std::string text = randomRuns(random, 200 + random() % 8000, 600);
+        std::vector<ListPattern> patterns = randomPatterns(random, "abA ", 5, 4);
+        std::string window;
+        LazyMarker::TextReader read = windowReader(text, window);
+
+        // Marked at once, or lazily in a few regions
+        LazyMarker marker;
+        marker.start(patterns, classes, true);
+        bool lazy = random() % 2 == 0;
+        Indicators indicators(STYLES, std::vector<char>(text.size(), 0));
+        if (lazy) {
+            for (int view = 0; view < 5; ++view) {
+                size_t start = random() % text.size();
+                std::vector<ListMatch> found;
+                marker.takeRange(read, text.size(), start, std::min(start + random() % 2000, text.size()), found);
+                fill(indicators, found);
+            }
+        }
+        else {
+            indicators = indicatorsOf(markAll(patterns, classes, text), text.size());
+            marker.takeAll(text.size(), 0);
+        }
+
+        // Updates of a few edits each, the marks repaired after every update
+        for (int update = 0; update < 6; ++update) {
+            for (int edit = 1 + random() % 3; edit > 0; --edit) {
+                size_t pos = random() % (text.size() + 1);
+                if (random() % 2 == 0 && pos < text.size()) {
+                    size_t length = std::min<size_t>(1 + random() % 20, text.size() - pos);
+                    replaceText(text, indicators, pos, length, "");
+                    marker.replaced(pos, length, 0);
+                }
+                else {
+                    std::string newText = randomText(random, "abA \na", 1 + random() % 10);
+                    replaceText(text, indicators, pos, 0, newText);
+                    marker.replaced(pos, 0, newText.size());
+                }
+            }
+            remarkEdited(marker, read, text, indicators);
+        }
+
+        if (lazy) {
+            std::vector<ListMatch> found;
+            marker.takeRange(read, text.size(), 0, text.size(), found);
+            fill(indicators, found);
+        }
+        CHECK(indicators == indicatorsOf(markAll(patterns, classes, text), text.size()));
+    }
+}
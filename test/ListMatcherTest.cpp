@@ -0,0 +1,260 @@
+// This file is part of Notepad++ project
+// Copyright (C)2023 Thomas Knoefel
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "Test.h"
+#include "ListMatcher.h"
+
+#include <algorithm>
+#include <cctype>
+
+static const std::string ALPHABET = "aAbB c\n";
+
+TEST(findAllParallelMatchesFindAll) {
+    std::mt19937 random(5);
+    for (int round = 0; round < 300; ++round) {
+        ListMatcher matcher;
+        matcher.build(randomPatterns(random, ALPHABET, 6, 5));
+        std::string text = randomText(random, ALPHABET, random() % 3000);
+        size_t rangeStart = text.empty() ? 0 : random() % text.size();
+        size_t rangeEnd = rangeStart + (text.size() > rangeStart ? random() % (text.size() - rangeStart + 1) : 0);
+
+        std::vector<ListMatch> expected;
+        matcher.findAll(text.data(), text.size(), rangeStart, rangeEnd, expected);
+
+        // Chunks shorter than the patterns make every occurrence likely to cross a chunk boundary
+        std::vector<ListMatch> found;
+        matcher.findAllParallel(text.data(), text.size(), rangeStart, rangeEnd, 1 + random() % 8, 1 + random() % 64, found);
+
+        sortMatches(expected);
+        sortMatches(found);
+        CHECK(sameMatches(found, expected));
+    }
+}
+
+TEST(chunkedSearchFindsFirstAndLast) {
+    std::mt19937 random(15);
+    for (int round = 0; round < 6000; ++round) {
+        std::vector<ListPattern> patterns = randomPatterns(random, ALPHABET, 6, 5);
+        std::string text = randomText(random, ALPHABET, random() % 300);
+
+        // Entries taken from the text, longer than the context read around a chunk, let a long occurrence
+        // start in front of a short one and still reach over the end of the chunk that holds the short one
+        if (round % 2 == 1 && !text.empty()) {
+            for (ListPattern& pattern : patterns) {
+                size_t start = random() % text.size();
+                pattern.findText = text.substr(start, 1 + random() % 16);
+            }
+        }
+        ListMatcher matcher;
+        matcher.build((round % 2 == 0) ? std::vector<ListPattern>{ patterns[0] } : patterns);
+        size_t rangeEnd = random() % (text.size() + 1);
+        size_t rangeStart = random() % (rangeEnd + 1);
+
+        std::vector<ListMatch> all;
+        matcher.findAll(text.data(), text.size(), rangeStart, rangeEnd, all);
+        const ListMatch* first = nullptr;
+        const ListMatch* last = nullptr;
+        for (const ListMatch& match : all) {
+            first = (first == nullptr || match.pos < first->pos) ? &match : first;
+            last = (last == nullptr || match.pos > last->pos) ? &match : last;
+        }
+
+        // Hand out copies, so reading outside the requested window cannot find anything
+        std::string window;
+        ListMatcher::TextReader read = [&](size_t start, size_t length) {
+            window = text.substr(start, length);
+            return window.c_str();
+        };
+        size_t firstChunk = 1 + random() % 16;
+        ListMatch found;
+        bool foundFirst = matcher.findFirstChunked(read, text.size(), rangeStart, rangeEnd, firstChunk, found);
+        CHECK(foundFirst == (first != nullptr));
+        CHECK(!foundFirst || (found.pos == first->pos && found.length == first->length));
+        bool foundLast = matcher.findLastChunked(read, text.size(), rangeStart, rangeEnd, firstChunk, found);
+        CHECK(foundLast == (last != nullptr));
+        CHECK(!foundLast || (found.pos == last->pos && found.length == last->length));
+    }
+}
+
+// Scintilla's default classes for the bytes of ALPHABET
+static bool isWordByte(char c) {
+    return std::isalnum(static_cast<unsigned char>(c)) || c == '_';
+}
+
+static int byteClass(char c) {
+    return (c == '\n' || c == '\r') ? 0 : (static_cast<unsigned char>(c) <= ' ') ? 1 : isWordByte(c) ? 2 : 3;
+}
+
+// Whether pattern occurs at pos of text, with the whole word rule of Scintilla's default classes
+static bool occursAt(const std::string& text, size_t pos, const ListPattern& pattern) {
+    size_t length = pattern.findText.size();
+    if (pos + length > text.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < length; ++i) {
+        char a = text[pos + i];
+        char b = pattern.findText[i];
+        if (pattern.matchCase ? a != b : std::tolower(static_cast<unsigned char>(a)) != std::tolower(static_cast<unsigned char>(b))) {
+            return false;
+        }
+    }
+    if (!pattern.wholeWord) {
+        return true;
+    }
+    int first = byteClass(text[pos]);
+    int last = byteClass(text[pos + length - 1]);
+    int before = (pos > 0) ? byteClass(text[pos - 1]) : 1;
+    int after = (pos + length < text.size()) ? byteClass(text[pos + length]) : 1;
+    return first >= 2 && first != before && last >= 2 && last != after;
+}
+
+// The list applied entry by entry, each entry searching on behind its last replacement in the text the
+// entries before it produced, as the panel's replace loop does
+static std::string replaceEntryByEntry(std::string text, const std::vector<ListPattern>& patterns, const std::vector<std::string>& replacements) {
+    for (size_t entry = 0; entry < patterns.size(); ++entry) {
+        size_t pos = 0;
+        while (pos + patterns[entry].findText.size() <= text.size()) {
+            if (occursAt(text, pos, patterns[entry])) {
+                text.replace(pos, patterns[entry].findText.size(), replacements[entry]);
+                pos += replacements[entry].size();
+            }
+            else {
+                ++pos;
+            }
+        }
+    }
+    return text;
+}
+
+// What the panel replaces in one pass: the sequential selection of the occurrences in the original text
+static std::string replaceInOnePass(const std::string& text, const std::vector<ListPattern>& patterns,
+    const std::vector<std::string>& replacements, bool& cascading) {
+    ListMatcher matcher;
+    matcher.build(patterns);
+    std::vector<ListMatch> candidates;
+    matcher.findAll(text.data(), text.size(), 0, text.size(), candidates);
+    std::vector<ListMatch> selected = matcher.selectSequentialMatches(std::move(candidates));
+    cascading = matcher.hasCascadingMatches(text.data(), text.size(), selected, replacements);
+    std::string output;
+    std::vector<size_t> outputPositions;
+    ListMatcher::buildReplacedText(text.data(), text.size(), selected, replacements, output, outputPositions);
+    return output;
+}
+
+TEST(sequentialSelectionReplacesLikeEntryByEntry) {
+    std::mt19937 random(1);
+    int compared = 0;
+    for (int round = 0; round < 3000; ++round) {
+        std::vector<ListPattern> patterns = randomPatterns(random, ALPHABET, 6, 5);
+        std::vector<std::string> replacements;
+        for (size_t entry = 0; entry < patterns.size(); ++entry) {
+            replacements.push_back(randomText(random, ALPHABET, random() % 4));
+        }
+        std::string text = randomText(random, ALPHABET, random() % 200);
+
+        // Without cascading the one pass gives the entry by entry result; where they differ it must have been reported
+        bool cascading = false;
+        std::string output = replaceInOnePass(text, patterns, replacements, cascading);
+        CHECK(cascading || output == replaceEntryByEntry(text, patterns, replacements));
+        compared += cascading ? 0 : 1;
+    }
+    CHECK(compared > 300);
+}
+
+TEST(cascadingListsAreReported) {
+    struct Case {
+        std::vector<ListPattern> patterns;
+        std::vector<std::string> replacements;
+        std::string text;
+    };
+    const Case cases[] = {
+        // Entry 2 finds what entry 1 wrote
+        { { { "a", false, true }, { "b", false, true } }, { "b", "c" }, "xa a" },
+        { { { "ab", false, true }, { "bb", false, true } }, { "b", "X" }, "abb" },
+        // Entry 2 finds text joined by entry 1 deleting what stood between
+        { { { "-", false, true }, { "ab", false, true } }, { "", "X" }, "a-b" },
+        // A whole word for entry 2 loses its boundary
+        { { { "-", false, true }, { "ab", true, true } }, { "", "X" }, "ab-cd" },
+        // A whole word for entry 2 gains its boundary
+        { { { "x", false, true }, { "ab", true, true } }, { " ", "X" }, "abxab" },
+        // The entry itself changes the boundary of its next occurrence
+        { { { "a-", true, true } }, { "a" }, "a-a-" },
+    };
+    for (const Case& c : cases) {
+        bool cascading = false;
+        std::string output = replaceInOnePass(c.text, c.patterns, c.replacements, cascading);
+        CHECK(cascading);
+        CHECK(output != replaceEntryByEntry(c.text, c.patterns, c.replacements));
+    }
+}
+
+// All entries at once, left to right: at each position the longest occurrence, of equal ones the earlier entry
+static std::string replaceLeftmostLongest(const std::string& text, const std::vector<ListPattern>& patterns, const std::vector<std::string>& replacements) {
+    std::string output;
+    size_t pos = 0;
+    while (pos < text.size()) {
+        size_t best = patterns.size();
+        for (size_t entry = 0; entry < patterns.size(); ++entry) {
+            if (occursAt(text, pos, patterns[entry]) && (best == patterns.size() || patterns[entry].findText.size() > patterns[best].findText.size())) {
+                best = entry;
+            }
+        }
+        if (best == patterns.size()) {
+            output += text[pos++];
+        }
+        else {
+            output += replacements[best];
+            pos += patterns[best].findText.size();
+        }
+    }
+    return output;
+}
+
+static std::string replaceSimultaneously(const std::string& text, const std::vector<ListPattern>& patterns, const std::vector<std::string>& replacements) {
+    ListMatcher matcher;
+    matcher.build(patterns);
+    std::vector<ListMatch> candidates;
+    matcher.findAll(text.data(), text.size(), 0, text.size(), candidates);
+    std::string output;
+    std::vector<size_t> outputPositions;
+    ListMatcher::buildReplacedText(text.data(), text.size(), ListMatcher::selectLeftmostLongestMatches(std::move(candidates)),
+        replacements, output, outputPositions);
+    return output;
+}
+
+TEST(leftmostLongestReplacesAllEntriesAtOnce) {
+    // Swapped entries do not see each other's results
+    CHECK(replaceSimultaneously("ab ba", { { "a", false, true }, { "b", false, true } }, { "b", "a" }) == "ba ab");
+    // Overlapping entries: the leftmost wins, then the longest, whatever the list order
+    CHECK(replaceSimultaneously("abcd", { { "bcd", false, true }, { "ab", false, true } }, { "1", "2" }) == "2cd");
+    CHECK(replaceSimultaneously("abcd", { { "a", false, true }, { "abc", false, true } }, { "1", "2" }) == "2d");
+    CHECK(replaceSimultaneously("abcd", { { "abc", false, true }, { "a", false, true } }, { "1", "2" }) == "1d");
+    // Equal occurrences go to the earlier entry
+    CHECK(replaceSimultaneously("aB ab", { { "ab", false, false }, { "AB", false, false } }, { "1", "2" }) == "1 1");
+    CHECK(replaceSimultaneously("aB ab", { { "AB", false, false }, { "ab", false, false } }, { "1", "2" }) == "1 1");
+    CHECK(replaceSimultaneously("ab", { { "ab", true, true }, { "ab", false, true } }, { "1", "2" }) == "1");
+
+    std::mt19937 random(9);
+    for (int round = 0; round < 3000; ++round) {
+        std::vector<ListPattern> patterns = randomPatterns(random, ALPHABET, 6, 5);
+        std::vector<std::string> replacements;
+        for (size_t entry = 0; entry < patterns.size(); ++entry) {
+            replacements.push_back(randomText(random, ALPHABET, random() % 4));
+        }
+        std::string text = randomText(random, ALPHABET, random() % 200);
+        CHECK(replaceSimultaneously(text, patterns, replacements) == replaceLeftmostLongest(text, patterns, replacements));
+    }
+}
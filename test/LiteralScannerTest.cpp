@@ -0,0 +1,110 @@
+// This file is part of Notepad++ project
+// Copyright (C)2023 Thomas Knoefel
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "Test.h"
+#include "LiteralScanner.h"
+
+#include <algorithm>
+
+static const char* const KERNELS[] = { "AVX2", "SSE2", "scalar" };
+
+// Bytes around the case bit of letters, and a byte with the high bit set
+static const std::string ALPHABET = "aAbB@`[{\xC1\xE1";
+
+static unsigned char foldAscii(unsigned char c) {
+    return (c >= 'A' && c <= 'Z') ? static_cast<unsigned char>(c + 32) : c;
+}
+
+static std::vector<size_t> expectedStarts(const std::string& text, size_t from, size_t rangeEnd, const std::string& needle, bool matchCase) {
+    std::vector<size_t> starts;
+    for (size_t pos = from; pos + needle.size() <= rangeEnd; ++pos) {
+        size_t i = 0;
+        while (i < needle.size() && (matchCase ? text[pos + i] == needle[i]
+            : foldAscii(static_cast<unsigned char>(text[pos + i])) == foldAscii(static_cast<unsigned char>(needle[i])))) {
+            ++i;
+        }
+        if (i == needle.size()) {
+            starts.push_back(pos);
+        }
+    }
+    return starts;
+}
+
+static std::vector<size_t> scannedStarts(const std::string& text, size_t from, size_t rangeEnd, const std::string& needle, bool matchCase) {
+    LiteralScanner scanner;
+    scanner.setPattern(needle, matchCase);
+    std::vector<size_t> starts;
+    size_t matchLength;
+    for (size_t pos = scanner.find(text.data(), from, rangeEnd, matchLength); pos < rangeEnd;
+        pos = scanner.find(text.data(), pos + 1, rangeEnd, matchLength)) {
+        starts.push_back(pos);
+    }
+    return starts;
+}
+
+TEST(literalKernelsMatchReference) {
+    std::mt19937 random(12);
+    std::string runtimeKernel = LiteralScanner::kernelName();
+    for (const char* name : KERNELS) {
+        if (!LiteralScanner::useKernel(name)) {
+            std::printf("  %s kernel not available, skipped\n", name);
+            continue;
+        }
+        for (int round = 0; round < 2000; ++round) {
+            std::string text = randomText(random, ALPHABET, random() % 200);
+            std::string needle = randomText(random, ALPHABET, 1 + random() % 6);
+            bool matchCase = (random() % 2 == 0);
+
+            // Plant the needle across a 16 or 32 byte block edge of the scan
+            size_t from = random() % 8;
+            size_t edge = from + 16 * (1 + random() % 4);
+            size_t plant = edge - 1 - random() % needle.size();
+            if (plant + needle.size() <= text.size()) {
+                text.replace(plant, needle.size(), needle);
+            }
+            size_t rangeEnd = text.size() - (text.empty() ? 0 : random() % std::min<size_t>(text.size(), 40));
+            if (from > rangeEnd) {
+                from = rangeEnd;
+            }
+
+            CHECK(scannedStarts(text, from, rangeEnd, needle, matchCase) == expectedStarts(text, from, rangeEnd, needle, matchCase));
+        }
+    }
+    LiteralScanner::useKernel(runtimeKernel);
+}
+
+TEST(literalKernelsFindAnyByte) {
+    std::mt19937 random(13);
+    std::string runtimeKernel = LiteralScanner::kernelName();
+    for (const char* name : KERNELS) {
+        if (!LiteralScanner::useKernel(name)) {
+            continue;
+        }
+        for (int round = 0; round < 2000; ++round) {
+            std::string text = randomText(random, ALPHABET, random() % 200);
+            // Up to 12 bytes, more than the vector kernels compare at once
+            std::string bytes = randomText(random, "abcdefghijklmnopqrstuvwxyz\xC1", 1 + random() % 12);
+            size_t from = text.empty() ? 0 : random() % text.size();
+
+            size_t expected = text.find_first_of(bytes, from);
+            if (expected == std::string::npos) {
+                expected = text.size();
+            }
+            CHECK(LiteralScanner::findAnyByte(text.data(), from, text.size(), bytes) == expected);
+        }
+    }
+    LiteralScanner::useKernel(runtimeKernel);
+}
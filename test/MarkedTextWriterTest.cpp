@@ -0,0 +1,116 @@
+// This file is part of Notepad++ project
+// Copyright (C)2023 Thomas Knoefel
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "Test.h"
+#include "MarkedTextWriter.h"
+
+struct Block {
+    size_t line;
+    size_t column;
+    std::string entry;
+    std::string text;
+};
+
+static std::string writeBlocks(MarkedTextFormat format, const std::string& eol, const std::vector<Block>& blocks) {
+    std::string output;
+    MarkedTextWriter writer(format, eol, [&output](const char* data, size_t length) {
+        output.append(data, length);
+        return true;
+    });
+    for (const Block& block : blocks) {
+        CHECK(writer.beginBlock(block.line, block.column, block.entry));
+        CHECK(writer.appendText(block.text.data(), block.text.size()));
+        CHECK(writer.endBlock());
+    }
+    CHECK(writer.finish());
+    CHECK(writer.blockCount() == blocks.size());
+    return output;
+}
+
+TEST(markedTextWriterFormatsBlocks) {
+    // "ab\r\ncd" marked at the start, across the line break by a second entry overlapping the first, and at the end
+    const std::vector<Block> blocks = {
+        { 0, 0, "x", "ab" },
+        { 0, 1, "y, \"z\"", "b\r\n" },
+        { 1, 1, "x", "d" },
+    };
+    CHECK(writeBlocks(MarkedTextFormat::Plain, "\r\n", blocks) == "abb\r\nd");
+    CHECK(writeBlocks(MarkedTextFormat::Lines, "\r\n", blocks) == "ab\r\nb\r\n\r\nd\r\n");
+    CHECK(writeBlocks(MarkedTextFormat::Lines, "\n", blocks) == "ab\nb\r\n\nd\n");
+    CHECK(writeBlocks(MarkedTextFormat::Positions, "\r\n", blocks) == "1:1\tab\r\n1:2\tb\r\n\r\n2:2\td\r\n");
+    CHECK(writeBlocks(MarkedTextFormat::Csv, "\r\n", blocks) ==
+        "Line,Column,Entry,Text\r\n1,1,x,\"ab\"\r\n1,2,\"y, \"\"z\"\"\",\"b\r\n\"\r\n2,2,x,\"d\"\r\n");
+
+    // Quotes in the text are doubled, empty blocks still count
+    CHECK(writeBlocks(MarkedTextFormat::Csv, "\n", { { 4, 0, "e", "say \"hi\"" }, { 5, 2, "e", "" } }) ==
+        "Line,Column,Entry,Text\n5,1,e,\"say \"\"hi\"\"\"\n6,3,e,\"\"\n");
+    CHECK(writeBlocks(MarkedTextFormat::Lines, "\n", { { 0, 0, "e", "" } }) == "\n");
+    CHECK(writeBlocks(MarkedTextFormat::Csv, "\n", {}) == "Line,Column,Entry,Text\n");
+    CHECK(writeBlocks(MarkedTextFormat::Plain, "\n", {}).empty());
+}
+
+TEST(markedTextWriterFlushesWholeCharacters) {
+    // Blocks of three byte characters, appended in pieces that cut characters, reach the sink in whole characters
+    std::mt19937 random(23);
+    std::string text;
+    while (text.size() < 3 * MarkedTextWriter::FLUSH_LENGTH) {
+        text += (random() % 4 == 0) ? "a" : "\xE2\x82\xAC";
+    }
+    for (MarkedTextFormat format : { MarkedTextFormat::Plain, MarkedTextFormat::Csv }) {
+        std::vector<std::string> pieces;
+        MarkedTextWriter writer(format, "\n", [&pieces](const char* data, size_t length) {
+            pieces.emplace_back(data, length);
+            return true;
+        });
+        for (int block = 0; block < 2; ++block) {
+            writer.beginBlock(0, 0, "e");
+            for (size_t done = 0; done < text.size();) {
+                size_t length = std::min<size_t>(1 + random() % 100000, text.size() - done);
+                writer.appendText(text.data() + done, length);
+                done += length;
+            }
+            writer.endBlock();
+        }
+        CHECK(writer.finish());
+
+        std::string output;
+        for (const std::string& piece : pieces) {
+            CHECK(!piece.empty() && (static_cast<unsigned char>(piece[0]) & 0xC0) != 0x80);
+            CHECK(piece.size() <= 2 * MarkedTextWriter::FLUSH_LENGTH);
+            output += piece;
+        }
+        CHECK(pieces.size() > 3);
+        std::string expected = (format == MarkedTextFormat::Csv)
+            ? "Line,Column,Entry,Text\n1,1,e,\"" + text + "\"\n1,1,e,\"" + text + "\"\n" : text + text;
+        CHECK(output == expected);
+    }
+}
+
+TEST(markedTextWriterStopsWithSink) {
+    size_t calls = 0;
+    MarkedTextWriter writer(MarkedTextFormat::Lines, "\n", [&calls](const char*, size_t) {
+        ++calls;
+        return false;
+    });
+    std::string text(MarkedTextWriter::FLUSH_LENGTH, 'a');
+    CHECK(writer.beginBlock(0, 0, "e"));
+    CHECK(!writer.appendText(text.data(), text.size()));
+    CHECK(!writer.endBlock());
+    CHECK(!writer.beginBlock(1, 0, "e"));
+    CHECK(!writer.appendText(text.data(), text.size()));
+    CHECK(!writer.finish());
+    CHECK(calls == 1);
+}
@@ -0,0 +1,120 @@
+// This file is part of Notepad++ project
+// Copyright (C)2023 Thomas Knoefel
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "Test.h"
+#include "MatchIndex.h"
+
+#include <algorithm>
+
+// ASCII letters in both cases, sharp s and long s folding into "ss", a lone lead and trail byte, punctuation
+static const std::vector<std::string> PIECES = { "a", "b", "A", " ", "ab", "\xC3\x9F", "s", "S", "\xC5\xBF", "_", ";", "\xC3", "\x9F", "k" };
+
+static std::vector<ListMatch> findIn(const ListMatcher& matcher, const std::string& text, size_t rangeStart, size_t rangeEnd) {
+    // Read the context around the range as the panel does
+    size_t readStart = (rangeStart > ListMatcher::CONTEXT_LENGTH) ? rangeStart - ListMatcher::CONTEXT_LENGTH : 0;
+    size_t readEnd = std::min(rangeEnd + ListMatcher::CONTEXT_LENGTH, text.size());
+    std::vector<ListMatch> found;
+    matcher.findAll(text.data() + readStart, readEnd - readStart, rangeStart - readStart, rangeEnd - readStart, found);
+    for (ListMatch& match : found) {
+        match.pos += readStart;
+    }
+    return found;
+}
+
+static void replace(MatchIndex& index, const ListMatcher& matcher, std::string& text, size_t pos, size_t length, const std::string& newText) {
+    text.replace(pos, length, newText);
+    size_t rescanStart, rescanEnd;
+    index.replaced(pos, length, newText.size(), rescanStart, rescanEnd);
+    index.addRescanned(findIn(matcher, text, rescanStart, std::min(rescanEnd, text.size())));
+}
+
+static bool sameMatch(const ListMatch* a, const ListMatch* b) {
+    if (a == nullptr || b == nullptr) {
+        return a == b;
+    }
+    return a->pos == b->pos && a->length == b->length && a->pattern == b->pattern;
+}
+
+// What searching every entry on its own would find: forward the first start at or behind pos, backward each
+// entry's last occurrence ending at or before pos, the one ending last winning
+static void searchEntries(const std::vector<ListMatch>& found, size_t entryCount, size_t pos, const ListMatch*& next, const ListMatch*& previous) {
+    next = nullptr;
+    previous = nullptr;
+    for (size_t entry = 0; entry < entryCount; ++entry) {
+        const ListMatch* entryNext = nullptr;
+        const ListMatch* entryPrevious = nullptr;
+        for (const ListMatch& match : found) {
+            if (match.pattern != entry) {
+                continue;
+            }
+            if (match.pos >= pos && (entryNext == nullptr || match.pos < entryNext->pos)) {
+                entryNext = &match;
+            }
+            if (match.pos < pos && match.pos + match.length <= pos && (entryPrevious == nullptr || match.pos > entryPrevious->pos)) {
+                entryPrevious = &match;
+            }
+        }
+        if (entryNext != nullptr && (next == nullptr || entryNext->pos < next->pos)) {
+            next = entryNext;
+        }
+        if (entryPrevious != nullptr && (previous == nullptr || entryPrevious->pos + entryPrevious->length > previous->pos + previous->length)) {
+            previous = entryPrevious;
+        }
+    }
+}
+
+TEST(matchIndexRepairMatchesFullSearch) {
+    std::mt19937 random(14);
+    for (int round = 0; round < 1500; ++round) {
+        std::vector<ListPattern> patterns(1 + random() % 4);
+        for (ListPattern& pattern : patterns) {
+            pattern = { randomPieces(random, PIECES, 1 + random() % 3), random() % 2 == 0, random() % 2 == 0 };
+        }
+        ListMatcher matcher;
+        matcher.build(patterns);
+
+        std::string text = randomPieces(random, PIECES, random() % 80);
+        MatchIndex index;
+        index.assign(findIn(matcher, text, 0, text.size()), patterns.size(), matcher.maxPatternLength());
+
+        for (int edit = 0; edit < 10; ++edit) {
+            // Scintilla reports a replacement as a deletion and an insertion
+            size_t pos = random() % (text.size() + 1);
+            size_t length = std::min<size_t>(random() % 4, text.size() - pos);
+            std::string newText = randomPieces(random, PIECES, random() % 3);
+            if (length > 0) {
+                replace(index, matcher, text, pos, length, "");
+            }
+            if (!newText.empty()) {
+                replace(index, matcher, text, pos, 0, newText);
+            }
+
+            std::vector<ListMatch> found = findIn(matcher, text, 0, text.size());
+            CHECK(index.size() == found.size());
+            for (size_t entry = 0; entry < patterns.size(); ++entry) {
+                CHECK(index.count(entry) == static_cast<size_t>(std::count_if(found.begin(), found.end(),
+                    [entry](const ListMatch& match) { return match.pattern == entry; })));
+            }
+            for (size_t at = 0; at <= text.size(); ++at) {
+                const ListMatch* next;
+                const ListMatch* previous;
+                searchEntries(found, patterns.size(), at, next, previous);
+                CHECK(sameMatch(index.next(at), next));
+                CHECK(sameMatch(index.previous(at), previous));
+            }
+        }
+    }
+}
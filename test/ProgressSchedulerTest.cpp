@@ -0,0 +1,75 @@
+// This file is part of Notepad++ project
+// Copyright (C)2023 Thomas Knoefel
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "Test.h"
+#include "ProgressScheduler.h"
+
+#include <atomic>
+#include <thread>
+
+TEST(cancelFromOtherThreadStopsWithinOneStep) {
+    for (int round = 0; round < 50; ++round) {
+        ProgressScheduler scheduler(1000000000, 0, std::chrono::milliseconds(1), [](const ProgressInfo&) {});
+        std::atomic<size_t> steps{ 0 };
+
+        std::thread worker([&] {
+            for (size_t step = 1; scheduler.update(step, step, step); ++step) {
+                steps = step;
+            }
+        });
+
+        while (steps < 1000 + static_cast<size_t>(round) * 100) {
+            std::this_thread::yield();
+        }
+        scheduler.cancel();
+        size_t stepsAtCancel = steps;
+        worker.join();
+
+        // The step in progress while cancel() ran may still complete, the next update() must stop the loop
+        CHECK(scheduler.isCancelled());
+        CHECK(steps <= stepsAtCancel + 1);
+    }
+}
+
+TEST(cancelFromReportStopsAtThatStep) {
+    ProgressScheduler* current = nullptr;
+    size_t reports = 0;
+    ProgressScheduler scheduler(1000000000, 0, std::chrono::milliseconds(0), [&](const ProgressInfo& info) {
+        ++reports;
+        if (info.done == 500) {
+            current->cancel();
+        }
+    });
+    current = &scheduler;
+
+    size_t step = 1;
+    while (scheduler.update(step, 0, 0)) {
+        ++step;
+    }
+    CHECK(step == 500);
+    CHECK(reports == 500);
+}
+
+TEST(shortRunsAreNotReported) {
+    size_t reports = 0;
+    ProgressScheduler scheduler(100, 100, std::chrono::milliseconds(0), [&](const ProgressInfo&) { ++reports; });
+    CHECK(!scheduler.isReporting());
+    for (size_t step = 1; step <= 100; ++step) {
+        CHECK(scheduler.update(step, 0, 0));
+    }
+    CHECK(reports == 0);
+    CHECK(scheduler.progress().done == 100);
+}
@@ -0,0 +1,185 @@
+// This file is part of Notepad++ project
+// Copyright (C)2023 Thomas Knoefel
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+// Replace All benchmark: applies the occurrences of a generated text once match by match, the way
+// performReplace() does, and once as the coalesced edits of ListMatcher::buildEdits(), which the panel sends
+// for literal entries. The document is a gap buffer like Scintilla's, and every call into it stands for the
+// Scintilla messages the panel sends for it.
+//
+// Usage: replace-benchmark [matches]     (default 1000000)
+
+#include "ListMatcher.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+// Same limits as MultiReplace::EDIT_COALESCE_GAP and EDIT_MAX_SPAN
+static const size_t EDIT_COALESCE_GAP = 4096;
+static const size_t EDIT_MAX_SPAN = 1 << 20;
+
+// Messages per replacement: SCI_SETTARGETRANGE, SCI_REPLACETARGET, SCI_GETTARGETEND and the caret
+// (SCI_SETCURRENTPOS, SCI_SETSELECTIONSTART, SCI_SETSELECTIONEND). The search for the match is not counted.
+static const size_t MATCH_MESSAGES = 6;
+// Messages per coalesced edit: SCI_SETTARGETRANGE, SCI_REPLACETARGET; the caret is set once at the end
+static const size_t EDIT_MESSAGES = 2;
+static const size_t CARET_MESSAGES = 3;
+
+// Text with a movable gap, as Scintilla stores a document
+class GapBuffer
+{
+public:
+    explicit GapBuffer(const std::string& text) : body(text), gapStart(text.size()), gapLength(0) {}
+
+    void replace(size_t pos, size_t length, const char* text, size_t textLength) {
+        moveGap(pos);
+        gapLength += length;
+        if (textLength > gapLength) {
+            grow(textLength);
+        }
+        std::memcpy(&body[gapStart], text, textLength);
+        gapStart += textLength;
+        gapLength -= textLength;
+    }
+
+    std::string text() const {
+        return body.substr(0, gapStart) + body.substr(gapStart + gapLength);
+    }
+
+private:
+    std::string body;
+    size_t gapStart;
+    size_t gapLength;
+
+    void moveGap(size_t pos) {
+        if (pos < gapStart) {
+            std::memmove(&body[pos + gapLength], &body[pos], gapStart - pos);
+        }
+        else if (pos > gapStart) {
+            std::memmove(&body[gapStart], &body[gapStart + gapLength], pos - gapStart);
+        }
+        gapStart = pos;
+    }
+
+    void grow(size_t needed) {
+        size_t extra = needed + body.size() / 8;
+        size_t tail = body.size() - gapStart - gapLength;
+        body.resize(body.size() + extra);
+        std::memmove(&body[body.size() - tail], &body[gapStart + gapLength], tail);
+        gapLength += extra;
+    }
+};
+
+struct RunResult {
+    std::string text;
+    size_t calls = 0;
+    size_t messages = 0;
+    double seconds = 0;
+};
+
+static double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Lines of filler words with an entry every few words, until matchCount occurrences are in the text
+static std::string generateText(const std::vector<ListPattern>& patterns, size_t matchCount) {
+    static const char* const filler[] = { "lorem", "ipsum", "dolor", "sit", "amet", "elit", "sed", "tempor" };
+    std::mt19937 random(42);
+    std::string text;
+    size_t placed = 0;
+    size_t words = 0;
+    while (placed < matchCount) {
+        if (random() % 3 == 0) {
+            text += patterns[random() % patterns.size()].findText;
+            ++placed;
+        }
+        else {
+            text += filler[random() % (sizeof(filler) / sizeof(filler[0]))];
+        }
+        text += (++words % 12 == 0) ? '\n' : ' ';
+    }
+    return text;
+}
+
+static RunResult replacePerMatch(const std::string& original, const std::vector<ListMatch>& selected, const std::vector<std::string>& replacements) {
+    RunResult result;
+    auto start = std::chrono::steady_clock::now();
+    GapBuffer document(original);
+    ptrdiff_t delta = 0;
+    for (const ListMatch& match : selected) {
+        const std::string& replacement = replacements[match.pattern];
+        document.replace(match.pos + delta, match.length, replacement.data(), replacement.size());
+        delta += static_cast<ptrdiff_t>(replacement.size()) - static_cast<ptrdiff_t>(match.length);
+        ++result.calls;
+        result.messages += MATCH_MESSAGES;
+    }
+    result.seconds = secondsSince(start);
+    result.text = document.text();
+    return result;
+}
+
+static RunResult replaceInEdits(const std::string& original, const std::vector<ListMatch>& selected, const std::vector<std::string>& replacements) {
+    RunResult result;
+    auto start = std::chrono::steady_clock::now();
+    std::vector<ListEdit> edits;
+    std::string buffer;
+    ListMatcher::buildEdits(original.data(), selected, replacements, EDIT_COALESCE_GAP, EDIT_MAX_SPAN, edits, buffer);
+
+    GapBuffer document(original);
+    ptrdiff_t delta = 0;
+    for (const ListEdit& edit : edits) {
+        document.replace(edit.pos + delta, edit.length, buffer.data() + edit.bufferPos, edit.bufferLength);
+        delta += static_cast<ptrdiff_t>(edit.bufferLength) - static_cast<ptrdiff_t>(edit.length);
+        ++result.calls;
+        result.messages += EDIT_MESSAGES;
+    }
+    result.messages += edits.empty() ? 0 : CARET_MESSAGES;
+    result.seconds = secondsSince(start);
+    result.text = document.text();
+    return result;
+}
+
+int main(int argc, char* argv[]) {
+    size_t matchCount = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 1000000;
+
+    std::vector<ListPattern> patterns = { { "alpha", false, true }, { "beta", true, false }, { "gamma delta", false, false } };
+    std::vector<std::string> replacements = { "ALPHA", "b", "gamma-delta-epsilon" };
+    std::string text = generateText(patterns, matchCount);
+
+    ListMatcher matcher;
+    matcher.build(patterns);
+    std::vector<ListMatch> candidates;
+    matcher.findAll(text.data(), text.size(), 0, text.size(), candidates);
+    std::vector<ListMatch> selected = ListMatcher::selectLeftmostLongestMatches(std::move(candidates));
+
+    std::printf("Text: %zu bytes, %zu matches\n", text.size(), selected.size());
+
+    RunResult perMatch = replacePerMatch(text, selected, replacements);
+    RunResult inEdits = replaceInEdits(text, selected, replacements);
+
+    std::printf("%-12s %10s %12s %10s\n", "Path", "Edits", "Messages", "Seconds");
+    std::printf("%-12s %10zu %12zu %10.3f\n", "Per match", perMatch.calls, perMatch.messages, perMatch.seconds);
+    std::printf("%-12s %10zu %12zu %10.3f\n", "Coalesced", inEdits.calls, inEdits.messages, inEdits.seconds);
+
+    if (perMatch.text != inEdits.text) {
+        std::fprintf(stderr, "Results differ\n");
+        return 1;
+    }
+    return 0;
+}
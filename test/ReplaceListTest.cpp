@@ -0,0 +1,117 @@
+// This file is part of Notepad++ project
+// Copyright (C)2023 Thomas Knoefel
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "Test.h"
+#include "ReplaceList.h"
+
+static const char* const HEADER = "Selected,Find,Replace,WholeWord,MatchCase,UseVariables,Extended,Regex,Fuzzy\n";
+
+static std::vector<ReplaceListEntry> parse(const std::string& rows) {
+    std::vector<ReplaceListEntry> list;
+    parseReplaceListCsv(HEADER + rows, "list.csv", list);
+    return list;
+}
+
+static bool isRejected(const std::string& rows) {
+    try {
+        parse(rows);
+    }
+    catch (const CsvLoadException&) {
+        return true;
+    }
+    return false;
+}
+
+// Quoted like MultiReplace::escapeCsvValue(), and for line breaks as well
+static std::string csvField(const std::string& value) {
+    std::string field;
+    bool needsQuotes = false;
+    for (char ch : value) {
+        needsQuotes = needsQuotes || ch == ',' || ch == '"' || ch == '\n' || ch == '\r';
+        field += ch;
+        if (ch == '"') {
+            field += ch;
+        }
+    }
+    return needsQuotes ? '"' + field + '"' : field;
+}
+
+static bool sameEntry(const ReplaceListEntry& a, const ReplaceListEntry& b) {
+    return a.isSelected == b.isSelected && a.findText == b.findText && a.replaceText == b.replaceText &&
+        a.wholeWord == b.wholeWord && a.matchCase == b.matchCase && a.useVariables == b.useVariables &&
+        a.extended == b.extended && a.regex == b.regex && a.fuzzy == b.fuzzy;
+}
+
+TEST(replaceListReadsQuotedFieldsAndFlags) {
+    std::vector<ReplaceListEntry> list = parse(
+        "1,plain,text,0,1,0,0,0,0\n"
+        "0,\"a,b\",\"say \"\"hi\"\"\",1,0,1,1,0,2\r\n"
+        "1,\"two\nlines\",\"\",0,0,0,0,1\n"
+        "2,x,,1,1,1,1,1,0");
+    CHECK(list.size() == 4);
+    if (list.size() != 4) {
+        return;
+    }
+    CHECK(list[0].isSelected && list[0].findText == "plain" && list[0].replaceText == "text" && list[0].matchCase);
+    CHECK(!list[0].wholeWord && !list[0].useVariables && !list[0].extended && !list[0].regex && list[0].fuzzy == 0);
+    CHECK(!list[1].isSelected && list[1].findText == "a,b" && list[1].replaceText == "say \"hi\"");
+    CHECK(list[1].wholeWord && !list[1].matchCase && list[1].useVariables && list[1].extended && !list[1].regex && list[1].fuzzy == 2);
+    // Lists saved before the Fuzzy column have eight columns
+    CHECK(list[2].findText == "two\nlines" && list[2].replaceText.empty() && list[2].regex && list[2].fuzzy == 0);
+    // Any number other than 0 is set
+    CHECK(list[3].isSelected && list[3].wholeWord && list[3].matchCase && list[3].regex && list[3].replaceText.empty());
+
+    CHECK(parse("").empty());
+    CHECK(parse("1,a,b,0,0,0,0,0,0\n").size() == 1);
+}
+
+TEST(replaceListRejectsMalformedRows) {
+    CHECK(isRejected("1,a,b,0,0,0,0\n"));                      // Too few columns
+    CHECK(isRejected("1,a,b,0,0,0,0,0,0,0\n"));                // Too many
+    CHECK(isRejected("1,a,b,0,0,0,0,0,0\n\n1,a,b,0,0,0,0,0,0\n")); // Empty row
+    CHECK(isRejected("yes,a,b,0,0,0,0,0,0\n"));                // Not a number
+    CHECK(isRejected("1,a,b,0,0,0,0,0,\n"));                   // Empty number
+    CHECK(isRejected("1,a,b,99999999999999999999,0,0,0,0,0\n")); // Out of range
+    CHECK(isRejected("1,\"a,b,0,0,0,0,0,0\n"));                // Unclosed quote takes the rest of the row
+}
+
+TEST(replaceListReadsWhatThePanelWrites) {
+    std::mt19937 random(8);
+    for (int round = 0; round < 500; ++round) {
+        std::vector<ReplaceListEntry> written(random() % 6);
+        std::string rows;
+        for (ReplaceListEntry& entry : written) {
+            entry.isSelected = random() % 2 == 0;
+            entry.findText = randomText(random, "ab,\"\n\r \xC3\xA4", 1 + random() % 8);
+            entry.replaceText = randomText(random, "ab,\"\n\r \xC3\xA4", random() % 8);
+            entry.wholeWord = random() % 2 == 0;
+            entry.matchCase = random() % 2 == 0;
+            entry.useVariables = random() % 2 == 0;
+            entry.extended = random() % 2 == 0;
+            entry.regex = random() % 2 == 0;
+            entry.fuzzy = random() % 4;
+            rows += std::to_string(entry.isSelected) + ',' + csvField(entry.findText) + ',' + csvField(entry.replaceText) + ',' +
+                std::to_string(entry.wholeWord) + ',' + std::to_string(entry.matchCase) + ',' + std::to_string(entry.useVariables) + ',' +
+                std::to_string(entry.extended) + ',' + std::to_string(entry.regex) + ',' + std::to_string(entry.fuzzy) +
+                ((random() % 2 == 0) ? "\r\n" : "\n");
+        }
+        std::vector<ReplaceListEntry> read = parse(rows);
+        CHECK(read.size() == written.size());
+        for (size_t i = 0; i < read.size() && i < written.size(); ++i) {
+            CHECK(sameEntry(read[i], written[i]));
+        }
+    }
+}
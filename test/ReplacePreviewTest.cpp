@@ -0,0 +1,123 @@
+// This file is part of Notepad++ project
+// Copyright (C)2023 Thomas Knoefel
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "Test.h"
+#include "ReplacePreview.h"
+
+#include <algorithm>
+
+static const std::string ALPHABET = "aAbB c\n";
+
+// The text with the before part of every previewed line replaced by its after part, all pages read in order
+static std::string applyPages(ReplacePreview& preview, const std::string& text, size_t linesPerPage) {
+    std::vector<size_t> lineStarts = { 0 };
+    for (size_t pos = 0; pos < text.size(); ++pos) {
+        if (text[pos] == '\n') {
+            lineStarts.push_back(pos + 1);
+        }
+    }
+    lineStarts.push_back(text.size() + 1);
+
+    std::string output;
+    size_t copied = 0;
+    std::vector<PreviewLine> lines;
+    for (size_t pageIndex = 0; preview.page(text.data(), text.size(), pageIndex, linesPerPage, lines); ++pageIndex) {
+        CHECK(!lines.empty() && lines.size() <= linesPerPage);
+        for (const PreviewLine& line : lines) {
+            CHECK(line.lineNumber + line.lineCount < lineStarts.size());
+            if (line.lineNumber + line.lineCount >= lineStarts.size()) {
+                return std::string();
+            }
+            size_t start = lineStarts[line.lineNumber];
+            size_t end = lineStarts[line.lineNumber + line.lineCount] - 1;
+            CHECK(start >= copied);
+            CHECK(line.before == text.substr(start, end - start));
+            output.append(text, copied, start - copied);
+            output.append(line.after);
+            copied = end;
+        }
+    }
+    output.append(text, copied, std::string::npos);
+    return output;
+}
+
+// The text with the range of every edit replaced by its slice of the buffer
+static std::string applyEdits(const std::string& text, const std::vector<ListEdit>& edits, const std::string& buffer) {
+    std::string output;
+    size_t copied = 0;
+    for (const ListEdit& edit : edits) {
+        output.append(text, copied, edit.pos - copied);
+        output.append(buffer, edit.bufferPos, edit.bufferLength);
+        copied = edit.pos + edit.length;
+    }
+    output.append(text, copied, std::string::npos);
+    return output;
+}
+
+TEST(replacePreviewAgreesWithReplaceAll) {
+    std::mt19937 random(7);
+    CharClass classes[256];
+    wordClasses(classes);
+    for (int round = 0; round < 3000; ++round) {
+        ListMatcher matcher;
+        matcher.setCharClasses(classes, true);
+        matcher.build(randomPatterns(random, ALPHABET, 6, 5));
+        std::vector<std::string> replacements;
+        for (size_t entry = 0; entry < matcher.patternCount(); ++entry) {
+            replacements.push_back(randomText(random, ALPHABET, random() % 4));
+        }
+        std::string text = randomText(random, ALPHABET, random() % 300);
+
+        // The selection of either list mode, as the panel hands it to both
+        std::vector<ListMatch> candidates;
+        matcher.findAll(text.data(), text.size(), 0, text.size(), candidates);
+        bool simultaneous = (random() % 2 == 0);
+        std::vector<ListMatch> selected = simultaneous ? ListMatcher::selectLeftmostLongestMatches(candidates)
+            : matcher.selectSequentialMatches(candidates);
+
+        std::string replaced;
+        std::vector<size_t> outputPositions;
+        ListMatcher::buildReplacedText(text.data(), text.size(), selected, replacements, replaced, outputPositions);
+        std::vector<ListEdit> edits;
+        std::string buffer;
+        ListMatcher::buildEdits(text.data(), selected, replacements, random() % 8, 1 + random() % 64, edits, buffer);
+        CHECK(applyEdits(text, edits, buffer) == replaced);
+
+        std::vector<size_t> entryHits(matcher.patternCount(), 0);
+        size_t editedHits = 0;
+        for (const ListMatch& match : selected) {
+            ++entryHits[match.pattern];
+        }
+        for (const ListEdit& edit : edits) {
+            editedHits += edit.matchCount;
+        }
+
+        ReplacePreview preview;
+        preview.setMatches(selected, replacements, matcher.patternCount());
+        CHECK(preview.entryHits() == entryHits);
+        CHECK(preview.totalHits() == outputPositions.size());
+        CHECK(preview.totalHits() == editedHits);
+        CHECK(applyPages(preview, text, 1 + random() % 5) == replaced);
+
+        // Without cascading entries the chained run of the same list ends where the single pass does
+        if (!simultaneous && !matcher.hasCascadingMatches(text.data(), text.size(), selected, replacements)) {
+            ReplacePreview chained;
+            chained.runSequential(text.data(), text.size(), matcher, replacements, classes, true, false);
+            CHECK(chained.entryHits() == entryHits);
+            CHECK(!chained.hasDiff() || applyPages(chained, text, 1 + random() % 5) == replaced);
+        }
+    }
+}
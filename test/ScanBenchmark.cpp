@@ -0,0 +1,138 @@
+// This file is part of Notepad++ project
+// Copyright (C)2023 Thomas Knoefel
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+// Literal search benchmark: counts the occurrences of single entries in a generated text with every
+// LiteralScanner kernel available here, with the list automaton and with a compare at every position,
+// which stands in for Scintilla's literal search (SCI_SEARCHINTARGET cannot run outside Notepad++).
+//
+// Usage: scan-benchmark [megabytes]      (default 128)
+
+#include "ListMatcher.h"
+#include "LiteralScanner.h"
+
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+struct SearchCase {
+    const char* findText;
+    bool matchCase;
+};
+
+static double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Lines of words, about one in eighty of them a search term
+static std::string generateText(size_t size) {
+    static const char* const words[] = { "order", "account", "payment", "delivery", "address", "status", "total",
+        "amount", "date", "number", "reference", "item", "quantity", "price", "tax", "note" };
+    static const char* const terms[] = { "customer", "Customer", "invoice", "INVOICE" };
+    std::mt19937 random(7);
+    std::string text;
+    text.reserve(size + 64);
+    size_t wordCount = 0;
+    while (text.size() < size) {
+        text += (random() % 80 == 0) ? terms[random() % 4] : words[random() % 16];
+        text += (++wordCount % 10 == 0) ? '\n' : ' ';
+    }
+    return text;
+}
+
+static size_t countScanner(const std::string& text, const SearchCase& search) {
+    LiteralScanner scanner;
+    scanner.setPattern(search.findText, search.matchCase);
+    size_t count = 0;
+    size_t matchLength;
+    for (size_t pos = scanner.find(text.data(), 0, text.size(), matchLength); pos < text.size();
+        pos = scanner.find(text.data(), pos + matchLength, text.size(), matchLength)) {
+        ++count;
+    }
+    return count;
+}
+
+static size_t countAutomaton(const std::string& text, const SearchCase& search) {
+    // A second entry that never occurs keeps the matcher from taking the single entry scanner
+    ListMatcher matcher;
+    matcher.build({ { search.findText, false, search.matchCase }, { "\x01\x02", false, true } });
+    std::vector<ListMatch> matches;
+    matcher.findAll(text.data(), text.size(), 0, text.size(), matches);
+    return ListMatcher::selectPatternMatches(std::move(matches)).size();
+}
+
+static size_t countPerPosition(const std::string& text, const SearchCase& search) {
+    std::string needle = search.findText;
+    size_t count = 0;
+    for (size_t pos = 0; pos + needle.size() <= text.size(); ) {
+        size_t i = 0;
+        while (i < needle.size() && (search.matchCase ? text[pos + i] == needle[i]
+            : std::tolower(static_cast<unsigned char>(text[pos + i])) == std::tolower(static_cast<unsigned char>(needle[i])))) {
+            ++i;
+        }
+        if (i == needle.size()) {
+            ++count;
+            pos += needle.size();
+        }
+        else {
+            ++pos;
+        }
+    }
+    return count;
+}
+
+int main(int argc, char* argv[]) {
+    size_t megabytes = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 128;
+    std::string text = generateText(megabytes << 20);
+    std::printf("Text: %zu bytes, runtime kernel %s\n", text.size(), LiteralScanner::kernelName());
+
+    const SearchCase cases[] = { { "customer", true }, { "invoice", false }, { "zebra", true } };
+    const char* const kernels[] = { "AVX2", "SSE2", "scalar" };
+    std::string runtimeKernel = LiteralScanner::kernelName();
+    bool same = true;
+
+    std::printf("%-10s %-6s %-14s %10s %10s\n", "Entry", "Case", "Path", "Hits", "Seconds");
+    for (const SearchCase& search : cases) {
+        auto report = [&](const char* path, size_t (*count)(const std::string&, const SearchCase&), size_t& expected) {
+            auto start = std::chrono::steady_clock::now();
+            size_t hits = count(text, search);
+            double seconds = secondsSince(start);
+            std::printf("%-10s %-6s %-14s %10zu %10.3f\n", search.findText, search.matchCase ? "match" : "any", path, hits, seconds);
+            if (expected == static_cast<size_t>(-1)) {
+                expected = hits;
+            }
+            same = same && (hits == expected);
+        };
+
+        size_t expected = static_cast<size_t>(-1);
+        for (const char* kernel : kernels) {
+            if (LiteralScanner::useKernel(kernel)) {
+                report(kernel, countScanner, expected);
+            }
+        }
+        LiteralScanner::useKernel(runtimeKernel);
+        report("automaton", countAutomaton, expected);
+        report("per position", countPerPosition, expected);
+    }
+
+    if (!same) {
+        std::fprintf(stderr, "Hit counts differ\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,151 @@
+// This file is part of Notepad++ project
+// Copyright (C)2023 Thomas Knoefel
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "Test.h"
+#include "SearchScope.h"
+
+#include <algorithm>
+
+static bool sameRanges(const std::vector<ScopeRange>& a, const std::vector<ScopeRange>& b) {
+    return std::equal(a.begin(), a.end(), b.begin(), b.end(), [](const ScopeRange& x, const ScopeRange& y) {
+        return x.start == y.start && x.end == y.end && x.column == y.column;
+    });
+}
+
+// A selection boundary after Scintilla deleted length bytes at pos and inserted newLength bytes there:
+// a start at the insert position moves behind the new text, an end only if the selection became empty
+static Sci_Position movedBoundary(Sci_Position p, Sci_Position pos, Sci_Position length, Sci_Position newLength, bool moveForEqual) {
+    p = (p > pos + length) ? p - length : std::min(p, pos);
+    return (p > pos || (p == pos && moveForEqual)) ? p + newLength : p;
+}
+
+TEST(searchScopeMovesSelectionsLikeScintilla) {
+    std::mt19937 random(10);
+    for (int round = 0; round < 500; ++round) {
+        // Sorted selections, some empty, some touching their neighbours
+        Sci_Position textLength = 1 + random() % 200;
+        std::vector<ScopeRange> expected;
+        for (Sci_Position pos = random() % 10; pos < textLength; pos += random() % 20) {
+            Sci_Position end = std::min(textLength, pos + static_cast<Sci_Position>(random() % 8));
+            expected.push_back({ pos, end, 0 });
+            pos = end;
+        }
+        SearchScope scope;
+        scope.assign(expected);
+
+        for (int edit = 0; edit < 40; ++edit) {
+            Sci_Position pos = random() % (textLength + 1);
+            Sci_Position length = (random() % 2 == 0) ? std::min<Sci_Position>(random() % 10, textLength - pos) : 0;
+            Sci_Position newLength = (random() % 2 == 0) ? random() % 10 : 0;
+            scope.replaced(pos, length, newLength);
+            textLength += newLength - length;
+            for (ScopeRange& range : expected) {
+                bool empty = (movedBoundary(range.start, pos, length, 0, false) == movedBoundary(range.end, pos, length, 0, false));
+                range.start = movedBoundary(range.start, pos, length, newLength, true);
+                range.end = movedBoundary(range.end, pos, length, newLength, empty);
+            }
+            CHECK(sameRanges(scope.allRanges(), expected));
+
+            // Searches in between move the cursor the next replacement starts from
+            Sci_Position from = random() % (textLength + 1);
+            size_t first = 0;
+            while (first < expected.size() && expected[first].end <= from) {
+                ++first;
+            }
+            CHECK(scope.findFrom(from) == first);
+        }
+    }
+}
+
+// Cells of the columns in the lines of text starting within [from, to], the way the panel reads them
+static std::vector<ScopeRange> readCells(const std::string& text, const std::vector<int>& columns, size_t from, size_t to) {
+    std::vector<ScopeRange> cells;
+    for (size_t lineStart = 0; lineStart <= text.size();) {
+        size_t lineEnd = std::min(text.find('\n', lineStart), text.size());
+        if (lineStart >= from && lineStart <= to) {
+            std::vector<size_t> starts = { lineStart };
+            std::vector<size_t> ends;
+            for (size_t pos = lineStart; pos < lineEnd; ++pos) {
+                if (text[pos] == ',') {
+                    ends.push_back(pos);
+                    starts.push_back(pos + 1);
+                }
+            }
+            ends.push_back(lineEnd);
+            for (int column : columns) {
+                if (static_cast<size_t>(column) <= starts.size()) {
+                    cells.push_back({ static_cast<Sci_Position>(starts[column - 1]), static_cast<Sci_Position>(ends[column - 1]), column });
+                }
+            }
+        }
+        lineStart = lineEnd + 1;
+    }
+    return cells;
+}
+
+static size_t lineStartAt(const std::string& text, size_t pos) {
+    while (pos > 0 && text[pos - 1] != '\n') {
+        --pos;
+    }
+    return pos;
+}
+
+static size_t lineEndAt(const std::string& text, size_t pos) {
+    return std::min(text.find('\n', pos), text.size());
+}
+
+TEST(searchScopeKeepsCellsLikeNewScan) {
+    std::mt19937 random(11);
+    const std::string alphabet = "ab,\n";
+    for (int round = 0; round < 500; ++round) {
+        std::string text = randomText(random, alphabet, random() % 200);
+        std::vector<int> columns;
+        for (int column = 1; column <= 4; ++column) {
+            if (random() % 2 == 0) {
+                columns.push_back(column);
+            }
+        }
+        SearchScope scope;
+        scope.assignCells(readCells(text, columns, 0, text.size()));
+
+        for (int edit = 0; edit < 40; ++edit) {
+            size_t pos = random() % (text.size() + 1);
+            size_t length = (random() % 2 == 0) ? std::min<size_t>(random() % 10, text.size() - pos) : 0;
+            std::string newText = randomText(random, (random() % 2 == 0) ? "ab" : alphabet, random() % 6);
+            bool layoutChanged = text.substr(pos, length).find_first_of(",\n") != std::string::npos ||
+                newText.find_first_of(",\n") != std::string::npos;
+
+            // As MultiReplace::updateSearchScope(): the ranges move, the lines of a changed layout are read again
+            text.replace(pos, length, newText);
+            scope.replaced(static_cast<Sci_Position>(pos), static_cast<Sci_Position>(length), static_cast<Sci_Position>(newText.size()));
+            if (layoutChanged) {
+                size_t from = lineStartAt(text, pos);
+                size_t to = lineEndAt(text, pos + newText.size());
+                scope.reload(static_cast<Sci_Position>(from), static_cast<Sci_Position>(to), readCells(text, columns, from, to));
+            }
+            CHECK(sameRanges(scope.allRanges(), readCells(text, columns, 0, text.size())));
+
+            // A search from the end of a cell still looks at it
+            Sci_Position from = random() % (text.size() + 1);
+            std::vector<ScopeRange> cells = scope.allRanges();
+            size_t first = 0;
+            while (first < cells.size() && cells[first].end < from) {
+                ++first;
+            }
+            CHECK(scope.findFrom(from) == first);
+        }
+    }
+}
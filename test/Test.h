@@ -0,0 +1,114 @@
+// This file is part of Notepad++ project
+// Copyright (C)2023 Thomas Knoefel
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef TEST_H
+#define TEST_H
+
+// Minimal test registry for the portable engine. TEST(name) defines a test that TestMain.cpp runs;
+// CHECK() records a failure and lets the test continue.
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <tuple>
+#include <vector>
+#include "ListMatcher.h"
+
+struct TestCase {
+    const char* name;
+    void (*run)();
+};
+
+inline std::vector<TestCase>& testCases() {
+    static std::vector<TestCase> cases;
+    return cases;
+}
+
+inline int& testFailures() {
+    static int failures = 0;
+    return failures;
+}
+
+struct TestRegistration {
+    TestRegistration(const char* name, void (*run)()) { testCases().push_back({ name, run }); }
+};
+
+#define TEST(name) \
+    static void name(); \
+    static TestRegistration name##Registration(#name, name); \
+    static void name()
+
+#define CHECK(condition) \
+    do { \
+        if (!(condition)) { \
+            std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition); \
+            ++testFailures(); \
+        } \
+    } while (false)
+
+// Random text over the bytes of alphabet, for differential tests against a simple oracle
+inline std::string randomText(std::mt19937& random, const std::string& alphabet, size_t length) {
+    std::string text(length, ' ');
+    for (char& c : text) {
+        c = alphabet[random() % alphabet.size()];
+    }
+    return text;
+}
+
+// Scintilla's default classes in a UTF-8 document: letters, digits, '_' and all bytes of multi byte characters form words
+inline void wordClasses(CharClass classes[256]) {
+    for (int i = 0; i < 256; ++i) {
+        classes[i] = (std::isalnum(i) || i >= 0x80 || i == '_') ? CharClass::Word
+            : (i == '\n') ? CharClass::NewLine : (i == ' ') ? CharClass::Space : CharClass::Punctuation;
+    }
+}
+
+// Text of count pieces drawn from pieces, for texts built from whole characters or chosen byte sequences
+inline std::string randomPieces(std::mt19937& random, const std::vector<std::string>& pieces, size_t count) {
+    std::string text;
+    for (size_t i = 0; i < count; ++i) {
+        text += pieces[random() % pieces.size()];
+    }
+    return text;
+}
+
+// Up to maxCount entries of up to maxLength bytes of alphabet, a third of them whole word, half of them matching case
+inline std::vector<ListPattern> randomPatterns(std::mt19937& random, const std::string& alphabet, size_t maxCount, size_t maxLength) {
+    std::vector<ListPattern> patterns(1 + random() % maxCount);
+    for (ListPattern& pattern : patterns) {
+        pattern.findText = randomText(random, alphabet, 1 + random() % maxLength);
+        pattern.wholeWord = (random() % 3 == 0);
+        pattern.matchCase = (random() % 2 == 0);
+    }
+    return patterns;
+}
+
+// Same occurrences in the same order
+inline bool sameMatches(const std::vector<ListMatch>& a, const std::vector<ListMatch>& b) {
+    return std::equal(a.begin(), a.end(), b.begin(), b.end(), [](const ListMatch& x, const ListMatch& y) {
+        return x.pos == y.pos && x.length == y.length && x.pattern == y.pattern;
+    });
+}
+
+// Orders occurrences by position, length and entry, for results whose order is not specified
+inline void sortMatches(std::vector<ListMatch>& matches) {
+    std::sort(matches.begin(), matches.end(), [](const ListMatch& a, const ListMatch& b) {
+        return std::tie(a.pos, a.length, a.pattern) < std::tie(b.pos, b.length, b.pattern);
+    });
+}
+
+#endif // TEST_H
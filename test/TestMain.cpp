@@ -0,0 +1,37 @@
+// This file is part of Notepad++ project
+// Copyright (C)2023 Thomas Knoefel
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+// Runs all registered tests, or those whose name contains the first argument
+
+#include "Test.h"
+
+#include <cstring>
+
+int main(int argc, char* argv[]) {
+    const char* filter = (argc > 1) ? argv[1] : "";
+    size_t run = 0;
+    for (const TestCase& test : testCases()) {
+        if (std::strstr(test.name, filter) == nullptr) {
+            continue;
+        }
+        int failuresBefore = testFailures();
+        test.run();
+        std::printf("%-40s %s\n", test.name, (testFailures() == failuresBefore) ? "ok" : "FAILED");
+        ++run;
+    }
+    std::printf("%zu tests, %d failed checks\n", run, testFailures());
+    return (testFailures() == 0) ? 0 : 1;
+}
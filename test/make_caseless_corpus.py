@@ -0,0 +1,128 @@
+#!/usr/bin/env python3
+# Writes CaselessCorpus.txt, the expected results of caseless UTF-8 searches for CaselessCorpusTest.cpp.
+#
+# The expectations come from a model of Scintilla's Document::FindText without SCFIND_MATCHCASE: the text
+# is decoded like UTF8Classify does it (a byte outside a valid sequence is a character of its own), each
+# character is folded with str.casefold() as Scintilla's CaseConvert table is generated, and an occurrence
+# must consume the folded needle exactly, character by character. Occurrences are taken left to right,
+# the next search starting behind the previous occurrence, as Mark and Replace All do.
+#
+# The Unicode version of Python must match the table in src/CaseFolding.cpp.
+
+import random
+import unicodedata
+
+UNICODE_VERSION = '14.0.0'
+
+
+def decode(text, pos):
+    lead = text[pos]
+    if lead < 0x80:
+        return 1, lead
+    width = 0 if lead >= 0xF5 else 4 if lead >= 0xF0 else 3 if lead >= 0xE0 else 2 if lead >= 0xC2 else 0
+    if width == 0 or pos + width > len(text):
+        return 1, None
+    if any(text[pos + i] & 0xC0 != 0x80 for i in range(1, width)):
+        return 1, None
+    second = text[pos + 1]
+    if (lead == 0xE0 and second < 0xA0) or (lead == 0xED and second > 0x9F) or \
+            (lead == 0xF0 and second < 0x90) or (lead == 0xF4 and second > 0x8F):
+        return 1, None
+    return width, ord(text[pos:pos + width].decode('utf-8'))
+
+
+def fold_character(text, pos):
+    width, code_point = decode(text, pos)
+    if code_point is None:
+        return width, text[pos:pos + 1]
+    return width, chr(code_point).casefold().encode('utf-8')
+
+
+def fold(text):
+    folded = b''
+    pos = 0
+    while pos < len(text):
+        width, piece = fold_character(text, pos)
+        folded += piece
+        pos += width
+    return folded
+
+
+def find_all(text, needle):
+    folded = fold(needle)
+    found = []
+    pos = 0
+    while pos < len(text):
+        index = 0
+        end = pos
+        while index < len(folded) and end < len(text):
+            width, piece = fold_character(text, end)
+            if folded[index:index + len(piece)] != piece:
+                break
+            index += len(piece)
+            end += width
+        if index == len(folded):
+            found.append((pos, end - pos))
+            pos = end
+        else:
+            pos += decode(text, pos)[0]
+    return found
+
+
+# Characters around the special foldings: sharp s, long s, Kelvin and Angstrom signs, ligatures, sigma,
+# dotted I, titlecase digraphs, and letters whose folding is longer or shorter than they are
+ALPHABET = ['a', 's', 'S', 't', 'T', 'k', 'K', 'f', 'F', 'i', 'I', 'x', ' ', 'ß', 'ẞ', 'ſ', 'K', 'ﬀ', 'ﬁ',
+            'ﬅ', 'ﬆ', 'σ', 'Σ', 'ς', 'é', 'É', 'İ', 'ŉ', 'ΐ', 'ǅ', 'ǆ', 'Ǆ', 'å', 'Å', 'Å', 'ff', 'st', 'ss']
+# Invalid UTF-8: lone trail bytes, truncated sequences, surrogates, bytes that never start a character
+INVALID = [b'\xa9', b'\x84\xaa', b'\xc3', b'\xff', b'\x80', b'\xe2\x84', b'\xed\xa0\x80', b'\xef\xbf\xbe']
+
+
+def random_text(rng, count, invalid_share):
+    text = b''
+    for _ in range(count):
+        if rng.random() < invalid_share:
+            text += rng.choice(INVALID)
+        elif rng.random() < 0.1:
+            text += rng.choice(ALPHABET).encode('utf-8')
+        else:
+            text += rng.choice(ALPHABET[:12] if rng.random() < 0.5 else ALPHABET).encode('utf-8')
+    return text
+
+
+def write_case(out, text, needles):
+    out.append('doc ' + text.hex())
+    for needle in needles:
+        found = find_all(text, needle)
+        out.append(' '.join(['find', needle.hex(), str(len(found))] + ['%d:%d' % hit for hit in found]))
+
+
+def main():
+    assert unicodedata.unidata_version == UNICODE_VERSION, unicodedata.unidata_version
+    rng = random.Random(13)
+    out = ['# Generated by make_caseless_corpus.py, do not edit',
+           '# doc <text as hex>, then per needle: find <needle as hex> <count> <start>:<length> ...']
+
+    # Every character of the folding table, searched by itself and by its folding
+    for code_point in range(0x80, 0x110000):
+        if 0xD800 <= code_point <= 0xDFFF:
+            continue
+        character = chr(code_point)
+        folded = character.casefold()
+        if folded == character:
+            continue
+        variants = [character, folded, character.upper(), character.lower()]
+        text = ('x' + ' '.join(variants) + 'y').encode('utf-8')
+        write_case(out, text, [character.encode('utf-8'), folded.encode('utf-8')])
+
+    # Random texts and needles mixing the characters above with invalid bytes
+    for _ in range(3000):
+        text = random_text(rng, rng.randint(0, 60), 0.05)
+        needles = [random_text(rng, rng.randint(1, 3), 0.08) for _ in range(rng.randint(1, 3))]
+        write_case(out, text, needles)
+
+    with open('CaselessCorpus.txt', 'w') as corpus:
+        corpus.write('\n'.join(out) + '\n')
+
+
+if __name__ == '__main__':
+    main()